@@ -0,0 +1,127 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./BLAS_benchmark/BatchBlasCpuBench.cc
+
+    Copyright (C) 2023
+
+Author: Peter Boyle <pboyle@bnl.gov>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+//
+// Host build companion to BatchBlasBench.cc: the same coarse multi-RHS and block
+// project shapes through GridBLAS, native CPU engine against the Eigen fallback,
+// plus the strided batch entry point.
+//
+#include <Grid/Grid.h>
+
+using namespace Grid;
+
+template<class CComplex>
+double Bench(GridBLAS &blas,int engine,int strided,
+	     GridBLASOperation_t OpA,int M,int N,int K,int BATCH)
+{
+  int64_t sA=(int64_t)M*K, sB=(int64_t)K*N, sC=(int64_t)M*N;
+  deviceVector<CComplex> A(sA*BATCH); acceleratorMemSet(&A[0],0,sA*BATCH*sizeof(CComplex));
+  deviceVector<CComplex> B(sB*BATCH); acceleratorMemSet(&B[0],0,sB*BATCH*sizeof(CComplex));
+  deviceVector<CComplex> C(sC*BATCH); acceleratorMemSet(&C[0],0,sC*BATCH*sizeof(CComplex));
+  deviceVector<CComplex *> As(BATCH), Bs(BATCH), Cs(BATCH);
+  for(int b=0;b<BATCH;b++){
+    As[b]=&A[b*sA]; Bs[b]=&B[b*sB]; Cs[b]=&C[b*sC];
+  }
+  CComplex alpha(1.0);
+  CComplex beta (1.0);
+
+  int saved = GridBLAS::cpuEngine;
+  GridBLAS::cpuEngine = engine;
+  auto call = [&](void) {
+    if ( strided ) blas.gemmStridedBatched(OpA,GridBLAS_OP_N,M,N,K,alpha,&A[0],sA,&B[0],sB,beta,&C[0],sC,BATCH);
+    else           blas.gemmBatched       (OpA,GridBLAS_OP_N,M,N,K,alpha,As,Bs,beta,Cs);
+  };
+  call(); // warm up
+
+  // Aim for about half a second per measurement
+  int ncall=1;
+  RealD t0 = usecond();
+  call();
+  RealD t1 = usecond();
+  ncall = std::max(1,std::min(1000,(int)(0.5e6/(t1-t0+1.0))));
+
+  t0 = usecond();
+  for(int i=0;i<ncall;i++) call();
+  t1 = usecond();
+  GridBLAS::cpuEngine = saved;
+
+  RealD flops = 8.0*M*N*K*BATCH*ncall;
+  return flops/(t1-t0)/1.e3; // GF/s
+}
+
+template<class CComplex>
+void BLAS(int vol,int blkvol)
+{
+  int  basis[] = { 16,32,64 };
+  int  rhs[]   = { 8,12,16 };
+
+  GridBLAS blas;
+
+  int fpbits = sizeof(CComplex)*4;
+  std::cout<<GridLogMessage << "=================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= batched GEMM fp"<<fpbits<<" on "<<GridThread::GetThreads()<<" threads"<<std::endl;
+  std::cout<<GridLogMessage << "=================================================================================="<<std::endl;
+
+  for(int shape=0;shape<2;shape++){
+    std::cout<<GridLogMessage << "----------------------------------------------------------------------------------"<<std::endl;
+    if ( shape==0 ) std::cout<<GridLogMessage << "  M\tN\tK\tBATCH\tGflop/s native\tstrided\t\tEigen  (coarse mrhs)"<<std::endl;
+    else            std::cout<<GridLogMessage << "  M\tN\tK\tBATCH\tGflop/s native\tstrided\t\tEigen  (block project)"<<std::endl;
+    std::cout<<GridLogMessage << "----------------------------------------------------------------------------------"<<std::endl;
+    for(int b=0;b<3;b++){
+      for(int r=0;r<3;r++){
+	int M=basis[b];
+	int N=rhs[r];
+	int K     = shape ? blkvol : basis[b];
+	int BATCH = shape ? vol/16 : vol;
+	GridBLASOperation_t OpA = shape ? GridBLAS_OP_C : GridBLAS_OP_N;
+	double pn = Bench<CComplex>(blas,GridBLAS_CPU_NATIVE,0,OpA,M,N,K,BATCH);
+	double ps = Bench<CComplex>(blas,GridBLAS_CPU_NATIVE,1,OpA,M,N,K,BATCH);
+	double pe = Bench<CComplex>(blas,GridBLAS_CPU_EIGEN ,0,OpA,M,N,K,BATCH);
+	std::cout<<GridLogMessage << "  "<<M<<"\t"<<N<<"\t"<<K<<"\t"<<BATCH<<"\t"
+		 <<pn<<"\t\t"<<ps<<"\t\t"<<pe<<std::endl;
+      }
+    }
+  }
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  int vol    = 8*8*8*8;
+  int blkvol = 4*4*4*4;
+  if( GridCmdOptionExists(argv,argv+argc,"--batch") ){
+    std::string arg = GridCmdOptionPayload(argv,argv+argc,"--batch");
+    GridCmdOptionInt(arg,vol);
+  }
+
+  std::cout<<GridLogMessage << " Batched BLAS CPU benchmark: native engine vs Eigen" <<std::endl;
+  BLAS<ComplexD>(vol,blkvol);
+  BLAS<ComplexF>(vol,blkvol);
+
+  Grid_finalize();
+}
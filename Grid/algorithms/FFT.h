@@ -28,6 +28,8 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 #ifndef _GRID_FFT_H_
 #define _GRID_FFT_H_
 
+#include <mutex>
+
 #ifdef HAVE_FFTW
 #if defined(USE_MKL) || defined(GRID_SYCL)
 #include <fftw/fftw3.h>
@@ -106,7 +108,6 @@ class FFT {
 private:
     
   GridCartesian *vgrid;
-  GridCartesian *sgrid;
     
   int Nd;
   double flops;
@@ -116,6 +117,72 @@ private:
   Coordinate dimensions;
   Coordinate processors;
   Coordinate processor_coor;
+
+  // One communicator per row of nodes along each distributed dimension,
+  // split once and reused by every transpose in that dimension.
+  std::vector<CartesianCommunicator *> rows;
+
+  CartesianCommunicator *RowComm(int dim)
+  {
+    if ( rows[dim] == nullptr ) {
+      Coordinate row(Nd,1);
+      row[dim] = processors[dim];
+      int me;
+      rows[dim] = new CartesianCommunicator(row,*vgrid,me);
+    }
+    return rows[dim];
+  }
+
+#ifdef HAVE_FFTW
+  // FFTW plans are shared by all FFT objects for the life of the program, as
+  // many callers construct an FFT per use. A plan depends only on the line
+  // length, direction, components per site and precision, so the key
+  // {G, sign, Ncomp} in a cache per precision covers every (grid, dim) with
+  // that extent. Lines are transformed contiguously in the pencil buffer and
+  // planned unaligned, so one plan serves every line. The FFTW planner is not
+  // thread safe, so lookups and planning are serialised; the plans are
+  // destroyed with the cache at program exit.
+  template<class scalar>
+  struct PlanCache {
+    typedef typename FFTW<scalar>::FFTW_plan FFTW_plan;
+    std::mutex lock;
+    std::map<std::vector<int>,FFTW_plan> plans;
+    ~PlanCache() {
+      for(auto &p : plans) FFTW<scalar>::fftw_destroy_plan(p.second);
+    }
+  };
+
+  template<class scalar>
+  static typename FFTW<scalar>::FFTW_plan Plan(int G,int sign,int Ncomp)
+  {
+    typedef typename FFTW<scalar>::FFTW_scalar FFTW_scalar;
+    typedef typename FFTW<scalar>::FFTW_plan   FFTW_plan;
+
+    static PlanCache<scalar> cache;
+    std::lock_guard<std::mutex> guard(cache.lock);
+
+    std::vector<int> key({G,sign,Ncomp});
+    auto it = cache.plans.find(key);
+    if ( it != cache.plans.end() ) return it->second;
+
+    std::vector<scalar> buf(G*Ncomp);
+    int rank = 1;  /* 1d transforms */
+    int n[] = {G}; /* 1d transforms of length G */
+    int howmany = Ncomp;
+    int odist,idist,istride,ostride;
+    idist   = odist   = 1;     /* Distance between consecutive FT's */
+    istride = ostride = Ncomp; /* distance between two elements in the same FT */
+    int *inembed = n, *onembed = n;
+    FFTW_plan p = FFTW<scalar>::fftw_plan_many_dft(rank,n,howmany,
+						   (FFTW_scalar *)&buf[0],inembed,
+						   istride,idist,
+						   (FFTW_scalar *)&buf[0],onembed,
+						   ostride, odist,
+						   sign,FFTW_ESTIMATE|FFTW_UNALIGNED);
+    cache.plans[key] = p;
+    return p;
+  }
+#endif
     
 public:
     
@@ -135,13 +202,16 @@ public:
   {
     flops=0;
     usec =0;
-    Coordinate layout(Nd,1);
-    sgrid = new GridCartesian(dimensions,layout,processors,*grid);
+    rows.resize(Nd,nullptr);
   };
     
   ~FFT ( void)  {
-    delete sgrid;
+    for(auto &r : rows) delete r;
   }
+
+  // Owns the row communicators
+  FFT(const FFT &) = delete;
+  FFT &operator=(const FFT &) = delete;
     
   template<class vobj>
   void FFT_dim_mask(Lattice<vobj> &result,const Lattice<vobj> &source,Coordinate mask,int sign){
@@ -164,101 +234,113 @@ public:
     FFT_dim_mask(result,source,mask,sign);
   }
 
-
   template<class vobj>
   void FFT_dim(Lattice<vobj> &result,const Lattice<vobj> &source,int dim, int sign){
+    std::vector<Lattice<vobj> > res(1,vgrid);
+    std::vector<Lattice<vobj> > src(1,source);
+    FFT_dim(res,src,dim,sign);
+    result = res[0];
+  }
+
+  // Batched transforms: all fields share one transpose in each direction
+  template<class vobj>
+  void FFT_dim_mask(std::vector<Lattice<vobj> > &result,const std::vector<Lattice<vobj> > &source,Coordinate mask,int sign){
+    std::vector<Lattice<vobj> > tmp(source);
+    for(int d=0;d<Nd;d++){
+      if( mask[d] ) {
+	FFT_dim(result,tmp,d,sign);
+	tmp=result;
+      }
+    }
+    result = tmp;
+  }
+
+  template<class vobj>
+  void FFT_all_dim(std::vector<Lattice<vobj> > &result,const std::vector<Lattice<vobj> > &source,int sign){
+    Coordinate mask(Nd,1);
+    FFT_dim_mask(result,source,mask,sign);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////
+  // Pencil decomposition along dim. The P nodes in a row along dim share the same
+  // orthogonal sites; each takes 1/P of the orthogonal lines (over all fields),
+  // gathers them at full length G with one all-to-all, transforms, and returns them
+  // with a second all-to-all. Every line is transformed exactly once.
+  ////////////////////////////////////////////////////////////////////////////////////////
+  template<class vobj>
+  void FFT_dim(std::vector<Lattice<vobj> > &result,const std::vector<Lattice<vobj> > &source,int dim, int sign){
 #ifndef HAVE_FFTW
     assert(0);
 #else
-    conformable(result.Grid(),vgrid);
-    conformable(source.Grid(),vgrid);
-
-    int L = vgrid->_ldimensions[dim];
-    int G = vgrid->_fdimensions[dim];
-      
-    Coordinate layout(Nd,1);
-    Coordinate pencil_gd(vgrid->_fdimensions);
-      
-    pencil_gd[dim] = G*processors[dim];
-      
-    // Pencil global vol LxLxGxLxL per node
-    GridCartesian pencil_g(pencil_gd,layout,processors,*vgrid);
-      
-    // Construct pencils
     typedef typename vobj::scalar_object sobj;
     typedef typename sobj::scalar_type   scalar;
-      
-    Lattice<sobj> pgbuf(&pencil_g);
-    autoView(pgbuf_v , pgbuf, CpuWrite);
-
     typedef typename FFTW<scalar>::FFTW_scalar FFTW_scalar;
     typedef typename FFTW<scalar>::FFTW_plan   FFTW_plan;
+
+    int Nf = source.size();
+    for(int f=0;f<Nf;f++) conformable(source[f].Grid(),vgrid);
+    result.resize(Nf,vgrid);
+
+    int L = vgrid->_ldimensions[dim];
+    int G = vgrid->_fdimensions[dim];
+    int P = processors[dim];
       
     int Ncomp = sizeof(sobj)/sizeof(scalar);
     int Nlow  = 1;
-    for(int d=0;d<dim;d++){
-      Nlow*=vgrid->_ldimensions[d];
-    }
-      
-    int rank = 1;  /* 1d transforms */
-    int n[] = {G}; /* 1d transforms of length G */
-    int howmany = Ncomp;
-    int odist,idist,istride,ostride;
-    idist   = odist   = 1;          /* Distance between consecutive FT's */
-    istride = ostride = Ncomp*Nlow; /* distance between two elements in the same FT */
-    int *inembed = n, *onembed = n;
+    int Nhigh = 1;
+    for(int d=0;d<dim;d++)    Nlow *=vgrid->_ldimensions[d];
+    for(int d=dim+1;d<Nd;d++) Nhigh*=vgrid->_ldimensions[d];
+    int M    = Nlow*Nhigh;        // orthogonal lines per field
+    int Mtot = M*Nf;
+    int C    = (Mtot+P-1)/P;      // lines per node after the transpose
       
     scalar div;
     if ( sign == backward ) div = 1.0/G;
     else if ( sign == forward ) div = 1.0;
     else assert(0);
-      
-    FFTW_plan p;
-    {
-      FFTW_scalar *in = (FFTW_scalar *)&pgbuf_v[0];
-      FFTW_scalar *out= (FFTW_scalar *)&pgbuf_v[0];
-      p = FFTW<scalar>::fftw_plan_many_dft(rank,n,howmany,
-					   in,inembed,
-					   istride,idist,
-					   out,onembed,
-					   ostride, odist,
-					   sign,FFTW_ESTIMATE);
+
+    FFTW_plan p = Plan<scalar>(G,sign,Ncomp);
+
+    // Local slabs, lines contiguous: lines[(f*M + low + Nlow*high)*L + l]
+    std::vector<sobj> lines(P*C*L);
+    std::vector<sobj> slex;
+    for(int f=0;f<Nf;f++){
+      unvectorizeToLexOrdArray(slex,source[f]);
+      thread_for(m,M,{
+	int low  = m%Nlow;
+	int high = m/Nlow;
+	for(int l=0;l<L;l++){
+	  lines[(f*M+m)*L+l] = slex[low+Nlow*(l+L*high)];
+	}
+      });
     }
-      
-    // Barrel shift and collect global pencil
-    Coordinate lcoor(Nd), gcoor(Nd);
-    result = source;
-    int pc = processor_coor[dim];
-    for(int p=0;p<processors[dim];p++) {
-      {
-	autoView(r_v,result,CpuRead);
-	autoView(p_v,pgbuf,CpuWrite);
-	thread_for(idx, sgrid->lSites(),{
-          Coordinate cbuf(Nd);
-          sobj s;
-	  sgrid->LocalIndexToLocalCoor(idx,cbuf);
-	  peekLocalSite(s,r_v,cbuf);
-	  cbuf[dim]+=((pc+p) % processors[dim])*L;
-	  pokeLocalSite(s,p_v,cbuf);
-        });
-      }
-      if (p != processors[dim] - 1) {
-	result = Cshift(result,dim,L);
-      }
+
+    // Transpose to pencils: node q sends its L sites of lines [pc*C,(pc+1)*C) to node pc,
+    // which lays them out as pencil[m*G + q*L + l]
+    std::vector<sobj> recv;
+    std::vector<sobj> pencil;
+    sobj *pencil_p = &lines[0];
+    if ( P > 1 ) {
+      recv.resize(P*C*L);
+      pencil.resize(C*G);
+      RowComm(dim)->AllToAll((void *)&lines[0],(void *)&recv[0],C*L,sizeof(sobj));
+      thread_for(m,C,{
+	for(int q=0;q<P;q++){
+	  for(int l=0;l<L;l++){
+	    pencil[m*G+q*L+l] = recv[(q*C+m)*L+l];
+	  }
+	}
+      });
+      pencil_p = &pencil[0];
     }
-      
-    // Loop over orthog coords
-    int NN=pencil_g.lSites();
+
+    // Lines past the end of the batch only pad the last node's share
+    int Cme = std::max(0,std::min(C,Mtot-processor_coor[dim]*C));
     GridStopWatch timer;
     timer.Start();
-    thread_for( idx,NN,{
-        Coordinate cbuf(Nd);
-	pencil_g.LocalIndexToLocalCoor(idx, cbuf);
-	if ( cbuf[dim] == 0 ) {  // restricts loop to plane at lcoor[dim]==0
-	  FFTW_scalar *in = (FFTW_scalar *)&pgbuf_v[idx];
-	  FFTW_scalar *out= (FFTW_scalar *)&pgbuf_v[idx];
-	  FFTW<scalar>::fftw_execute_dft(p,in,out);
-	}
+    thread_for( m,Cme,{
+	FFTW_scalar *in = (FFTW_scalar *)&pencil_p[m*G];
+	FFTW<scalar>::fftw_execute_dft(p,in,in);
     });
     timer.Stop();
       
@@ -267,26 +349,31 @@ public:
     FFTW<scalar>::fftw_flops(p,&add,&mul,&fma);
     flops_call = add+mul+2.0*fma;
     usec += timer.useconds();
-    flops+= flops_call*NN;
-      
+    flops+= flops_call*Cme;
+
+    // Transpose back
+    if ( P > 1 ) {
+      thread_for(m,C,{
+	for(int q=0;q<P;q++){
+	  for(int l=0;l<L;l++){
+	    recv[(q*C+m)*L+l] = pencil[m*G+q*L+l];
+	  }
+	}
+      });
+      RowComm(dim)->AllToAll((void *)&recv[0],(void *)&lines[0],C*L,sizeof(sobj));
+    }
+
     // writing out result
-    {
-      autoView(pgbuf_v,pgbuf,CpuRead);
-      autoView(result_v,result,CpuWrite);
-      thread_for(idx,sgrid->lSites(),{
-	Coordinate clbuf(Nd), cgbuf(Nd);
-	sobj s;
-	sgrid->LocalIndexToLocalCoor(idx,clbuf);
-	cgbuf = clbuf;
-	cgbuf[dim] = clbuf[dim]+L*pc;
-	peekLocalSite(s,pgbuf_v,cgbuf);
-	pokeLocalSite(s,result_v,clbuf);
+    for(int f=0;f<Nf;f++){
+      thread_for(m,M,{
+	int low  = m%Nlow;
+	int high = m/Nlow;
+	for(int l=0;l<L;l++){
+	  slex[low+Nlow*(l+L*high)] = lines[(f*M+m)*L+l]*div;
+	}
       });
+      vectorizeFromLexOrdArray(slex,result[f]);
     }
-    result = result*div;
-      
-    // destroying plan
-    FFTW<scalar>::fftw_destroy_plan(p);
 #endif
   }
 };
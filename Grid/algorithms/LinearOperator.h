@@ -331,8 +331,12 @@ template<class Matrix,class Field>
       Field tmp(in.Grid());
       tmp.Checkerboard() = !in.Checkerboard();
       
-      _Mat.Meooe(in,tmp);
-      _Mat.MooeeInv(tmp,out);
+      if ( _Mat.MooeeInvMeooeFused() ) {
+	_Mat.MooeeInvMeooe(in,out);
+      } else {
+	_Mat.Meooe(in,tmp);
+	_Mat.MooeeInv(tmp,out);
+      }
       _Mat.Meooe(out,tmp);
       _Mat.Mooee(in,out);
       axpy(out,-1.0,tmp,out);
@@ -340,8 +344,12 @@ template<class Matrix,class Field>
     virtual void MpcDag   (const Field &in, Field &out){
       Field tmp(in.Grid());
 	
-      _Mat.MeooeDag(in,tmp);
-      _Mat.MooeeInvDag(tmp,out);
+      if ( _Mat.MooeeInvMeooeFused() ) {
+	_Mat.MooeeInvDagMeooeDag(in,out);
+      } else {
+	_Mat.MeooeDag(in,tmp);
+	_Mat.MooeeInvDag(tmp,out);
+      }
       _Mat.MeooeDag(out,tmp);
       _Mat.MooeeDag(in,out);
       axpy(out,-1.0,tmp,out);
@@ -357,18 +365,29 @@ template<class Matrix,class Field>
     virtual void Mpc      (const Field &in, Field &out) {
       Field tmp(in.Grid());
 
-      _Mat.Meooe(in,out);
-      _Mat.MooeeInv(out,tmp);
-      _Mat.Meooe(tmp,out);
-      _Mat.MooeeInv(out,tmp);
-      axpy(out,-1.0,tmp,in);
+      if ( _Mat.MooeeInvMeooeFused() ) {
+	_Mat.MooeeInvMeooe(in,tmp);
+	_Mat.MooeeInvMeooe(tmp,out);
+	axpy(out,-1.0,out,in);
+      } else {
+	_Mat.Meooe(in,out);
+	_Mat.MooeeInv(out,tmp);
+	_Mat.Meooe(tmp,out);
+	_Mat.MooeeInv(out,tmp);
+	axpy(out,-1.0,tmp,in);
+      }
     }
     virtual void MpcDag   (const Field &in, Field &out){
       Field tmp(in.Grid());
       
-      _Mat.MooeeInvDag(in,out);
-      _Mat.MeooeDag(out,tmp);
-      _Mat.MooeeInvDag(tmp,out);
+      if ( _Mat.MooeeInvMeooeFused() ) {
+	_Mat.MooeeInvDag(in,tmp);
+	_Mat.MooeeInvDagMeooeDag(tmp,out);
+      } else {
+	_Mat.MooeeInvDag(in,out);
+	_Mat.MeooeDag(out,tmp);
+	_Mat.MooeeInvDag(tmp,out);
+      }
       _Mat.MeooeDag(out,tmp);
       axpy(out,-1.0,tmp,in);
     }
@@ -383,9 +402,14 @@ template<class Matrix,class Field>
     virtual void Mpc      (const Field &in, Field &out) {
       Field tmp(in.Grid());
       
-      _Mat.MooeeInv(in,out);
-      _Mat.Meooe(out,tmp);
-      _Mat.MooeeInv(tmp,out);
+      if ( _Mat.MooeeInvMeooeFused() ) {
+	_Mat.MooeeInv(in,tmp);
+	_Mat.MooeeInvMeooe(tmp,out);
+      } else {
+	_Mat.MooeeInv(in,out);
+	_Mat.Meooe(out,tmp);
+	_Mat.MooeeInv(tmp,out);
+      }
       _Mat.Meooe(out,tmp);
       
       axpy(out,-1.0,tmp,in);
@@ -393,10 +417,15 @@ template<class Matrix,class Field>
     virtual  void MpcDag   (const Field &in, Field &out){
       Field tmp(in.Grid());
 
-      _Mat.MeooeDag(in,out);
-      _Mat.MooeeInvDag(out,tmp);
-      _Mat.MeooeDag(tmp,out);
-      _Mat.MooeeInvDag(out,tmp);
+      if ( _Mat.MooeeInvMeooeFused() ) {
+	_Mat.MooeeInvDagMeooeDag(in,out);
+	_Mat.MooeeInvDagMeooeDag(out,tmp);
+      } else {
+	_Mat.MeooeDag(in,out);
+	_Mat.MooeeInvDag(out,tmp);
+	_Mat.MeooeDag(tmp,out);
+	_Mat.MooeeInvDag(out,tmp);
+      }
 
       axpy(out,-1.0,tmp,in);
     }
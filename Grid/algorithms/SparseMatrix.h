@@ -78,6 +78,24 @@ public:
   virtual  void MeooeDag    (const Field &in, Field &out)=0;
   virtual  void MooeeDag    (const Field &in, Field &out)=0;
   virtual  void MooeeInvDag (const Field &in, Field &out)=0;
+
+  // MooeeInv Meooe and its adjoint product, as met in the Schur operators.
+  // Operators able to apply both in one pass over the field override these
+  // and report it in MooeeInvMeooeFused; the Schur operators only call them
+  // then, and otherwise keep the separate calls on their own scratch field.
+  virtual  int  MooeeInvMeooeFused(void) { return 0; }
+  virtual  void MooeeInvMeooe(const Field &in, Field &out) {
+    Field tmp(in.Grid());
+    tmp.Checkerboard() = !in.Checkerboard();
+    Meooe(in,tmp);
+    MooeeInv(tmp,out);
+  }
+  virtual  void MooeeInvDagMeooeDag(const Field &in, Field &out) {
+    Field tmp(in.Grid());
+    tmp.Checkerboard() = !in.Checkerboard();
+    MeooeDag(in,tmp);
+    MooeeInvDag(tmp,out);
+  }
   virtual ~CheckerBoardedSparseMatrixBase() {};
 };
 
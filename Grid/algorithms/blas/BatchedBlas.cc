@@ -30,5 +30,6 @@ Author: Peter Boyle <pboyle@bnl.gov>
 NAMESPACE_BEGIN(Grid);
 gridblasHandle_t GridBLAS::gridblasHandle;
 int              GridBLAS::gridblasInit;
+int              GridBLAS::cpuEngine = GridBLAS_CPU_AUTO;
 NAMESPACE_END(Grid);
 
@@ -65,6 +65,14 @@ NAMESPACE_BEGIN(Grid);
 #endif
 
 enum GridBLASOperation_t { GridBLAS_OP_N, GridBLAS_OP_T, GridBLAS_OP_C } ;
+enum GridBLASCpuEngine_t { GridBLAS_CPU_EIGEN, GridBLAS_CPU_NATIVE, GridBLAS_CPU_AUTO } ;
+NAMESPACE_END(Grid);
+
+#if !defined(GRID_SYCL) && !defined(GRID_CUDA) && !defined(GRID_HIP)
+#include <Grid/algorithms/blas/BatchedBlasCpu.h>
+#endif
+
+NAMESPACE_BEGIN(Grid);
 
 class GridBLAS {
 public:
@@ -72,6 +80,16 @@ public:
   
   static gridblasHandle_t gridblasHandle;
   static int            gridblasInit;
+  static int            cpuEngine;     // host builds: GridBLAS_CPU_AUTO, GridBLAS_CPU_NATIVE or GridBLAS_CPU_EIGEN
+
+  // GridBLAS_CPU_AUTO picks per call. The native engine only beats Eigen on short
+  // fp64 complex reductions (coarse multi-RHS, k<=32); long reductions such as the
+  // block project (k=256) and the other precisions go to Eigen.
+  template<class T> static inline int cpuNative(int m,int n,int k)
+  {
+    if ( cpuEngine == GridBLAS_CPU_AUTO ) return std::is_same<T,ComplexD>::value && (k <= 32);
+    return cpuEngine == GridBLAS_CPU_NATIVE;
+  }
   
   static void Init(void)
   {
@@ -361,7 +379,13 @@ public:
 #endif
 #endif
 #if !defined(GRID_SYCL) && !defined(GRID_CUDA) && !defined(GRID_HIP)
-    // Need a default/reference implementation; use Eigen
+    if ( cpuNative<ComplexD>(m,n,k) ) {
+      cpuGemmBatched(OpA,OpB,m,n,k,alpha,beta,batchCount,
+		     [&](int p){ return Amk[p]; },
+		     [&](int p){ return Bkn[p]; },
+		     [&](int p){ return Cmn[p]; });
+    } else
+    // Reference implementation; use Eigen
       if ( (OpA == GridBLAS_OP_N ) && (OpB == GridBLAS_OP_N) ) {
 	thread_for (p, batchCount, {
 	  Eigen::Map<Eigen::MatrixXcd> eAmk(Amk[p],m,k);
@@ -508,7 +532,13 @@ public:
     synchronise();
 #endif
 #if !defined(GRID_SYCL) && !defined(GRID_CUDA) && !defined(GRID_HIP)
-    // Need a default/reference implementation; use Eigen
+    if ( cpuNative<ComplexF>(m,n,k) ) {
+      cpuGemmBatched(OpA,OpB,m,n,k,alpha,beta,batchCount,
+		     [&](int p){ return Amk[p]; },
+		     [&](int p){ return Bkn[p]; },
+		     [&](int p){ return Cmn[p]; });
+    } else
+    // Reference implementation; use Eigen
       if ( (OpA == GridBLAS_OP_N ) && (OpB == GridBLAS_OP_N) ) {
 	thread_for (p, batchCount, {
 	  Eigen::Map<Eigen::MatrixXcf> eAmk(Amk[p],m,k);
@@ -575,8 +605,11 @@ public:
     static deviceVector<RealF> alpha_p(1);
     static deviceVector<RealF> beta_p(1);
     // can prestore the 1 and the zero on device
+#if defined(GRID_SYCL) || defined(GRID_CUDA) || defined(GRID_HIP)
+    // only the vendor BLAS reads these; host thread_bcopy moves whole 8 byte words
     acceleratorCopyToDevice((void *)&alpha,(void *)&alpha_p[0],sizeof(RealF));
     acceleratorCopyToDevice((void *)&beta ,(void *)&beta_p[0],sizeof(RealF));
+#endif
     RealD t0=usecond();
 
     assert(Bkn.size()==batchCount);
@@ -655,7 +688,13 @@ public:
       synchronise();
 #endif
 #if !defined(GRID_SYCL) && !defined(GRID_CUDA) && !defined(GRID_HIP)
-    // Need a default/reference implementation; use Eigen
+    if ( cpuNative<RealF>(m,n,k) ) {
+      cpuGemmBatched(OpA,OpB,m,n,k,alpha,beta,batchCount,
+		     [&](int p){ return Amk[p]; },
+		     [&](int p){ return Bkn[p]; },
+		     [&](int p){ return Cmn[p]; });
+    } else
+    // Reference implementation; use Eigen
       if ( (OpA == GridBLAS_OP_N ) && (OpB == GridBLAS_OP_N) ) {
 	thread_for (p, batchCount, {
 	  Eigen::Map<Eigen::MatrixXf> eAmk(Amk[p],m,k);
@@ -803,7 +842,13 @@ public:
       synchronise();
 #endif
 #if !defined(GRID_SYCL) && !defined(GRID_CUDA) && !defined(GRID_HIP)
-    // Need a default/reference implementation; use Eigen
+    if ( cpuNative<RealD>(m,n,k) ) {
+      cpuGemmBatched(OpA,OpB,m,n,k,alpha,beta,batchCount,
+		     [&](int p){ return Amk[p]; },
+		     [&](int p){ return Bkn[p]; },
+		     [&](int p){ return Cmn[p]; });
+    } else
+    // Reference implementation; use Eigen
       if ( (OpA == GridBLAS_OP_N ) && (OpB == GridBLAS_OP_N) ) {
 	thread_for (p, batchCount, {
 	  Eigen::Map<Eigen::MatrixXd> eAmk(Amk[p],m,k);
@@ -841,6 +886,45 @@ public:
      RealD bytes = 1.0*sizeof(RealD)*(m*k+k*n+m*n)*batchCount;
   }
 
+  /////////////////////////////////////////////////////////////////////////////////////
+  // Strided batch: matrix p lives at A+p*strideA, B+p*strideB, C+p*strideC, so no
+  // pointer lists need to be built. Host builds call the native engine directly;
+  // device builds hand the vendor library a pointer list.
+  /////////////////////////////////////////////////////////////////////////////////////
+  template<class T>
+  void gemmStridedBatched(GridBLASOperation_t OpA,
+			  GridBLASOperation_t OpB,
+			  int m,int n, int k,
+			  T alpha,
+			  T *Amk, int64_t strideA,
+			  T *Bkn, int64_t strideB,
+			  T beta,
+			  T *Cmn, int64_t strideC,
+			  int batchCount)
+  {
+    if ( batchCount == 0 ) return;
+#if !defined(GRID_SYCL) && !defined(GRID_CUDA) && !defined(GRID_HIP)
+    if ( cpuNative<T>(m,n,k) ) {
+      cpuGemmBatched(OpA,OpB,m,n,k,alpha,beta,batchCount,
+		     [&](int p){ return Amk+p*strideA; },
+		     [&](int p){ return Bkn+p*strideB; },
+		     [&](int p){ return Cmn+p*strideC; });
+      return;
+    }
+#endif
+    std::vector<T *> hA(batchCount), hB(batchCount), hC(batchCount);
+    for(int p=0;p<batchCount;p++){
+      hA[p] = Amk+p*strideA;
+      hB[p] = Bkn+p*strideB;
+      hC[p] = Cmn+p*strideC;
+    }
+    deviceVector<T *> As(batchCount), Bs(batchCount), Cs(batchCount);
+    acceleratorCopyToDevice(&hA[0],&As[0],batchCount*sizeof(T *));
+    acceleratorCopyToDevice(&hB[0],&Bs[0],batchCount*sizeof(T *));
+    acceleratorCopyToDevice(&hC[0],&Cs[0],batchCount*sizeof(T *));
+    gemmBatched(OpA,OpB,m,n,k,alpha,As,Bs,beta,Cs);
+  }
+
   template<class CComplex>
   double benchmark(int M, int N, int K, int BATCH)
   {
@@ -0,0 +1,264 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: BatchedBlasCpu.h
+
+    Copyright (C) 2023
+
+Author: Peter Boyle <pboyle@bnl.gov>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Native CPU batched GEMM engine behind GridBLAS on host only builds.
+//
+// Column major, BLAS conventions: C_mn = alpha op(A)_mk op(B)_kn + beta C_mn.
+//
+// Each pair of columns is C(:,j) = beta C(:,j) + sum_l op(A)(:,l) b(l,j), an axpy over the
+// contiguous m index with b = alpha op(B)(:,j) gathered first. For op(A)=C,T the matrix
+// is packed once per batch entry into an m contiguous per-thread buffer, as a packed
+// BLAS would, rather than running strided dot products.
+//
+// m is a template parameter for the sizes produced by the coarse multi-RHS operators
+// and block projectors (nbasis 4..64) so the inner loops fully unroll, vectorise and
+// accumulate in registers; other sizes take the runtime loop. Complex arithmetic is
+// spelled out on interleaved reals to avoid the library complex multiply.
+//
+// Work is tiled over (batch entry, column block) so that a handful of large matrices
+// and many tiny ones both spread over all threads. Batches come either as pointer lists
+// or as one base pointer plus a fixed stride per matrix (strided batch).
+///////////////////////////////////////////////////////////////////////////////////////////
+template<class S> struct CpuGemmTraits {
+  typedef S real; static const int cplx=0;
+  static inline S re(S a) { return a; }
+  static inline S im(S a) { return 0; }
+};
+template<class R> struct CpuGemmTraits<std::complex<R>> {
+  typedef R real; static const int cplx=1;
+  static inline R re(std::complex<R> a) { return a.real(); }
+  static inline R im(std::complex<R> a) { return a.imag(); }
+};
+
+// Per column kernels; LT is the compile time m, 0 for runtime
+template<class S,int LT>
+struct CpuGemmKernel {
+  typedef typename CpuGemmTraits<S>::real R;
+  static const int cplx = CpuGemmTraits<S>::cplx;
+  static const int W    = cplx ? 2 : 1;   // reals per element
+
+  // gather alpha * op(B)(:,j) contiguously
+  static inline void gatherB(GridBLASOperation_t OpB,int n,int k,const R *B,int j,R alpha_r,R alpha_i,R *b)
+  {
+    for(int l=0;l<k;l++){
+      R br,bi=0;
+      if ( OpB == GridBLAS_OP_N ) {
+	br = B[W*(l+j*k)];
+	if ( cplx ) bi = B[W*(l+j*k)+1];
+      } else {
+	br = B[W*(j+l*n)];
+	if ( cplx ) bi = B[W*(j+l*n)+1];
+	if ( OpB == GridBLAS_OP_C ) bi = -bi;
+      }
+      if ( cplx ) {
+	b[2*l]   = alpha_r*br - alpha_i*bi;
+	b[2*l+1] = alpha_r*bi + alpha_i*br;
+      } else {
+	b[l]     = alpha_r*br;
+      }
+    }
+  }
+
+  // Rows [i0,i0+ib) of C0,C1 = beta C + op(A) b for columns j, j+1 (C1 null: one column).
+  // IB>0 accumulates in registers over the whole k loop; IB=0 is the runtime size path
+  // and works in place on C.
+  template<int IB>
+  static inline void axpy2block(int i0,int ib_,int m,int k,const R * __restrict A,
+				const R * __restrict bj0,const R * __restrict bj1,
+				R beta_r,R beta_i,R * __restrict C0,R * __restrict C1)
+  {
+    const int ib = IB ? IB : ib_;
+    R acc0[IB ? W*IB : 1];
+    R acc1[IB ? W*IB : 1];
+    R *a0 = IB ? acc0 : &C0[W*i0];
+    R *a1 = IB ? acc1 : (C1 ? &C1[W*i0] : nullptr);
+    const R *c0 = &C0[W*i0];
+    const R *c1 = C1 ? &C1[W*i0] : nullptr;
+    const bool zb = (beta_r==0) && (beta_i==0); // beta==0 must not propagate NaN from C
+    for(int i=0;i<ib;i++){
+      if ( cplx ) {
+	R re0 = zb ? 0 : beta_r*c0[2*i]-beta_i*c0[2*i+1];
+	R im0 = zb ? 0 : beta_r*c0[2*i+1]+beta_i*c0[2*i];
+	a0[2*i]=re0; a0[2*i+1]=im0;
+	if ( C1 ) {
+	  R re1 = zb ? 0 : beta_r*c1[2*i]-beta_i*c1[2*i+1];
+	  R im1 = zb ? 0 : beta_r*c1[2*i+1]+beta_i*c1[2*i];
+	  a1[2*i]=re1; a1[2*i+1]=im1;
+	}
+      } else {
+	a0[i] = zb ? 0 : beta_r*c0[i];
+	if ( C1 ) a1[i] = zb ? 0 : beta_r*c1[i];
+      }
+    }
+    for(int l=0;l<k;l++){
+      const R *a = &A[W*(l*m+i0)];
+      if ( cplx ) {
+	R b0r=bj0[2*l], b0i=bj0[2*l+1];
+	if ( C1 ) {
+	  R b1r=bj1[2*l], b1i=bj1[2*l+1];
+	  // (re,im) += (ar,ai) br + (-ai,ar) bi : a lane swap, no deinterleave
+	  for(int i=0;i<ib;i++){
+	    R ar=a[2*i], ai=a[2*i+1];
+	    a0[2*i]   += ar*b0r; a0[2*i+1] += ai*b0r;
+	    a1[2*i]   += ar*b1r; a1[2*i+1] += ai*b1r;
+	    a0[2*i]   -= ai*b0i; a0[2*i+1] += ar*b0i;
+	    a1[2*i]   -= ai*b1i; a1[2*i+1] += ar*b1i;
+	  }
+	} else {
+	  for(int i=0;i<ib;i++){
+	    R ar=a[2*i], ai=a[2*i+1];
+	    a0[2*i]   += ar*b0r; a0[2*i+1] += ai*b0r;
+	    a0[2*i]   -= ai*b0i; a0[2*i+1] += ar*b0i;
+	  }
+	}
+      } else {
+	R b0=bj0[l];
+	if ( C1 ) {
+	  R b1=bj1[l];
+	  for(int i=0;i<ib;i++){ a0[i] += a[i]*b0; a1[i] += a[i]*b1; }
+	} else {
+	  for(int i=0;i<ib;i++){ a0[i] += a[i]*b0; }
+	}
+      }
+    }
+    if ( IB ) {
+      for(int i=0;i<W*IB;i++) C0[W*i0+i]=a0[i];
+      if ( C1 ) for(int i=0;i<W*IB;i++) C1[W*i0+i]=a1[i];
+    }
+  }
+
+  // Row block: 8 or 4 elements, which divide every specialised m
+  static const int RB = (LT%8==0) ? 8 : ((LT%4==0) ? 4 : LT);
+
+  // C0,C1 = beta C + op(A) b for columns j, j+1 (C1 null: one column); LT is m
+  static inline void axpy2(int m,int k,const R * __restrict A,
+			   const R * __restrict bj0,const R * __restrict bj1,
+			   R beta_r,R beta_i,R * __restrict C0,R * __restrict C1)
+  {
+    if ( LT ) {
+      for(int i0=0;i0<LT;i0+=RB) axpy2block<RB>(i0,RB,LT,k,A,bj0,bj1,beta_r,beta_i,C0,C1);
+    } else {
+      axpy2block<0>(0,m,m,k,A,bj0,bj1,beta_r,beta_i,C0,C1);
+    }
+  }
+
+  // op(A)=C,T : pack op(A) column major (m contiguous) so the axpy kernel applies
+  static inline void packA(GridBLASOperation_t OpA,int m,int k,const R *A,R *a)
+  {
+    const R sgn = (OpA==GridBLAS_OP_C) ? -1 : 1;
+    for(int i=0;i<m;i++){
+      for(int l=0;l<k;l++){
+	a[W*(i+l*m)] = A[W*(l+i*k)];
+	if ( cplx ) a[W*(i+l*m)+1] = sgn*A[W*(l+i*k)+1];
+      }
+    }
+  }
+};
+
+template<class S,int LT,class GetA,class GetB,class GetC>
+void cpuGemmBatchedDriver(GridBLASOperation_t OpA,GridBLASOperation_t OpB,
+			  int m,int n,int k,S alpha,S beta,int batchCount,
+			  GetA getA,GetB getB,GetC getC)
+{
+  typedef CpuGemmKernel<S,LT> Kernel;
+  typedef typename Kernel::R R;
+  const int W = Kernel::W;
+  typedef CpuGemmTraits<S> Traits;
+  R alpha_r = Traits::re(alpha), alpha_i = Traits::im(alpha);
+  R beta_r  = Traits::re(beta) , beta_i  = Traits::im(beta);
+
+  // Tile columns only when there are too few batch entries to feed every thread
+  int nthr = GridThread::GetThreads();
+  int tn = n;
+  if ( batchCount < 2*nthr ) {
+    tn = (int)(((int64_t)n*batchCount + 2*nthr - 1)/(2*nthr));
+    tn = std::max(2,tn+(tn&1));
+    tn = std::min(n,tn);
+  }
+  int ntile = (n+tn-1)/tn;
+  uint64_t nwork = (uint64_t)batchCount*ntile;
+
+  thread_region
+  {
+    std::vector<R> bbuf(2*W*k+2);
+    std::vector<R> abuf( (OpA==GridBLAS_OP_N) ? 0 : W*m*k );
+    R *b0 = &bbuf[0];
+    R *b1 = &bbuf[W*k];
+    int packed = -1;
+    thread_for_in_region(w,nwork,{
+      int p  = w / ntile;
+      int j0 = (w % ntile)*tn;
+      int j1 = std::min(n,j0+tn);
+      const R *A = (const R *)getA(p);
+      const R *B = (const R *)getB(p);
+      R       *C = (R *)getC(p);
+      if ( OpA != GridBLAS_OP_N ) {
+	// consecutive tiles of one entry usually land on the same thread; pack once
+	if ( packed != p ) Kernel::packA(OpA,m,k,A,&abuf[0]);
+	packed = p;
+	A = &abuf[0];
+      }
+      for(int j=j0;j<j1;j+=2){
+	int two = (j+1<j1);
+	Kernel::gatherB(OpB,n,k,B,j,alpha_r,alpha_i,b0);
+	if ( two ) Kernel::gatherB(OpB,n,k,B,j+1,alpha_r,alpha_i,b1);
+	Kernel::axpy2(m,k,A,b0,b1,beta_r,beta_i,&C[W*j*m],two ? &C[W*(j+1)*m] : nullptr);
+      }
+    });
+  }
+}
+
+// Dispatch on m, the contiguous length of C and of (packed) op(A)
+template<class S,class GetA,class GetB,class GetC>
+void cpuGemmBatched(GridBLASOperation_t OpA,GridBLASOperation_t OpB,
+		    int m,int n,int k,S alpha,S beta,int batchCount,
+		    GetA getA,GetB getB,GetC getC)
+{
+  if ( batchCount==0 || m==0 || n==0 ) return;
+  switch(m) {
+#define CPU_GEMM_CASE(LL) case LL: cpuGemmBatchedDriver<S,LL>(OpA,OpB,m,n,k,alpha,beta,batchCount,getA,getB,getC); break;
+    CPU_GEMM_CASE(4);
+    CPU_GEMM_CASE(8);
+    CPU_GEMM_CASE(12);
+    CPU_GEMM_CASE(16);
+    CPU_GEMM_CASE(24);
+    CPU_GEMM_CASE(32);
+    CPU_GEMM_CASE(48);
+    CPU_GEMM_CASE(64);
+#undef CPU_GEMM_CASE
+  default:
+    cpuGemmBatchedDriver<S,0>(OpA,OpB,m,n,k,alpha,beta,batchCount,getA,getB,getC);
+    break;
+  }
+}
+
+NAMESPACE_END(Grid);
@@ -0,0 +1,243 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/algorithms/deflation/CompressedEigenVectors.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////
+// Eigenvector store holding each vector packed in fp16 (PackedVector=vRealH)
+// or fp32 (vRealF), with one scale per outer site so that fp16 keeps its
+// relative precision whatever the normalisation of the vector. An fp16
+// store of double precision fermions is about a quarter of the size of
+// the std::vector<Field> it replaces.
+//
+// Vectors are read with get(i,out) and written with set(i,in); there is
+// deliberately no operator[], as a decompressed temporary would silently
+// drop writes. Code shared with std::vector<Field> uses basisGrid and
+// basisGet. The deflation projections (basisInnerProducts, basisSubtract)
+// unpack in the kernel a chunk of vectors at a time and never form a full
+// precision field.
+////////////////////////////////////////////////////////////////////////////
+template<class Field,class PackedVector=vRealH>
+class CompressedEigenVectors {
+public:
+  typedef typename Field::vector_object vobj;
+  typedef typename vobj::vector_type    vector_type;
+  typedef typename toRealMapper<vector_type>::Realified vreal_t;
+  typedef typename vreal_t::scalar_type      RealScalar;
+  typedef typename PackedVector::scalar_type PackedScalar;
+
+  static const int Nreal   = sizeof(vobj)/sizeof(vreal_t);     // real vectors per site
+  static const int Nword   = sizeof(vobj)/sizeof(RealScalar);  // reals per site
+  static const int Npacked = Nreal*sizeof(PackedScalar)/sizeof(RealScalar);
+  static_assert( (Nreal*sizeof(PackedScalar)) % sizeof(RealScalar) == 0,
+		 "CompressedEigenVectors: site object does not fill whole packed vectors");
+  static_assert( sizeof(PackedScalar) < sizeof(RealScalar),
+		 "CompressedEigenVectors: packed precision must be lower than the field");
+
+private:
+  GridBase *grid;
+  std::vector<deviceVector<PackedVector> > data;
+  std::vector<deviceVector<RealF> >        scale;
+  std::vector<int>                         cb;
+
+public:
+  CompressedEigenVectors(GridBase *_grid) : grid(_grid) {};
+  CompressedEigenVectors(size_t n,GridBase *_grid) : grid(_grid) { resize(n); };
+
+  GridBase *Grid(void) const { return grid; }
+  size_t size(void) const { return data.size(); }
+  void clear(void) { resize(0); }
+
+  // New vectors are zero
+  void resize(size_t n)
+  {
+    size_t n0 = size();
+    uint64_t sites = grid->oSites();
+    data.resize(n);
+    scale.resize(n);
+    cb.resize(n,Even);
+    for(size_t i=n0;i<n;i++){
+      data[i].resize(sites*Npacked);
+      scale[i].resize(sites);
+      acceleratorMemSet(&data[i][0],0,sites*Npacked*sizeof(PackedVector));
+      acceleratorMemSet(&scale[i][0],0,sites*sizeof(RealF));
+    }
+  }
+  void push_back(const Field &f)
+  {
+    resize(size()+1);
+    set(size()-1,f);
+  }
+  // Storage held, in bytes
+  RealD Bytes(void) const
+  {
+    return (RealD)size()*grid->oSites()*(Npacked*sizeof(PackedVector)+sizeof(RealF));
+  }
+
+  static accelerator_inline vobj Decode(const PackedVector *d,RealF s)
+  {
+    vobj x;
+    precisionChange((vreal_t *)&x,d,Nreal);
+    RealScalar *xp = (RealScalar *)&x;
+    for(int w=0;w<Nword;w++) xp[w] = xp[w]*s;
+    return x;
+  }
+
+  void set(size_t i,const Field &f)
+  {
+    assert(i<size());
+    assert(f.Grid()==grid);
+    cb[i] = f.Checkerboard();
+    PackedVector *d_p = &data[i][0];
+    RealF        *s_p = &scale[i][0];
+    autoView( f_v , f, AcceleratorRead);
+    accelerator_for(ss,grid->oSites(),1,{
+      vobj x = f_v[ss];
+      RealScalar *xp = (RealScalar *)&x;
+      RealScalar m = 0.0;
+      for(int w=0;w<Nword;w++) m = (fabs(xp[w])>m) ? fabs(xp[w]) : m;
+      RealF s = (m>0.0) ? m : 1.0;
+      RealScalar inv = 1.0/s;
+      for(int w=0;w<Nword;w++) xp[w] = xp[w]*inv;
+      precisionChange(&d_p[ss*Npacked],(vreal_t *)&x,Nreal);
+      s_p[ss] = s;
+    });
+  }
+  void get(size_t i,Field &f) const
+  {
+    assert(i<size());
+    assert(f.Grid()==grid);
+    f.Checkerboard() = cb[i];
+    const PackedVector *d_p = &data[i][0];
+    const RealF        *s_p = &scale[i][0];
+    autoView( f_v , f, AcceleratorWrite);
+    accelerator_for(ss,grid->oSites(),1,{
+      f_v[ss] = Decode(&d_p[ss*Npacked],s_p[ss]);
+    });
+  }
+
+  // ip[k-k0] = <evec[k],w>, chunks of vectors unpacked on the fly, one global sum
+  void InnerProducts(std::vector<ComplexD> &ip,int k0,int k1,const Field &w) const
+  {
+    typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+    const int basisChunk = 8;
+    typedef iVector<inner_t,basisChunk> chunk_t;
+
+    const uint64_t sites = grid->oSites();
+    int nk = k1-k0;
+    ip.resize(nk);
+    if ( nk<=0 ) return;
+    assert(w.Grid()==grid);
+
+    Vector<const PackedVector *> d_v(nk);
+    Vector<const RealF *>        s_v(nk);
+    for(int k=0;k<nk;k++){
+      d_v[k] = &data[k0+k][0];
+      s_v[k] = &scale[k0+k][0];
+    }
+    const PackedVector **d_p = &d_v[0];
+    const RealF        **s_p = &s_v[0];
+
+    deviceVector<chunk_t> inner_tmp(sites);
+    chunk_t *inner_tmp_v = &inner_tmp[0];
+    autoView( w_v , w, AcceleratorRead);
+    for(int b=0;b<nk;b+=basisChunk){
+      int nb = MIN(basisChunk,nk-b);
+      accelerator_for(ss,sites,1,{
+	vobj w_l = w_v[ss];
+	chunk_t acc;
+	acc = Zero();
+	for(int j=0;j<nb;j++){
+	  acc._internal[j] = innerProductD(Decode(&d_p[b+j][ss*Npacked],s_p[b+j][ss]),w_l);
+	}
+	inner_tmp_v[ss] = acc;
+      });
+      auto chunk = sum(inner_tmp_v,sites);
+      for(int j=0;j<nb;j++) ip[b+j] = TensorRemove(chunk._internal[j]);
+    }
+    grid->GlobalSumVector(&ip[0],nk);
+  }
+
+  // w -= sum_k ip[k-k0] evec[k]
+  void Subtract(Field &w,const std::vector<ComplexD> &ip,int k0,int k1) const
+  {
+    typedef typename vobj::scalar_type scalar_type;
+    const int basisChunk = 8;
+    int nk = k1-k0;
+    if ( nk<=0 ) return;
+    assert(w.Grid()==grid);
+
+    Vector<const PackedVector *> d_v(nk);
+    Vector<const RealF *>        s_v(nk);
+    Vector<scalar_type>          c_v(nk);
+    for(int k=0;k<nk;k++){
+      d_v[k] = &data[k0+k][0];
+      s_v[k] = &scale[k0+k][0];
+      c_v[k] = ip[k];
+    }
+    const PackedVector **d_p = &d_v[0];
+    const RealF        **s_p = &s_v[0];
+    scalar_type         *c_p = &c_v[0];
+
+    autoView( w_v , w, AcceleratorWrite);
+    for(int b=0;b<nk;b+=basisChunk){
+      int nb = MIN(basisChunk,nk-b);
+      accelerator_for(ss,grid->oSites(),1,{
+	vobj w_l = w_v[ss];
+	for(int j=b;j<b+nb;j++){
+	  w_l = w_l - c_p[j]*Decode(&d_p[j][ss*Npacked],s_p[j][ss]);
+	}
+	w_v[ss] = w_l;
+      });
+    }
+  }
+};
+
+// Grid and element access common to std::vector<Field> and the packed store
+template<class Field>
+GridBase *basisGrid(const std::vector<Field> &basis) { return basis[0].Grid(); }
+template<class Field,class PackedVector>
+GridBase *basisGrid(const CompressedEigenVectors<Field,PackedVector> &basis) { return basis.Grid(); }
+template<class Field>
+void basisGet(const std::vector<Field> &basis,size_t i,Field &out) { out = basis[i]; }
+template<class Field,class PackedVector>
+void basisGet(const CompressedEigenVectors<Field,PackedVector> &basis,size_t i,Field &out) { basis.get(i,out); }
+
+template<class Field,class PackedVector>
+void basisInnerProducts(std::vector<ComplexD> &ip,const CompressedEigenVectors<Field,PackedVector> &basis,int k0,int k1,const Field &w)
+{
+  basis.InnerProducts(ip,k0,k1,w);
+}
+template<class Field,class PackedVector>
+void basisSubtract(Field &w,const CompressedEigenVectors<Field,PackedVector> &basis,const std::vector<ComplexD> &ip,int k0,int k1)
+{
+  basis.Subtract(w,ip,k0,k1);
+}
+
+NAMESPACE_END(Grid);
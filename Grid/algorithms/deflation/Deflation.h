@@ -50,23 +50,24 @@ public:
 };
 
 ////////////////////////////////
-// Fine grid deflation
+// Fine grid deflation; the eigenvectors may be a std::vector<Field>
+// or a CompressedEigenVectors store
 ////////////////////////////////
-template<class Field>
+template<class Field,class Evecs=std::vector<Field> >
 class DeflatedGuesser: public LinearFunction<Field> {
 private:
-  const std::vector<Field> &evec;
+  const Evecs              &evec;
   const std::vector<RealD> &eval;
   const unsigned int       N;
 
 public:
   using LinearFunction<Field>::operator();
 
-  DeflatedGuesser(const std::vector<Field> & _evec,const std::vector<RealD> & _eval)
+  DeflatedGuesser(const Evecs & _evec,const std::vector<RealD> & _eval)
   : DeflatedGuesser(_evec, _eval, _evec.size())
   {}
 
-  DeflatedGuesser(const std::vector<Field> & _evec, const std::vector<RealD> & _eval, const unsigned int _N)
+  DeflatedGuesser(const Evecs & _evec, const std::vector<RealD> & _eval, const unsigned int _N)
   : evec(_evec), eval(_eval), N(_N)
   {
     assert(evec.size()==eval.size());
@@ -74,12 +75,12 @@ public:
   } 
 
   virtual void operator()(const Field &src,Field &guess) {
+    std::vector<ComplexD> ip;
+    basisInnerProducts(ip,evec,0,N,src);
+    for (int i=0;i<N;i++) ip[i] = -ip[i]/eval[i];
     guess = Zero();
-    for (int i=0;i<N;i++) {
-      const Field& tmp = evec[i];
-      axpy(guess,TensorRemove(innerProduct(tmp,src)) / eval[i],tmp,guess);
-    }
     guess.Checkerboard() = src.Checkerboard();
+    basisSubtract(guess,evec,ip,0,N);
   }
 };
 
@@ -95,7 +95,7 @@ public:
     BLAS_E.resize (vol * words * nev );
     std::cout << GridLogMessage << " Allocate for "<<nev<<" eigenvectors and volume "<<vol<<std::endl;
   }
-  void ImportEigenVector(Field &evec,RealD &_eval, int ev)
+  void ImportEigenVector(const Field &evec,RealD _eval, int ev)
   {
     //    std::cout << " ev " <<ev<<" eval "<<_eval<< std::endl;
     assert(ev<eval.size());
@@ -106,21 +106,26 @@ public:
     acceleratorCopyDeviceToDevice(&v[0],&BLAS_E[offset],sizeof(scalar_object)*vol);
 
   }
-  void ImportEigenBasis(std::vector<Field> &evec,std::vector<RealD> &_eval)
+  // Evecs is a std::vector<Field> or a CompressedEigenVectors store
+  template<class Evecs>
+  void ImportEigenBasis(const Evecs &evec,std::vector<RealD> &_eval)
   {
     ImportEigenBasis(evec,_eval,0,evec.size());
   }
   // Could use to import a batch of eigenvectors
-  void ImportEigenBasis(std::vector<Field> &evec,std::vector<RealD> &_eval, int _ev0, int _nev)
+  template<class Evecs>
+  void ImportEigenBasis(const Evecs &evec,std::vector<RealD> &_eval, int _ev0, int _nev)
   {
     assert(_ev0+_nev<=evec.size());
 
-    Allocate(_nev,evec[0].Grid());
+    Allocate(_nev,basisGrid(evec));
     
     // Imports a sub-batch of eigenvectors, _ev0, ..., _ev0+_nev-1
+    Field tmp(grid);
     for(int e=0;e<nev;e++){
       std::cout << "Importing eigenvector "<<e<<" evalue "<<_eval[_ev0+e]<<std::endl;
-      ImportEigenVector(evec[_ev0+e],_eval[_ev0+e],e);
+      basisGet(evec,_ev0+e,tmp);
+      ImportEigenVector(tmp,_eval[_ev0+e],e);
     }
   }
   void DeflateSources(std::vector<Field> &source,std::vector<Field> & guess)
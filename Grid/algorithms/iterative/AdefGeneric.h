@@ -539,20 +539,20 @@ class TwoLevelADEF2 : public TwoLevelCG<Field>
 };
 
   
-template<class Field>
+template<class Field,class Evecs=std::vector<Field> >
 class TwoLevelADEF1defl : public TwoLevelCG<Field>
 {
 public:
-  const std::vector<Field> &evec;
+  const Evecs &evec;
   const std::vector<RealD> &eval;
   
   TwoLevelADEF1defl(RealD tol,
 		   Integer maxit,
 		   LinearOperatorBase<Field>   &FineLinop,
 		   LinearFunction<Field>   &Smoother,
-		   std::vector<Field> &_evec,
+		   Evecs &_evec,
 		   std::vector<RealD> &_eval) : 
-    TwoLevelCG<Field>(tol,maxit,FineLinop,Smoother,_evec[0].Grid()),
+    TwoLevelCG<Field>(tol,maxit,FineLinop,Smoother,basisGrid(_evec)),
     evec(_evec),
     eval(_eval)
   {};
@@ -578,15 +578,14 @@ public:
     // // Q   = Sum_i |phi_i> 1/lambda_i <phi_i|
     // // A Q = Sum_i |phi_i> <phi_i|
     // // M(1-AQ) = M(1-proj) + Q
+    std::vector<ComplexD> ip;
+    basisInnerProducts(ip,evec,0,N,in);
+    Pin = in;
+    basisSubtract(Pin,evec,ip,0,N);
+    for (int i=0;i<N;i++) ip[i] = -ip[i]/eval[i];
     Qin.Checkerboard()=in.Checkerboard();
     Qin = Zero();
-    Pin = in;
-    for (int i=0;i<N;i++) {
-      const Field& tmp = evec[i];
-      auto ip = TensorRemove(innerProduct(tmp,in));
-      axpy(Qin, ip / eval[i],tmp,Qin);
-      axpy(Pin, -ip ,tmp,Pin);
-    }
+    basisSubtract(Qin,evec,ip,0,N);
 
     this->_Smoother(Pin,out);
 
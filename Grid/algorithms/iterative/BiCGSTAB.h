@@ -58,6 +58,9 @@ class BiCGSTAB : public OperatorFunction<Field>
 
     void operator()(LinearOperatorBase<Field>& Linop, const Field& src, Field& psi) 
     {
+      SolverPerformanceMonitor Perf("BiCGSTAB");
+      Perf.Begin(src);
+
       psi.Checkerboard() = src.Checkerboard();
       conformable(psi, src);
 
@@ -95,7 +98,7 @@ class BiCGSTAB : public OperatorFunction<Field>
       RealD rsq = Tolerance * Tolerance * ssq;
 
       // Check if guess is really REALLY good :)
-      if(a <= rsq){ return; }
+      if(a <= rsq){ Perf.End(0,1,true,std::sqrt(a/ssq)); return; }
 
       std::cout << GridLogIterative << std::setprecision(8) << "BiCGSTAB: k=0 residual " << a << " target " << rsq << std::endl;
 
@@ -214,6 +217,11 @@ class BiCGSTAB : public OperatorFunction<Field>
           std::cout << GridLogMessage << "\tAxpyNorm   " << AxpyNormTimer.Elapsed() << std::endl;
           std::cout << GridLogMessage << "\tLinearComb " << LinearCombTimer.Elapsed() << std::endl;
 
+          // per iteration: three inner products, two norms, four vector updates
+          Perf.Linalg(k*23,k*22);
+          Perf.Times(MatrixTimer,LinalgTimer,InnerTimer);
+          Perf.End(k,2*k+2,true,true_residual);
+
           if(ErrorOnNoConverge){ assert(true_residual / Tolerance < 10000.0); }
 
           IterationsToComplete = k;	
@@ -223,6 +231,9 @@ class BiCGSTAB : public OperatorFunction<Field>
       }
       
       std::cout << GridLogMessage << "BiCGSTAB did NOT converge" << std::endl;
+      Perf.Linalg(MaxIterations*23,MaxIterations*22);
+      Perf.Times(MatrixTimer,LinalgTimer,InnerTimer);
+      Perf.End(MaxIterations,2*MaxIterations+1,false,std::sqrt(cp/ssq));
 
       if(ErrorOnNoConverge){ assert(0); }
       IterationsToComplete = k;
@@ -70,6 +70,8 @@ public:
       this->LogBegin();
 
       GRID_TRACE("ConjugateGradient");
+    SolverPerformanceMonitor Perf("ConjugateGradient");
+    Perf.Begin(src);
     GridStopWatch PreambleTimer;
     GridStopWatch ConstructTimer;
     GridStopWatch NormTimer;
@@ -114,6 +116,7 @@ public:
       psi = Zero();
       IterationsToComplete = 1;
       TrueResidual = 0.;
+      Perf.End(0,0,true,TrueResidual);
       return;
     }
 
@@ -131,6 +134,7 @@ public:
       TrueResidual = std::sqrt(a/ssq);
       std::cout << GridLogMessage << "ConjugateGradient guess is converged already " << std::endl;
       IterationsToComplete = 0;	
+      Perf.End(0,guess==0.0 ? 0:1,true,TrueResidual);
       return;
     }
 
@@ -172,15 +176,8 @@ public:
       b = cp / c;
 
       LinearCombTimer.Start();
-      {
-	autoView( psi_v , psi, AcceleratorWrite);
-	autoView( p_v   , p,   AcceleratorWrite);
-	autoView( r_v   , r,   AcceleratorWrite);
-	accelerator_for(ss,p_v.size(), Field::vector_object::Nsimd(),{
-	    coalescedWrite(psi_v[ss], a      *  p_v(ss) + psi_v(ss));
-	    coalescedWrite(p_v[ss]  , b      *  p_v(ss) + r_v  (ss));
-	});
-      }
+      fusedEval(FusedAssign(psi, a*p + psi),
+		FusedAssign(p,   b*p + r));
       LinearCombTimer.Stop();
       LinalgTimer.Stop();
       LogIteration(k,a,b);
@@ -222,6 +219,11 @@ public:
 
 	std::cout << GridLogDebug << "\tMobius flop rate " << DwfFlops/ usecs<< " Gflops " <<std::endl;
 
+	// per iteration: inner product, axpy_norm, fused p/psi update
+	Perf.Linalg(k*(2+3+5),k*(2+4+4));
+	Perf.Times(MatrixTimer,LinalgTimer,InnerTimer);
+	Perf.End(k,k+(guess==0.0 ? 1:2),true,true_residual);
+
         if (ErrorOnNoConverge) assert(true_residual / Tolerance < 10000.0);
 
 	IterationsToComplete = k;	
@@ -251,6 +253,10 @@ public:
     std::cout << GridLogPerformance << "\t\tAxpyNorm   " << AxpyNormTimer.Elapsed() <<std::endl;
     std::cout << GridLogPerformance << "\t\tLinearComb " << LinearCombTimer.Elapsed() <<std::endl;
 
+    Perf.Linalg(MaxIterations*(2+3+5),MaxIterations*(2+4+4));
+    Perf.Times(MatrixTimer,LinalgTimer,InnerTimer);
+    Perf.End(MaxIterations,MaxIterations+(guess==0.0 ? 0:1),false,std::sqrt(cp/ssq));
+
     if (ErrorOnNoConverge) assert(0);
     IterationsToComplete = k;
 
@@ -53,6 +53,8 @@ NAMESPACE_BEGIN(Grid);
 
     //Option to speed up *inner single precision* solves using a LinearFunction that produces a guess
     LinearFunction<FieldF> *guesser;
+
+    bool UsePipelinedCG; //Inner and patch-up solves use ConjugateGradientPipelined
     
     MixedPrecisionConjugateGradient(RealD tol, 
 				    Integer maxinnerit, 
@@ -62,7 +64,7 @@ NAMESPACE_BEGIN(Grid);
 				    LinearOperatorBase<FieldD> &_Linop_d) :
       Linop_f(_Linop_f), Linop_d(_Linop_d),
       Tolerance(tol), InnerTolerance(tol), MaxInnerIterations(maxinnerit), MaxOuterIterations(maxouterit), SinglePrecGrid(_sp_grid),
-      OuterLoopNormMult(100.), guesser(NULL){ };
+      OuterLoopNormMult(100.), guesser(NULL), UsePipelinedCG(false){ };
 
     void useGuesser(LinearFunction<FieldF> &g){
       guesser = &g;
@@ -100,7 +102,10 @@ NAMESPACE_BEGIN(Grid);
     sol_f.Checkerboard() = cb;
     
     std::cout<<GridLogMessage<<"MixedPrecisionConjugateGradient: Starting initial inner CG with tolerance " << inner_tol << std::endl;
-    ConjugateGradient<FieldF> CG_f(inner_tol, MaxInnerIterations);
+    ConjugateGradient<FieldF>          CG_f_std (inner_tol, MaxInnerIterations);
+    ConjugateGradientPipelined<FieldF> CG_f_pipe(inner_tol, MaxInnerIterations);
+    CG_f_pipe.StagnationWindow = 100; // single precision may plateau above inner_tol; the outer loop recovers
+    ConjugateGradient<FieldF> &CG_f = UsePipelinedCG ? CG_f_pipe : CG_f_std;
     CG_f.ErrorOnNoConverge = false;
 
     GridStopWatch InnerCGtimer;
@@ -154,7 +159,9 @@ NAMESPACE_BEGIN(Grid);
     //Final trial CG
     std::cout<<GridLogMessage<<"MixedPrecisionConjugateGradient: Starting final patch-up double-precision solve"<<std::endl;
     
-    ConjugateGradient<FieldD> CG_d(Tolerance, MaxInnerIterations);
+    ConjugateGradient<FieldD>          CG_d_std (Tolerance, MaxInnerIterations);
+    ConjugateGradientPipelined<FieldD> CG_d_pipe(Tolerance, MaxInnerIterations);
+    ConjugateGradient<FieldD> &CG_d = UsePipelinedCG ? CG_d_pipe : CG_d_std;
     CG_d(Linop_d, src_d_in, sol_d);
     TotalFinalStepIterations = CG_d.IterationsToComplete;
     TrueResidual = CG_d.TrueResidual;
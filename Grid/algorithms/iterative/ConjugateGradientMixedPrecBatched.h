@@ -50,6 +50,7 @@ public:
   //Option to speed up *inner single precision* solves using a LinearFunction that produces a guess
   LinearFunction<FieldF> *guesser;
   bool updateResidual;
+  bool UsePipelinedCG; //Inner and patch-up solves use ConjugateGradientPipelined
   
   MixedPrecisionConjugateGradientBatched(RealD tol, 
           Integer maxinnerit, 
@@ -61,7 +62,7 @@ public:
           bool _updateResidual=true) :
     Linop_f(_Linop_f), Linop_d(_Linop_d),
     Tolerance(tol), InnerTolerance(tol), MaxInnerIterations(maxinnerit), MaxOuterIterations(maxouterit), MaxPatchupIterations(maxpatchit), SinglePrecGrid(_sp_grid),
-    OuterLoopNormMult(100.), guesser(NULL), updateResidual(_updateResidual) { };
+    OuterLoopNormMult(100.), guesser(NULL), updateResidual(_updateResidual), UsePipelinedCG(false) { };
 
   void useGuesser(LinearFunction<FieldF> &g){
     guesser = &g;
@@ -127,7 +128,10 @@ public:
     
     RealD inner_tol = InnerTolerance;
     
-    ConjugateGradient<FieldF> CG_f(inner_tol, MaxInnerIterations);
+    ConjugateGradient<FieldF>          CG_f_std (inner_tol, MaxInnerIterations);
+    ConjugateGradientPipelined<FieldF> CG_f_pipe(inner_tol, MaxInnerIterations);
+    CG_f_pipe.StagnationWindow = 100; // single precision may plateau above inner_tol; the outer loop recovers
+    ConjugateGradient<FieldF> &CG_f = UsePipelinedCG ? CG_f_pipe : CG_f_std;
     CG_f.ErrorOnNoConverge = false;
     
     Integer &outer_iter = TotalOuterIterations; //so it will be equal to the final iteration count
@@ -191,7 +195,9 @@ public:
     std::cout<<GridLogMessage<<"MixedPrecisionConjugateGradientBatched: Starting final patch-up double-precision solve"<<std::endl;
     
     for (int i=0; i<NBatch; i++) {
-      ConjugateGradient<FieldD> CG_d(Tolerance, MaxPatchupIterations);
+      ConjugateGradient<FieldD>          CG_d_std (Tolerance, MaxPatchupIterations);
+      ConjugateGradientPipelined<FieldD> CG_d_pipe(Tolerance, MaxPatchupIterations);
+      ConjugateGradient<FieldD> &CG_d = UsePipelinedCG ? CG_d_pipe : CG_d_std;
       CG_d(Linop_d, src_d_in[i], sol_d[i]);
       TotalFinalStepIterations[i] += CG_d.IterationsToComplete;
     }
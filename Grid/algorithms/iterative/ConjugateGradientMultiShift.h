@@ -85,6 +85,8 @@ public:
   void operator() (LinearOperatorBase<Field> &Linop, const Field &src, std::vector<Field> &psi)
   {
     GRID_TRACE("ConjugateGradientMultiShift");
+    SolverPerformanceMonitor Perf("ConjugateGradientMultiShift");
+    Perf.Begin(src);
   
     GridBase *grid = src.Grid();
   
@@ -138,6 +140,7 @@ public:
 	IterationsToCompleteShift[s] = 1;
 	TrueResidualShift[s] = 0.;
       }
+      Perf.End(0,0,true,0.0);
       return;
     }
 
@@ -284,6 +287,11 @@ public:
 	}
       }
     
+      // p, mmp, r updates, inner product and norm; ps and psi per active shift
+      int active=0;
+      for(int s=0;s<nshift;s++) if ( !converged[s] ) active++;
+      Perf.Linalg(3+3+3+2+1+6*active,2+2+4+2+2+5*active);
+
       // Convergence checks
       int all_converged = 1;
       for(int s=0;s<nshift;s++){
@@ -331,6 +339,11 @@ public:
 
       IterationsToComplete = k;	
 
+      RealD max_resid=0;
+      for(int s=0;s<nshift;s++) max_resid=std::max(max_resid,TrueResidualShift[s]);
+      Perf.Times(MatrixTimer,AXPYTimer);
+      Perf.End(k,k+1+nshift,true,max_resid);
+
 	return;
       }
 
@@ -338,6 +351,8 @@ public:
     }
     // ugly hack
     std::cout<<GridLogMessage<<"CG multi shift did not converge"<<std::endl;
+    Perf.Times(MatrixTimer,AXPYTimer);
+    Perf.End(MaxIterations,MaxIterations+1,false,std::sqrt(c/cp));
     //  assert(0);
   }
 
@@ -0,0 +1,418 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/algorithms/iterative/ConjugateGradientMultiShiftSStep.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////////////
+// s-step (communication avoiding) multi-shift CG.
+//
+// Each outer iteration builds the basis
+//
+//   V = [ p, A p, ..., A^s p, r, A r, ..., A^{s-1} r ] ,  A = MdagM + m_0
+//
+// with 2s-1 operator applications (scaled by 1/theta to keep the monomials in
+// range), takes its Gram matrix V^dag V in a single global reduction, and then runs
+// s CG steps on the 2s+1 component coordinates of r and p with no further
+// communication. The shifted systems follow the usual collinear residual
+// recurrences (zeta); each shift's direction and solution are carried as
+//
+//   p_s = gamma_s p_s^0 + V w_s ,   x_s = x_s^0 + delta_s p_s^0 + V u_s
+//
+// so all shifts, r and p are brought up to date by a single pass over memory at
+// the end of the block, in place of two reductions and a pass per shift every
+// iteration.
+//
+// The basis costs 2s-1 operator applications per s iterations against s for
+// plain CG, so this pays where reduction latency and the per-shift sweeps
+// dominate, i.e. many poles on many nodes. The monomial basis loses accuracy
+// as s grows; s=2..4 converges like CG on typical fermion operators.
+/////////////////////////////////////////////////////////////////////////////////////
+template<class Field>
+class ConjugateGradientMultiShiftSStep : public OperatorMultiFunction<Field>,
+					 public OperatorFunction<Field>
+{
+public:
+
+  using OperatorFunction<Field>::operator();
+
+  static const int SStepMax = 8;
+
+  Integer MaxIterations;
+  Integer IterationsToComplete; //Number of iterations the CG took to finish. Filled in upon completion
+  std::vector<int> IterationsToCompleteShift;  // Iterations for this shift
+  int SStep;
+  MultiShiftFunction shifts;
+  std::vector<RealD> TrueResidualShift;
+
+  ConjugateGradientMultiShiftSStep(Integer maxit, const MultiShiftFunction &_shifts,int _SStep=4) :
+    MaxIterations(maxit),
+    SStep(_SStep),
+    shifts(_shifts)
+  {
+    assert(SStep>=1 && SStep<=SStepMax);
+    IterationsToCompleteShift.resize(_shifts.order);
+    TrueResidualShift.resize(_shifts.order);
+  }
+
+  void operator() (LinearOperatorBase<Field> &Linop, const Field &src, Field &psi)
+  {
+    GridBase *grid = src.Grid();
+    int nshift = shifts.order;
+    std::vector<Field> results(nshift,grid);
+    (*this)(Linop,src,results,psi);
+  }
+  void operator() (LinearOperatorBase<Field> &Linop, const Field &src, std::vector<Field> &results, Field &psi)
+  {
+    int nshift = shifts.order;
+
+    (*this)(Linop,src,results);
+
+    psi = shifts.norm*src;
+    for(int i=0;i<nshift;i++){
+      psi = psi + shifts.residues[i]*results[i];
+    }
+  }
+
+  // Coordinates in V: y = T c for y = A V c / theta on the non-terminal columns
+  void ApplyT(const std::vector<RealD> &c,std::vector<RealD> &y,RealD theta)
+  {
+    int s  = SStep;
+    int nv = 2*s+1;
+    for(int i=0;i<nv;i++) y[i]=0.0;
+    for(int i=0;i<s;i++)   y[i+1]   = theta*c[i];
+    for(int i=0;i<s-1;i++) y[s+2+i] = theta*c[s+1+i];
+  }
+  RealD GramProduct(const std::vector<RealD> &G,const std::vector<RealD> &a,const std::vector<RealD> &b)
+  {
+    int nv = a.size();
+    RealD r=0.0;
+    for(int i=0;i<nv;i++){
+      for(int j=0;j<nv;j++){
+	r += a[i]*G[i*nv+j]*b[j];
+      }
+    }
+    return r;
+  }
+
+  void operator() (LinearOperatorBase<Field> &Linop, const Field &src, std::vector<Field> &psi)
+  {
+    GRID_TRACE("ConjugateGradientMultiShiftSStep");
+    SolverPerformanceMonitor Perf("ConjugateGradientMultiShiftSStep");
+    Perf.Begin(src);
+
+    GridBase *grid = src.Grid();
+    int nshift = shifts.order;
+    int s  = SStep;
+    int nv = 2*s+1;
+
+    std::vector<RealD> &mass(shifts.poles);
+    std::vector<RealD> &mresidual(shifts.tolerances);
+
+    assert(psi.size()==nshift);
+    assert(mass.size()==nshift);
+    assert(mresidual.size()==nshift);
+    for(int i=0;i<nshift;i++) assert( mass[i]>= mass[0] );
+
+    std::vector<Field> V(nv,grid);     // p chain V[0..s], r chain V[s+1..2s]
+    std::vector<Field> ps(nshift,grid);// shifted search directions
+    Field tmp(grid);
+    Field mmp(grid);
+
+    RealD cp = norm2(src);
+    if( cp == 0. ){
+      for(int i=0;i<nshift;i++){
+	psi[i] = Zero();
+	IterationsToCompleteShift[i] = 1;
+	TrueResidualShift[i] = 0.;
+      }
+      Perf.End(0,0,true,0.0);
+      return;
+    }
+
+    std::vector<RealD> rsq(nshift);
+    std::vector<int>   converged(nshift,0);
+    for(int i=0;i<nshift;i++){
+      rsq[i] = cp * mresidual[i] * mresidual[i];
+      std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftSStep: shift "<<i
+	       <<" target resid^2 "<<rsq[i]<<std::endl;
+      ps[i]  = src;
+      psi[i] = Zero();
+      psi[i].Checkerboard() = src.Checkerboard();
+    }
+    V[0]   = src;
+    V[s+1] = src;
+
+    // Basis scale |A src|/|src|
+    Linop.HermOp(src,mmp);
+    axpy(mmp,mass[0],src,mmp);
+    RealD theta = std::sqrt(norm2(mmp)/cp);
+    std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftSStep: s = "<<s<<" basis scale "<<theta<<std::endl;
+
+    // Scalar CG state, and the shifted recurrences
+    RealD rr = cp;
+    RealD alpha_prev = 1.0;
+    RealD beta_prev  = 0.0;
+    std::vector<RealD> zeta(nshift,1.0);
+    std::vector<RealD> zeta_prev(nshift,1.0);
+
+    // Block coordinates
+    std::vector<RealD> G(nv*nv);
+    std::vector<RealD> pc(nv), rc(nv), Apc(nv);
+    std::vector<RealD> gamma(nshift), delta(nshift);
+    std::vector<std::vector<RealD> > w(nshift,std::vector<RealD>(nv));
+    std::vector<std::vector<RealD> > u(nshift,std::vector<RealD>(nv));
+
+    GridStopWatch MatrixTimer;
+    GridStopWatch LinalgTimer;
+    GridStopWatch ReduceTimer;
+    GridStopWatch SolverTimer;
+    SolverTimer.Start();
+
+    int k=0;
+    int matrix_calls=1;
+    int all_converged=0;
+    while ( (k<MaxIterations) && !all_converged ) {
+
+      ///////////////////////////////////////////////
+      // Monomial basis
+      ///////////////////////////////////////////////
+      for(int j=0;j<2*s;j++){
+	if ( j==s ) continue;
+	MatrixTimer.Start();
+	Linop.HermOp(V[j],V[j+1]);
+	MatrixTimer.Stop();
+	LinalgTimer.Start();
+	axpby(V[j+1],1.0/theta,mass[0]/theta,V[j+1],V[j]);
+	LinalgTimer.Stop();
+	matrix_calls++;
+      }
+      Perf.Linalg(3*(2*s-1),3*(2*s-1));
+
+      ///////////////////////////////////////////////
+      // Gram matrix, one global reduction
+      ///////////////////////////////////////////////
+      ReduceTimer.Start();
+      std::vector<ComplexD> Gc(nv*(nv+1)/2);
+      std::vector<ComplexD> ip;
+      for(int i=0,o=0;i<nv;i++){
+	basisInnerProductsLocal(ip,V,0,i+1,V[i]);
+	for(int j=0;j<=i;j++) Gc[o++] = ip[j];
+      }
+      grid->GlobalSumVector(&Gc[0],Gc.size());
+      for(int i=0,o=0;i<nv;i++){
+	for(int j=0;j<=i;j++,o++){
+	  G[i*nv+j] = G[j*nv+i] = real(Gc[o]);
+	}
+      }
+      ReduceTimer.Stop();
+      Perf.Linalg(nv*(nv+1)/2+nv*(nv+8)/8,2.0*nv*(nv+1));
+
+      ///////////////////////////////////////////////
+      // s CG steps in coordinates
+      ///////////////////////////////////////////////
+      for(int i=0;i<nv;i++) { pc[i]=0.0; rc[i]=0.0; }
+      pc[0]   = 1.0;
+      rc[s+1] = 1.0;
+      std::vector<int> active(nshift);
+      for(int i=0;i<nshift;i++){
+	active[i] = !converged[i];
+	gamma[i]=1.0;
+	delta[i]=0.0;
+	for(int j=0;j<nv;j++) { w[i][j]=0.0; u[i][j]=0.0; }
+      }
+
+      for(int j=0; (j<s) && (k<MaxIterations) && !all_converged ;j++){
+	k++;
+	ApplyT(pc,Apc,theta);
+	RealD pAp   = GramProduct(G,pc,Apc);
+	RealD alpha = rr/pAp;
+	for(int i=0;i<nv;i++) rc[i] -= alpha*Apc[i];
+	RealD rr_new = GramProduct(G,rc,rc);
+	RealD beta   = rr_new/rr;
+
+	all_converged=1;
+	for(int i=0;i<nshift;i++){
+	  if ( converged[i] ) continue;
+	  RealD sigma = mass[i]-mass[0];
+	  RealD zeta_next = zeta[i]*zeta_prev[i]*alpha_prev
+	    / (alpha*beta_prev*(zeta_prev[i]-zeta[i]) + zeta_prev[i]*alpha_prev*(1.0+sigma*alpha));
+	  RealD ratio   = zeta_next/zeta[i];
+	  RealD alpha_s = alpha*ratio;
+	  RealD beta_s  = beta*ratio*ratio;
+	  delta[i] += alpha_s*gamma[i];
+	  for(int v=0;v<nv;v++) u[i][v] += alpha_s*w[i][v];
+	  gamma[i] *= beta_s;
+	  for(int v=0;v<nv;v++) w[i][v] = zeta_next*rc[v] + beta_s*w[i][v];
+	  zeta_prev[i] = zeta[i];
+	  zeta[i]      = zeta_next;
+
+	  IterationsToCompleteShift[i] = k;
+	  if ( rr_new*zeta[i]*zeta[i] < rsq[i] ) {
+	    std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftSStep k="<<k<<" Shift "<<i<<" has converged"<<std::endl;
+	    converged[i]=1;
+	  } else {
+	    all_converged=0;
+	  }
+	}
+	for(int i=0;i<nv;i++) pc[i] = rc[i] + beta*pc[i];
+
+	std::cout << GridLogIterative << "ConjugateGradientMultiShiftSStep: k= "<<k<<" residual "<<std::sqrt(rr_new/cp)<<std::endl;
+	alpha_prev = alpha;
+	beta_prev  = beta;
+	rr         = rr_new;
+      }
+
+      ///////////////////////////////////////////////
+      // One pass: r, p and every shift active in the block
+      ///////////////////////////////////////////////
+      LinalgTimer.Start();
+      int nactive = Update(V,ps,psi,active,rc,pc,gamma,delta,w,u);
+      LinalgTimer.Stop();
+      Perf.Linalg(nv+2+4*nactive,2.0*nv*(2+2*nactive)+4*nactive);
+    }
+    SolverTimer.Stop();
+    IterationsToComplete = k;
+
+    if ( all_converged ) {
+      std::cout<<GridLogMessage<< "CGMultiShiftSStep: All shifts have converged iteration "<<k<<std::endl;
+    } else {
+      std::cout<<GridLogMessage<< "CGMultiShiftSStep: did not converge"<<std::endl;
+    }
+
+    // Check answers
+    RealD max_resid=0;
+    RealD d,qq;
+    RealD cn = norm2(src);
+    for(int i=0; i < nshift; i++) {
+      Linop.HermOpAndNorm(psi[i],mmp,d,qq);
+      axpy(tmp,mass[i],psi[i],mmp);
+      axpy(mmp,-1.0,src,tmp);
+      TrueResidualShift[i] = std::sqrt(norm2(mmp)/cn);
+      max_resid=std::max(max_resid,TrueResidualShift[i]);
+      std::cout<<GridLogMessage<<"CGMultiShiftSStep: shift["<<i<<"] true residual "<< TrueResidualShift[i] <<std::endl;
+    }
+
+    std::cout << GridLogMessage << "Time Breakdown "<<std::endl;
+    std::cout << GridLogMessage << "\tElapsed    " << SolverTimer.Elapsed() <<std::endl;
+    std::cout << GridLogMessage << "\tMatrix     " << MatrixTimer.Elapsed() <<std::endl;
+    std::cout << GridLogMessage << "\tLinalg     " << LinalgTimer.Elapsed() <<std::endl;
+    std::cout << GridLogMessage << "\tReduce     " << ReduceTimer.Elapsed() <<std::endl;
+
+    Perf.Times(MatrixTimer,LinalgTimer,ReduceTimer);
+    Perf.End(k,matrix_calls+nshift,all_converged,max_resid);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////
+  // Single sweep block update
+  //   x_s = x_s + delta_s p_s + V u_s ;  p_s = gamma_s p_s + V w_s   (shifts active in block)
+  //   p = V pc -> V[0] ; r = V rc -> V[s+1]
+  /////////////////////////////////////////////////////////////////////////////////////
+  int Update(std::vector<Field> &V,std::vector<Field> &ps,std::vector<Field> &psi,
+	     const std::vector<int> &active,
+	     const std::vector<RealD> &rc,const std::vector<RealD> &pc,
+	     const std::vector<RealD> &gamma,const std::vector<RealD> &delta,
+	     const std::vector<std::vector<RealD> > &w,const std::vector<std::vector<RealD> > &u)
+  {
+    typedef typename Field::vector_object vobj;
+    typedef decltype(V[0].View(AcceleratorWrite)) View;
+    int s  = SStep;
+    int nv = 2*s+1;
+    int nshift = ps.size();
+
+    std::vector<int> list;
+    for(int i=0;i<nshift;i++) if ( active[i] ) list.push_back(i);
+    int na = list.size();
+
+    // Coefficients: rc | pc | per active shift gamma, delta, w, u
+    const int stride = 2+2*nv;
+    Vector<RealD> coef(2*nv+na*stride);
+    for(int v=0;v<nv;v++){
+      coef[v]    = rc[v];
+      coef[nv+v] = pc[v];
+    }
+    for(int a=0;a<na;a++){
+      RealD *c = &coef[2*nv+a*stride];
+      c[0] = gamma[list[a]];
+      c[1] = delta[list[a]];
+      for(int v=0;v<nv;v++){
+	c[2+v]    = w[list[a]][v];
+	c[2+nv+v] = u[list[a]][v];
+      }
+    }
+    RealD *coef_p = &coef[0];
+
+    Vector<View> V_v;   V_v.reserve(nv);
+    Vector<View> ps_v;  ps_v.reserve(na);
+    Vector<View> psi_v; psi_v.reserve(na);
+    for(int v=0;v<nv;v++) V_v.push_back(V[v].View(AcceleratorWrite));
+    for(int a=0;a<na;a++){
+      ps_v.push_back(ps[list[a]].View(AcceleratorWrite));
+      psi_v.push_back(psi[list[a]].View(AcceleratorWrite));
+    }
+    View *V_p   = &V_v[0];
+    View *ps_p  = na ? &ps_v[0]  : nullptr;
+    View *psi_p = na ? &psi_v[0] : nullptr;
+
+    accelerator_for(ss,V[0].Grid()->oSites(),vobj::Nsimd(),{
+      for(int a=0;a<na;a++){
+	const RealD *c = &coef_p[2*nv+a*stride];
+	auto p_s = coalescedRead(ps_p[a][ss]);
+	auto x_s = coalescedRead(psi_p[a][ss]);
+	x_s = x_s + c[1]*p_s;
+	p_s = c[0]*p_s;
+	for(int v=0;v<nv;v++){
+	  auto V_l = coalescedRead(V_p[v][ss]);
+	  p_s = p_s + c[2+v]*V_l;
+	  x_s = x_s + c[2+nv+v]*V_l;
+	}
+	coalescedWrite(ps_p[a][ss],p_s);
+	coalescedWrite(psi_p[a][ss],x_s);
+      }
+      auto V_l = coalescedRead(V_p[0][ss]);
+      auto r_l = coef_p[0]*V_l;
+      auto p_l = coef_p[nv]*V_l;
+      for(int v=1;v<nv;v++){
+	V_l = coalescedRead(V_p[v][ss]);
+	r_l = r_l + coef_p[v]*V_l;
+	p_l = p_l + coef_p[nv+v]*V_l;
+      }
+      coalescedWrite(V_p[0][ss],p_l);
+      coalescedWrite(V_p[s+1][ss],r_l);
+    });
+
+    for(int v=0;v<nv;v++) V_v[v].ViewClose();
+    for(int a=0;a<na;a++){
+      ps_v[a].ViewClose();
+      psi_v[a].ViewClose();
+    }
+    return na;
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -0,0 +1,311 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/algorithms/iterative/ConjugateGradientPipelined.h
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#ifndef GRID_CONJUGATE_GRADIENT_PIPELINED_H
+#define GRID_CONJUGATE_GRADIENT_PIPELINED_H
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////
+// Pipelined CG, Ghysels and Vanroose, Parallel Computing 40 (2014) 224.
+//
+// Both dot products of an iteration, (r,r) and (w,r) with w = A r, are formed
+// in one local pass and combined in a single non-blocking GlobalSumVectorBegin
+// that completes behind the next HermOp, q = A w. The recurrences
+//
+//   z = q + b z ; s = w + b s ; p = r + b p
+//   x = x + a p ; r = r - a s ; w = w - a z
+//
+// are fused into one sweep. Rounding errors in the extra recurrences are
+// amplified and the recursive residual drifts from the true one, so whenever
+// the residual has dropped by a factor Delta since the last replacement (and
+// on apparent convergence) r, w, s and z are recomputed from x and p:
+// residual replacement, as in ConjugateGradientReliableUpdate.
+// Once the attainable accuracy of the working precision is reached the
+// recursive residual stagnates rather than falling below the target. With
+// StagnationWindow set, the solve is abandoned after that many iterations
+// without a new minimum and reported as not converged; this is off by
+// default, since the residual of a valid solve can plateau for a while, and
+// is only switched on by the mixed precision drivers for their inner solves.
+//
+// Derives from ConjugateGradient so it can be handed to SchurRedBlack* and to
+// the mixed precision drivers wherever a ConjugateGradient is taken.
+/////////////////////////////////////////////////////////////
+template <class Field>
+class ConjugateGradientPipelined : public ConjugateGradient<Field> {
+public:
+
+  using ConjugateGradient<Field>::operator();
+
+  RealD   Delta;              // replace when |r|^2 drops by Delta since the last replacement
+  Integer StagnationWindow;   // iterations without progress before giving up; 0 never gives up
+  Integer ReplacementsDone;
+
+  ConjugateGradientPipelined(RealD tol, Integer maxit, bool err_on_no_conv = true, RealD _delta = 1.0e-4)
+    : ConjugateGradient<Field>(tol,maxit,err_on_no_conv),
+      Delta(_delta),
+      StagnationWindow(0)
+  {
+    assert(Delta > 0. && Delta < 1. && "Expect  0 < Delta < 1");
+  };
+
+  virtual void LogBegin(void){
+    std::cout << "ConjugateGradientPipelined::LogBegin() "<<std::endl;
+  };
+
+  // r = src - A x ; w = A r ; s = A p ; z = A s
+  void ReplaceResidual(LinearOperatorBase<Field> &Linop, const Field &src, const Field &psi,
+		       Field &r, Field &w, const Field &p, Field &s, Field &z)
+  {
+    Linop.HermOp(psi, w);
+    r = src - w;
+    Linop.HermOp(r, w);
+    Linop.HermOp(p, s);
+    Linop.HermOp(s, z);
+    ReplacementsDone++;
+  }
+
+  void operator()(LinearOperatorBase<Field> &Linop, const Field &src, Field &psi) {
+
+    this->LogBegin();
+
+    GRID_TRACE("ConjugateGradientPipelined");
+    SolverPerformanceMonitor Perf("ConjugateGradientPipelined");
+    Perf.Begin(src);
+
+    RealD    &Tolerance     = this->Tolerance;
+    Integer  &MaxIterations = this->MaxIterations;
+
+    GridBase *grid = src.Grid();
+    psi.Checkerboard() = src.Checkerboard();
+    conformable(psi, src);
+
+    Field r(grid); r.Checkerboard() = src.Checkerboard();
+    Field w(grid); w.Checkerboard() = src.Checkerboard();
+    Field q(grid); q.Checkerboard() = src.Checkerboard();
+    Field z(grid); z.Checkerboard() = src.Checkerboard();
+    Field s(grid); s.Checkerboard() = src.Checkerboard();
+    Field p(grid); p.Checkerboard() = src.Checkerboard();
+
+    ReplacementsDone = 0;
+
+    RealD ssq   = norm2(src);
+    RealD guess = norm2(psi);
+    assert(std::isnan(guess) == 0);
+
+    // Handle trivial case of zero src
+    if (ssq == 0.){
+      psi = Zero();
+      this->IterationsToComplete = 1;
+      this->TrueResidual = 0.;
+      Perf.End(0,0,true,0.0);
+      return;
+    }
+
+    int matrix_calls = 1;
+    if ( guess == 0.0 ) {
+      r = src;
+    } else {
+      matrix_calls++;
+      Linop.HermOp(psi, w);
+      r = src - w;
+    }
+    Linop.HermOp(r, w);
+    z = Zero();
+    s = Zero();
+    p = Zero();
+
+    RealD rsq = Tolerance * Tolerance * ssq;
+
+    std::cout << GridLogIterative << std::setprecision(8) << "ConjugateGradientPipelined: guess " << guess << std::endl;
+    std::cout << GridLogIterative << std::setprecision(8) << "ConjugateGradientPipelined:   src " << ssq << std::endl;
+
+    GridStopWatch LinalgTimer;
+    GridStopWatch ReduceTimer;
+    GridStopWatch MatrixTimer;
+    GridStopWatch ReplaceTimer;
+    GridStopWatch SolverTimer;
+
+    RealD a, b, gamma, delta, true_rsq;
+    RealD gamma_old = 0.0, a_old = 0.0;
+    RealD gamma_min = -1.0;
+    RealD MaxResidSinceLastReplace = 0.0;
+    int   k_min = 0;
+    bool  converged = false;
+    Vector<ComplexD> dots(2);
+
+    SolverTimer.Start();
+    int k;
+    for (k = 1; k <= MaxIterations; k++) {
+
+      // Local gamma = (r,r) and delta = (w,r), one global reduction
+      ReduceTimer.Start();
+      CommsRequest_t req;
+      {
+	ComplexD ip; RealD nrm;
+	rankInnerProductNorm(ip, nrm, r, w);
+	dots[0] = nrm;
+	dots[1] = ip;
+	grid->GlobalSumVectorBegin(&dots[0],2,req);
+      }
+      ReduceTimer.Stop();
+
+      // q = A w does not depend on the reduction; overlap it
+      MatrixTimer.Start();
+      Linop.HermOp(w, q);
+      MatrixTimer.Stop();
+
+      ReduceTimer.Start();
+      grid->GlobalSumVectorComplete(req);
+      ReduceTimer.Stop();
+
+      gamma = real(dots[0]);
+      delta = real(dots[1]);
+
+      std::cout << GridLogIterative << "ConjugateGradientPipelined: Iteration " << k
+		<< " residual " << std::sqrt(gamma/ssq) << " target " << Tolerance << std::endl;
+
+      // Stopping condition; confirm against the true residual
+      if ( gamma <= rsq ) {
+	ReplaceTimer.Start();
+	matrix_calls++;
+	Linop.HermOp(psi, q);
+	q = src - q;
+	true_rsq = norm2(q);
+	ReplaceTimer.Stop();
+	if ( true_rsq <= rsq ) { converged = true; break; }
+	std::cout << GridLogMessage << "ConjugateGradientPipelined: Iteration " << k
+		  << " recursive residual " << std::sqrt(gamma/ssq)
+		  << " true residual " << std::sqrt(true_rsq/ssq) << "; continuing from replaced residual" << std::endl;
+	ReplaceTimer.Start();
+	ReplaceResidual(Linop,src,psi,r,w,p,s,z);
+	ReplaceTimer.Stop();
+	gamma_old = 0.0; // restart the recurrence from the true residual
+	gamma_min = -1.0;
+	MaxResidSinceLastReplace = 0.0;
+	continue;
+      }
+      MaxResidSinceLastReplace = std::max(MaxResidSinceLastReplace, gamma);
+
+      if ( (gamma_min < 0.0) || (gamma < gamma_min) ) {
+	gamma_min = gamma;
+	k_min     = k;
+      } else if ( StagnationWindow && (k - k_min >= StagnationWindow) ) {
+	std::cout << GridLogMessage << "ConjugateGradientPipelined: residual stagnated at "
+		  << std::sqrt(gamma_min/ssq) << " since iteration " << k_min << std::endl;
+	break;
+      }
+
+      if ( gamma_old == 0.0 ) {
+	b = 0.0;
+	a = gamma / delta;
+      } else {
+	b = gamma / gamma_old;
+	a = gamma / (delta - b * gamma / a_old);
+      }
+      gamma_old = gamma;
+      a_old     = a;
+
+      LinalgTimer.Start();
+      {
+	autoView( psi_v , psi, AcceleratorWrite);
+	autoView( r_v   , r,   AcceleratorWrite);
+	autoView( w_v   , w,   AcceleratorWrite);
+	autoView( q_v   , q,   AcceleratorRead);
+	autoView( z_v   , z,   AcceleratorWrite);
+	autoView( s_v   , s,   AcceleratorWrite);
+	autoView( p_v   , p,   AcceleratorWrite);
+	accelerator_for(ss,p_v.size(), Field::vector_object::Nsimd(),{
+	    auto zz = q_v(ss) + b * z_v(ss);
+	    auto sv = w_v(ss) + b * s_v(ss);
+	    auto pp = r_v(ss) + b * p_v(ss);
+	    coalescedWrite(z_v[ss]  , zz);
+	    coalescedWrite(s_v[ss]  , sv);
+	    coalescedWrite(p_v[ss]  , pp);
+	    coalescedWrite(psi_v[ss], psi_v(ss) + a * pp);
+	    coalescedWrite(r_v[ss]  , r_v(ss)   - a * sv);
+	    coalescedWrite(w_v[ss]  , w_v(ss)   - a * zz);
+	});
+      }
+      LinalgTimer.Stop();
+      this->LogIteration(k,a,b);
+
+      if ( gamma < Delta * MaxResidSinceLastReplace ) {
+	ReplaceTimer.Start();
+	ReplaceResidual(Linop,src,psi,r,w,p,s,z);
+	ReplaceTimer.Stop();
+	gamma_min = -1.0;
+	MaxResidSinceLastReplace = 0.0;
+      }
+    }
+    SolverTimer.Stop();
+
+    if ( !converged ) {
+      matrix_calls++;
+      Linop.HermOp(psi, q);
+      q = q - src;
+      true_rsq = norm2(q);
+    }
+    RealD true_residual = std::sqrt(true_rsq/ssq);
+
+    if ( converged ) {
+      std::cout << GridLogMessage << "ConjugateGradientPipelined Converged on iteration " << k
+		<< "\tComputed residual " << std::sqrt(gamma / ssq)
+		<< "\tTrue residual " << true_residual
+		<< "\tTarget " << Tolerance
+		<< "\tReplacements " << ReplacementsDone << std::endl;
+    } else {
+      std::cout << GridLogMessage << "ConjugateGradientPipelined did NOT converge "<<k<<" / "<< MaxIterations
+		<<" residual "<< true_residual << std::endl;
+    }
+    std::cout << GridLogMessage << "\tSolver Elapsed    " << SolverTimer.Elapsed() <<std::endl;
+    std::cout << GridLogPerformance << "Time breakdown "<<std::endl;
+    std::cout << GridLogPerformance << "\tMatrix     " << MatrixTimer.Elapsed() <<std::endl;
+    std::cout << GridLogPerformance << "\tReduce     " << ReduceTimer.Elapsed() <<std::endl;
+    std::cout << GridLogPerformance << "\tLinalg     " << LinalgTimer.Elapsed() <<std::endl;
+    std::cout << GridLogPerformance << "\tReplace    " << ReplaceTimer.Elapsed() <<std::endl;
+
+    // per iteration: fused norm and inner product, fused six vector update
+    int iters = std::min(k,(int)MaxIterations);
+    Perf.Linalg(iters*(2+10),iters*(4+12));
+    Perf.Times(MatrixTimer,LinalgTimer,ReduceTimer);
+    Perf.End(iters,matrix_calls+iters+4*ReplacementsDone,converged,true_residual);
+
+    this->IterationsToComplete = iters;
+    this->TrueResidual = true_residual;
+
+    if ( converged ) {
+      if (this->ErrorOnNoConverge) assert(true_residual / Tolerance < 10000.0);
+    } else {
+      if (this->ErrorOnNoConverge) assert(0);
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
+#endif
@@ -108,6 +108,10 @@ class ImplicitlyRestartedLanczos {
     
   RealD OrthoTime;
   RealD eresid, betastp;
+  GridStopWatch PolyTimer;
+  GridStopWatch LinalgTimer;
+  int PolyCalls;
+  SolverPerformanceMonitor Perf;
   ////////////////////////////////
   // Embedded objects
   ////////////////////////////////
@@ -154,7 +158,8 @@ public:
     Nstop(_Nstop)  ,      Nk(_Nk),      Nm(_Nm),
     eresid(_eresid),      betastp(_betastp),
     MaxIter(_MaxIter)  ,      MinRestart(_MinRestart),
-    orth_period(_orth_period), diagonalisation(_diagonalisation)  { };
+    orth_period(_orth_period), diagonalisation(_diagonalisation),
+    Perf("ImplicitlyRestartedLanczos")  { };
 
     ImplicitlyRestartedLanczos(LinearFunction<Field> & PolyOp,
 			       LinearFunction<Field> & HermOp,
@@ -170,7 +175,8 @@ public:
     Nstop(_Nstop)  ,      Nk(_Nk),      Nm(_Nm),
     eresid(_eresid),      betastp(_betastp),
     MaxIter(_MaxIter)  ,      MinRestart(_MinRestart),
-    orth_period(_orth_period), diagonalisation(_diagonalisation)  { };
+    orth_period(_orth_period), diagonalisation(_diagonalisation),
+    Perf("ImplicitlyRestartedLanczos")  { };
 
   ////////////////////////////////
   // Helpers
@@ -189,6 +195,7 @@ public:
     basisOrthogonalize(evec,w,k);
     normalise(w);
     OrthoTime+=usecond()/1e6;
+    Perf.Linalg(2*k+3*k/8+4,4*k+3);
   }
 
 /* Rudy Arthur's thesis pp.137
@@ -212,6 +219,11 @@ until convergence
   {
     GridBase *grid = src.Grid();
     assert(grid == evec[0].Grid());
+
+    Perf.Begin(src);
+    PolyTimer.Reset();
+    LinalgTimer.Reset();
+    PolyCalls=0;
     
     //    GridLogIRL.TimingMode(1);
     std::cout << GridLogIRL <<"**************************************************************************"<< std::endl;
@@ -337,7 +349,10 @@ until convergence
 
       assert(k2<Nm);      assert(k2<Nm);      assert(k1>0);
 
+      LinalgTimer.Start();
       basisRotate(evec,Qt,k1-1,k2+1,0,Nm,Nm); /// big constraint on the basis
+      LinalgTimer.Stop();
+      Perf.Linalg(Nm+k2-k1+2,2.0*Nm*(k2-k1+2));
       std::cout<<GridLogIRL <<"basisRotated  by Qt *"<<k1-1<<","<<k2+1<<")"<<std::endl;
       
       ////////////////////////////////////////////////////
@@ -403,6 +418,8 @@ until convergence
     }
 
     std::cout<<GridLogError<<"\n NOT converged.\n";
+    Perf.Times(PolyTimer,LinalgTimer);
+    Perf.End(MaxIter,PolyCalls,false,0.0);
     abort();
 	
   converged:
@@ -441,6 +458,10 @@ until convergence
     std::cout << GridLogIRL << " -- beta(k)     = "<< beta_k << "\n";
     std::cout << GridLogIRL << " -- Nconv       = "<< Nconv  << "\n";
     std::cout << GridLogIRL <<"**************************************************************************"<< std::endl;
+
+    // Restarts as iterations, PolyOp applications as matrix calls; no single residual
+    Perf.Times(PolyTimer,LinalgTimer);
+    Perf.End(iter,PolyCalls,Nconv>=Nstop,0.0);
   }
 
  private:
@@ -467,8 +488,12 @@ until convergence
 
     Field& evec_k = evec[k];
 
+    PolyTimer.Start();
     _PolyOp(evec_k,w);    std::cout<<GridLogDebug << "PolyOp" <<std::endl;
+    PolyTimer.Stop();
+    PolyCalls++;
 
+    LinalgTimer.Start();
     if(k>0) w -= lme[k-1] * evec[k-1];
 
     ComplexD zalph = innerProduct(evec_k,w);
@@ -488,6 +513,8 @@ until convergence
     }
 
     if(k < Nm-1) evec[k+1] = w;
+    LinalgTimer.Stop();
+    Perf.Linalg(3+2+3+3+2,2+2+2+3);
 
     std::cout<<GridLogIRL << "Lanczos step alpha[" << k << "] = " << zalph << " beta[" << k << "] = "<<beta<<std::endl;
     if ( beta < tiny ) 
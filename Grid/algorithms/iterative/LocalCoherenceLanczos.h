@@ -446,6 +446,19 @@ public:
     blockPromote(evec_coarse[i],evec,subspace);  
     eval = evals_coarse[i];
   }
+
+  //Reconstruct all fine eigenvectors one at a time into a std::vector<FineField>, or a
+  //CompressedEigenVectors store so the full precision set is never held in memory
+  template<class Evecs>
+  void getFineEvecsEvals(Evecs &evecs, std::vector<RealD> &evals) const{
+    FineField evec(_FineGrid);
+    evecs.clear();
+    evals.resize(evec_coarse.size());
+    for(int i=0;i<evec_coarse.size();i++){
+      getFineEvecEval(evec,evals[i],i);
+      evecs.push_back(evec);
+    }
+  }
     
     
 };
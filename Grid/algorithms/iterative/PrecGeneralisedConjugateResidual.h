@@ -54,6 +54,8 @@ public:
   GridStopWatch PrecTimer;
   GridStopWatch MatTimer;
   GridStopWatch LinalgTimer;
+  SolverPerformanceMonitor Perf;
+  int MatCalls;
 
   LinearFunction<Field>     &Preconditioner;
   LinearOperatorBase<Field> &Linop;
@@ -66,7 +68,8 @@ public:
     Linop(_Linop),
     Preconditioner(Prec),
     mmax(_mmax),
-    nstep(_nstep)
+    nstep(_nstep),
+    Perf("PrecGeneralisedConjugateResidual")
   { 
     level=1;
     verbose=1;
@@ -74,6 +77,8 @@ public:
 
   void operator() (const Field &src, Field &psi){
 
+    Perf.Begin(src);
+    MatCalls=0;
     psi=Zero();
     RealD cp, ssq,rsq;
     ssq=norm2(src);
@@ -102,6 +107,8 @@ public:
 	Linop.HermOp(psi,r);
 	axpy(r,-1.0,src,r);
 	RealD tr = norm2(r);
+	Perf.Times(MatTimer,LinalgTimer);
+	Perf.End(steps,MatCalls+1,true,sqrt(tr/ssq));
 	GCRLogLevel<<"PGCR: Converged on iteration " <<steps
 		 << " computed residual "<<sqrt(cp/ssq)
 		 << " true residual "    <<sqrt(tr/ssq)
@@ -118,6 +125,8 @@ public:
 
     }
     GCRLogLevel<<"Variable Preconditioned GCR did not converge"<<std::endl;
+    Perf.Times(MatTimer,LinalgTimer);
+    Perf.End(steps,MatCalls,false,sqrt(cp/ssq));
     //    assert(0);
   }
 
@@ -157,6 +166,8 @@ public:
     LinalgTimer.Start();
     r=src-Az;
     LinalgTimer.Stop();
+    MatCalls+=2;
+    Perf.Linalg(3+4+1,1+2);
     GCRLogLevel<< "PGCR true residual r = src - A psi   "<<norm2(r) <<std::endl;
     
     /////////////////////
@@ -197,6 +208,7 @@ public:
 
       cp = axpy_norm(r,-a,q[peri_k],r);
       LinalgTimer.Stop();
+      Perf.Linalg(2+3+3,2+2+4);
 
       GCRLogLevel<< "PGCR step["<<steps<<"]  resid " << cp << " target " <<rsq<<std::endl; 
 
@@ -230,6 +242,8 @@ public:
       }
       qq[peri_kp]=norm2(q[peri_kp]); // could use axpy_norm
       LinalgTimer.Stop();
+      MatCalls++;
+      Perf.Linalg(4+1+northog*(2+6),2+northog*(2+4));
     }
     assert(0); // never reached
     return cp;
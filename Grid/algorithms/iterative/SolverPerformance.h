@@ -0,0 +1,240 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/algorithms/iterative/SolverPerformance.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////
+// Common per solve performance record for the iterative solvers.
+//
+// Times are seconds on this rank. Linear algebra flops and bytes are
+// global and estimated by the solver from the vector operations it
+// issues; operator cost is left as a call count since only the
+// operator knows its own flop count. Reductions and halo figures are
+// differences of the process wide communicator and stencil counters
+// over the solve, so a nested solve is also charged to its parent.
+/////////////////////////////////////////////////////////////
+class SolverPerformance : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(SolverPerformance,
+				  std::string, Solver,
+				  int,    Solves,
+				  int,    Iterations,
+				  int,    MatrixCalls,
+				  bool,   Converged,
+				  RealD,  TrueResidual,
+				  RealD,  TotalTime,
+				  RealD,  MatrixTime,
+				  RealD,  LinalgTime,
+				  RealD,  ReduceTime,
+				  RealD,  LinalgFlops,
+				  RealD,  LinalgBytes,
+				  RealD,  Reductions,
+				  RealD,  HaloTime,
+				  RealD,  HaloBytes,
+				  RealD,  HaloExchanges);
+
+  // Sum counts and times, keep the worst residual
+  void Accumulate(const SolverPerformance &r)
+  {
+    Solves       += r.Solves;
+    Iterations   += r.Iterations;
+    MatrixCalls  += r.MatrixCalls;
+    Converged     = Converged && r.Converged;
+    TrueResidual  = std::max(TrueResidual,r.TrueResidual);
+    TotalTime    += r.TotalTime;
+    MatrixTime   += r.MatrixTime;
+    LinalgTime   += r.LinalgTime;
+    ReduceTime   += r.ReduceTime;
+    LinalgFlops  += r.LinalgFlops;
+    LinalgBytes  += r.LinalgBytes;
+    Reductions   += r.Reductions;
+    HaloTime     += r.HaloTime;
+    HaloBytes    += r.HaloBytes;
+    HaloExchanges+= r.HaloExchanges;
+  }
+};
+
+/////////////////////////////////////////////////////////////
+// Records of all solves since the last Clear(); an HMC observable
+// writes and clears it once per trajectory. Recording is off until
+// Enable() is called, so runs without a consumer that clears the log
+// do not grow it without bound.
+/////////////////////////////////////////////////////////////
+class SolverPerformanceLog {
+public:
+  static std::vector<SolverPerformance> &Records(void)
+  {
+    static std::vector<SolverPerformance> records;
+    return records;
+  }
+  static int &Enabled(void)
+  {
+    static int enabled = 0;
+    return enabled;
+  }
+  static void Enable(void)  { Enabled() = 1; }
+  static void Disable(void) { Enabled() = 0; }
+  static void Record(const SolverPerformance &r) { if ( Enabled() ) Records().push_back(r); }
+  static void Clear(void) { std::vector<SolverPerformance>().swap(Records()); }
+
+  // One aggregate per solver name, in order of first appearance
+  static std::vector<SolverPerformance> Summary(void)
+  {
+    std::vector<SolverPerformance> summary;
+    for(auto &r : Records()){
+      int s=0;
+      while ( (s<summary.size()) && (summary[s].Solver != r.Solver) ) s++;
+      if ( s==summary.size() ) summary.push_back(r);
+      else                     summary[s].Accumulate(r);
+    }
+    return summary;
+  }
+
+  template<class Writer>
+  static void Write(Writer &WR)
+  {
+    write(WR,"Summary",Summary());
+    write(WR,"Solves",Records());
+  }
+
+  // JSON for a .json file name, XML otherwise; only the world boss writes
+  static void WriteFile(const std::string &file)
+  {
+    if ( CartesianCommunicator::RankWorld() != 0 ) return;
+    std::string ext = file.substr(file.find_last_of('.')+1);
+#ifndef GRID_HIP
+    if ( ext == "json" ) {
+      JSONWriter WR(file);
+      Write(WR);
+      return;
+    }
+#endif
+    XmlWriter WR(file);
+    Write(WR);
+  }
+};
+
+/////////////////////////////////////////////////////////////
+// Helper the solvers fill in over one solve:
+//
+//   SolverPerformanceMonitor Perf("ConjugateGradient");
+//   Perf.Begin(src);
+//   ... Perf.Linalg(streams,flops) per vector operation ...
+//   Perf.Times(MatrixTimer,LinalgTimer,InnerTimer);
+//   Perf.End(iterations,matrix_calls,converged,true_residual);
+//
+// Linalg counts are in units of one field: streams is the number of
+// fields read or written, flops the floating point operations per real.
+/////////////////////////////////////////////////////////////
+class SolverPerformanceMonitor {
+public:
+  SolverPerformance Perf;
+
+  RealD    FieldBytes;
+  RealD    FieldReals;
+  RealD    usec0;
+  double   HaloUsec0;
+  uint64_t HaloBytes0;
+  uint64_t HaloExchanges0;
+  uint64_t Reductions0;
+
+  SolverPerformanceMonitor(const std::string &solver)
+  {
+    Perf.Solver = solver;
+  }
+
+  template<class Field>
+  void Begin(const Field &src)
+  {
+    typedef typename Field::vector_object vobj;
+    typedef typename RealPart<typename vobj::scalar_type>::type RealScalar;
+    RealD site_bytes = sizeof(vobj)/vobj::Nsimd();
+    FieldBytes = site_bytes*src.Grid()->gSites();
+    FieldReals = FieldBytes/sizeof(RealScalar);
+
+    std::string name = Perf.Solver;
+    Perf = SolverPerformance();
+    Perf.Solver = name;
+    Perf.Solves = 1;
+
+    Reductions0 = CartesianCommunicator::GlobalSumCount;
+    StencilGetHaloCounts(HaloUsec0,HaloBytes0,HaloExchanges0);
+    usec0 = usecond();
+  }
+
+  void Linalg(RealD streams,RealD flops)
+  {
+    Perf.LinalgBytes += streams*FieldBytes;
+    Perf.LinalgFlops += flops*FieldReals;
+  }
+
+  // Reduce time is left zero for solvers that do not time reductions separately
+  void Times(const GridStopWatch &Matrix,const GridStopWatch &Linalg)
+  {
+    Perf.MatrixTime = 1.0e-6*Matrix.useconds();
+    Perf.LinalgTime = 1.0e-6*Linalg.useconds();
+  }
+  void Times(const GridStopWatch &Matrix,const GridStopWatch &Linalg,const GridStopWatch &Reduce)
+  {
+    Times(Matrix,Linalg);
+    Perf.ReduceTime = 1.0e-6*Reduce.useconds();
+  }
+
+  void End(int iterations,int matrix_calls,bool converged,RealD true_residual)
+  {
+    double   usec;
+    uint64_t bytes, exchanges;
+    StencilGetHaloCounts(usec,bytes,exchanges);
+
+    Perf.Iterations    = iterations;
+    Perf.MatrixCalls   = matrix_calls;
+    Perf.Converged     = converged;
+    Perf.TrueResidual  = true_residual;
+    Perf.TotalTime     = 1.0e-6*(usecond()-usec0);
+    Perf.Reductions    = CartesianCommunicator::GlobalSumCount - Reductions0;
+    Perf.HaloTime      = 1.0e-6*(usec-HaloUsec0);
+    Perf.HaloBytes     = bytes-HaloBytes0;
+    Perf.HaloExchanges = exchanges-HaloExchanges0;
+
+    std::cout << GridLogPerformance << Perf.Solver
+	      << " iterations "  << Perf.Iterations
+	      << " total "       << Perf.TotalTime  << " s"
+	      << " matrix "      << Perf.MatrixTime << " s"
+	      << " linalg "      << Perf.LinalgTime << " s"
+	      << " reduce "      << Perf.ReduceTime << " s"
+	      << " halo "        << Perf.HaloTime   << " s"
+	      << " reductions "  << Perf.Reductions
+	      << " linalg GF/s " << (Perf.LinalgTime>0 ? 1.0e-9*Perf.LinalgFlops/Perf.LinalgTime : 0.0)
+	      << std::endl;
+
+    SolverPerformanceLog::Record(Perf);
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -69,6 +69,8 @@ void MemoryManager::PrintBytes(void)
   std::cout << " MemoryManager : "<<(cacheBytes>>20) <<" acc cache Mbytes "<<std::endl;
   cacheBytes = CacheBytes[Shared];
   std::cout << " MemoryManager : "<<(cacheBytes>>20) <<" shared cache Mbytes "<<std::endl;
+  std::cout << " MemoryManager : "<<HostCacheHits()  <<" cpu cache hits "<<HostCacheMisses()<<" misses"<<std::endl;
+  std::cout << " MemoryManager : "<<DeviceCacheHits()<<" acc cache hits "<<DeviceCacheMisses()<<" misses"<<std::endl;
   
 #ifdef GRID_CUDA
   cuda_mem();
@@ -78,14 +80,31 @@ void MemoryManager::PrintBytes(void)
 
 uint64_t MemoryManager::DeviceCacheBytes() { return CacheBytes[Acc] + CacheBytes[AccHuge] + CacheBytes[AccSmall]; }
 uint64_t MemoryManager::HostCacheBytes()   { return CacheBytes[Cpu] + CacheBytes[CpuHuge] + CacheBytes[CpuSmall]; }
+uint64_t MemoryManager::DeviceCacheHits()  { return CacheHits[Acc] + CacheHits[AccHuge] + CacheHits[AccSmall]; }
+uint64_t MemoryManager::HostCacheHits()    { return CacheHits[Cpu] + CacheHits[CpuHuge] + CacheHits[CpuSmall]; }
+uint64_t MemoryManager::DeviceCacheMisses(){ return CacheMisses[Acc] + CacheMisses[AccHuge] + CacheMisses[AccSmall]; }
+uint64_t MemoryManager::HostCacheMisses()  { return CacheMisses[Cpu] + CacheMisses[CpuHuge] + CacheMisses[CpuSmall]; }
+void MemoryManager::ResetCacheCounters()
+{
+  for(int t=0;t<NallocType;t++){
+    CacheHits[t]=0;
+    CacheMisses[t]=0;
+  }
+}
 
 //////////////////////////////////////////////////////////////////////
-// Data tables for recently freed pooiniter caches
+// Data tables for recently freed pointer caches
 //////////////////////////////////////////////////////////////////////
-MemoryManager::AllocationCacheEntry MemoryManager::Entries[MemoryManager::NallocType][MemoryManager::NallocCacheMax];
-int MemoryManager::Victim[MemoryManager::NallocType];
+MemoryManager::AllocationFreeList_t MemoryManager::FreeList[MemoryManager::NallocType];
+MemoryManager::AllocationAge_t      MemoryManager::FreeAge[MemoryManager::NallocType];
+uint64_t MemoryManager::Clock;
 int MemoryManager::Ncache[MemoryManager::NallocType] = { 2, 0, 8, 8, 0, 16, 8, 0, 16 };
 uint64_t MemoryManager::CacheBytes[MemoryManager::NallocType];
+uint64_t MemoryManager::CacheHits[MemoryManager::NallocType];
+uint64_t MemoryManager::CacheMisses[MemoryManager::NallocType];
+int MemoryManager::Slack     = 0;
+std::unordered_map<void *,size_t> MemoryManager::SlackBytes;
+int MemoryManager::HugePages = 1;
 //////////////////////////////////////////////////////////////////////
 // Actual allocation and deallocation utils
 //////////////////////////////////////////////////////////////////////
@@ -173,6 +192,9 @@ void *MemoryManager::CpuAllocate(size_t bytes)
   void *ptr = (void *) Lookup(bytes,Cpu);
   if ( ptr == (void *) NULL ) {
     ptr = (void *) acceleratorAllocCpu(bytes);
+#ifdef MADV_HUGEPAGE
+    if ( HugePages && (bytes >= GRID_ALLOC_HUGEPAGE_LIMIT) ) madvise(ptr,bytes,MADV_HUGEPAGE);
+#endif
   }
 #ifdef GRID_MM_VERBOSE
   std::cout <<"CpuAllocate "<<std::endl;
@@ -234,6 +256,19 @@ void MemoryManager::Init(void)
     }
   }
 
+  str= getenv("GRID_ALLOC_SLACK");
+  if ( str ) {
+    Nc = atoi(str);
+    if ( (Nc>=0) && (Nc <= 100)) {
+      Slack=Nc;
+    }
+  }
+
+  str= getenv("GRID_ALLOC_HUGEPAGES");
+  if ( str ) {
+    HugePages = atoi(str);
+  }
+
 }
 
 void MemoryManager::InitMessage(void) {
@@ -247,6 +282,7 @@ void MemoryManager::InitMessage(void) {
   std::cout << GridLogMessage<< "MemoryManager::Init() cache pool for recent host   allocations: SMALL "<<Ncache[CpuSmall]<<" LARGE "<<Ncache[Cpu]<<" HUGE "<<Ncache[CpuHuge]<<std::endl;
   std::cout << GridLogMessage<< "MemoryManager::Init() cache pool for recent device allocations: SMALL "<<Ncache[AccSmall]<<" LARGE "<<Ncache[Acc]<<" Huge "<<Ncache[AccHuge]<<std::endl;
   std::cout << GridLogMessage<< "MemoryManager::Init() cache pool for recent shared allocations: SMALL "<<Ncache[SharedSmall]<<" LARGE "<<Ncache[Shared]<<" Huge "<<Ncache[SharedHuge]<<std::endl;
+  std::cout << GridLogMessage<< "MemoryManager::Init() cache pool reuses blocks up to "<<Slack<<"% larger than requested"<<std::endl;
 #endif
   
 #ifdef GRID_UVM
@@ -275,86 +311,84 @@ void MemoryManager::InitMessage(void) {
 
 }
 
-void *MemoryManager::Insert(void *ptr,size_t bytes,int type) 
+int MemoryManager::CacheType(size_t bytes,int type)
 {
-#ifdef ALLOCATION_CACHE
-  int cache;
-  if      (bytes < GRID_ALLOC_SMALL_LIMIT) cache = type + 2;
-  else if (bytes >= GRID_ALLOC_HUGE_LIMIT) cache = type + 1;
-  else                                     cache = type;
-
-  return Insert(ptr,bytes,Entries[cache],Ncache[cache],Victim[cache],CacheBytes[cache]);  
-#else
-  return ptr;
-#endif
+  if      (bytes < GRID_ALLOC_SMALL_LIMIT) return type + 2;
+  else if (bytes >= GRID_ALLOC_HUGE_LIMIT) return type + 1;
+  return type;
 }
 
-void *MemoryManager::Insert(void *ptr,size_t bytes,AllocationCacheEntry *entries,int ncache,int &victim, uint64_t &cacheBytes) 
+void *MemoryManager::Insert(void *ptr,size_t bytes,int type) 
 {
+#ifdef ALLOCATION_CACHE
 #ifdef GRID_OMP
   assert(omp_in_parallel()==0);
 #endif 
-
-  if (ncache == 0) return ptr;
-
-  void * ret = NULL;
-  int v = -1;
-
-  for(int e=0;e<ncache;e++) {
-    if ( entries[e].valid==0 ) {
-      v=e; 
-      break;
-    }
+  // Key and account the block on its true size if Lookup gave out a larger one
+  auto slack = SlackBytes.find(ptr);
+  if ( slack != SlackBytes.end() ) {
+    bytes = slack->second;
+    SlackBytes.erase(slack);
   }
+  int cache = CacheType(bytes,type);
+  int ncache= Ncache[cache];
+  if (ncache == 0) return ptr;
 
-  if ( v==-1 ) {
-    v=victim;
-    victim = (victim+1)%ncache;
-  }
+  AllocationFreeList_t &list = FreeList[cache];
+  AllocationAge_t      &age  = FreeAge[cache];
 
-  if ( entries[v].valid ) {
-    ret = entries[v].address;
-    cacheBytes -= entries[v].bytes;
-    entries[v].valid = 0;
-    entries[v].address = NULL;
-    entries[v].bytes = 0;
+  void * ret = NULL;
+  if ( list.size() >= ncache ) {
+    // Evict the longest unused block
+    auto victim = age.begin()->second;
+    ret = victim->second.address;
+    CacheBytes[cache] -= victim->first;
+    list.erase(victim);
+    age.erase(age.begin());
   }
 
-  entries[v].address=ptr;
-  entries[v].bytes  =bytes;
-  entries[v].valid  =1;
-  cacheBytes += bytes;
+  AllocationCacheEntry entry;
+  entry.address = ptr;
+  entry.age     = Clock++;
+  auto it = list.insert(std::make_pair(bytes,entry));
+  age[entry.age] = it;
+  CacheBytes[cache] += bytes;
 
   return ret;
-}
-
-void *MemoryManager::Lookup(size_t bytes,int type)
-{
-#ifdef ALLOCATION_CACHE
-  int cache;
-  if      (bytes < GRID_ALLOC_SMALL_LIMIT) cache = type + 2;
-  else if (bytes >= GRID_ALLOC_HUGE_LIMIT) cache = type + 1;
-  else                                     cache = type;
-
-  return Lookup(bytes,Entries[cache],Ncache[cache],CacheBytes[cache]);
 #else
-  return NULL;
+  return ptr;
 #endif
 }
 
-void *MemoryManager::Lookup(size_t bytes,AllocationCacheEntry *entries,int ncache,uint64_t & cacheBytes) 
+void *MemoryManager::Lookup(size_t bytes,int type)
 {
+#ifdef ALLOCATION_CACHE
 #ifdef GRID_OMP
   assert(omp_in_parallel()==0);
 #endif 
-  for(int e=0;e<ncache;e++){
-    if ( entries[e].valid && ( entries[e].bytes == bytes ) ) {
-      entries[e].valid = 0;
-      cacheBytes -= entries[e].bytes;
-      return entries[e].address;
-    }
+  int cache = CacheType(bytes,type);
+
+  AllocationFreeList_t &list = FreeList[cache];
+
+  // Smallest cached block at least as large as requested, within the slack
+  auto it = list.lower_bound(bytes);
+  if ( (it == list.end()) || (it->first > bytes + (bytes/100)*Slack) ) {
+    CacheMisses[cache]++;
+    profilerCacheLookup(0);
+    return NULL;
   }
+
+  void *ptr = it->second.address;
+  if ( it->first != bytes ) SlackBytes[ptr] = it->first;
+  CacheBytes[cache] -= it->first;
+  FreeAge[cache].erase(it->second.age);
+  list.erase(it);
+  CacheHits[cache]++;
+  profilerCacheLookup(1);
+  return ptr;
+#else
   return NULL;
+#endif
 }
 
 
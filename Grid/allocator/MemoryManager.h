@@ -28,6 +28,7 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 /*  END LEGAL */
 #pragma once
 #include <list> 
+#include <map> 
 #include <unordered_map>  
 
 NAMESPACE_BEGIN(Grid);
@@ -36,6 +37,7 @@ NAMESPACE_BEGIN(Grid);
 
 #define GRID_ALLOC_SMALL_LIMIT (4096)
 #define GRID_ALLOC_HUGE_LIMIT  (2147483648)
+#define GRID_ALLOC_HUGEPAGE_LIMIT (2097152)
 
 #define STRINGIFY(x) #x
 #define TOSTRING(x) STRINGIFY(x)
@@ -83,6 +85,10 @@ struct MemoryStatus {
   uint64_t     DeviceDestroy;
   uint64_t     DeviceAllocCacheBytes;
   uint64_t     HostAllocCacheBytes;
+  uint64_t     DeviceAllocCacheHits;
+  uint64_t     DeviceAllocCacheMisses;
+  uint64_t     HostAllocCacheHits;
+  uint64_t     HostAllocCacheMisses;
 };
 
 
@@ -90,28 +96,39 @@ class MemoryManager {
 private:
 
   ////////////////////////////////////////////////////////////
-  // For caching recently freed allocations
+  // For caching recently freed allocations.
+  // Free blocks are bucketed by size so lookup is a best fit
+  // search O(log N) rather than a linear scan; a block up to
+  // Slack percent larger than the request may be reused.
+  // The oldest block is evicted when a pool is full.
   ////////////////////////////////////////////////////////////
   typedef struct { 
     void *address;
-    size_t bytes;
-    int valid;
+    uint64_t age;
   } AllocationCacheEntry;
 
-  static const int NallocCacheMax=128; 
+  typedef std::multimap<size_t,AllocationCacheEntry>  AllocationFreeList_t;
+  typedef std::map<uint64_t,AllocationFreeList_t::iterator> AllocationAge_t;
+
+  static const int NallocCacheMax=1024; 
   static const int NallocType=9;
-  static AllocationCacheEntry Entries[NallocType][NallocCacheMax];
-  static int Victim[NallocType];
+  static AllocationFreeList_t FreeList[NallocType];
+  static AllocationAge_t      FreeAge[NallocType];
+  static uint64_t Clock;
   static int Ncache[NallocType];
   static uint64_t CacheBytes[NallocType];
+  static uint64_t CacheHits[NallocType];
+  static uint64_t CacheMisses[NallocType];
+  static int Slack;
+  static std::unordered_map<void *,size_t> SlackBytes; // true size of blocks handed out larger than requested
+  static int HugePages;
 
   /////////////////////////////////////////////////
   // Free pool
   /////////////////////////////////////////////////
+  static int   CacheType(size_t bytes,int type);
   static void *Insert(void *ptr,size_t bytes,int type) ;
   static void *Lookup(size_t bytes,int type) ;
-  static void *Insert(void *ptr,size_t bytes,AllocationCacheEntry *entries,int ncache,int &victim,uint64_t &cbytes) ;
-  static void *Lookup(size_t bytes,AllocationCacheEntry *entries,int ncache,uint64_t &cbytes) ;
 
  public:
   static void PrintBytes(void);
@@ -140,6 +157,11 @@ private:
   
   static uint64_t     DeviceCacheBytes();
   static uint64_t     HostCacheBytes();
+  static uint64_t     DeviceCacheHits();
+  static uint64_t     DeviceCacheMisses();
+  static uint64_t     HostCacheHits();
+  static uint64_t     HostCacheMisses();
+  static void         ResetCacheCounters();
 
   static MemoryStatus GetFootprint(void) {
     MemoryStatus stat;
@@ -154,6 +176,10 @@ private:
     stat.DeviceDestroy     = DeviceDestroy;
     stat.DeviceAllocCacheBytes = DeviceCacheBytes();
     stat.HostAllocCacheBytes   = HostCacheBytes();
+    stat.DeviceAllocCacheHits  = DeviceCacheHits();
+    stat.DeviceAllocCacheMisses= DeviceCacheMisses();
+    stat.HostAllocCacheHits    = HostCacheHits();
+    stat.HostAllocCacheMisses  = HostCacheMisses();
     return stat;
   };
   
@@ -37,6 +37,7 @@ struct MemoryStats
 {
   size_t totalAllocated{0}, maxAllocated{0}, 
     currentlyAllocated{0}, totalFreed{0};
+  size_t cacheHits{0}, cacheMisses{0};
 };
     
 class MemoryProfiler
@@ -60,6 +61,8 @@ public:
 		<< std::endl;						\
       std::cout << GridLogDebug << "[Memory debug] freed  : " << memString(s->totalFreed) \
 		<< std::endl;						\
+      std::cout << GridLogDebug << "[Memory debug] cache  : " << s->cacheHits << " hits " \
+		<< s->cacheMisses << " misses" << std::endl;		\
     }
 
 #define profilerAllocate(bytes)						\
@@ -89,6 +92,14 @@ public:
       profilerDebugPrint;						\
     }
 
+#define profilerCacheLookup(hit)				\
+  if (MemoryProfiler::stats)						\
+    {									\
+      auto s = MemoryProfiler::stats;					\
+      if (hit) s->cacheHits++;						\
+      else     s->cacheMisses++;					\
+    }
+
 void check_huge_pages(void *Buf,uint64_t BYTES);
 
 NAMESPACE_END(Grid);
@@ -34,6 +34,7 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 NAMESPACE_BEGIN(Grid);
 
 bool Stencil_force_mpi = true;
+bool Stencil_persistent_comms = false;
 
 ///////////////////////////////////////////////////////////////
 // Info that is setup once and indept of cartesian layout
@@ -41,6 +42,7 @@ bool Stencil_force_mpi = true;
 CartesianCommunicator::CommunicatorPolicy_t  
 CartesianCommunicator::CommunicatorPolicy= CartesianCommunicator::CommunicatorPolicyConcurrent;
 int CartesianCommunicator::nCommThreads = -1;
+uint64_t CartesianCommunicator::GlobalSumCount = 0;
 
 /////////////////////////////////
 // Grid information queries
@@ -73,6 +75,14 @@ void CartesianCommunicator::GlobalSumVector(ComplexD *c,int N)
 {
   GlobalSumVector((double *)c,2*N);
 }
+void CartesianCommunicator::GlobalSumVectorBegin(ComplexF *c,int N,CommsRequest_t &req)
+{
+  GlobalSumVectorBegin((float *)c,2*N,req);
+}
+void CartesianCommunicator::GlobalSumVectorBegin(ComplexD *c,int N,CommsRequest_t &req)
+{
+  GlobalSumVectorBegin((double *)c,2*N,req);
+}
   
 NAMESPACE_END(Grid);
 
@@ -36,6 +36,7 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 NAMESPACE_BEGIN(Grid);
 
 extern bool Stencil_force_mpi ;
+extern bool Stencil_persistent_comms ;
 
 class CartesianCommunicator : public SharedMemory {
 
@@ -49,6 +50,12 @@ public:
   static void SetCommunicatorPolicy(CommunicatorPolicy_t policy ) { CommunicatorPolicy = policy; }
   static int       nCommThreads;
 
+  ////////////////////////////////////////////
+  // Floating point global sums issued by this process;
+  // read by solver instrumentation to count reductions
+  ////////////////////////////////////////////
+  static uint64_t  GlobalSumCount;
+
   ////////////////////////////////////////////
   // Communicator should know nothing of the physics grid, only processor grid.
   ////////////////////////////////////////////
@@ -128,6 +135,16 @@ public:
   void GlobalXOR(uint32_t &);
   void GlobalXOR(uint64_t &);
 
+  ////////////////////////////////////////////////////////////
+  // Non-blocking reduction; the buffer must stay live and
+  // untouched until the matching Complete
+  ////////////////////////////////////////////////////////////
+  void GlobalSumVectorBegin(RealF *,int N,CommsRequest_t &req);
+  void GlobalSumVectorBegin(RealD *,int N,CommsRequest_t &req);
+  void GlobalSumVectorBegin(ComplexF *c,int N,CommsRequest_t &req);
+  void GlobalSumVectorBegin(ComplexD *c,int N,CommsRequest_t &req);
+  void GlobalSumVectorComplete(CommsRequest_t &req);
+
   template<class obj> void GlobalSumP2P(obj &o)
   {
     std::vector<obj> column;
@@ -197,6 +214,22 @@ public:
   void StencilSendToRecvFromComplete(std::vector<CommsRequest_t> &waitall,int i);
   void StencilBarrier(void);
 
+  ////////////////////////////////////////////////////////////
+  // Persistent halo exchange; requests are built once by Init
+  // and replayed by Begin/Complete on every exchange.
+  // Only the MPI legs are persistent, so callers must route
+  // everything through MPI (Stencil_force_mpi).
+  ////////////////////////////////////////////////////////////
+  double StencilSendToRecvFromPersistentInit(std::vector<CommsRequest_t> &list,
+					     void *xmit,
+					     int xmit_to_rank,int do_xmit,
+					     void *recv,
+					     int recv_from_rank,int do_recv,
+					     int xbytes,int rbytes,int dir);
+  void StencilSendToRecvFromPersistentBegin(std::vector<CommsRequest_t> &list);
+  void StencilSendToRecvFromPersistentComplete(std::vector<CommsRequest_t> &list);
+  void StencilSendToRecvFromPersistentFree(std::vector<CommsRequest_t> &list);
+
   ////////////////////////////////////////////////////////////
   // Barrier
   ////////////////////////////////////////////////////////////
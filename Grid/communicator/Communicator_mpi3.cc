@@ -288,24 +288,45 @@ void CartesianCommunicator::GlobalMax(double &d)
   assert(ierr==0);
 }
 void CartesianCommunicator::GlobalSum(float &f){
+  GlobalSumCount++;
   int ierr=MPI_Allreduce(MPI_IN_PLACE,&f,1,MPI_FLOAT,MPI_SUM,communicator);
   assert(ierr==0);
 }
 void CartesianCommunicator::GlobalSumVector(float *f,int N)
 {
+  GlobalSumCount++;
   int ierr=MPI_Allreduce(MPI_IN_PLACE,f,N,MPI_FLOAT,MPI_SUM,communicator);
   assert(ierr==0);
 }
 void CartesianCommunicator::GlobalSum(double &d)
 {
+  GlobalSumCount++;
   int ierr = MPI_Allreduce(MPI_IN_PLACE,&d,1,MPI_DOUBLE,MPI_SUM,communicator);
   assert(ierr==0);
 }
 void CartesianCommunicator::GlobalSumVector(double *d,int N)
 {
+  GlobalSumCount++;
   int ierr = MPI_Allreduce(MPI_IN_PLACE,d,N,MPI_DOUBLE,MPI_SUM,communicator);
   assert(ierr==0);
 }
+void CartesianCommunicator::GlobalSumVectorBegin(float *f,int N,CommsRequest_t &req)
+{
+  GlobalSumCount++;
+  int ierr=MPI_Iallreduce(MPI_IN_PLACE,f,N,MPI_FLOAT,MPI_SUM,communicator,&req);
+  assert(ierr==0);
+}
+void CartesianCommunicator::GlobalSumVectorBegin(double *d,int N,CommsRequest_t &req)
+{
+  GlobalSumCount++;
+  int ierr=MPI_Iallreduce(MPI_IN_PLACE,d,N,MPI_DOUBLE,MPI_SUM,communicator,&req);
+  assert(ierr==0);
+}
+void CartesianCommunicator::GlobalSumVectorComplete(CommsRequest_t &req)
+{
+  int ierr=MPI_Wait(&req,MPI_STATUS_IGNORE);
+  assert(ierr==0);
+}
 
 void CartesianCommunicator::SendToRecvFromBegin(std::vector<CommsRequest_t> &list,
 						void *xmit,
@@ -459,6 +480,79 @@ void CartesianCommunicator::StencilSendToRecvFromComplete(std::vector<CommsReque
   assert(ierr==0);
   list.resize(0);
 }
+double CartesianCommunicator::StencilSendToRecvFromPersistentInit(std::vector<CommsRequest_t> &list,
+								  void *xmit,
+								  int dest,int dox,
+								  void *recv,
+								  int from,int dor,
+								  int xbytes,int rbytes,int dir)
+{
+  int ncomm  =communicator_halo.size();
+  int commdir=dir%ncomm;
+
+  MPI_Request xrq;
+  MPI_Request rrq;
+
+  int ierr;
+  int gdest = ShmRanks[dest];
+  int gfrom = ShmRanks[from];
+
+  assert(dest != _processor);
+  assert(from != _processor);
+  double off_node_bytes=0.0;
+  int tag;
+
+  if ( dor ) {
+    // Intranode copies are not replayable; caller must force MPI
+    assert( (gfrom ==MPI_UNDEFINED) || Stencil_force_mpi );
+    tag= dir+from*32;
+    ierr=MPI_Recv_init(recv, rbytes, MPI_CHAR,from,tag,communicator_halo[commdir],&rrq);
+    assert(ierr==0);
+    list.push_back(rrq);
+    off_node_bytes+=rbytes;
+  }
+  if ( dox ) {
+    assert( (gdest ==MPI_UNDEFINED) || Stencil_force_mpi );
+    tag= dir+_processor*32;
+    ierr=MPI_Send_init(xmit, xbytes, MPI_CHAR,dest,tag,communicator_halo[commdir],&xrq);
+    assert(ierr==0);
+    list.push_back(xrq);
+    off_node_bytes+=xbytes;
+  }
+  return off_node_bytes;
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentBegin(std::vector<CommsRequest_t> &list)
+{
+  int nreq=list.size();
+  if (nreq==0) return;
+  int ierr = MPI_Startall(nreq,&list[0]);
+  assert(ierr==0);
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentComplete(std::vector<CommsRequest_t> &list)
+{
+  int nreq=list.size();
+
+  acceleratorCopySynchronise();
+
+  if (nreq==0) return;
+
+  // Persistent requests go inactive on completion but are not freed
+  std::vector<MPI_Status> status(nreq);
+  int ierr = MPI_Waitall(nreq,&list[0],&status[0]);
+  assert(ierr==0);
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentFree(std::vector<CommsRequest_t> &list)
+{
+  int finalized;
+  MPI_Finalized(&finalized);
+  if ( !finalized ) {
+    for(int i=0;i<list.size();i++){
+      int ierr = MPI_Request_free(&list[i]);
+      assert(ierr==0);
+    }
+  }
+  list.resize(0);
+}
 void CartesianCommunicator::StencilBarrier(void)
 {
   MPI_Barrier  (ShmComm);
@@ -71,15 +71,18 @@ CartesianCommunicator::~CartesianCommunicator(){}
 
 void CartesianCommunicator::GlobalMax(float &){}
 void CartesianCommunicator::GlobalMax(double &){}
-void CartesianCommunicator::GlobalSum(float &){}
-void CartesianCommunicator::GlobalSumVector(float *,int N){}
-void CartesianCommunicator::GlobalSum(double &){}
-void CartesianCommunicator::GlobalSumVector(double *,int N){}
+void CartesianCommunicator::GlobalSum(float &){ GlobalSumCount++; }
+void CartesianCommunicator::GlobalSumVector(float *,int N){ GlobalSumCount++; }
+void CartesianCommunicator::GlobalSum(double &){ GlobalSumCount++; }
+void CartesianCommunicator::GlobalSumVector(double *,int N){ GlobalSumCount++; }
 void CartesianCommunicator::GlobalSum(uint32_t &){}
 void CartesianCommunicator::GlobalSum(uint64_t &){}
 void CartesianCommunicator::GlobalSumVector(uint64_t *,int N){}
 void CartesianCommunicator::GlobalXOR(uint32_t &){}
 void CartesianCommunicator::GlobalXOR(uint64_t &){}
+void CartesianCommunicator::GlobalSumVectorBegin(float *,int N,CommsRequest_t &req){ GlobalSumCount++; req=0; }
+void CartesianCommunicator::GlobalSumVectorBegin(double *,int N,CommsRequest_t &req){ GlobalSumCount++; req=0; }
+void CartesianCommunicator::GlobalSumVectorComplete(CommsRequest_t &req){}
 
 
 // Basic Halo comms primitive -- should never call in single node
@@ -144,6 +147,18 @@ double CartesianCommunicator::StencilSendToRecvFromBegin(std::vector<CommsReques
 void CartesianCommunicator::StencilSendToRecvFromComplete(std::vector<CommsRequest_t> &waitall,int dir)
 {
 }
+double CartesianCommunicator::StencilSendToRecvFromPersistentInit(std::vector<CommsRequest_t> &list,
+								  void *xmit,
+								  int xmit_to_rank,int dox,
+								  void *recv,
+								  int recv_from_rank,int dor,
+								  int xbytes,int rbytes, int dir)
+{
+  return xbytes+rbytes;
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentBegin(std::vector<CommsRequest_t> &list){}
+void CartesianCommunicator::StencilSendToRecvFromPersistentComplete(std::vector<CommsRequest_t> &list){}
+void CartesianCommunicator::StencilSendToRecvFromPersistentFree(std::vector<CommsRequest_t> &list){ list.resize(0); }
 
 void CartesianCommunicator::StencilBarrier(void){};
 
@@ -0,0 +1,227 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/lattice/Lattice_fusion.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Several expression template statements evaluated in one sweep over the sites:
+//
+//   fusedEval(FusedAssign(psi, a*p + psi),
+//             FusedAssign(p,   b*p + r));
+//
+//   RealD cp; ComplexD pAp;
+//   fusedEval(FusedAssign(r, r - a*mmp),
+//             FusedNorm2(cp, r),
+//             FusedInnerProduct(pAp, p, mmp));
+//
+// Statements run in order on each site, so a statement sees the values assigned
+// by the statements before it. Expressions are point-wise, so this is the same
+// result as running them one after another over the whole lattice. Reductions
+// are accumulated alongside and combined in a single global sum at the end.
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Vector type an expression evaluates to
+template<class Expr> struct FusedVectorType {
+  typedef typename std::remove_const<typename std::remove_reference<decltype(vecEval(0,std::declval<Expr>()))>::type>::type sobj;
+  typedef typename sobj::vector_type type;
+};
+
+//////////////////////////////////////////
+// Device side statements
+//////////////////////////////////////////
+template<class vobj,class Expr>
+struct FusedAssignKernel {
+  LatticeView<vobj> me;
+  Expr expr;
+  template<class Acc> accelerator_inline void site(uint64_t ss,Acc &acc) const {
+    auto tmp = eval(ss,expr);
+    coalescedWrite(me[ss],tmp);
+  }
+  void Close(void) { me.ViewClose(); ExpressionViewClose(expr); }
+};
+
+template<class Expr1,class Expr2>
+struct FusedInnerProductKernel {
+  Expr1 x;
+  Expr2 y;
+  int slot;
+  template<class Acc> accelerator_inline void site(uint64_t ss,Acc &acc) const {
+    acc._internal[slot] = TensorRemove(innerProduct(eval(ss,x),eval(ss,y)));
+  }
+  void Close(void) { ExpressionViewClose(x); ExpressionViewClose(y); }
+};
+
+struct FusedEnd {
+  template<class Acc> accelerator_inline void site(uint64_t ss,Acc &acc) const {};
+  void Close(void) {};
+};
+template<class Head,class Tail>
+struct FusedList {
+  Head head;
+  Tail tail;
+  template<class Acc> accelerator_inline void site(uint64_t ss,Acc &acc) const {
+    head.site(ss,acc);
+    tail.site(ss,acc);
+  }
+  void Close(void) { head.Close(); tail.Close(); }
+};
+
+//////////////////////////////////////////
+// Host side statements
+//////////////////////////////////////////
+template<class vobj,class _Expr>
+class LatticeFusedAssign {
+public:
+  typedef typename ViewMap<_Expr>::Type Expr;
+  typedef typename vobj::vector_type vector_type;
+  static const int reductions = 0;
+
+  Lattice<vobj> &lat;
+  Expr expr;
+
+  LatticeFusedAssign(Lattice<vobj> &_lat,const _Expr &_expr) : lat(_lat), expr(_expr) {};
+
+  void Prepare(GridBase *&grid,int &slot) {
+    GridFromExpression(grid,expr);
+    conformable(grid,lat.Grid());
+    int cb=-1;
+    CBFromExpression(cb,expr);
+    assert( (cb==Odd) || (cb==Even));
+    lat.Checkerboard()=cb;
+  }
+  FusedAssignKernel<vobj,Expr> Open(void) {
+    FusedAssignKernel<vobj,Expr> k{lat.View(AcceleratorWrite),expr};
+    ExpressionViewOpen(k.expr);
+    return k;
+  }
+  void Result(const std::vector<ComplexD> &red) {};
+};
+
+inline void fusedResult(RealD    &r,const ComplexD &c) { r = real(c); }
+inline void fusedResult(ComplexD &r,const ComplexD &c) { r = c; }
+
+template<class _Expr1,class _Expr2,class Result_t>
+class LatticeFusedInnerProduct {
+public:
+  typedef typename ViewMap<_Expr1>::Type Expr1;
+  typedef typename ViewMap<_Expr2>::Type Expr2;
+  typedef typename FusedVectorType<Expr1>::type vector_type;
+  static const int reductions = 1;
+
+  Result_t &result;
+  Expr1 x;
+  Expr2 y;
+  int slot;
+
+  LatticeFusedInnerProduct(Result_t &_result,const _Expr1 &_x,const _Expr2 &_y) : result(_result), x(_x), y(_y) {};
+
+  void Prepare(GridBase *&grid,int &_slot) {
+    GridFromExpression(grid,x);
+    GridFromExpression(grid,y);
+    slot = _slot++;
+  }
+  FusedInnerProductKernel<Expr1,Expr2> Open(void) {
+    FusedInnerProductKernel<Expr1,Expr2> k{x,y,slot};
+    ExpressionViewOpen(k.x);
+    ExpressionViewOpen(k.y);
+    return k;
+  }
+  void Result(const std::vector<ComplexD> &red) { fusedResult(result,red[slot]); };
+};
+
+template<class vobj,class Expr>
+LatticeFusedAssign<vobj,Expr> FusedAssign(Lattice<vobj> &lat,const Expr &expr)
+{
+  return LatticeFusedAssign<vobj,Expr>(lat,expr);
+}
+template<class Expr>
+LatticeFusedInnerProduct<Expr,Expr,RealD> FusedNorm2(RealD &nrm,const Expr &x)
+{
+  return LatticeFusedInnerProduct<Expr,Expr,RealD>(nrm,x,x);
+}
+template<class Expr1,class Expr2>
+LatticeFusedInnerProduct<Expr1,Expr2,ComplexD> FusedInnerProduct(ComplexD &ip,const Expr1 &x,const Expr2 &y)
+{
+  return LatticeFusedInnerProduct<Expr1,Expr2,ComplexD>(ip,x,y);
+}
+
+//////////////////////////////////////////
+// Statement list helpers
+//////////////////////////////////////////
+template<class... Stmts> struct FusedReductions { static const int value = 0; };
+template<class S,class... Stmts> struct FusedReductions<S,Stmts...> {
+  static const int value = S::reductions + FusedReductions<Stmts...>::value;
+};
+
+inline FusedEnd fusedOpen(void) { return FusedEnd(); }
+template<class S,class... Stmts>
+auto fusedOpen(S &s,Stmts&... stmts) -> FusedList<decltype(s.Open()),decltype(fusedOpen(stmts...))>
+{
+  auto head = s.Open();
+  return FusedList<decltype(head),decltype(fusedOpen(stmts...))>{head,fusedOpen(stmts...)};
+}
+
+template<class S,class... Stmts>
+void fusedEval(S s0,Stmts... stmts)
+{
+  GRID_TRACE("FusedExpressionEval");
+  typedef typename S::vector_type vector_type;
+  const int Nred = FusedReductions<S,Stmts...>::value;
+  typedef iVector<vector_type,(Nred>0 ? Nred : 1)> red_t;
+
+  // Statement order fixes the reduction slots
+  GridBase *grid = nullptr;
+  int slot = 0;
+  s0.Prepare(grid,slot);
+  (void)std::initializer_list<int>{ (stmts.Prepare(grid,slot),0)... };
+  assert(grid!=nullptr);
+
+  const uint64_t sites = grid->oSites();
+  deviceVector<red_t> red_tmp(Nred ? sites : 0);
+  red_t *red_p = Nred ? &red_tmp[0] : nullptr;
+
+  auto kernel = fusedOpen(s0,stmts...);
+  accelerator_for(ss,sites,vector_type::Nsimd(),{
+    decltype(coalescedRead(red_p[0])) acc;
+    kernel.site(ss,acc);
+    if ( Nred ) coalescedWrite(red_p[ss],acc);
+  });
+  kernel.Close();
+
+  if ( Nred ) {
+    auto sum = sumD(red_p,sites);
+    std::vector<ComplexD> red(Nred);
+    for(int r=0;r<Nred;r++) red[r] = sum._internal[r];
+    grid->GlobalSumVector(&red[0],Nred);
+    s0.Result(red);
+    (void)std::initializer_list<int>{ (stmts.Result(red),0)... };
+  }
+}
+
+NAMESPACE_END(Grid);
@@ -371,14 +371,12 @@ axpby_norm_fast(Lattice<vobj> &z,sobj a,sobj b,const Lattice<vobj> &x,const Latt
   return nrm; 
 }
  
+// Rank local (left,right) and |left|^2 in one pass; caller reduces
 template<class vobj> strong_inline void
-innerProductNorm(ComplexD& ip, RealD &nrm, const Lattice<vobj> &left,const Lattice<vobj> &right)
+rankInnerProductNorm(ComplexD& ip, RealD &nrm, const Lattice<vobj> &left,const Lattice<vobj> &right)
 {
   conformable(left,right);
 
-  typedef typename vobj::vector_typeD vector_type;
-  Vector<ComplexD> tmp(2);
-
   GridBase *grid = left.Grid();
 
   const uint64_t nsimd = grid->Nsimd();
@@ -401,14 +399,90 @@ innerProductNorm(ComplexD& ip, RealD &nrm, const Lattice<vobj> &left,const Latti
       });
   }
 
-  tmp[0] = TensorRemove(sum(inner_tmp_v,sites));
-  tmp[1] = TensorRemove(sum(norm_tmp_v,sites));
+  ip  = TensorRemove(sum(inner_tmp_v,sites));
+  nrm = real(TensorRemove(sum(norm_tmp_v,sites)));
+}
+
+template<class vobj> strong_inline void
+innerProductNorm(ComplexD& ip, RealD &nrm, const Lattice<vobj> &left,const Lattice<vobj> &right)
+{
+  Vector<ComplexD> tmp(2);
+  GridBase *grid = left.Grid();
+
+  rankInnerProductNorm(ip,nrm,left,right);
+  tmp[0] = ip;
+  tmp[1] = nrm;
 
   grid->GlobalSumVector(&tmp[0],2); // keep norm Complex -> can use GlobalSumVector
   ip = tmp[0];
   nrm = real(tmp[1]);
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+// Non-blocking global reductions
+//
+//   auto ip = innerProductAsync(x,y);   // local sum, reduction issued
+//   Linop.HermOp(p,mmp);                 // overlapped work
+//   ComplexD c = ip.get();               // completes the reduction
+//
+// Copies share one reduction; get() may be called repeatedly.
+/////////////////////////////////////////////////////////////////////////////////
+template<class T>
+class ReductionFuture {
+private:
+  struct State {
+    GridBase      *grid;
+    T              value;   // reduced in place; address fixed while in flight
+    RealD          local;
+    CommsRequest_t req;
+    bool           done;
+  };
+  std::shared_ptr<State> state;
+public:
+  ReductionFuture() {};
+  ReductionFuture(GridBase *grid,const T &local)
+  {
+    state = std::make_shared<State>();
+    state->grid  = grid;
+    state->value = local;
+    state->local = real(local);
+    state->done  = false;
+    FlightRecorder::NormLog(state->local);
+    grid->GlobalSumVectorBegin(&state->value,1,state->req);
+  }
+  ~ReductionFuture() {
+    if ( state.use_count()==1 ) get(); // never leave MPI writing to freed memory
+  }
+  ReductionFuture(const ReductionFuture &) = default;
+  ReductionFuture &operator=(const ReductionFuture &rhs) {
+    if ( state.use_count()==1 ) get();
+    state = rhs.state;
+    return *this;
+  }
+  bool valid(void) const { return (bool)state; }
+  T get(void) {
+    assert(valid());
+    if ( !state->done ) {
+      state->grid->GlobalSumVectorComplete(state->req);
+      FlightRecorder::ReductionLog(state->local,real(state->value));
+      state->done = true;
+    }
+    return state->value;
+  }
+};
+
+template<class vobj>
+inline ReductionFuture<ComplexD> innerProductAsync(const Lattice<vobj> &left,const Lattice<vobj> &right)
+{
+  return ReductionFuture<ComplexD>(left.Grid(),rankInnerProduct(left,right));
+}
+
+template<class vobj>
+inline ReductionFuture<RealD> norm2Async(const Lattice<vobj> &arg)
+{
+  return ReductionFuture<RealD>(arg.Grid(),real(rankInnerProduct(arg,arg)));
+}
+
 template<class Op,class T1>
 inline auto sum(const LatticeUnaryExpression<Op,T1> & expr)
   ->typename decltype(expr.op.func(eval(0,expr.arg1)))::scalar_object
@@ -438,6 +512,57 @@ inline auto sum(const LatticeTrinaryExpression<Op,T1,T2,T3> & expr)
 // sliceSum, sliceInnerProduct, sliceAxpy, sliceNorm etc...
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Sum the simd lanes of the local slice sums lvSum[i*rd+r] of a batch, place them at their
+// global slice and sum over nodes with a single GlobalSumVector for the whole batch.
+// Returns result[i*fd+t] on every node.
+//////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj> inline void sliceSumLanesAndNodes(GridBase *grid,const Vector<vobj> &lvSum,int Nbatch,int orthogdim,
+						       std::vector<typename vobj::scalar_object> &result)
+{
+  typedef typename vobj::scalar_object sobj;
+  typedef typename vobj::scalar_object::scalar_type scalar_type;
+
+  const int    Nd = grid->_ndimension;
+  const int Nsimd = grid->Nsimd();
+
+  int fd=grid->_fdimensions[orthogdim];
+  int ld=grid->_ldimensions[orthogdim];
+  int rd=grid->_rdimensions[orthogdim];
+  int pc=grid->_processor_coor[orthogdim];
+
+  ExtractBuffer<sobj> extracted(Nsimd);                  // splitting the SIMD
+
+  result.resize(Nbatch*fd);
+  for(int t=0;t<Nbatch*fd;t++){
+    result[t]=Zero();
+  }
+
+  // Sum across simd lanes in the plane, breaking out orthog dir.
+  Coordinate icoor(Nd);
+  for(int i=0;i<Nbatch;i++){
+    for(int rt=0;rt<rd;rt++){
+
+      extract(lvSum[i*rd+rt],extracted);
+
+      for(int idx=0;idx<Nsimd;idx++){
+
+	grid->iCoorFromIindex(icoor,idx);
+
+	int ldx =rt+icoor[orthogdim]*rd;
+
+	result[i*fd+pc*ld+ldx]=result[i*fd+pc*ld+ldx]+extracted[idx];
+
+      }
+    }
+  }
+
+  // sum over nodes.
+  scalar_type * ptr = (scalar_type *) &result[0];
+  int words = Nbatch*fd*sizeof(sobj)/sizeof(scalar_type);
+  grid->GlobalSumVector(ptr, words);
+}
+
 template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<typename vobj::scalar_object> &result,int orthogdim)
 {
   ///////////////////////////////////////////////////////
@@ -445,8 +570,6 @@ template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<
   // may be important for correlation functions
   // But easily avoided by using double precision fields
   ///////////////////////////////////////////////////////
-  typedef typename vobj::scalar_object sobj;
-  typedef typename vobj::scalar_object::scalar_type scalar_type;
   GridBase  *grid = Data.Grid();
   assert(grid!=NULL);
 
@@ -456,15 +579,9 @@ template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<
   assert(orthogdim >= 0);
   assert(orthogdim < Nd);
 
-  int fd=grid->_fdimensions[orthogdim];
-  int ld=grid->_ldimensions[orthogdim];
   int rd=grid->_rdimensions[orthogdim];
 
   Vector<vobj> lvSum(rd); // will locally sum vectors first
-  Vector<sobj> lsSum(ld,Zero());                    // sum across these down to scalars
-  ExtractBuffer<sobj> extracted(Nsimd);                  // splitting the SIMD
-
-  result.resize(fd); // And then global sum to return the same vector to every node 
   for(int r=0;r<rd;r++){
     lvSum[r]=Zero();
   }
@@ -477,46 +594,122 @@ template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<
   //Reduce Data down to lvSum
   sliceSumReduction(Data,lvSum,rd, e1,e2,stride,ostride,Nsimd);
 
-  // Sum across simd lanes in the plane, breaking out orthog dir.
-  Coordinate icoor(Nd);
-
-  for(int rt=0;rt<rd;rt++){
-
-    extract(lvSum[rt],extracted);
+  // And then global sum to return the same vector to every node 
+  sliceSumLanesAndNodes(grid,lvSum,1,orthogdim,result);
+}
+template<class vobj> inline
+std::vector<typename vobj::scalar_object> 
+sliceSum(const Lattice<vobj> &Data,int orthogdim)
+{
+  std::vector<typename vobj::scalar_object> result;
+  sliceSum(Data,result,orthogdim);
+  return result;
+}
 
-    for(int idx=0;idx<Nsimd;idx++){
+//////////////////////////////////////////////////////////////////////////////////////////
+// Batched slice sums of several fields, in one pass over the lattice and one global sum
+//////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj> inline void sliceSum(const std::vector<Lattice<vobj> > &Data,
+					  std::vector<std::vector<typename vobj::scalar_object> > &result,int orthogdim)
+{
+  typedef typename vobj::scalar_object sobj;
+  int Nbatch = Data.size();
+  assert(Nbatch>0);
+  GridBase  *grid = Data[0].Grid();
+  for(int i=0;i<Nbatch;i++) conformable(grid,Data[i].Grid());
 
-      grid->iCoorFromIindex(icoor,idx);
+  assert(orthogdim >= 0);
+  assert(orthogdim < grid->_ndimension);
 
-      int ldx =rt+icoor[orthogdim]*rd;
+  int fd=grid->_fdimensions[orthogdim];
+  int rd=grid->_rdimensions[orthogdim];
+  int e1=    grid->_slice_nblock[orthogdim];
+  int e2=    grid->_slice_block [orthogdim];
+  int stride=grid->_slice_stride[orthogdim];
+  int ostride=grid->_ostride[orthogdim];
 
-      lsSum[ldx]=lsSum[ldx]+extracted[idx];
+  Vector<vobj> lvSum(Nbatch*rd);
+  for(int r=0;r<Nbatch*rd;r++){
+    lvSum[r]=Zero();
+  }
 
-    }
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
+  Vector<vobj> lv(rd);
+  for(int i=0;i<Nbatch;i++){
+    for(int r=0;r<rd;r++) lv[r]=Zero();
+    sliceSumReduction(Data[i],lv,rd,e1,e2,stride,ostride,grid->Nsimd());
+    for(int r=0;r<rd;r++) lvSum[i*rd+r]=lv[r];
   }
-  
-  // sum over nodes.
-  for(int t=0;t<fd;t++){
-    int pt = t/ld; // processor plane
-    int lt = t%ld;
-    if ( pt == grid->_processor_coor[orthogdim] ) {
-      result[t]=lsSum[lt];
-    } else {
-      result[t]=Zero();
-    }
+#else
+  typedef decltype(Data[0].View(CpuRead)) View;
+  std::vector<View> Data_v;
+  for(int i=0;i<Nbatch;i++) Data_v.push_back(Data[i].View(CpuRead));
+  sliceSumBatchReduction_cpu(lvSum,Nbatch,rd,e1,e2,stride,ostride,
+			     [&](int ss,int i) -> const vobj & { return Data_v[i][ss]; });
+  for(int i=0;i<Nbatch;i++) Data_v[i].ViewClose();
+#endif
 
+  std::vector<sobj> all;
+  sliceSumLanesAndNodes(grid,lvSum,Nbatch,orthogdim,all);
+  result.resize(Nbatch);
+  for(int i=0;i<Nbatch;i++){
+    result[i].assign(all.begin()+i*fd,all.begin()+(i+1)*fd);
   }
-  scalar_type * ptr = (scalar_type *) &result[0];
-  int words = fd*sizeof(sobj)/sizeof(scalar_type);
-  grid->GlobalSumVector(ptr, words);
 }
-template<class vobj> inline
-std::vector<typename vobj::scalar_object> 
-sliceSum(const Lattice<vobj> &Data,int orthogdim)
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Slice sums of one field times each of a batch of phases, e.g. momentum projection,
+// without forming the products as lattices
+//////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj,class pobj> inline void sliceSum(const Lattice<vobj> &Data,const std::vector<Lattice<pobj> > &phases,
+						     std::vector<std::vector<typename vobj::scalar_object> > &result,int orthogdim)
 {
-  std::vector<typename vobj::scalar_object> result;
-  sliceSum(Data,result,orthogdim);
-  return result;
+  typedef typename vobj::scalar_object sobj;
+  int Nbatch = phases.size();
+  assert(Nbatch>0);
+  GridBase  *grid = Data.Grid();
+  for(int i=0;i<Nbatch;i++) conformable(grid,phases[i].Grid());
+
+  assert(orthogdim >= 0);
+  assert(orthogdim < grid->_ndimension);
+
+  int fd=grid->_fdimensions[orthogdim];
+  int rd=grid->_rdimensions[orthogdim];
+  int e1=    grid->_slice_nblock[orthogdim];
+  int e2=    grid->_slice_block [orthogdim];
+  int stride=grid->_slice_stride[orthogdim];
+  int ostride=grid->_ostride[orthogdim];
+
+  Vector<vobj> lvSum(Nbatch*rd);
+  for(int r=0;r<Nbatch*rd;r++){
+    lvSum[r]=Zero();
+  }
+
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
+  Vector<vobj> lv(rd);
+  Lattice<vobj> tmp(grid);
+  for(int i=0;i<Nbatch;i++){
+    tmp = Data*phases[i];
+    for(int r=0;r<rd;r++) lv[r]=Zero();
+    sliceSumReduction(tmp,lv,rd,e1,e2,stride,ostride,grid->Nsimd());
+    for(int r=0;r<rd;r++) lvSum[i*rd+r]=lv[r];
+  }
+#else
+  typedef decltype(phases[0].View(CpuRead)) View;
+  std::vector<View> phase_v;
+  for(int i=0;i<Nbatch;i++) phase_v.push_back(phases[i].View(CpuRead));
+  autoView( Data_v, Data, CpuRead);
+  sliceSumBatchReduction_cpu(lvSum,Nbatch,rd,e1,e2,stride,ostride,
+			     [&](int ss,int i) { vobj v = Data_v[ss]*phase_v[i][ss]; return v; });
+  for(int i=0;i<Nbatch;i++) phase_v[i].ViewClose();
+#endif
+
+  std::vector<sobj> all;
+  sliceSumLanesAndNodes(grid,lvSum,Nbatch,orthogdim,all);
+  result.resize(Nbatch);
+  for(int i=0;i<Nbatch;i++){
+    result[i].assign(all.begin()+i*fd,all.begin()+(i+1)*fd);
+  }
 }
 
 /*
@@ -536,27 +729,21 @@ static void sliceInnerProductMatrix(  Eigen::MatrixXcd &mat, const Lattice<vobj>
 template<class vobj>
 static void sliceInnerProductVector( std::vector<ComplexD> & result, const Lattice<vobj> &lhs,const Lattice<vobj> &rhs,int orthogdim) 
 {
-  typedef typename vobj::vector_type   vector_type;
-  typedef typename vobj::scalar_type   scalar_type;
+  typedef decltype(innerProduct(vobj(),vobj())) inner_t;
+  typedef typename inner_t::scalar_object inner_s;
   GridBase  *grid = lhs.Grid();
   assert(grid!=NULL);
   conformable(grid,rhs.Grid());
 
   const int    Nd = grid->_ndimension;
-  const int Nsimd = grid->Nsimd();
 
   assert(orthogdim >= 0);
   assert(orthogdim < Nd);
 
   int fd=grid->_fdimensions[orthogdim];
-  int ld=grid->_ldimensions[orthogdim];
   int rd=grid->_rdimensions[orthogdim];
 
-  Vector<vector_type> lvSum(rd); // will locally sum vectors first
-  Vector<scalar_type > lsSum(ld,scalar_type(0.0));                    // sum across these down to scalars
-  ExtractBuffer<iScalar<scalar_type> > extracted(Nsimd);   // splitting the SIMD  
-
-  result.resize(fd); // And then global sum to return the same vector to every node for IO to file
+  Vector<inner_t> lvSum(rd); // will locally sum vectors first
   for(int r=0;r<rd;r++){
     lvSum[r]=Zero();
   }
@@ -564,57 +751,76 @@ static void sliceInnerProductVector( std::vector<ComplexD> & result, const Latti
   int e1=    grid->_slice_nblock[orthogdim];
   int e2=    grid->_slice_block [orthogdim];
   int stride=grid->_slice_stride[orthogdim];
+  int ostride=grid->_ostride[orthogdim];
 
   autoView( lhv, lhs, CpuRead);
   autoView( rhv, rhs, CpuRead);
-  thread_for( r,rd,{
-
-    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
-
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
-	int ss= so+n*stride+b;
-	vector_type vv = TensorRemove(innerProduct(lhv[ss],rhv[ss]));
-	lvSum[r]=lvSum[r]+vv;
-      }
-    }
-  });
-
-  // Sum across simd lanes in the plane, breaking out orthog dir.
-  Coordinate icoor(Nd);
-  for(int rt=0;rt<rd;rt++){
+  sliceSumBatchReduction_cpu(lvSum,1,rd,e1,e2,stride,ostride,
+			     [&](int ss,int i) { return innerProduct(lhv[ss],rhv[ss]); });
 
-    iScalar<vector_type> temp; 
-    temp._internal = lvSum[rt];
-    extract(temp,extracted);
-
-    for(int idx=0;idx<Nsimd;idx++){
+  // Sum across simd lanes and nodes, return the same vector to every node for IO to file
+  std::vector<inner_s> gsum;
+  sliceSumLanesAndNodes(grid,lvSum,1,orthogdim,gsum);
+  result.resize(fd);
+  for(int t=0;t<fd;t++){
+    result[t]=TensorRemove(gsum[t]);
+  }
+}
 
-      grid->iCoorFromIindex(icoor,idx);
+// Batched slice inner products <lhs[i]|rhs[i]>, in one pass and one global sum
+template<class vobj>
+static void sliceInnerProductVector( std::vector<std::vector<ComplexD> > & result, const std::vector<Lattice<vobj> > &lhs,const std::vector<Lattice<vobj> > &rhs,int orthogdim) 
+{
+  typedef decltype(innerProduct(vobj(),vobj())) inner_t;
+  typedef typename inner_t::scalar_object inner_s;
+  int Nbatch = lhs.size();
+  assert(Nbatch>0);
+  assert(rhs.size()==Nbatch);
+  GridBase  *grid = lhs[0].Grid();
+  for(int i=0;i<Nbatch;i++){
+    conformable(grid,lhs[i].Grid());
+    conformable(grid,rhs[i].Grid());
+  }
 
-      int ldx =rt+icoor[orthogdim]*rd;
+  assert(orthogdim >= 0);
+  assert(orthogdim < grid->_ndimension);
 
-      lsSum[ldx]=lsSum[ldx]+extracted[idx]._internal;
+  int fd=grid->_fdimensions[orthogdim];
+  int rd=grid->_rdimensions[orthogdim];
+  int e1=    grid->_slice_nblock[orthogdim];
+  int e2=    grid->_slice_block [orthogdim];
+  int stride=grid->_slice_stride[orthogdim];
+  int ostride=grid->_ostride[orthogdim];
 
-    }
+  Vector<inner_t> lvSum(Nbatch*rd);
+  for(int r=0;r<Nbatch*rd;r++){
+    lvSum[r]=Zero();
   }
-  
-  // sum over nodes.
-  scalar_type gsum;
-  for(int t=0;t<fd;t++){
-    int pt = t/ld; // processor plane
-    int lt = t%ld;
-    if ( pt == grid->_processor_coor[orthogdim] ) {
-      gsum=lsSum[lt];
-    } else {
-      gsum=scalar_type(0.0);
-    }
 
-    grid->GlobalSum(gsum);
+  typedef decltype(lhs[0].View(CpuRead)) View;
+  std::vector<View> lhv, rhv;
+  for(int i=0;i<Nbatch;i++){
+    lhv.push_back(lhs[i].View(CpuRead));
+    rhv.push_back(rhs[i].View(CpuRead));
+  }
+  sliceSumBatchReduction_cpu(lvSum,Nbatch,rd,e1,e2,stride,ostride,
+			     [&](int ss,int i) { return innerProduct(lhv[i][ss],rhv[i][ss]); });
+  for(int i=0;i<Nbatch;i++){
+    lhv[i].ViewClose();
+    rhv[i].ViewClose();
+  }
 
-    result[t]=gsum;
+  std::vector<inner_s> gsum;
+  sliceSumLanesAndNodes(grid,lvSum,Nbatch,orthogdim,gsum);
+  result.resize(Nbatch);
+  for(int i=0;i<Nbatch;i++){
+    result[i].resize(fd);
+    for(int t=0;t<fd;t++){
+      result[i][t]=TensorRemove(gsum[i*fd+t]);
+    }
   }
 }
+
 template<class vobj>
 static void sliceNorm (std::vector<RealD> &sn,const Lattice<vobj> &rhs,int Orthog) 
 {
@@ -632,6 +838,20 @@ static void sliceNorm (std::vector<RealD> &sn,const Lattice<vobj> &rhs,int Ortho
   }
 };
 
+template<class vobj>
+static void sliceNorm (std::vector<std::vector<RealD> > &sn,const std::vector<Lattice<vobj> > &rhs,int Orthog) 
+{
+  std::vector<std::vector<ComplexD> > ip;
+  sliceInnerProductVector(ip,rhs,rhs,Orthog);
+  sn.resize(ip.size());
+  for(int i=0;i<ip.size();i++){
+    sn[i].resize(ip[i].size());
+    for(int ss=0;ss<ip[i].size();ss++){
+      sn[i][ss] = real(ip[i][ss]);
+    }
+  }
+};
+
 
 template<class vobj>
 static void sliceMaddVector(Lattice<vobj> &R,std::vector<RealD> &a,const Lattice<vobj> &X,const Lattice<vobj> &Y,
@@ -120,6 +120,78 @@ void fillScalar(ComplexD &s,distribution &dist,generator &gen)
   s.imag(dist(gen));
 }
   
+//////////////////////////////////////////////////////////////
+// Counter based generator (Philox4x32-10, Salmon et al SC11).
+// Stateless: output is a pure function of (counter,key), so a
+// lattice can be filled with one counter per global site and no
+// per-site engine state.
+//////////////////////////////////////////////////////////////
+accelerator_inline void philox4x32(uint32_t ctr[4],uint32_t k0,uint32_t k1)
+{
+  const uint32_t M0=0xD2511F53, M1=0xCD9E8D57;
+  const uint32_t W0=0x9E3779B9, W1=0xBB67AE85;
+  for(int r=0;r<10;r++){
+    uint64_t p0 = (uint64_t)M0*ctr[0];
+    uint64_t p1 = (uint64_t)M1*ctr[2];
+    uint32_t c0 = (uint32_t)(p1>>32)^ctr[1]^k0;
+    uint32_t c2 = (uint32_t)(p0>>32)^ctr[3]^k1;
+    ctr[0]=c0;  ctr[1]=(uint32_t)p1;
+    ctr[2]=c2;  ctr[3]=(uint32_t)p0;
+    k0+=W0; k1+=W1;
+  }
+}
+
+// Two doubles in [0,1) from one Philox block
+accelerator_inline void philoxU01(uint64_t site,uint32_t draw,uint32_t stream,
+				  uint32_t k0,uint32_t k1,RealD &u0,RealD &u1)
+{
+  uint32_t ctr[4] = { (uint32_t)site, (uint32_t)(site>>32), draw, stream };
+  philox4x32(ctr,k0,k1);
+  const RealD twom53 = 1.0/9007199254740992.0;
+  u0 = (RealD)(((((uint64_t)ctr[1])<<32)|ctr[0])>>11)*twom53;
+  u1 = (RealD)(((((uint64_t)ctr[3])<<32)|ctr[2])>>11)*twom53;
+}
+
+//////////////////////////////////////////////////////////////
+// Map pairs of uniforms onto the distributions GridParallelRNG
+// carries, taking the parameters from the std:: object.
+//////////////////////////////////////////////////////////////
+template<class distribution> class CounterDistribution;
+
+template<> class CounterDistribution<std::uniform_real_distribution<RealD> > {
+public:
+  RealD a,w;
+  CounterDistribution(std::uniform_real_distribution<RealD> &d) : a(d.a()), w(d.b()-d.a()) {};
+  void operator()(RealD u0,RealD u1,RealD &v0,RealD &v1) const { v0=a+w*u0; v1=a+w*u1; }
+};
+template<> class CounterDistribution<std::normal_distribution<RealD> > {
+public:
+  RealD mean,sigma;
+  CounterDistribution(std::normal_distribution<RealD> &d) : mean(d.mean()), sigma(d.stddev()) {};
+  void operator()(RealD u0,RealD u1,RealD &v0,RealD &v1) const {
+    // Box-Muller; 1-u0 is in (0,1]
+    RealD r  = sigma*std::sqrt(-2.0*std::log(1.0-u0));
+    RealD th = 2.0*M_PI*u1;
+    v0 = mean + r*std::cos(th);
+    v1 = mean + r*std::sin(th);
+  }
+};
+template<> class CounterDistribution<std::discrete_distribution<int32_t> > {
+public:
+  std::vector<double> cumulative;
+  CounterDistribution(std::discrete_distribution<int32_t> &d) {
+    std::vector<double> p = d.probabilities();
+    cumulative.resize(p.size());
+    double c=0.0;
+    for(int i=0;i<p.size();i++) { c+=p[i]; cumulative[i]=c; }
+  };
+  RealD pick(RealD u) const {
+    for(int i=0;i<cumulative.size()-1;i++) if ( u < cumulative[i] ) return i;
+    return cumulative.size()-1;
+  }
+  void operator()(RealD u0,RealD u1,RealD &v0,RealD &v1) const { v0=pick(u0); v1=pick(u1); }
+};
+
 class GridRNGbase {
 public:
   // One generator per site.
@@ -349,22 +421,50 @@ private:
   GridBase *_grid;
   unsigned int _vol;
 
+  //////////////////////////////////////////////////////////////
+  // Counter based mode: the key and the number of fills so far are
+  // the entire state. Draws depend only on the global site index,
+  // so they do not change with the MPI or SIMD decomposition.
+  //////////////////////////////////////////////////////////////
+  int      _counter_based;
+  uint32_t _key[2];
+  uint64_t _counter;
+
 public:
+  static int CounterBased; // Default for new generators; --rng-counter
+
   GridBase *Grid(void) const { return _grid; }
   int generator_idx(int os,int is) {
     return is*_grid->oSites()+os;
   }
 
-  GridParallelRNG(GridBase *grid) : GridRNGbase() {
+  GridParallelRNG(GridBase *grid,int counter_based=CounterBased) : GridRNGbase() {
     _grid = grid;
     _vol  =_grid->iSites()*_grid->oSites();
+    _time_counter = 0.0;
+    _counter_based= counter_based;
+    _key[0]=_key[1]=0;
+    _counter=0;
+
+    // Distributions only carry parameters in counter mode
+    int nstate = _counter_based ? 1 : _vol;
+    _generators.resize(_counter_based ? 0 : _vol);
+    _uniform.resize(nstate,std::uniform_real_distribution<RealD>{0,1});
+    _gaussian.resize(nstate,std::normal_distribution<RealD>(0.0,1.0) );
+    _bernoulli.resize(nstate,std::discrete_distribution<int32_t>{1,1});
+    _uid.resize(nstate,std::uniform_int_distribution<uint32_t>() );
+  }
 
-    _generators.resize(_vol);
-    _uniform.resize(_vol,std::uniform_real_distribution<RealD>{0,1});
-    _gaussian.resize(_vol,std::normal_distribution<RealD>(0.0,1.0) );
-    _bernoulli.resize(_vol,std::discrete_distribution<int32_t>{1,1});
-    _uid.resize(_vol,std::uniform_int_distribution<uint32_t>() );
+  int  IsCounterBased(void) const { return _counter_based; }
+  void GetCounterState(uint32_t &k0,uint32_t &k1,uint64_t &counter) const {
+    assert(_counter_based);
+    k0=_key[0]; k1=_key[1]; counter=_counter;
+  }
+  void SetCounterState(uint32_t k0,uint32_t k1,uint64_t counter) {
+    assert(_counter_based);
+    _key[0]=k0; _key[1]=k1; _counter=counter;
   }
+
   template <class vobj,class distribution> inline void fill(Lattice<vobj> &l,std::vector<distribution> &dist)
   {
     if ( l.Grid()->_isCheckerBoarded ) {
@@ -373,6 +473,10 @@ public:
       pickCheckerboard(l.Checkerboard(),l,tmp);
       return;
     }
+    if ( _counter_based ) {
+      fillCounter(l,dist);
+      return;
+    }
     typedef typename vobj::scalar_object scalar_object;
     typedef typename vobj::scalar_type scalar_type;
     typedef typename vobj::vector_type vector_type;
@@ -408,6 +512,64 @@ public:
     _time_counter += usecond()- inner_time_counter;
   }
 
+  //////////////////////////////////////////////////////////////
+  // Writes each SIMD lane straight into the vobj layout; the counter
+  // is (global site, draw within site, fill number) under the key.
+  //////////////////////////////////////////////////////////////
+  template <class vobj,class distribution> inline void fillCounter(Lattice<vobj> &l,std::vector<distribution> &dist)
+  {
+    typedef typename vobj::scalar_object scalar_object;
+    typedef typename vobj::scalar_type scalar_type;
+    typedef typename vobj::vector_type vector_type;
+    typedef typename RealPart<scalar_type>::type Real;
+
+    double inner_time_counter = usecond();
+
+    int multiplicity = RNGfillable_general(_grid, l.Grid());
+    int Nsimd  = _grid->Nsimd();
+    int osites = _grid->oSites();
+    int vNsimd = vector_type::Nsimd();  // real vectors on complex grids duplicate lanes
+    int lanes  = vNsimd/Nsimd;
+    int cplx   = sizeof(scalar_type)/sizeof(Real);
+    int nreal  = sizeof(scalar_object)/sizeof(Real);
+    int nblock = (nreal+1)/2;
+    int rank   = _grid->ThisRank();
+
+    assert(_counter < (1ULL<<32));
+    uint32_t stream = (uint32_t)_counter;
+    uint32_t k0=_key[0];
+    uint32_t k1=_key[1];
+    CounterDistribution<distribution> cdist(dist[0]);
+
+    autoView(l_v, l, CpuWrite);
+    thread_for( ss, osites, {
+      Coordinate gcoor;
+      for (int si = 0; si < Nsimd; si++) {
+	int64_t gidx;
+	_grid->RankIndexToGlobalCoor(rank,ss,si,gcoor);
+	_grid->GlobalCoorToGlobalIndex(gcoor,gidx);
+	for (int m = 0; m < multiplicity; m++) {
+	  int sm = multiplicity * ss + m;
+	  Real *pointer = (Real *)&l_v[sm];
+	  for (int b = 0; b < nblock; b++) {
+	    RealD u0,u1,v0,v1;
+	    philoxU01(gidx,m*nblock+b,stream,k0,k1,u0,u1);
+	    cdist(u0,u1,v0,v1);
+	    for(int l=0;l<lanes;l++){
+	      int r = 2*b;
+	      int lane = si*lanes+l;
+	      pointer[((r/cplx)*vNsimd+lane)*cplx+r%cplx] = v0; r++;
+	      if ( r<nreal ) pointer[((r/cplx)*vNsimd+lane)*cplx+r%cplx] = v1;
+	    }
+	  }
+	}
+      }
+    });
+    _counter++;
+
+    _time_counter += usecond()- inner_time_counter;
+  }
+
     void SeedUniqueString(const std::string &s){
       std::vector<int> seeds;
       seeds = GridChecksum::sha256_seeds(s);
@@ -423,6 +585,15 @@ public:
 
     std::seed_seq source(seeds.begin(),seeds.end());
 
+    if ( _counter_based ) {
+      std::vector<uint32_t> key(2);
+      source.generate(key.begin(),key.end());
+      _key[0]=key[0];
+      _key[1]=key[1];
+      _counter=0;
+      return;
+    }
+
     RngEngine master_engine(source);
 
 #ifdef RNG_FAST_DISCARD
@@ -518,6 +689,12 @@ public:
 
     // draw
     int l_idx=generator_idx(o_idx,i_idx);
+    if ( _counter_based ) {
+      uint32_t ctr[4] = { (uint32_t)gsite, 0, 0, (uint32_t)_counter };
+      philox4x32(ctr,_key[0],_key[1]);
+      _counter++;
+      return ctr[0];
+    }
     if( rank == _grid->ThisRank() ){
       the_number = _uid[l_idx](_generators[l_idx]);
     }
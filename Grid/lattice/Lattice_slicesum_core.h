@@ -192,22 +192,55 @@ template<class vobj> inline void sliceSumReduction_gpu(const Lattice<vobj> &Data
 }
 
 
-template<class vobj> inline void sliceSumReduction_cpu(const Lattice<vobj> &Data, Vector<vobj> &lvSum, const int &rd, const int &e1, const int &e2, const int &stride, const int &ostride, const int &Nsimd)
+//////////////////////////////////////////////////////////////////////////////////////////
+// CPU slice reduction threaded over all sites rather than over the rd slices, so short
+// local orthogonal extents still occupy every core. Each thread walks a contiguous
+// range of the (slice, site in slice) index space and accumulates into private slice
+// sums, which are then added over threads.
+//
+// A batch of Nbatch reductions is made in the same pass: op(ss,i) returns the term of
+// batch member i at outer site ss, and is accumulated into lvSum[i*rd+r].
+//////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj,class SiteOp> inline void sliceSumBatchReduction_cpu(Vector<vobj> &lvSum, const int Nbatch, const int rd, const int e1, const int e2, const int stride, const int ostride, SiteOp op)
 {
-  // sum over reduced dimension planes, breaking out orthog dir
-  // Parallel over orthog direction
-  autoView( Data_v, Data, CpuRead);
-  thread_for( r,rd, {
-    int so=r*ostride; // base offset for start of plane 
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
-        int ss= so+n*stride+b;
-        lvSum[r]=lvSum[r]+Data_v[ss];
+  const int nthread = GridThread::GetThreads();
+  const int nslice  = e1*e2;
+  const int nwork   = rd*nslice;
+  const int nsum    = Nbatch*rd;
+  assert(lvSum.size()==nsum);
+
+  Vector<vobj> thrSum(nthread*nsum);
+  thread_for(thr,nthread, {
+    int mywork, myoff;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    vobj *acc = &thrSum[thr*nsum];
+    for(int i=0;i<nsum;i++) acc[i]=Zero();
+    int r = myoff/nslice;
+    int n = (myoff%nslice)/e2;
+    int b = myoff%e2;
+    for(int w=0;w<mywork;w++){
+      int ss= r*ostride+n*stride+b;
+      for(int i=0;i<Nbatch;i++){
+	acc[i*rd+r] = acc[i*rd+r] + op(ss,i);
       }
+      if ( ++b == e2 ) { b=0; if ( ++n == e1 ) { n=0; r++; } }
+    }
+  });
+  thread_for(i,nsum, {
+    vobj vsum = lvSum[i];
+    for(int thr=0;thr<nthread;thr++){
+      vsum = vsum + thrSum[thr*nsum+i];
     }
+    lvSum[i] = vsum;
   });
 }
 
+template<class vobj> inline void sliceSumReduction_cpu(const Lattice<vobj> &Data, Vector<vobj> &lvSum, const int &rd, const int &e1, const int &e2, const int &stride, const int &ostride, const int &Nsimd)
+{
+  autoView( Data_v, Data, CpuRead);
+  sliceSumBatchReduction_cpu(lvSum,1,rd,e1,e2,stride,ostride,[&](int ss,int i) -> const vobj & { return Data_v[ss]; });
+}
+
 template<class vobj> inline void sliceSumReduction(const Lattice<vobj> &Data, Vector<vobj> &lvSum, const int &rd, const int &e1, const int &e2, const int &stride, const int &ostride, const int &Nsimd) 
 {
   #if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
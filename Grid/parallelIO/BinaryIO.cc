@@ -2,3 +2,7 @@
 
 int                    Grid::BinaryIO::latticeWriteMaxRetry = -1;
 Grid::BinaryIO::IoPerf Grid::BinaryIO::lastPerf;
+uint64_t               Grid::BinaryIO::ioChunkBytes = 32*1024*1024;
+int                    Grid::BinaryIO::writeBehind = 0;
+std::thread            Grid::BinaryIO::writeBehindThread;
+std::string            Grid::BinaryIO::writeBehindError;
@@ -42,6 +42,10 @@
 
 #include <arpa/inet.h>
 #include <algorithm>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 NAMESPACE_BEGIN(Grid);
 
@@ -94,6 +98,10 @@ class BinaryIO {
 
   static IoPerf lastPerf;
   static int latticeWriteMaxRetry;
+  static uint64_t ioChunkBytes;          // Streaming chunk; 0 selects the unfused whole-buffer passes
+  static int writeBehind;                // Lattice writes drain to disk in a background thread
+  static std::thread writeBehindThread;
+  static std::string writeBehindError;   // Set by the drain thread, reported by WriteBehindComplete
 
   /////////////////////////////////////////////////////////////////////////////
   // more byte manipulation helpers
@@ -255,6 +263,115 @@ class BinaryIO {
       fp[i] = Grid_ntohll(g);
     });
   }
+  /////////////////////////////////////////////////////////////////////////////
+  // Streaming pass: byte order conversion fused with both checksums, one site
+  // at a time over sites [begin,end). Reading, the SciDAC crc is taken on the
+  // file bytes and the NERSC sum on host words; writing, the reverse.  Sum and
+  // xor are order independent so any chunking gives the whole-buffer result.
+  // An optional per-site operation (e.g. munge) runs first in the same pass.
+  /////////////////////////////////////////////////////////////////////////////
+  static const int BINARYIO_IEEE32BIG = 0;
+  static const int BINARYIO_IEEE32    = 1;
+  static const int BINARYIO_IEEE64BIG = 2;
+  static const int BINARYIO_IEEE64    = 3;
+
+  static inline int ByteOrder(const std::string &format)
+  {
+    if ( format == std::string("IEEE32BIG") ) return BINARYIO_IEEE32BIG;
+    if ( format == std::string("IEEE32") )    return BINARYIO_IEEE32;
+    if ( format == std::string("IEEE64BIG") ) return BINARYIO_IEEE64BIG;
+    if ( format == std::string("IEEE64") || format == std::string("IEEE64LITTLE") ) return BINARYIO_IEEE64;
+    assert(0);
+    return -1;
+  }
+  static inline void SwapSite(void *site,uint64_t bytes,int order)
+  {
+    if ( order==BINARYIO_IEEE32BIG || order==BINARYIO_IEEE32 ) {
+      uint32_t *f = (uint32_t *)site;
+      for(uint64_t i=0;i<bytes/sizeof(uint32_t);i++){
+	if ( order==BINARYIO_IEEE32 ) f[i] = ntohl(byte_reverse32(f[i]));
+	else                          f[i] = ntohl(f[i]);
+      }
+    } else {
+      uint64_t *f = (uint64_t *)site;
+      for(uint64_t i=0;i<bytes/sizeof(uint64_t);i++){
+	if ( order==BINARYIO_IEEE64 ) f[i] = Grid_ntohll(byte_reverse64(f[i]));
+	else                          f[i] = Grid_ntohll(f[i]);
+      }
+    }
+  }
+  template<class fobj,class SiteOp>
+  static inline void StreamChecksumSwap(GridBase *grid,fobj *fbuf,uint64_t begin,uint64_t end,
+					int order,int control,
+					uint32_t &nersc_csum,uint32_t &scidac_csuma,uint32_t &scidac_csumb,
+					SiteOp op)
+  {
+    const uint64_t size32 = sizeof(fobj) / sizeof(uint32_t);
+    int nd = grid->_ndimension;
+    Coordinate local_vol   =grid->LocalDimensions();
+    Coordinate local_start =grid->LocalStarts();
+    Coordinate global_vol  =grid->FullDimensions();
+    uint64_t nsite = end-begin;
+
+    thread_region
+    {
+      Coordinate coor(nd);
+      uint32_t nersc_csum_thr=0;
+      uint32_t scidac_csuma_thr=0;
+      uint32_t scidac_csumb_thr=0;
+
+      thread_for_in_region( ss, nsite,
+      {
+	uint64_t local_site = begin+ss;
+	uint32_t *site_buf = (uint32_t *)&fbuf[local_site];
+
+	op(local_site);
+
+	if ( control & BINARYIO_WRITE ) {
+	  for (uint64_t j = 0; j < size32; j++) nersc_csum_thr += site_buf[j];
+	  SwapSite(site_buf,sizeof(fobj),order);
+	}
+
+	int64_t global_site;
+	Lexicographic::CoorFromIndex(coor,local_site,local_vol);
+	for(int d=0;d<nd;d++) coor[d] = coor[d]+local_start[d];
+	Lexicographic::IndexFromCoor(coor,global_site,global_vol);
+	uint64_t gsite29 = global_site%29;
+	uint64_t gsite31 = global_site%31;
+	uint32_t site_crc = crc32(0,(unsigned char *)site_buf,sizeof(fobj));
+	scidac_csuma_thr ^= site_crc<<gsite29 | site_crc>>(32-gsite29);
+	scidac_csumb_thr ^= site_crc<<gsite31 | site_crc>>(32-gsite31);
+
+	if ( control & BINARYIO_READ ) {
+	  SwapSite(site_buf,sizeof(fobj),order);
+	  for (uint64_t j = 0; j < size32; j++) nersc_csum_thr += site_buf[j];
+	}
+      });
+
+      thread_critical
+      {
+	nersc_csum  += nersc_csum_thr;
+	scidac_csuma^= scidac_csuma_thr;
+	scidac_csumb^= scidac_csumb_thr;
+      }
+    }
+  }
+  template<class fobj>
+  static inline void StreamChecksumSwap(GridBase *grid,fobj *fbuf,uint64_t begin,uint64_t end,
+					int order,int control,
+					uint32_t &nersc_csum,uint32_t &scidac_csuma,uint32_t &scidac_csumb)
+  {
+    StreamChecksumSwap(grid,fbuf,begin,end,order,control,nersc_csum,scidac_csuma,scidac_csumb,
+		       [](uint64_t site){});
+  }
+  static inline uint64_t ChunkSites(uint64_t objbytes,uint64_t nsite)
+  {
+    uint64_t chunk = ioChunkBytes/objbytes;
+    if ( chunk < 1 ) chunk = 1;
+    if ( chunk > nsite ) chunk = nsite;
+    return chunk;
+  }
+
   /////////////////////////////////////////////////////////////////////////////
   // Real action:
   // Read or Write distributed lexico array of ANY object to a specific location in file 
@@ -358,6 +475,9 @@ class BinaryIO {
     int ieee64    = (format == std::string("IEEE64") || format == std::string("IEEE64LITTLE"));
     assert(ieee64||ieee32|ieee64big||ieee32big);
     assert((ieee64+ieee32+ieee64big+ieee32big)==1);
+    int order    = ByteOrder(format);
+    int streamed = (ioChunkBytes > 0);
+    int inflight = 0;
     //////////////////////////////////////////////////////////////////////////////
     // Do the I/O
     //////////////////////////////////////////////////////////////////////////////
@@ -459,33 +579,78 @@ class BinaryIO {
         {
           fin.seekg(offset + myrank * lsites * sizeof(fobj));
         }
-        fin.read((char *)&iodata[0], iodata.size() * sizeof(fobj));
-        assert(fin.fail() == 0);
+	if ( streamed ) {
+	  ////////////////////////////////////////////////////////////////////
+	  // Double buffered: chunk c+1 is read while chunk c is swapped and
+	  // checksummed in flight.
+	  ////////////////////////////////////////////////////////////////////
+	  uint64_t nsite = iodata.size();
+	  uint64_t chunk = ChunkSites(sizeof(fobj),nsite);
+	  uint64_t nchunk= (nsite+chunk-1)/chunk;
+	  int ok = 1;
+	  auto reader = [&](uint64_t c) {
+	    uint64_t b = c*chunk;
+	    uint64_t e = std::min(nsite,b+chunk);
+	    fin.read((char *)&iodata[b], (e-b)*sizeof(fobj));
+	    if ( fin.fail() ) ok = 0;
+	  };
+	  reader(0);
+	  for(uint64_t c=0;c<nchunk;c++){
+	    std::thread prefetch;
+	    if ( c+1 < nchunk ) prefetch = std::thread(reader,c+1);
+	    bstimer.Start();
+	    uint64_t b = c*chunk;
+	    StreamChecksumSwap(grid,&iodata[0],b,std::min(nsite,b+chunk),order,BINARYIO_READ,
+			       nersc_csum,scidac_csuma,scidac_csumb);
+	    bstimer.Stop();
+	    if ( prefetch.joinable() ) prefetch.join();
+	  }
+	  assert(ok);
+	  inflight = 1;
+	} else {
+	  fin.read((char *)&iodata[0], iodata.size() * sizeof(fobj));
+	  assert(fin.fail() == 0);
+	}
         fin.close();
       }
       timer.Stop();
 
       grid->Barrier();
 
-      bstimer.Start();
-      ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
-      if (ieee32big) be32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee32)    le32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64big) be64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64)    le64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      NerscChecksum(grid,iodata,nersc_csum);
-      bstimer.Stop();
+      if ( !inflight ) {
+	bstimer.Start();
+	if ( streamed ) {
+	  StreamChecksumSwap(grid,&iodata[0],0,iodata.size(),order,BINARYIO_READ,
+			     nersc_csum,scidac_csuma,scidac_csumb);
+	} else {
+	  ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
+	  if (ieee32big) be32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+	  if (ieee32)    le32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+	  if (ieee64big) be64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+	  if (ieee64)    le64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+	  NerscChecksum(grid,iodata,nersc_csum);
+	}
+	bstimer.Stop();
+      }
     }
     
     if ( control & BINARYIO_WRITE ) { 
 
+      // C++ path swaps and checksums each chunk just before it is written
+      inflight = streamed && !( (control & BINARYIO_LEXICOGRAPHIC) && (nrank > 1) );
+
       bstimer.Start();
-      NerscChecksum(grid,iodata,nersc_csum);
-      if (ieee32big) htobe32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee32)    htole32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64big) htobe64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64)    htole64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
+      if ( streamed && !inflight ) {
+	StreamChecksumSwap(grid,&iodata[0],0,iodata.size(),order,BINARYIO_WRITE,
+			   nersc_csum,scidac_csuma,scidac_csumb);
+      } else if ( !streamed ) {
+	NerscChecksum(grid,iodata,nersc_csum);
+	if (ieee32big) htobe32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+	if (ieee32)    htole32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+	if (ieee64big) htobe64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+	if (ieee64)    htole64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+	ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
+      }
       bstimer.Stop();
 
       grid->Barrier();
@@ -640,12 +805,39 @@ class BinaryIO {
 	  }
 	}
 
-	try {
-	  fout.write((char *)&iodata[0],iodata.size()*sizeof(fobj));//assert( fout.fail()==0);
+	std::string failure;
+	auto writer = [&](uint64_t b,uint64_t e) {
+	  try {
+	    fout.write((char *)&iodata[b],(e-b)*sizeof(fobj));//assert( fout.fail()==0);
+	  }
+	  catch (const std::fstream::failure& exc) {
+	    failure = exc.what();
+	  }
+	};
+	if ( inflight ) {
+	  ////////////////////////////////////////////////////////////////////
+	  // Double buffered: chunk c is written while chunk c+1 is checksummed
+	  // and swapped to file order.
+	  ////////////////////////////////////////////////////////////////////
+	  uint64_t nsite = iodata.size();
+	  uint64_t chunk = ChunkSites(sizeof(fobj),nsite);
+	  std::thread drain;
+	  for(uint64_t b=0;b<nsite;b+=chunk){
+	    uint64_t e = std::min(nsite,b+chunk);
+	    bstimer.Start();
+	    StreamChecksumSwap(grid,&iodata[0],b,e,order,BINARYIO_WRITE,
+			       nersc_csum,scidac_csuma,scidac_csumb);
+	    bstimer.Stop();
+	    if ( drain.joinable() ) drain.join();
+	    drain = std::thread(writer,b,e);
+	  }
+	  if ( drain.joinable() ) drain.join();
+	} else {
+	  writer(0,iodata.size());
 	}
-	catch (const std::fstream::failure& exc) {
+	if ( failure.size() ) {
 	  std::cout << "Exception in writing file " << file << std::endl;
-	  std::cout << GridLogError << "Exception description: "<< exc.what() << std::endl;
+	  std::cout << GridLogError << "Exception description: "<< failure << std::endl;
 #ifdef USE_MPI_IO
 	  MPI_Abort(MPI_COMM_WORLD,1);
 #else
@@ -707,6 +899,7 @@ class BinaryIO {
     std::vector<sobj> scalardata(lsites); 
     std::vector<fobj>     iodata(lsites); // Munge, checksum, byte order in here
     
+    WriteBehindComplete();
     IOobject(w,grid,iodata,file,offset,format,BINARYIO_READ|control,
 	     nersc_csum,scidac_csuma,scidac_csumb);
 
@@ -743,6 +936,11 @@ class BinaryIO {
     int attemptsLeft = std::max(0, BinaryIO::latticeWriteMaxRetry);
     bool checkWrite = (BinaryIO::latticeWriteMaxRetry >= 0);
 
+    if ( writeBehind && (control == BINARYIO_LEXICOGRAPHIC) ) {
+      writeLatticeObjectBehind<vobj,fobj>(Umu,file,munge,offset,format,nersc_csum,scidac_csuma,scidac_csumb);
+      return;
+    }
+
     std::vector<sobj> scalardata(lsites); 
     std::vector<fobj>     iodata(lsites); // Munge, checksum, byte order in here
 
@@ -790,6 +988,185 @@ class BinaryIO {
     std::cout<<GridLogMessage<<"writeLatticeObject: unvectorize overhead "<<timer.Elapsed()  <<std::endl;
   }
   
+  /////////////////////////////////////////////////////////////////////////////
+  // Write behind: munge, byte order and checksums in one pass over a private
+  // snapshot, then return with the checksums while a background thread drains
+  // the snapshot to disk.  Each rank pwrite's its own contiguous runs of the
+  // global lexicographic file, so the drain makes no MPI calls.  One write is
+  // outstanding at a time; readers and the next writer wait for it.
+  //
+  // The file is extended to cover the payload before returning, so callers
+  // may seek to the end and append (e.g. the LIME records closing an ILDG
+  // write). Anything that reads or overwrites the payload must call
+  // WriteBehindComplete first, which also reports a failed drain.
+  //////////////////////////////////////////////////////////////////////////////////////
+  static inline void WriteBehindComplete(void)
+  {
+    if ( writeBehindThread.joinable() ) writeBehindThread.join();
+    if ( !writeBehindError.empty() ) {
+      std::cout << GridLogError << writeBehindError << std::endl;
+      exit(1);
+    }
+  }
+  template<class vobj,class fobj,class munger>
+  static inline void writeLatticeObjectBehind(Lattice<vobj> &Umu,
+					      std::string file,
+					      munger munge,
+					      uint64_t offset,
+					      const std::string &format,
+					      uint32_t &nersc_csum,
+					      uint32_t &scidac_csuma,
+					      uint32_t &scidac_csumb)
+  {
+    typedef typename vobj::scalar_object sobj;
+    GridBase *grid = Umu.Grid();
+    uint64_t lsites = grid->lSites();
+    int nd = grid->_ndimension;
+
+    WriteBehindComplete();
+
+    GridStopWatch timer; timer.Start();
+    std::vector<sobj> scalardata(lsites);
+    unvectorizeToLexOrdArray(scalardata,Umu);
+
+    std::shared_ptr<std::vector<fobj> > snapshot(new std::vector<fobj>(lsites));
+    fobj *iodata = &(*snapshot)[0];
+    nersc_csum=0;
+    scidac_csuma=0;
+    scidac_csumb=0;
+    StreamChecksumSwap(grid,iodata,0,lsites,ByteOrder(format),BINARYIO_WRITE,
+		       nersc_csum,scidac_csuma,scidac_csumb,
+		       [&](uint64_t x){ munge(scalardata[x],iodata[x]); });
+    grid->GlobalSum(nersc_csum);
+    grid->GlobalXOR(scidac_csuma);
+    grid->GlobalXOR(scidac_csumb);
+
+    ////////////////////////////////////////////////////////////////////////
+    // Runs of sites contiguous in both the local and the global file order
+    ////////////////////////////////////////////////////////////////////////
+    Coordinate lLattice = grid->LocalDimensions();
+    Coordinate gLattice = grid->GlobalDimensions();
+    Coordinate lStart   = grid->LocalStarts();
+    uint64_t run = lLattice[0];
+    for(int d=0; (d<nd-1) && (lLattice[d]==gLattice[d]); d++) run *= lLattice[d+1];
+    std::vector<std::pair<uint64_t,uint64_t> > runs; // file offset, local site
+    for(uint64_t l=0;l<lsites;l+=run){
+      Coordinate coor(nd);
+      int64_t gidx;
+      Lexicographic::CoorFromIndex(coor,l,lLattice);
+      for(int d=0;d<nd;d++) coor[d]+=lStart[d];
+      Lexicographic::IndexFromCoor(coor,gidx,gLattice);
+      runs.push_back(std::make_pair(offset+gidx*sizeof(fobj),l));
+    }
+    timer.Stop();
+
+    // File must exist on all ranks, and span the payload, before anyone drains into it
+    if ( grid->IsBoss() ) {
+      off_t end = offset + grid->_gsites*sizeof(fobj);
+      struct stat st;
+      int fd = ::open(file.c_str(),O_WRONLY|O_CREAT,0644);
+      if ( (fd < 0) || ::fstat(fd,&st) || ((st.st_size < end) && ::ftruncate(fd,end)) ) {
+	std::cout << GridLogError << "Write behind cannot create " << file << " : " << strerror(errno) << std::endl;
+	exit(1);
+      }
+      ::close(fd);
+    }
+    grid->Barrier();
+
+    std::cout<<GridLogMessage<<"writeLatticeObject: write behind "<<file<<" "<<lsites*sizeof(fobj)*grid->ProcessorCount()
+	     <<" bytes; munge, endian and checksum "<<timer.Elapsed()<<std::endl;
+
+    writeBehindThread = std::thread([=]() {
+      GridStopWatch drain; drain.Start();
+      int fd = ::open(file.c_str(),O_WRONLY);
+      int err = (fd < 0) ? errno : 0;
+      for(uint64_t r=0;!err && r<runs.size();r++){
+	const char *buf  = (const char *)&(*snapshot)[runs[r].second];
+	uint64_t   bytes = run*sizeof(fobj);
+	off_t      where = runs[r].first;
+	while ( !err && bytes ) {
+	  ssize_t n = ::pwrite(fd,buf,bytes,where);
+	  if ( n < 0 )       err = errno;
+	  else if ( n == 0 ) err = EIO;
+	  else { buf+=n; bytes-=n; where+=n; }
+	}
+      }
+      if ( (fd >= 0) && ::close(fd) && !err ) err = errno;
+      drain.Stop();
+      if ( err ) {
+	writeBehindError = "Write behind failed on file " + file + " : " + strerror(err);
+	return;
+      }
+      std::cout<<GridLogMessage<<"writeLatticeObject: write behind "<<file<<" drained in "<<drain.Elapsed()<<std::endl;
+    });
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Counter based parallel RNG has no per-site state; a single record holds
+  // the serial RNG state followed by the key and fill counter.
+  //////////////////////////////////////////////////////////////////////////////////////
+  static inline void writeCounterRNG(GridSerialRNG &serial_rng,
+				     GridParallelRNG &parallel_rng,
+				     std::string file,
+				     uint64_t offset,
+				     uint32_t &nersc_csum,
+				     uint32_t &scidac_csuma,
+				     uint32_t &scidac_csumb)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    typedef RngStateType word; word w=0;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    typedef std::array<RngStateType,RngStateCount+4> RNGstate;
+    std::string format = "IEEE32BIG";
+
+    std::vector<RNGstate> iodata(1);
+    std::vector<RngStateType> tmp(RngStateCount);
+    serial_rng.GetState(tmp,0);
+    std::copy(tmp.begin(),tmp.end(),iodata[0].begin());
+
+    uint32_t k0,k1; uint64_t counter;
+    parallel_rng.GetCounterState(k0,k1,counter);
+    iodata[0][RngStateCount+0] = k0;
+    iodata[0][RngStateCount+1] = k1;
+    iodata[0][RngStateCount+2] = (uint32_t)counter;
+    iodata[0][RngStateCount+3] = (uint32_t)(counter>>32);
+
+    IOobject(w,parallel_rng.Grid(),iodata,file,offset,format,BINARYIO_WRITE|BINARYIO_MASTER_APPEND,
+	     nersc_csum,scidac_csuma,scidac_csumb);
+
+    std::cout << GridLogMessage << "RNG counter key " << std::hex << k0 <<" "<< k1 << std::dec << " counter " << counter << std::endl;
+    std::cout << GridLogMessage << "RNG file checksum " << std::hex << nersc_csum    << std::dec << std::endl;
+  }
+  static inline void readCounterRNG(GridSerialRNG &serial_rng,
+				    GridParallelRNG &parallel_rng,
+				    std::string file,
+				    uint64_t offset,
+				    uint32_t &nersc_csum,
+				    uint32_t &scidac_csuma,
+				    uint32_t &scidac_csumb)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    typedef RngStateType word; word w=0;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    typedef std::array<RngStateType,RngStateCount+4> RNGstate;
+    std::string format = "IEEE32BIG";
+
+    std::vector<RNGstate> iodata(1);
+    IOobject(w,parallel_rng.Grid(),iodata,file,offset,format,BINARYIO_READ|BINARYIO_MASTER_APPEND,
+	     nersc_csum,scidac_csuma,scidac_csumb);
+
+    std::vector<RngStateType> tmp(RngStateCount);
+    std::copy(iodata[0].begin(),iodata[0].begin()+RngStateCount,tmp.begin());
+    serial_rng.SetState(tmp,0);
+
+    uint32_t k0 = iodata[0][RngStateCount+0];
+    uint32_t k1 = iodata[0][RngStateCount+1];
+    uint64_t counter = ((uint64_t)(uint32_t)iodata[0][RngStateCount+3]<<32) | (uint32_t)iodata[0][RngStateCount+2];
+    parallel_rng.SetCounterState(k0,k1,counter);
+
+    std::cout << GridLogMessage << "RNG counter key " << std::hex << k0 <<" "<< k1 << std::dec << " counter " << counter << std::endl;
+    std::cout << GridLogMessage << "RNG file checksum " << std::hex << nersc_csum    << std::dec << std::endl;
+  }
   /////////////////////////////////////////////////////////////////////////////
   // Read a RNG;  use IOobject and lexico map to an array of state 
   //////////////////////////////////////////////////////////////////////////////////////
@@ -820,6 +1197,11 @@ class BinaryIO {
 
     std::cout << GridLogMessage << "RNG read I/O on file " << file << std::endl;
 
+    if ( parallel_rng.IsCounterBased() ) {
+      readCounterRNG(serial_rng,parallel_rng,file,offset,nersc_csum,scidac_csuma,scidac_csumb);
+      return;
+    }
+
     std::vector<RNGstate> iodata(lsites);
     IOobject(w,grid,iodata,file,offset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC,
 	     nersc_csum,scidac_csuma,scidac_csumb);
@@ -886,6 +1268,11 @@ class BinaryIO {
 
     std::cout << GridLogMessage << "RNG write I/O on file " << file << std::endl;
 
+    if ( parallel_rng.IsCounterBased() ) {
+      writeCounterRNG(serial_rng,parallel_rng,file,offset,nersc_csum,scidac_csuma,scidac_csumb);
+      return;
+    }
+
     timer.Start();
     std::vector<RNGstate> iodata(lsites);
     thread_for(lidx,lsites,{
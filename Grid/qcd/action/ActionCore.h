@@ -40,6 +40,7 @@ NAMESPACE_CHECK(ActionSet);
 NAMESPACE_CHECK(ActionParams);
 
 #include <Grid/qcd/action/filters/MomentumFilter.h>
+#include <Grid/qcd/action/filters/FilterSiteList.h>
 #include <Grid/qcd/action/filters/DirichletFilter.h>
 #include <Grid/qcd/action/filters/DDHMCFilter.h>
 
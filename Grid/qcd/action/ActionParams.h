@@ -40,9 +40,13 @@ struct GparityWilsonImplParams {
                      //mu=Nd-1 is assumed to be the time direction and a twist value of 1 indicates antiperiodic BCs
   Coordinate dirichlet; // Blocksize of dirichlet BCs
   int  partialDirichlet;
+  int  reconstruct; // Packed link storage, as in WilsonImplParams
+  int  comms_precision; // Halo wire format, as in WilsonImplParams
   GparityWilsonImplParams() : twists(Nd, 0) {
     dirichlet.resize(0);
     partialDirichlet=0;
+    reconstruct=18;
+    comms_precision=HaloPrecisionFull;
   };
 };
   
@@ -52,9 +56,18 @@ struct WilsonImplParams {
   int  partialDirichlet;
   AcceleratorVector<Real,Nd> twist_n_2pi_L;
   AcceleratorVector<Complex,Nd> boundary_phases;
+  // Links read by the hand kernels: 18 = full 3x3, 12 = two rows plus a phase word (7 complex,
+  // 14 reals), 8 = 5 complex words (10 reals). The packed copies are extra; the full doubled
+  // fields stay resident for forces and the other kernels, so packing costs memory.
+  int  reconstruct;
+  // Halo wire format (HaloPrecision). fp16/bf16 halos are an opt-in for the inner single
+  // precision operator of a mixed precision solve; the outer operator should stay full.
+  int  comms_precision;
   WilsonImplParams()  {
     dirichlet.resize(0);
     partialDirichlet=0;
+    reconstruct=18;
+    comms_precision=HaloPrecisionFull;
     boundary_phases.resize(Nd, 1.0);
       twist_n_2pi_L.resize(Nd, 0.0);
   };
@@ -62,15 +75,21 @@ struct WilsonImplParams {
     twist_n_2pi_L.resize(Nd, 0.0);
     partialDirichlet=0;
     dirichlet.resize(0);
+    reconstruct=18;
+    comms_precision=HaloPrecisionFull;
   }
 };
 
 struct StaggeredImplParams {
   Coordinate dirichlet; // Blocksize of dirichlet BCs
   int  partialDirichlet;
+  int  reconstruct; // Packed link storage, as in WilsonImplParams
+  int  comms_precision; // Halo wire format, as in WilsonImplParams
   StaggeredImplParams()
   {
     partialDirichlet=0;
+    reconstruct=18;
+    comms_precision=HaloPrecisionFull;
     dirichlet.resize(0);
   };
 };
@@ -75,6 +75,15 @@ public:
     this->DhopDerivEO(mat, U, V, dag);
   };
 
+  // EOFA replaces MooeeInv, so the Cayley fused products do not apply
+  virtual int  MooeeInvMeooeFused(void) { return 0; }
+  virtual void MooeeInvMeooe(const FermionField& in, FermionField& out){
+    CheckerBoardedSparseMatrixBase<FermionField>::MooeeInvMeooe(in, out);
+  };
+  virtual void MooeeInvDagMeooeDag(const FermionField& in, FermionField& out){
+    CheckerBoardedSparseMatrixBase<FermionField>::MooeeInvDagMeooeDag(in, out);
+  };
+
   // Recompute 5D coefficients for different value of shift constant
   // (needed for heatbath loop over poles)
   virtual void RefreshShiftCoefficients(RealD new_shift) = 0;
@@ -32,6 +32,117 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 
 NAMESPACE_BEGIN(Grid);
 
+///////////////////////////////////////////////////////////////
+// Per 4d site 5th dimension operators on an Ls-vector starting at ss:
+// the LDU solve of Mooee (and its adjoint), and an in place M5Ddag.
+// Shared by MooeeInv and the fused hopping term sweeps, where it is
+// applied to the Dhop output of one 4d site while still in cache.
+///////////////////////////////////////////////////////////////
+template<class Coeff_t>
+class CayleySiteOp {
+public:
+  const Coeff_t *plee, *pdee, *puee, *pleem, *pueem;
+  const Coeff_t *plower, *pdiag, *pupper; // M5Ddag applied before the solve, if set
+  int Ls;
+  int dag;
+
+  // (L^{\prime})^{-1} L_m^{-1} then U_m^{-1} D^{-1} U^{-1}; in place safe
+  template<class In,class Out> accelerator_inline
+  void Solve(const In &psi,Out &chi,uint64_t ss) const
+  {
+    const int Ls = this->Ls;
+    const Coeff_t *plee = this->plee, *pdee = this->pdee, *puee = this->puee;
+    const Coeff_t *pleem= this->pleem,*pueem= this->pueem;
+    typedef decltype(coalescedRead(psi[0])) spinor;
+    spinor tmp, acc, res;
+    res = psi(ss);
+    spProj5m(tmp,res);
+    acc = pleem[0]*tmp;
+    spProj5p(tmp,res);
+    coalescedWrite(chi[ss],res);
+    for(int s=1;s<Ls-1;s++){
+      res = psi(ss+s);
+      res -= plee[s-1]*tmp;
+      spProj5m(tmp,res);
+      acc += pleem[s]*tmp;
+      spProj5p(tmp,res);
+      coalescedWrite(chi[ss+s],res);
+    }
+    res = psi(ss+Ls-1) - plee[Ls-2]*tmp - acc;
+    res = (1.0/pdee[Ls-1])*res;
+    coalescedWrite(chi[ss+Ls-1],res);
+    spProj5p(acc,res);
+    spProj5m(tmp,res);
+    for (int s=Ls-2;s>=0;s--){
+      res = (1.0/pdee[s])*chi(ss+s) - puee[s]*tmp - pueem[s]*acc;
+      spProj5m(tmp,res);
+      coalescedWrite(chi[ss+s],res);
+    }
+  }
+  // (U^{\prime})^{-dagger} U_m^{-\dagger} then L_m^{-\dagger} D^{-dagger} L^{-dagger}; in place safe
+  template<class In,class Out> accelerator_inline
+  void SolveDag(const In &psi,Out &chi,uint64_t ss) const
+  {
+    const int Ls = this->Ls;
+    const Coeff_t *plee = this->plee, *pdee = this->pdee, *puee = this->puee;
+    const Coeff_t *pleem= this->pleem,*pueem= this->pueem;
+    typedef decltype(coalescedRead(psi[0])) spinor;
+    spinor tmp, acc, res;
+    res = psi(ss);
+    spProj5p(tmp,res);
+    acc = conjugate(pueem[0])*tmp;
+    spProj5m(tmp,res);
+    coalescedWrite(chi[ss],res);
+    for(int s=1;s<Ls-1;s++){
+      res = psi(ss+s);
+      res -= conjugate(puee[s-1])*tmp;
+      spProj5p(tmp,res);
+      acc += conjugate(pueem[s])*tmp;
+      spProj5m(tmp,res);
+      coalescedWrite(chi[ss+s],res);
+    }
+    res = psi(ss+Ls-1) - conjugate(puee[Ls-2])*tmp - acc;
+    res = conjugate(1.0/pdee[Ls-1])*res;
+    coalescedWrite(chi[ss+Ls-1],res);
+    spProj5m(acc,res);
+    spProj5p(tmp,res);
+    for (int s=Ls-2;s>=0;s--){
+      res = conjugate(1.0/pdee[s])*chi(ss+s) - conjugate(plee[s])*tmp - conjugate(pleem[s])*acc;
+      spProj5p(tmp,res);
+      coalescedWrite(chi[ss+s],res);
+    }
+  }
+  // In place M5Ddag: keeps the original s-1 and s=0 spinors as it sweeps
+  template<class Out> accelerator_inline
+  void M5Ddag(Out &chi,uint64_t ss) const
+  {
+    const int Ls = this->Ls;
+    const Coeff_t *plower = this->plower, *pdiag = this->pdiag, *pupper = this->pupper;
+    typedef decltype(coalescedRead(chi[0])) spinor;
+    spinor first, prev, cur, tmp1, tmp2;
+    first = chi(ss);
+    prev  = chi(ss+Ls-1);
+    for(int s=0;s<Ls;s++){
+      cur = chi(ss+s);
+      if ( s==Ls-1 ) spProj5p(tmp1,first);
+      else           spProj5p(tmp1,chi(ss+s+1));
+      spProj5m(tmp2,prev);
+      coalescedWrite(chi[ss+s],pdiag[s]*cur+pupper[s]*tmp1+plower[s]*tmp2);
+      prev = cur;
+    }
+  }
+  template<class Out> accelerator_inline
+  void operator()(Out &chi,uint64_t ss) const
+  {
+    if ( dag ) {
+      if ( pdiag ) M5Ddag(chi,ss);
+      SolveDag(chi,chi,ss);
+    } else {
+      Solve(chi,chi,ss);
+    }
+  }
+};
+
 template<class Impl>
 class CayleyFermion5D : public WilsonFermion5D<Impl>
 {
@@ -52,6 +163,13 @@ public:
   virtual void   MooeeInvDag (const FermionField &in, FermionField &out);
   virtual void   Meo5D (const FermionField &psi, FermionField &chi);
 
+  // Hopping term and 5d solve in one sweep under --dslash-fuse5d
+  virtual int    MooeeInvMeooeFused (void) {
+    return WilsonKernelsStatic::Fuse5D && (this->FermionRedBlackGrid()->_rdimensions[0] == this->Ls); // s local and innermost
+  }
+  virtual void   MooeeInvMeooe      (const FermionField &in, FermionField &out);
+  virtual void   MooeeInvDagMeooeDag(const FermionField &in, FermionField &out);
+
   virtual void   M5D   (const FermionField &psi, FermionField &chi);
   virtual void   M5Ddag(const FermionField &psi, FermionField &chi);
 
@@ -114,6 +232,11 @@ public:
 
   void   Meooe5D       (const FermionField &in, FermionField &out);
   void   MeooeDag5D    (const FermionField &in, FermionField &out);
+  void   MeooeDag5DCoeffs(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+
+  CayleySiteOp<Coeff_t> MooeeInvSiteOp(int dag);
+  template<class SiteOp>
+  void   MeooeSiteOp   (const FermionField &in, FermionField &out,int dag,SiteOp &op);
 
   //    protected:
   RealD mass_plus, mass_minus;
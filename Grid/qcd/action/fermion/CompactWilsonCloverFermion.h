@@ -164,6 +164,12 @@ public:
 
   void MooeeInvDag(const FermionField& in, FermionField& out) override;
 
+  int  MooeeInvMeooeFused(void) override { return WilsonKernelsStatic::FuseClover; }
+
+  void MooeeInvMeooe(const FermionField& in, FermionField& out) override;
+
+  void MooeeInvDagMeooeDag(const FermionField& in, FermionField& out) override;
+
   void Mdir(const FermionField& in, FermionField& out, int dir, int disp) override;
 
   void MdirAll(const FermionField& in, std::vector<FermionField>& out) override;
@@ -183,6 +189,8 @@ public:
                      const CloverDiagonalField& diagonal,
                      const CloverTriangleField& triangle);
 
+  void MooeeInvMeooeInternal(const FermionField& in, FermionField& out, int dag);
+
   /////////////////////////////////////////////
   // Helpers
   /////////////////////////////////////////////
@@ -164,6 +164,9 @@ public:
   DoubledGaugeField UUUmuEven;
   DoubledGaugeField UUUmuOdd;
 
+  // Packed copies of the above read by the hopping term, if requested
+  PackedGaugeLinks<Impl> PackedLinks;
+
   LebesgueOrder Lebesgue;
   LebesgueOrder LebesgueEvenOdd;
   
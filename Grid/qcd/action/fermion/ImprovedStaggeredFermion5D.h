@@ -191,6 +191,9 @@ public:
   DoubledGaugeField UUUmu;
   DoubledGaugeField UUUmuEven;
   DoubledGaugeField UUUmuOdd;
+
+  // Packed copies of the above read by the hopping term, if requested
+  PackedGaugeLinks<Impl> PackedLinks;
     
   LebesgueOrder Lebesgue;
   LebesgueOrder LebesgueEvenOdd;
@@ -0,0 +1,400 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/fermion/PackedGaugeLinks.h
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Compressed storage of doubled gauge links for the hand unrolled hopping terms.
+//
+// Each Nc=3 link is factored as U = z V with V in SU(3) and z a cube root of det U; z carries
+// the boundary phases, the -1/2 of the Wilson term and any staggered phases or coefficients.
+//
+// Reconstruct-12 stores the first two rows of U and w = z/conj(z)^2, and recovers the third row
+// as w conj(row0 x row1). Reconstruct-8 stores V_01, V_02, V_10, the phases of V_00 and V_20
+// as one complex word, and z; V is recovered from unitarity and rescaled by z.
+// Either way the link is rebuilt in registers inside the kernel; the full fields are kept for
+// everything else (forces, DhopDir, the assembler and generic kernels).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum { LinkReconstruct18=18, LinkReconstruct12=12, LinkReconstruct8=8 };
+
+template<class vtype> using iPackedLink12 = iVector<iScalar<iVector<vtype,7> >, Nds>;
+template<class vtype> using iPackedLink8  = iVector<iScalar<iVector<vtype,5> >, Nds>;
+
+template<class Simt> accelerator_inline
+void reconstructLink12(const Simt &U_00,const Simt &U_01,const Simt &U_02,
+		       const Simt &U_10,const Simt &U_11,const Simt &U_12,const Simt &w,
+		       Simt &U_20,Simt &U_21,Simt &U_22)
+{
+  U_20 = w*conjugate(U_01*U_12-U_02*U_11);
+  U_21 = w*conjugate(U_02*U_10-U_00*U_12);
+  U_22 = w*conjugate(U_00*U_11-U_01*U_10);
+}
+
+template<class Simt> accelerator_inline
+void reconstructLink8(const Simt &V_01,const Simt &V_02,const Simt &V_10,const Simt &p,const Simt &z,
+		      Simt &U_00,Simt &U_01,Simt &U_02,
+		      Simt &U_10,Simt &U_11,Simt &U_12,
+		      Simt &U_20,Simt &U_21,Simt &U_22)
+{
+  Simt one  = 1.0;
+  Simt half = 0.5;
+  Simt n    = real(V_01*conjugate(V_01)+V_02*conjugate(V_02));
+  Simt m    = real(V_10*conjugate(V_10));
+  Simt V_00 = sqrt(real(one-n))*exp(timesI(half*(p+conjugate(p))));
+  Simt V_20 = sqrt(real(n-m))  *exp(half*(p-conjugate(p)));
+  Simt r    = one/n;
+  Simt A    = conjugate(V_00)*V_10;
+  Simt B    = conjugate(V_00)*V_20;
+  U_11 = (conjugate(V_20)*conjugate(V_02)+A*V_01)*r;
+  U_12 = (conjugate(V_20)*conjugate(V_01)-A*V_02)*r;
+  U_21 = (conjugate(V_10)*conjugate(V_02)-B*V_01)*r;
+  U_22 = (conjugate(V_10)*conjugate(V_01)+B*V_02)*r;
+  U_00 = z*V_00;
+  U_01 = z*V_01;
+  U_02 = z*V_02;
+  U_10 = z*V_10;
+  U_11 =-z*U_11;
+  U_12 = z*U_12;
+  U_20 = z*V_20;
+  U_21 = z*U_21;
+  U_22 =-z*U_22;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Read one link into nine registers, whatever the storage
+////////////////////////////////////////////////////////////////////////////
+template<class vtype,class Simt> accelerator_inline
+void loadLink(const iScalar<iMatrix<vtype,3> > &ref,int lane,
+	      Simt &U_00,Simt &U_01,Simt &U_02,
+	      Simt &U_10,Simt &U_11,Simt &U_12,
+	      Simt &U_20,Simt &U_21,Simt &U_22)
+{
+  U_00 = coalescedRead(ref()(0,0),lane);
+  U_01 = coalescedRead(ref()(0,1),lane);
+  U_02 = coalescedRead(ref()(0,2),lane);
+  U_10 = coalescedRead(ref()(1,0),lane);
+  U_11 = coalescedRead(ref()(1,1),lane);
+  U_12 = coalescedRead(ref()(1,2),lane);
+  U_20 = coalescedRead(ref()(2,0),lane);
+  U_21 = coalescedRead(ref()(2,1),lane);
+  U_22 = coalescedRead(ref()(2,2),lane);
+}
+
+template<class vtype,class Simt> accelerator_inline
+void loadLink(const iScalar<iVector<vtype,7> > &ref,int lane,
+	      Simt &U_00,Simt &U_01,Simt &U_02,
+	      Simt &U_10,Simt &U_11,Simt &U_12,
+	      Simt &U_20,Simt &U_21,Simt &U_22)
+{
+  U_00 = coalescedRead(ref()(0),lane);
+  U_01 = coalescedRead(ref()(1),lane);
+  U_02 = coalescedRead(ref()(2),lane);
+  U_10 = coalescedRead(ref()(3),lane);
+  U_11 = coalescedRead(ref()(4),lane);
+  U_12 = coalescedRead(ref()(5),lane);
+  Simt w = coalescedRead(ref()(6),lane);
+  reconstructLink12(U_00,U_01,U_02,U_10,U_11,U_12,w,U_20,U_21,U_22);
+}
+
+template<class vtype,class Simt> accelerator_inline
+void loadLink(const iScalar<iVector<vtype,5> > &ref,int lane,
+	      Simt &U_00,Simt &U_01,Simt &U_02,
+	      Simt &U_10,Simt &U_11,Simt &U_12,
+	      Simt &U_20,Simt &U_21,Simt &U_22)
+{
+  Simt V_01 = coalescedRead(ref()(0),lane);
+  Simt V_02 = coalescedRead(ref()(1),lane);
+  Simt V_10 = coalescedRead(ref()(2),lane);
+  Simt p    = coalescedRead(ref()(3),lane);
+  Simt z    = coalescedRead(ref()(4),lane);
+  reconstructLink8(V_01,V_02,V_10,p,z,U_00,U_01,U_02,U_10,U_11,U_12,U_20,U_21,U_22);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Host side packing of a single link. The link is first reunitarised, so
+// configurations that have drifted from the group by rounding (hot starts,
+// long HMC streams) still pack; the packed operator then differs from the
+// full one by that drift. Returns false if the drift exceeds 256 epsilon
+// of the precision, so anything beyond rounding keeps the full links, or the
+// packed form does not come back to within 10^4 epsilon, both relative to |z|.
+////////////////////////////////////////////////////////////////////////////
+template<class S>
+inline ComplexD linkScale(const iScalar<iMatrix<S,3> > &M,RealD &az)
+{
+  ComplexD m[3][3];
+  for(int i=0;i<3;i++){
+    for(int j=0;j<3;j++){
+      m[i][j] = ComplexD(real(M()(i,j)),imag(M()(i,j)));
+    }
+  }
+  ComplexD d = m[0][0]*(m[1][1]*m[2][2]-m[1][2]*m[2][1])
+             - m[0][1]*(m[1][0]*m[2][2]-m[1][2]*m[2][0])
+             + m[0][2]*(m[1][0]*m[2][1]-m[1][1]*m[2][0]);
+  az = pow(sqrt(real(d)*real(d)+imag(d)*imag(d)),1.0/3.0);
+  RealD th = atan2(imag(d),real(d))/3.0;
+  return ComplexD(az*cos(th),az*sin(th));
+}
+
+// Factor M = z V with V projected onto SU(3) by Gram-Schmidt on its rows;
+// drift is |M - z V| relative to |z|.
+template<class S>
+inline bool unitariseLink(const iScalar<iMatrix<S,3> > &M,ComplexD &z,RealD &az,ComplexD V[3][3],RealD &drift)
+{
+  z = linkScale(M,az);
+  if ( !(az > 0.0) ) return false;
+  ComplexD iz = ComplexD(1.0,0.0)/z;
+  for(int i=0;i<2;i++){
+    for(int j=0;j<3;j++){
+      V[i][j] = ComplexD(real(M()(i,j)),imag(M()(i,j)))*iz;
+    }
+  }
+  RealD n0 = 0.0;
+  for(int j=0;j<3;j++) n0 += real(conjugate(V[0][j])*V[0][j]);
+  for(int j=0;j<3;j++) V[0][j] = V[0][j]/sqrt(n0);
+  ComplexD o = 0.0;
+  for(int j=0;j<3;j++) o += conjugate(V[0][j])*V[1][j];
+  for(int j=0;j<3;j++) V[1][j] = V[1][j]-o*V[0][j];
+  RealD n1 = 0.0;
+  for(int j=0;j<3;j++) n1 += real(conjugate(V[1][j])*V[1][j]);
+  for(int j=0;j<3;j++) V[1][j] = V[1][j]/sqrt(n1);
+  V[2][0] = conjugate(V[0][1]*V[1][2]-V[0][2]*V[1][1]);
+  V[2][1] = conjugate(V[0][2]*V[1][0]-V[0][0]*V[1][2]);
+  V[2][2] = conjugate(V[0][0]*V[1][1]-V[0][1]*V[1][0]);
+
+  drift = 0.0;
+  for(int i=0;i<3;i++){
+    for(int j=0;j<3;j++){
+      ComplexD d = ComplexD(real(M()(i,j)),imag(M()(i,j)))-z*V[i][j];
+      drift = std::max(drift,(RealD)sqrt(real(d)*real(d)+imag(d)*imag(d))/az);
+    }
+  }
+  RealD tol = 256.0*std::numeric_limits<decltype(real(S()))>::epsilon();
+  return drift <= tol; // NaN compares false
+}
+
+template<class S>
+inline bool packLinkError(const ComplexD W[3][3],S U[3][3],RealD az)
+{
+  RealD tol = 1.0e4*std::numeric_limits<decltype(real(S()))>::epsilon();
+  RealD err = 0.0;
+  for(int i=0;i<3;i++){
+    for(int j=0;j<3;j++){
+      ComplexD d = ComplexD(real(U[i][j]),imag(U[i][j]))-W[i][j];
+      err = std::max(err,(RealD)sqrt(real(d)*real(d)+imag(d)*imag(d)));
+    }
+  }
+  return err <= tol*az; // NaN compares false
+}
+
+template<class S>
+inline bool packLink(const iScalar<iMatrix<S,3> > &M,iScalar<iVector<S,7> > &P,RealD &drift)
+{
+  RealD az;
+  ComplexD z, V[3][3], W[3][3];
+  if ( !unitariseLink(M,z,az,V,drift) ) return false;
+  ComplexD cz = conjugate(z);
+  ComplexD w  = z/(cz*cz);
+  for(int i=0;i<3;i++){
+    for(int j=0;j<3;j++){
+      W[i][j] = z*V[i][j];
+    }
+  }
+
+  for(int j=0;j<3;j++){
+    P()(j)   = S(real(W[0][j]),imag(W[0][j]));
+    P()(3+j) = S(real(W[1][j]),imag(W[1][j]));
+  }
+  P()(6) = S(real(w),imag(w));
+
+  S U[3][3];
+  for(int j=0;j<3;j++){
+    U[0][j] = P()(j);
+    U[1][j] = P()(3+j);
+  }
+  reconstructLink12(U[0][0],U[0][1],U[0][2],U[1][0],U[1][1],U[1][2],P()(6),U[2][0],U[2][1],U[2][2]);
+  return packLinkError(W,U,az);
+}
+
+template<class S>
+inline bool packLink(const iScalar<iMatrix<S,3> > &M,iScalar<iVector<S,5> > &P,RealD &drift)
+{
+  RealD az;
+  ComplexD z, V[3][3], W[3][3];
+  if ( !unitariseLink(M,z,az,V,drift) ) return false;
+  for(int i=0;i<3;i++){
+    for(int j=0;j<3;j++){
+      W[i][j] = z*V[i][j];
+    }
+  }
+  ComplexD p(atan2(imag(V[0][0]),real(V[0][0])),atan2(imag(V[2][0]),real(V[2][0])));
+
+  P()(0) = S(real(V[0][1]),imag(V[0][1]));
+  P()(1) = S(real(V[0][2]),imag(V[0][2]));
+  P()(2) = S(real(V[1][0]),imag(V[1][0]));
+  P()(3) = S(real(p),imag(p));
+  P()(4) = S(real(z),imag(z));
+
+  S U[3][3];
+  reconstructLink8(P()(0),P()(1),P()(2),P()(3),P()(4),
+		   U[0][0],U[0][1],U[0][2],U[1][0],U[1][1],U[1][2],U[2][0],U[2][1],U[2][2]);
+  return packLinkError(W,U,az);
+}
+
+template<class vtype,int N>
+inline int packGaugeField(const Lattice<iVector<iScalar<iMatrix<vtype,3> >,Nds> > &U,
+			  Lattice<iVector<iScalar<iVector<vtype,N> >,Nds> > &P,RealD &drift)
+{
+  typedef iVector<iScalar<iVector<vtype,N> >,Nds> vobj;
+  typedef typename vobj::scalar_object sobj;
+  GridBase *grid = U.Grid();
+  P.Checkerboard() = U.Checkerboard();
+
+  const int Nsimd = vtype::Nsimd();
+  std::vector<int>   bad(grid->oSites(),0);
+  std::vector<RealD> dev(grid->oSites(),0.0);
+  {
+    autoView( U_v , U, CpuRead);
+    autoView( P_v , P, CpuWrite);
+    thread_for( ss, grid->oSites(), {
+      for(int lane=0;lane<Nsimd;lane++){
+	auto Ul = extractLane(lane,U_v[ss]);
+	sobj Pl;
+	for(int mu=0;mu<Nds;mu++){
+	  RealD d = 0.0;
+	  if ( !packLink(Ul(mu),Pl(mu),d) ) bad[ss]=1;
+	  dev[ss] = std::max(dev[ss],d);
+	}
+	insertLane(lane,P_v[ss],Pl);
+      }
+    });
+  }
+  uint64_t nbad = 0;
+  for(auto b : bad) nbad+=b;
+  grid->GlobalSum(nbad);
+  drift = 0.0;
+  for(auto d : dev) drift = std::max(drift,d);
+  grid->GlobalMax(drift);
+  return nbad==0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Packed copies of a fermion action's doubled gauge fields. Import packs
+// each field in the requested form, falling back to reconstruct-12 and
+// then to full links; all fields always share the same form.
+////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+class PackedGaugeLinks {
+public:
+  typedef typename Impl::Simd                  Simd;
+  typedef typename Impl::DoubledGaugeField     DoubledGaugeField;
+  typedef typename Impl::SiteDoubledGaugeField SiteDoubledGaugeField;
+  typedef Lattice<iPackedLink12<Simd> > PackedGaugeField12;
+  typedef Lattice<iPackedLink8<Simd> >  PackedGaugeField8;
+
+  static constexpr bool Supported =
+    std::is_same<SiteDoubledGaugeField,iVector<iScalar<iMatrix<Simd,3> >,Nds> >::value;
+
+  int reconstruct;
+  std::vector<PackedGaugeField12> U12;
+  std::vector<PackedGaugeField8>  U8;
+  std::vector<const DoubledGaugeField *> source;
+
+  PackedGaugeLinks() : reconstruct(LinkReconstruct18) {};
+
+  // Which packed field holds the links of U
+  int Index(const DoubledGaugeField &U) const
+  {
+    for(int i=0;i<source.size();i++){
+      if ( source[i]==&U ) return i;
+    }
+    assert(0 && "PackedGaugeLinks: field was not imported");
+    return -1;
+  }
+
+  void Import(int requested,const std::vector<const DoubledGaugeField *> &fields)
+  {
+    assert( (requested==LinkReconstruct18)
+	  ||(requested==LinkReconstruct12)
+	  ||(requested==LinkReconstruct8) );
+    reconstruct = LinkReconstruct18;
+    U12.clear();
+    U8.clear();
+    source.clear();
+    if ( requested == LinkReconstruct18 ) return;
+
+    if constexpr (Supported) {
+      RealD drift;
+      if ( requested == LinkReconstruct8 ) {
+	if ( Pack(fields,U8,drift) ) {
+	  reconstruct = LinkReconstruct8;
+	  source = fields;
+	  Report(drift);
+	  return;
+	}
+	std::cout << GridLogWarning << "PackedGaugeLinks: links do not reconstruct from 8 reals, trying 12" << std::endl;
+      }
+      if ( Pack(fields,U12,drift) ) {
+	reconstruct = LinkReconstruct12;
+	source = fields;
+	Report(drift);
+	return;
+      }
+      std::cout << GridLogWarning << "PackedGaugeLinks: links are not unitary up to a phase, keeping 18 reals" << std::endl;
+    } else {
+      std::cout << GridLogWarning << "PackedGaugeLinks: only plain Nc=3 links are packed, keeping 18 reals" << std::endl;
+    }
+  }
+
+private:
+  void Report(RealD drift)
+  {
+    std::cout << GridLogMessage << "PackedGaugeLinks: packed to "<<reconstruct<<" reals, links reunitarised by up to "<<drift<<" relative" << std::endl;
+  }
+
+  template<class PackedField>
+  static int Pack(const std::vector<const DoubledGaugeField *> &fields,std::vector<PackedField> &packed,RealD &drift)
+  {
+    packed.clear();
+    packed.reserve(fields.size());
+    drift = 0.0;
+    for(auto f : fields){
+      RealD d;
+      packed.emplace_back(f->Grid());
+      if ( !packGaugeField(*f,packed.back(),d) ) {
+	packed.clear();
+	return 0;
+      }
+      drift = std::max(drift,d);
+    }
+    return 1;
+  }
+};
+
+NAMESPACE_END(Grid);
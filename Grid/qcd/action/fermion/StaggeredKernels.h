@@ -56,10 +56,20 @@ template<class Impl> class StaggeredKernels : public FermionOperator<Impl> , pub
 		 DoubledGaugeField &U,
 		 const FermionField &in, FermionField &out, int dag, int interior,int exterior);
   
+  // Improved hopping term reading U and UUU from their packed copies in links.
+  // Always runs the hand unrolled kernels, which rebuild each link in registers.
+  void DhopImprovedPacked(StencilImpl &st, LebesgueOrder &lo, const PackedGaugeLinks<Impl> &links,
+			  DoubledGaugeField &U, DoubledGaugeField &UUU,
+			  const FermionField &in, FermionField &out, int dag, int interior,int exterior);
+
   void DhopDirKernel(StencilImpl &st, DoubledGaugeFieldView &U, DoubledGaugeFieldView &UUU, SiteSpinor * buf,
 		     int sF, int sU, const FermionFieldView &in, FermionFieldView &out, int dir,int disp);
  protected:    
 
+  template<class PackedField>
+  void DhopImprovedPackedField(StencilImpl &st, const PackedField &U, const PackedField &UUU,
+			       const FermionField &in, FermionField &out, int dag, int interior,int exterior);
+
    ///////////////////////////////////////////////////////////////////////////////////////
    // Generic Nc kernels
    ///////////////////////////////////////////////////////////////////////////////////////
@@ -83,24 +93,24 @@ template<class Impl> class StaggeredKernels : public FermionOperator<Impl> , pub
 			   const FermionFieldView &in, FermionFieldView &out,int dag);
 
    ///////////////////////////////////////////////////////////////////////////////////////
-   // Nc=3 specific kernels
+   // Nc=3 specific kernels, reading full or packed links
    ///////////////////////////////////////////////////////////////////////////////////////
    
-   template<int Naik> static accelerator_inline
+   template<int Naik,class GaugeView> static accelerator_inline
    void DhopSiteHand(StencilView &st, 
-		     DoubledGaugeFieldView &U,DoubledGaugeFieldView &UUU, 
+		     GaugeView &U,GaugeView &UUU, 
 		     SiteSpinor * buf, int LLs, int sU, 
 		     const FermionFieldView &in, FermionFieldView &out,int dag);
    
-   template<int Naik> static accelerator_inline
+   template<int Naik,class GaugeView> static accelerator_inline
    void DhopSiteHandInt(StencilView &st, 
-			DoubledGaugeFieldView &U,DoubledGaugeFieldView &UUU, 
+			GaugeView &U,GaugeView &UUU, 
 			SiteSpinor * buf, int LLs, int sU, 
 			const FermionFieldView &in, FermionFieldView &out,int dag);
    
-   template<int Naik> static accelerator_inline
+   template<int Naik,class GaugeView> static accelerator_inline
    void DhopSiteHandExt(StencilView &st, 
-			DoubledGaugeFieldView &U,DoubledGaugeFieldView &UUU, 
+			GaugeView &U,GaugeView &UUU, 
 			SiteSpinor * buf, int LLs, int sU, 
 			const FermionFieldView &in, FermionFieldView &out,int dag);
 
@@ -470,6 +470,8 @@ public:
     this->_grid->StencilBarrier();
 
     assert(source.Grid()==this->_grid);
+
+    this->PlanCheck(compress);
     
     this->u_comm_offset=0;
       
@@ -506,6 +508,7 @@ public:
       vet_same_node(this->same_node[Tm],this->HaloGatherDir(source,TpCompress,Tm,face_idx));
     }
     this->face_table_computed=1;
+    this->PlanRecord();
     assert(this->u_comm_offset==this->_unified_buffer_size);
     accelerator_barrier();
   }
@@ -202,6 +202,9 @@ public:
   DoubledGaugeField Umu;
   DoubledGaugeField UmuEven;
   DoubledGaugeField UmuOdd;
+
+  // Packed copies of the above read by the hopping term, if requested
+  PackedGaugeLinks<Impl> PackedLinks;
     
   LebesgueOrder Lebesgue;
   LebesgueOrder LebesgueEvenOdd;
@@ -42,6 +42,8 @@ public:
   enum { CommsAndCompute, CommsThenCompute };
   static int Opt;  
   static int Comms;
+  static int Fuse5D; // 5d operators fuse their 5th dimension solves into the hopping term sweep
+  static int FuseClover; // compact clover applies its inverse in the even-odd hopping term sweep
 };
  
 template<class Impl> class WilsonKernels : public FermionOperator<Impl> , public WilsonKernelsStatic { 
@@ -61,6 +63,20 @@ public:
 			    int Ls, int Nsite, const FermionField &in, FermionField &out,
 			    int interior=1,int exterior=1) ;
 
+  // Complete (interior and exterior) hopping term followed, per 4d site, by
+  // op(out_v,sF) acting in place on the Ls-vector out[sF..sF+Ls-1] while it is
+  // still in cache. Requires s innermost and unvectorised.
+  template<class SiteOp>
+  static void DhopKernelSiteOp(int Opt,StencilImpl &st,  DoubledGaugeField &U, SiteHalfSpinor * buf,
+			       int Ls, int Nsite, const FermionField &in, FermionField &out,
+			       int dag, SiteOp &op) ;
+
+  // Hopping term reading the links of U from their packed copy in links.
+  // Always runs the hand unrolled kernels, which rebuild each link in registers.
+  static void DhopKernelPacked(StencilImpl &st, const PackedGaugeLinks<Impl> &links, DoubledGaugeField &U,
+			       SiteHalfSpinor * buf, int Ls, int Nsite, const FermionField &in, FermionField &out,
+			       int dag, int interior=1,int exterior=1) ;
+
   static void DhopDirAll( StencilImpl &st, DoubledGaugeField &U,SiteHalfSpinor *buf, int Ls,
 			  int Nsite, const FermionField &in, std::vector<FermionField> &out) ;
 
@@ -69,6 +85,11 @@ public:
 
 private:
 
+  template<class PackedField>
+  static void DhopKernelPackedField(StencilImpl &st, const PackedField &U, SiteHalfSpinor * buf,
+				    int Ls, int Nsite, const FermionField &in, FermionField &out,
+				    int dag, int interior,int exterior) ;
+
   static accelerator_inline void DhopDirK(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor * buf,
 				   int sF, int sU, const FermionFieldView &in, FermionFieldView &out, int dirdisp, int gamma);
 
@@ -136,6 +157,26 @@ private:
   
   static accelerator void HandDhopSiteDagExt(StencilView &st,  DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
 					     int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+
+  // Hand unrolled, links rebuilt from a packed view
+  template<class PackedView>
+  static accelerator void HandDhopSitePacked(StencilView &st, PackedView &U, SiteHalfSpinor * buf,
+					     int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+  template<class PackedView>
+  static accelerator void HandDhopSiteDagPacked(StencilView &st, PackedView &U, SiteHalfSpinor * buf,
+						int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+  template<class PackedView>
+  static accelerator void HandDhopSiteIntPacked(StencilView &st, PackedView &U, SiteHalfSpinor * buf,
+						int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+  template<class PackedView>
+  static accelerator void HandDhopSiteDagIntPacked(StencilView &st, PackedView &U, SiteHalfSpinor * buf,
+						   int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+  template<class PackedView>
+  static accelerator void HandDhopSiteExtPacked(StencilView &st, PackedView &U, SiteHalfSpinor * buf,
+						int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+  template<class PackedView>
+  static accelerator void HandDhopSiteDagExtPacked(StencilView &st, PackedView &U, SiteHalfSpinor * buf,
+						   int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
  public:
  WilsonKernels(const ImplParams &p = ImplParams()) : Base(p){};
 };
@@ -246,11 +246,20 @@ void CayleyFermion5D<Impl>::M5Ddag (const FermionField &psi, FermionField &chi)
 
 template<class Impl>
 void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField &Din)
+{
+  Vector<Coeff_t> diag;
+  Vector<Coeff_t> upper;
+  Vector<Coeff_t> lower;
+  MeooeDag5DCoeffs(lower,diag,upper);
+  M5Ddag(psi,psi,Din,lower,diag,upper);
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::MeooeDag5DCoeffs(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag =bs;
-  Vector<Coeff_t> upper=cs;
-  Vector<Coeff_t> lower=cs; 
+  diag =bs;
+  upper=cs;
+  lower=cs; 
 
   for (int s=0;s<Ls;s++){
     if ( s== 0 ) {
@@ -267,7 +276,6 @@ void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField
     lower[s] = conjugate(lower[s]);
     diag[s]  = conjugate(diag[s]);
   }
-  M5Ddag(psi,psi,Din,lower,diag,upper);
 }
 
 template<class Impl>
@@ -328,6 +336,84 @@ void CayleyFermion5D<Impl>::MeooeDag    (const FermionField &psi, FermionField &
   MeooeDag5D(this->tmp(),chi); 
 }
 
+////////////////////////////////////////////////////////////////////////
+// Fused hopping term and 5d solve.
+//
+// MooeeInv Meooe       = MooeeInv    Dhop Meooe5D
+// MooeeInvDag MeooeDag = MooeeInvDag MeooeDag5D Dhop^dag
+//
+// With --dslash-fuse5d the 5d work following Dhop is done per 4d site
+// on the Ls spinors the hopping kernel has just written, saving one
+// (forward) or two (adjoint) passes over the output field. Halo exchange
+// is always completed before the sweep, so comms are not overlapped.
+////////////////////////////////////////////////////////////////////////
+template<class Impl>
+CayleySiteOp<typename CayleyFermion5D<Impl>::Coeff_t> CayleyFermion5D<Impl>::MooeeInvSiteOp(int dag)
+{
+  CayleySiteOp<Coeff_t> op;
+  op.plee  = &lee [0];
+  op.pdee  = &dee [0];
+  op.puee  = &uee [0];
+  op.pleem = &leem[0];
+  op.pueem = &ueem[0];
+  op.plower= nullptr;
+  op.pdiag = nullptr;
+  op.pupper= nullptr;
+  op.Ls    = this->Ls;
+  op.dag   = dag;
+  return op;
+}
+
+template<class Impl> template<class SiteOp>
+void CayleyFermion5D<Impl>::MeooeSiteOp(const FermionField &in, FermionField &out,int dag,SiteOp &op)
+{
+  conformable(in.Grid(),this->FermionRedBlackGrid());
+  conformable(in.Grid(),out.Grid());
+
+  int odd = (in.Checkerboard() == Odd);
+  StencilImpl       &st = odd ? this->StencilOdd : this->StencilEven;
+  DoubledGaugeField &U  = odd ? this->UmuEven    : this->UmuOdd;
+  out.Checkerboard() = odd ? Even : Odd;
+
+  Compressor compressor(dag);
+  st.HaloExchangeOpt(in,compressor);
+  WilsonKernels<Impl>::DhopKernelSiteOp(WilsonKernelsStatic::Opt,st,U,st.CommBuf(),
+					this->Ls,U.oSites(),in,out,dag,op);
+}
+
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeInvMeooe(const FermionField &psi, FermionField &chi)
+{
+  // Needs s local and innermost
+  if ( !WilsonKernelsStatic::Fuse5D || (psi.Grid()->_rdimensions[0] != this->Ls) ) {
+    CheckerBoardedSparseMatrixBase<FermionField>::MooeeInvMeooe(psi,chi);
+    return;
+  }
+  Meooe5D(psi,this->tmp()); 
+
+  auto op = MooeeInvSiteOp(DaggerNo);
+  MeooeSiteOp(this->tmp(),chi,DaggerNo,op);
+}
+
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeInvDagMeooeDag(const FermionField &psi, FermionField &chi)
+{
+  if ( !WilsonKernelsStatic::Fuse5D || (psi.Grid()->_rdimensions[0] != this->Ls) ) {
+    CheckerBoardedSparseMatrixBase<FermionField>::MooeeInvDagMeooeDag(psi,chi);
+    return;
+  }
+  Vector<Coeff_t> diag;
+  Vector<Coeff_t> upper;
+  Vector<Coeff_t> lower;
+  MeooeDag5DCoeffs(lower,diag,upper);
+
+  auto op = MooeeInvSiteOp(DaggerYes);
+  op.plower = &lower[0];
+  op.pdiag  = &diag[0];
+  op.pupper = &upper[0];
+  MeooeSiteOp(psi,chi,DaggerYes,op);
+}
+
 template<class Impl>
 void  CayleyFermion5D<Impl>::Mdir (const FermionField &psi, FermionField &chi,int dir,int disp)
 {
@@ -125,48 +125,14 @@ CayleyFermion5D<Impl>::MooeeInv    (const FermionField &psi_i, FermionField &chi
   autoView(chi , chi_i,AcceleratorWrite);
 
   int Ls=this->Ls;
+  auto op = MooeeInvSiteOp(DaggerNo);
 
-  auto plee  = & lee [0];
-  auto pdee  = & dee [0];
-  auto puee  = & uee [0];
-  auto pleem = & leem[0];
-  auto pueem = & ueem[0];
-
+  // X = Nc*Ns
+  // flops = 2X + (Ls-2)(4X + 4X) + 6X + 1 + 2X + (Ls-1)(10X + 1) = -16X + Ls(1+18X) = -192 + 217*Ls flops
   uint64_t nloop = grid->oSites()/Ls;
   accelerator_for(sss,nloop,Simd::Nsimd(),{
     uint64_t ss=sss*Ls;
-    typedef decltype(coalescedRead(psi[0])) spinor;
-    spinor tmp, acc, res;
-
-    // X = Nc*Ns
-    // flops = 2X + (Ls-2)(4X + 4X) + 6X + 1 + 2X + (Ls-1)(10X + 1) = -16X + Ls(1+18X) = -192 + 217*Ls flops
-    // Apply (L^{\prime})^{-1} L_m^{-1}
-    res = psi(ss);
-    spProj5m(tmp,res);
-    acc = pleem[0]*tmp;
-    spProj5p(tmp,res);
-    coalescedWrite(chi[ss],res);
-    
-    for(int s=1;s<Ls-1;s++){
-      res = psi(ss+s);
-      res -= plee[s-1]*tmp;
-      spProj5m(tmp,res);
-      acc += pleem[s]*tmp;
-      spProj5p(tmp,res);
-      coalescedWrite(chi[ss+s],res);
-    }
-    res = psi(ss+Ls-1) - plee[Ls-2]*tmp - acc;
-    
-    // Apply U_m^{-1} D^{-1} U^{-1}
-    res = (1.0/pdee[Ls-1])*res;
-    coalescedWrite(chi[ss+Ls-1],res);
-    spProj5p(acc,res);
-    spProj5m(tmp,res);
-    for (int s=Ls-2;s>=0;s--){
-      res = (1.0/pdee[s])*chi(ss+s) - puee[s]*tmp - pueem[s]*acc;
-      spProj5m(tmp,res);
-      coalescedWrite(chi[ss+s],res);
-    }
+    op.Solve(psi,chi,ss);
   });
   
 }
@@ -182,49 +148,13 @@ CayleyFermion5D<Impl>::MooeeInvDag (const FermionField &psi_i, FermionField &chi
   autoView(psi , psi_i,AcceleratorRead);
   autoView(chi , chi_i,AcceleratorWrite);
 
-  auto plee  = & lee [0];
-  auto pdee  = & dee [0];
-  auto puee  = & uee [0];
-  auto pleem = & leem[0];
-  auto pueem = & ueem[0];
-
-  assert(psi.Checkerboard() == psi.Checkerboard());
+  auto op = MooeeInvSiteOp(DaggerYes);
 
+  // flops = -192 + 217*Ls, as MooeeInv
   uint64_t nloop = grid->oSites()/Ls;
   accelerator_for(sss,nloop,Simd::Nsimd(),{
     uint64_t ss=sss*Ls;
-    typedef decltype(coalescedRead(psi[0])) spinor;
-    spinor tmp, acc, res;
-
-    // X = Nc*Ns
-    // flops = 2X + (Ls-2)(4X + 4X) + 6X + 1 + 2X + (Ls-1)(10X + 1) = -16X + Ls(1+18X) = -192 + 217*Ls flops
-    // Apply (U^{\prime})^{-dagger} U_m^{-\dagger}
-    res = psi(ss);
-    spProj5p(tmp,res);
-    acc = conjugate(pueem[0])*tmp;
-    spProj5m(tmp,res);
-    coalescedWrite(chi[ss],res);
-    
-    for(int s=1;s<Ls-1;s++){
-      res = psi(ss+s);
-      res -= conjugate(puee[s-1])*tmp;
-      spProj5p(tmp,res);
-      acc += conjugate(pueem[s])*tmp;
-      spProj5m(tmp,res);
-      coalescedWrite(chi[ss+s],res);
-    }
-    res = psi(ss+Ls-1) - conjugate(puee[Ls-2])*tmp - acc;
-    
-    // Apply L_m^{-\dagger} D^{-dagger} L^{-dagger}
-    res = conjugate(1.0/pdee[Ls-1])*res;
-    coalescedWrite(chi[ss+Ls-1],res);
-    spProj5m(acc,res);
-    spProj5p(tmp,res);
-    for (int s=Ls-2;s>=0;s--){
-      res = conjugate(1.0/pdee[s])*chi(ss+s) - conjugate(plee[s])*tmp - conjugate(pleem[s])*acc;
-      spProj5p(tmp,res);
-      coalescedWrite(chi[ss+s],res);
-    }
+    op.SolveDag(psi,chi,ss);
   });
 
 }
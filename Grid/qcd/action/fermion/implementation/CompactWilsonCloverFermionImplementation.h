@@ -174,6 +174,33 @@ void CompactWilsonCloverFermion<Impl, CloverHelpers>::MooeeInvDag(const FermionF
   MooeeInv(in, out); // blocks are hermitian
 }
 
+////////////////////////////////////////////////////////////////////////
+// Fused hopping term and clover inverse.
+//
+// With --dslash-fuse-clover the packed inverse of the output checkerboard
+// and the boundary mask are applied per site to the spinor Dhop has just
+// written, saving the separate MooeeInv (and mask) passes over the field.
+// Both are site local, so masking once after the inverse is equivalent.
+// Halo exchange is completed before the sweep, so comms are not overlapped.
+////////////////////////////////////////////////////////////////////////
+template<class Impl, class CloverHelpers>
+void CompactWilsonCloverFermion<Impl, CloverHelpers>::MooeeInvMeooe(const FermionField& in, FermionField& out) {
+  if(!WilsonKernelsStatic::FuseClover) {
+    CheckerBoardedSparseMatrixBase<FermionField>::MooeeInvMeooe(in, out);
+    return;
+  }
+  MooeeInvMeooeInternal(in, out, DaggerNo);
+}
+
+template<class Impl, class CloverHelpers>
+void CompactWilsonCloverFermion<Impl, CloverHelpers>::MooeeInvDagMeooeDag(const FermionField& in, FermionField& out) {
+  if(!WilsonKernelsStatic::FuseClover) {
+    CheckerBoardedSparseMatrixBase<FermionField>::MooeeInvDagMeooeDag(in, out);
+    return;
+  }
+  MooeeInvMeooeInternal(in, out, DaggerYes); // blocks are hermitian
+}
+
 template<class Impl, class CloverHelpers>
 void CompactWilsonCloverFermion<Impl, CloverHelpers>::Mdir(const FermionField& in, FermionField& out, int dir, int disp) {
   DhopDir(in, out, dir, disp);
@@ -291,6 +318,34 @@ void CompactWilsonCloverFermion<Impl, CloverHelpers>::MooeeInternal(const Fermio
   CompactHelpers::MooeeKernel(diagonal.oSites(), 1, in, out, diagonal, triangle);
 }
 
+template<class Impl, class CloverHelpers>
+void CompactWilsonCloverFermion<Impl, CloverHelpers>::MooeeInvMeooeInternal(const FermionField& in, FermionField& out, int dag) {
+  conformable(in.Grid(), this->FermionRedBlackGrid());
+  conformable(in.Grid(), out.Grid());
+
+  int odd = (in.Checkerboard() == Odd);
+  StencilImpl&               st       = odd ? this->StencilOdd : this->StencilEven;
+  DoubledGaugeField&         U        = odd ? this->UmuEven    : this->UmuOdd;
+  const CloverDiagonalField& diagonal = odd ? DiagonalInvEven  : DiagonalInvOdd;
+  const CloverTriangleField& triangle = odd ? TriangleInvEven  : TriangleInvOdd;
+  const MaskField&           mask     = odd ? BoundaryMaskEven : BoundaryMaskOdd;
+  out.Checkerboard() = odd ? Even : Odd;
+
+  Compressor compressor(dag);
+  st.HaloExchange(in, compressor);
+
+  autoView(diagonal_v, diagonal, AcceleratorRead);
+  autoView(triangle_v, triangle, AcceleratorRead);
+  autoView(mask_v,     mask,     AcceleratorRead);
+
+  CompactCloverSiteOp<Impl> op;
+  op.diagonal = &diagonal_v[0];
+  op.triangle = &triangle_v[0];
+  op.mask     = fixedBoundaries ? &mask_v[0] : nullptr;
+  WilsonKernels<Impl>::DhopKernelSiteOp(WilsonKernelsStatic::Opt, st, U, st.CommBuf(),
+                                        1, U.oSites(), in, out, dag, op);
+}
+
 template<class Impl, class CloverHelpers>
 void CompactWilsonCloverFermion<Impl, CloverHelpers>::ImportGauge(const GaugeField& _Umu) {
   // NOTE: parts copied from original implementation
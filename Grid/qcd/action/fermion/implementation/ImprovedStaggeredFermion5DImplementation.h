@@ -130,6 +130,7 @@ void ImprovedStaggeredFermion5D<Impl>::CopyGaugeCheckerboards(void)
   pickCheckerboard(Odd,  UmuOdd ,  Umu);
   pickCheckerboard(Even, UUUmuEven,UUUmu);
   pickCheckerboard(Odd,  UUUmuOdd, UUUmu);
+  PackedLinks.Import(this->Params.reconstruct,{&Umu,&UmuEven,&UmuOdd,&UUUmu,&UUUmuEven,&UUUmuOdd});
 }
 template<class Impl>
 ImprovedStaggeredFermion5D<Impl>::ImprovedStaggeredFermion5D(GaugeField &_Uthin,GaugeField &_Ufat,
@@ -313,7 +314,11 @@ void ImprovedStaggeredFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl &
   {
     int interior=1;
     int exterior=0;
-    Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    if (PackedLinks.reconstruct != LinkReconstruct18) {
+      Kernels::DhopImprovedPacked(st,lo,PackedLinks,U,UUU,in,out,dag,interior,exterior);
+    } else {
+      Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    }
   }
 
   st.CommsMerge(compressor);
@@ -323,7 +328,11 @@ void ImprovedStaggeredFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl &
   {
     int interior=0;
     int exterior=1;
-    Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    if (PackedLinks.reconstruct != LinkReconstruct18) {
+      Kernels::DhopImprovedPacked(st,lo,PackedLinks,U,UUU,in,out,dag,interior,exterior);
+    } else {
+      Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    }
   }
 }
 
@@ -341,7 +350,11 @@ void ImprovedStaggeredFermion5D<Impl>::DhopInternalSerialComms(StencilImpl & st,
   {
     int interior=1;
     int exterior=1;
-    Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    if (PackedLinks.reconstruct != LinkReconstruct18) {
+      Kernels::DhopImprovedPacked(st,lo,PackedLinks,U,UUU,in,out,dag,interior,exterior);
+    } else {
+      Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    }
   }
 }
 /*CHANGE END*/
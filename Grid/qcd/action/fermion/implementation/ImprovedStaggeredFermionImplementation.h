@@ -132,6 +132,7 @@ void ImprovedStaggeredFermion<Impl>::CopyGaugeCheckerboards(void)
   pickCheckerboard(Odd,  UmuOdd ,  Umu);
   pickCheckerboard(Even, UUUmuEven,UUUmu);
   pickCheckerboard(Odd,  UUUmuOdd, UUUmu);
+  PackedLinks.Import(this->Params.reconstruct,{&Umu,&UmuEven,&UmuOdd,&UUUmu,&UUUmuEven,&UUUmuOdd});
 }
 template <class Impl>
 void ImprovedStaggeredFermion<Impl>::ImportGauge(const GaugeField &_Uthin,const GaugeField &_Ufat) 
@@ -429,7 +430,11 @@ void ImprovedStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st
   {
     int interior=1;
     int exterior=0;
-    Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    if (PackedLinks.reconstruct != LinkReconstruct18) {
+      Kernels::DhopImprovedPacked(st,lo,PackedLinks,U,UUU,in,out,dag,interior,exterior);
+    } else {
+      Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    }
   }
 
   st.CommunicateComplete(requests);
@@ -440,7 +445,11 @@ void ImprovedStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st
   {
     int interior=0;
     int exterior=1;
-    Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    if (PackedLinks.reconstruct != LinkReconstruct18) {
+      Kernels::DhopImprovedPacked(st,lo,PackedLinks,U,UUU,in,out,dag,interior,exterior);
+    } else {
+      Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    }
   }
 }
 
@@ -460,7 +469,11 @@ void ImprovedStaggeredFermion<Impl>::DhopInternalSerialComms(StencilImpl &st, Le
   {
     int interior=1;
     int exterior=1;
-    Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    if (PackedLinks.reconstruct != LinkReconstruct18) {
+      Kernels::DhopImprovedPacked(st,lo,PackedLinks,U,UUU,in,out,dag,interior,exterior);
+    } else {
+      Kernels::DhopImproved(st,lo,U,UUU,in,out,dag,interior,exterior);
+    }
   }
 };
 
@@ -64,18 +64,10 @@ NAMESPACE_BEGIN(Grid);
 #endif
 
 
-// To splat or not to splat depends on the implementation
+// To splat or not to splat depends on the implementation.
+// Links are read in full or rebuilt from a packed form by loadLink.
 #define MULT(A,UChi)				\
-  auto & ref(U[sU](A));			\
-    U_00=coalescedRead(ref()(0,0),lane);				\
-    U_10=coalescedRead(ref()(1,0),lane);				\
-    U_20=coalescedRead(ref()(2,0),lane);				\
-    U_01=coalescedRead(ref()(0,1),lane);				\
-    U_11=coalescedRead(ref()(1,1),lane);				\
-    U_21=coalescedRead(ref()(2,1),lane);				\
-    U_02=coalescedRead(ref()(0,2),lane);				\
-    U_12=coalescedRead(ref()(1,2),lane);				\
-    U_22=coalescedRead(ref()(2,2),lane);				\
+  loadLink(U[sU](A),lane,U_00,U_01,U_02,U_10,U_11,U_12,U_20,U_21,U_22); \
     UChi ## _0  = U_00*Chi_0;	       \
     UChi ## _1  = U_10*Chi_0;\
     UChi ## _2  = U_20*Chi_0;\
@@ -87,16 +79,7 @@ NAMESPACE_BEGIN(Grid);
     UChi ## _2 += U_22*Chi_2;
 
 #define MULT_ADD(U,A,UChi)			\
-  auto & ref(U[sU](A));			\
-    U_00=coalescedRead(ref()(0,0),lane);				\
-    U_10=coalescedRead(ref()(1,0),lane);				\
-    U_20=coalescedRead(ref()(2,0),lane);				\
-    U_01=coalescedRead(ref()(0,1),lane);				\
-    U_11=coalescedRead(ref()(1,1),lane);				\
-    U_21=coalescedRead(ref()(2,1),lane);				\
-    U_02=coalescedRead(ref()(0,2),lane);				\
-    U_12=coalescedRead(ref()(1,2),lane);				\
-    U_22=coalescedRead(ref()(2,2),lane);				\
+  loadLink(U[sU](A),lane,U_00,U_01,U_02,U_10,U_11,U_12,U_20,U_21,U_22); \
     UChi ## _0 += U_00*Chi_0;	       \
     UChi ## _1 += U_10*Chi_0;\
     UChi ## _2 += U_20*Chi_0;\
@@ -186,9 +169,9 @@ NAMESPACE_BEGIN(Grid);
   
 
 template <class Impl>
-template <int Naik> accelerator_inline
+template <int Naik,class GaugeView> accelerator_inline
 void StaggeredKernels<Impl>::DhopSiteHand(StencilView &st,
-					  DoubledGaugeFieldView &U,DoubledGaugeFieldView &UUU,
+					  GaugeView &U,GaugeView &UUU,
 					  SiteSpinor *buf, int sF, int sU, 
 					  const FermionFieldView &in, FermionFieldView &out,int dag) 
 {
@@ -247,9 +230,9 @@ void StaggeredKernels<Impl>::DhopSiteHand(StencilView &st,
 
 
 template <class Impl>
-template <int Naik> accelerator_inline
+template <int Naik,class GaugeView> accelerator_inline
 void StaggeredKernels<Impl>::DhopSiteHandInt(StencilView &st, 
-					     DoubledGaugeFieldView &U, DoubledGaugeFieldView &UUU,
+					     GaugeView &U,GaugeView &UUU,
 					     SiteSpinor *buf, int sF, int sU, 
 					     const FermionFieldView &in, FermionFieldView &out,int dag) 
 {
@@ -311,9 +294,9 @@ void StaggeredKernels<Impl>::DhopSiteHandInt(StencilView &st,
 
 
 template <class Impl>
-template <int Naik> accelerator_inline
+template <int Naik,class GaugeView> accelerator_inline
 void StaggeredKernels<Impl>::DhopSiteHandExt(StencilView &st,
-					     DoubledGaugeFieldView &U, DoubledGaugeFieldView &UUU,
+					     GaugeView &U,GaugeView &UUU,
 					     SiteSpinor *buf, int sF, int sU, 
 					     const FermionFieldView &in, FermionFieldView &out,int dag) 
 {
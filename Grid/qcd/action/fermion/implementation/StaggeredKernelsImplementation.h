@@ -294,6 +294,53 @@ void StaggeredKernels<Impl>::DhopImproved(StencilImpl &st, LebesgueOrder &lo,
   assert(0 && " Kernel optimisation case not covered ");
 }
 template <class Impl> 
+void StaggeredKernels<Impl>::DhopImprovedPacked(StencilImpl &st, LebesgueOrder &lo, const PackedGaugeLinks<Impl> &links,
+						DoubledGaugeField &U, DoubledGaugeField &UUU, 
+						const FermionField &in, FermionField &out, int dag, int interior,int exterior)
+{
+  if constexpr (PackedGaugeLinks<Impl>::Supported) {
+    int iU   = links.Index(U);
+    int iUUU = links.Index(UUU);
+    if ( links.reconstruct == LinkReconstruct12 ) {
+      DhopImprovedPackedField(st,links.U12[iU],links.U12[iUUU],in,out,dag,interior,exterior);
+      return;
+    }
+    if ( links.reconstruct == LinkReconstruct8 ) {
+      DhopImprovedPackedField(st,links.U8[iU],links.U8[iUUU],in,out,dag,interior,exterior);
+      return;
+    }
+  }
+  assert(0 && " Links were not packed ");
+}
+template <class Impl> template <class PackedField>
+void StaggeredKernels<Impl>::DhopImprovedPackedField(StencilImpl &st, const PackedField &U, const PackedField &UUU,
+						     const FermionField &in, FermionField &out, int dag, int interior,int exterior)
+{
+  GridBase *FGrid=in.Grid();  
+  GridBase *UGrid=U.Grid();  
+  typedef StaggeredKernels<Impl> ThisKernel;
+  autoView( UUU_v , UUU, AcceleratorRead);
+  autoView( U_v   ,   U, AcceleratorRead);
+  autoView( in_v  ,  in, AcceleratorRead);
+  autoView( out_v , out, AcceleratorWrite);
+  autoView( st_v  ,  st, AcceleratorRead);
+  SiteSpinor * buf = st.CommBuf();
+    
+  int Ls=1;
+  if(FGrid->Nd()==UGrid->Nd()+1){
+    Ls    = FGrid->_rdimensions[0];
+  }
+  int Nsite = UGrid->oSites();
+
+  if( interior && exterior ) { 
+    KERNEL_CALL(DhopSiteHand,1);
+  } else if( interior ) {
+    KERNEL_CALL(DhopSiteHandInt,1);
+  } else if( exterior ) { 
+    KERNEL_CALL(DhopSiteHandExt,1);
+  }
+}
+template <class Impl> 
 void StaggeredKernels<Impl>::DhopNaive(StencilImpl &st, LebesgueOrder &lo, 
 				       DoubledGaugeField &U,
 				       const FermionField &in, FermionField &out, int dag, int interior,int exterior)
@@ -178,6 +178,7 @@ void WilsonFermion5D<Impl>::ImportGauge(const GaugeField &_Umu)
   Impl::DoubleStore(GaugeGrid(),Umu,HUmu);
   pickCheckerboard(Even,UmuEven,Umu);
   pickCheckerboard(Odd ,UmuOdd,Umu);
+  PackedLinks.Import(this->Params.reconstruct,{&Umu,&UmuEven,&UmuOdd});
 }
 template<class Impl>
 void WilsonFermion5D<Impl>::DhopDir(const FermionField &in, FermionField &out,int dir5,int disp)
@@ -351,7 +352,10 @@ void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, Lebesg
   // do the compute interior
   /////////////////////////////
   int Opt = WilsonKernelsStatic::Opt; // Why pass this. Kernels should know
-  if (dag == DaggerYes) {
+  if (PackedLinks.reconstruct != LinkReconstruct18) {
+    GRID_TRACE("DhopPackedInterior");
+    Kernels::DhopKernelPacked(st,PackedLinks,U,st.CommBuf(),LLs,U.oSites(),in,out,dag,1,0);
+  } else if (dag == DaggerYes) {
     GRID_TRACE("DhopDagInterior");
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),LLs,U.oSites(),in,out,1,0);
   } else {
@@ -374,7 +378,10 @@ void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, Lebesg
   }
   
 
-  if (dag == DaggerYes) {
+  if (PackedLinks.reconstruct != LinkReconstruct18) {
+    GRID_TRACE("DhopPackedExterior");
+    Kernels::DhopKernelPacked(st,PackedLinks,U,st.CommBuf(),LLs,U.oSites(),in,out,dag,0,1);
+  } else if (dag == DaggerYes) {
     GRID_TRACE("DhopDagExterior");
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),LLs,U.oSites(),in,out,0,1);
   } else {
@@ -401,7 +408,10 @@ void WilsonFermion5D<Impl>::DhopInternalSerialComms(StencilImpl & st, LebesgueOr
   }
   
   int Opt = WilsonKernelsStatic::Opt;
-  if (dag == DaggerYes) {
+  if (PackedLinks.reconstruct != LinkReconstruct18) {
+    GRID_TRACE("DhopPacked");
+    Kernels::DhopKernelPacked(st,PackedLinks,U,st.CommBuf(),LLs,U.oSites(),in,out,dag);
+  } else if (dag == DaggerYes) {
     GRID_TRACE("DhopDag");
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),LLs,U.oSites(),in,out);
   } else {
@@ -104,6 +104,7 @@ void WilsonFermion<Impl>::ImportGauge(const GaugeField &_Umu)
   Impl::DoubleStore(GaugeGrid(), Umu, HUmu);
   pickCheckerboard(Even, UmuEven, Umu);
   pickCheckerboard(Odd, UmuOdd, Umu);
+  PackedLinks.Import(this->Params.reconstruct,{&Umu,&UmuEven,&UmuOdd});
 }
 
 /////////////////////////////
@@ -441,7 +442,10 @@ void WilsonFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, LebesgueO
   // do the compute interior
   /////////////////////////////
   int Opt = WilsonKernelsStatic::Opt;
-  if (dag == DaggerYes) {
+  if (PackedLinks.reconstruct != LinkReconstruct18) {
+    GRID_TRACE("DhopPackedInterior");
+    Kernels::DhopKernelPacked(st,PackedLinks,U,st.CommBuf(),1,U.oSites(),in,out,dag,1,0);
+  } else if (dag == DaggerYes) {
     GRID_TRACE("DhopDagInterior");
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),1,U.oSites(),in,out,1,0);
   } else {
@@ -463,7 +467,10 @@ void WilsonFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, LebesgueO
   // do the compute exterior
   /////////////////////////////
 
-  if (dag == DaggerYes) {
+  if (PackedLinks.reconstruct != LinkReconstruct18) {
+    GRID_TRACE("DhopPackedExterior");
+    Kernels::DhopKernelPacked(st,PackedLinks,U,st.CommBuf(),1,U.oSites(),in,out,dag,0,1);
+  } else if (dag == DaggerYes) {
     GRID_TRACE("DhopDagExterior");
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),1,U.oSites(),in,out,0,1);
   } else {
@@ -488,7 +495,10 @@ void WilsonFermion<Impl>::DhopInternalSerial(StencilImpl &st, LebesgueOrder &lo,
   }
 
   int Opt = WilsonKernelsStatic::Opt;
-  if (dag == DaggerYes) {
+  if (PackedLinks.reconstruct != LinkReconstruct18) {
+    GRID_TRACE("DhopPacked");
+    Kernels::DhopKernelPacked(st,PackedLinks,U,st.CommBuf(),1,U.oSites(),in,out,dag);
+  } else if (dag == DaggerYes) {
     GRID_TRACE("DhopDag");
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),1,U.oSites(),in,out);
   } else {
@@ -520,6 +520,90 @@ void WilsonKernels<Impl>::DhopKernel(int Opt,StencilImpl &st,  DoubledGaugeField
    assert(0 && " Kernel optimisation case not covered ");
   }
 
+  template <class Impl>
+  void WilsonKernels<Impl>::DhopKernelPacked(StencilImpl &st, const PackedGaugeLinks<Impl> &links, DoubledGaugeField &U,
+					     SiteHalfSpinor * buf, int Ls, int Nsite, const FermionField &in, FermionField &out,
+					     int dag, int interior,int exterior)
+  {
+    if constexpr (PackedGaugeLinks<Impl>::Supported) {
+      int i = links.Index(U);
+      if ( links.reconstruct == LinkReconstruct12 ) {
+	DhopKernelPackedField(st,links.U12[i],buf,Ls,Nsite,in,out,dag,interior,exterior);
+	return;
+      }
+      if ( links.reconstruct == LinkReconstruct8 ) {
+	DhopKernelPackedField(st,links.U8[i],buf,Ls,Nsite,in,out,dag,interior,exterior);
+	return;
+      }
+    }
+    assert(0 && " Links were not packed ");
+  }
+
+  template <class Impl> template <class PackedField>
+  void WilsonKernels<Impl>::DhopKernelPackedField(StencilImpl &st, const PackedField &U, SiteHalfSpinor * buf,
+						  int Ls, int Nsite, const FermionField &in, FermionField &out,
+						  int dag, int interior,int exterior)
+  {
+    autoView(U_v  ,U,AcceleratorRead);
+    autoView(in_v ,in,AcceleratorRead);
+    autoView(out_v,out,AcceleratorWrite);
+    autoView(st_v ,st,AcceleratorRead);
+
+    if ( dag == DaggerYes ) {
+      if( interior && exterior ) {
+	acceleratorFenceComputeStream();
+	KERNEL_CALL(HandDhopSiteDagPacked);
+      } else if( interior ) {
+	KERNEL_CALLNB(HandDhopSiteDagIntPacked);
+      } else if( exterior ) {
+	acceleratorFenceComputeStream();
+	KERNEL_CALL_EXT(HandDhopSiteDagExtPacked);
+      }
+    } else {
+      if( interior && exterior ) {
+	acceleratorFenceComputeStream();
+	KERNEL_CALL(HandDhopSitePacked);
+      } else if( interior ) {
+	KERNEL_CALLNB(HandDhopSiteIntPacked);
+      } else if( exterior ) {
+	acceleratorFenceComputeStream();
+	KERNEL_CALL_EXT(HandDhopSiteExtPacked);
+      }
+    }
+  }
+
+  template <class Impl> template <class SiteOp>
+  void WilsonKernels<Impl>::DhopKernelSiteOp(int Opt,StencilImpl &st,  DoubledGaugeField &U, SiteHalfSpinor * buf,
+					     int Ls, int Nsite, const FermionField &in, FermionField &out,
+					     int dag, SiteOp &op)
+  {
+    autoView(U_v  ,U,AcceleratorRead);
+    autoView(in_v ,in,AcceleratorRead);
+    autoView(out_v,out,AcceleratorWrite);
+    autoView(st_v ,st,AcceleratorRead);
+
+    // One 4d site per thread: all of s, then the 5th dimension operator.
+    // The assembler kernels are replaced by the Nc=3 unrolled ones here.
+#define SITEOP_CALL(A)						\
+    accelerator_for( sU, Nsite, Simd::Nsimd(), {		\
+	int sF = sU*Ls;						\
+	for(int s=0;s<Ls;s++){					\
+	  WilsonKernels<Impl>::A(st_v,U_v,buf,sF+s,sU,in_v,out_v);	\
+	}							\
+	op(out_v,sF);						\
+    });
+
+    acceleratorFenceComputeStream();
+    if ( dag == DaggerYes ) {
+      if (Opt == WilsonKernelsStatic::OptGeneric ) { SITEOP_CALL(GenericDhopSiteDag); }
+      else                                         { SITEOP_CALL(HandDhopSiteDag); }
+    } else {
+      if (Opt == WilsonKernelsStatic::OptGeneric ) { SITEOP_CALL(GenericDhopSite); }
+      else                                         { SITEOP_CALL(HandDhopSite); }
+    }
+#undef SITEOP_CALL
+  }
+
 #undef KERNEL_CALLNB
 #undef KERNEL_CALL
 #undef ASM_CALL
@@ -32,6 +32,11 @@ directory
 NAMESPACE_BEGIN(Grid);
 ////////////////////////////////////////////////////
 // DDHMC filter with sub-block size B[mu]
+//
+// For each mu with an active block, zero all links on the Width slices either
+// side of the block face (coor%B in B-Width..B-1 and 0..Width-1), and the mu
+// link connecting to them from slice B-Width-1.
+// The boundary sites are listed once per grid and zeroed in place.
 ////////////////////////////////////////////////////
 
 template<typename GaugeField>
@@ -39,75 +44,33 @@ struct DDHMCFilter: public MomentumFilterBase<GaugeField>
 {
   Coordinate Block;
   int Width;
+  mutable FilterSiteList Sites;
   
   DDHMCFilter(const Coordinate &_Block,int _Width=2): Block(_Block) { Width=_Width; }
 
-  void applyFilter(GaugeField &U) const override
+  uint32_t Mask(const Coordinate &Global,const Coordinate &coor) const
   {
-    GridBase *grid = U.Grid();
-    Coordinate Global=grid->GlobalDimensions();
-    GaugeField zzz(grid); zzz = Zero();
-    LatticeInteger coor(grid); 
-    
-    auto zzz_mu = PeekIndex<LorentzIndex>(zzz,0);
-    ////////////////////////////////////////////////////
-    // Zero BDY layers
-    ////////////////////////////////////////////////////
-    std::cout<<GridLogMessage<<" DDHMC Force Filter Block "<<Block<<" width " <<Width<<std::endl;
+    uint32_t m=0;
     for(int mu=0;mu<Nd;mu++) {
-
       Integer B1 = Block[mu];
       if ( B1 && (B1 <= Global[mu]) ) {
-	LatticeCoordinate(coor,mu);
-
-	////////////////////////////////
-	// OmegaBar - zero all links contained in slice B-1,0 and
-	// mu links connecting to Omega
-	////////////////////////////////
-	if ( Width==1) { 
-	  U    = where(mod(coor,B1)==Integer(B1-1),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(0)   ,zzz,U); 
-	  auto U_mu   = PeekIndex<LorentzIndex>(U,mu);
-	  U_mu = where(mod(coor,B1)==Integer(B1-2),zzz_mu,U_mu); 
-	  PokeIndex<LorentzIndex>(U, U_mu, mu);
-	}
-	if ( Width==2) { 
-	  U    = where(mod(coor,B1)==Integer(B1-2),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(B1-1),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(0)   ,zzz,U); 
-	  U    = where(mod(coor,B1)==Integer(1)   ,zzz,U); 
-	  auto U_mu   = PeekIndex<LorentzIndex>(U,mu);
-	  U_mu = where(mod(coor,B1)==Integer(B1-3),zzz_mu,U_mu); 
-	  PokeIndex<LorentzIndex>(U, U_mu, mu);
-	}
-	if ( Width==3) { 
-	  U    = where(mod(coor,B1)==Integer(B1-3),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(B1-2),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(B1-1),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(0)   ,zzz,U); 
-	  U    = where(mod(coor,B1)==Integer(1)   ,zzz,U); 
-	  U    = where(mod(coor,B1)==Integer(2)   ,zzz,U); 
-	  auto U_mu   = PeekIndex<LorentzIndex>(U,mu);
-	  U_mu = where(mod(coor,B1)==Integer(B1-4),zzz_mu,U_mu); 
-	  PokeIndex<LorentzIndex>(U, U_mu, mu);
-	}
-	if ( Width==4) { 
-	  U    = where(mod(coor,B1)==Integer(B1-4),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(B1-3),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(B1-2),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(B1-1),zzz,U);
-	  U    = where(mod(coor,B1)==Integer(0)   ,zzz,U); 
-	  U    = where(mod(coor,B1)==Integer(1)   ,zzz,U); 
-	  U    = where(mod(coor,B1)==Integer(2)   ,zzz,U); 
-	  U    = where(mod(coor,B1)==Integer(3)   ,zzz,U); 
-	  auto U_mu   = PeekIndex<LorentzIndex>(U,mu);
-	  U_mu = where(mod(coor,B1)==Integer(B1-5),zzz_mu,U_mu); 
-	  PokeIndex<LorentzIndex>(U, U_mu, mu);
-	}
+	Integer r = coor[mu]%B1;
+	if ( (r >= B1-Width) || (r < Width) ) m |= (1<<Nd)-1; // OmegaBar: all links
+	if ( r == B1-Width-1 )                m |= 1<<mu;     // mu links connecting to Omega
       }
+    }
+    return m;
+  }
 
+  void applyFilter(GaugeField &U) const override
+  {
+    GridBase *grid = U.Grid();
+    if ( !Sites.Valid(grid) ) {
+      std::cout<<GridLogMessage<<" DDHMC Force Filter Block "<<Block<<" width " <<Width<<std::endl;
+      Coordinate Global=grid->GlobalDimensions();
+      Sites.Build(grid,[&](const Coordinate &coor){ return Mask(Global,coor); });
     }
-   
+    Sites.Apply(U);
   }
 };
 
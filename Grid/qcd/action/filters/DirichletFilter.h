@@ -31,6 +31,10 @@ directory
 
 NAMESPACE_BEGIN(Grid);
 
+////////////////////////////////////////////////////
+// Zero strictly the mu links crossing between domains,
+// coor%Block[mu] == Block[mu]-1, in place over a cached site list
+////////////////////////////////////////////////////
 template<typename MomentaField>
 struct DirichletFilter: public MomentumFilterBase<MomentaField>
 {
@@ -40,28 +44,30 @@ struct DirichletFilter: public MomentumFilterBase<MomentaField>
   typedef iScalar<iScalar<iScalar<vector_type> > >            ScalarType; //complex phase for each site
   
   Coordinate Block;
+  mutable FilterSiteList Sites;
   
   DirichletFilter(const Coordinate &_Block): Block(_Block){}
 
-  void applyFilter(MomentaField &P) const override
+  uint32_t Mask(const Coordinate &Global,const Coordinate &coor) const
   {
-    GridBase *grid = P.Grid();
-    typedef decltype(PeekIndex<LorentzIndex>(P, 0)) LatCM;
-    ////////////////////////////////////////////////////
-    // Zero strictly links crossing between domains
-    ////////////////////////////////////////////////////
-    LatticeInteger coor(grid); 
-    LatCM zz(grid); zz = Zero();
+    uint32_t m=0;
     for(int mu=0;mu<Nd;mu++) {
-      if ( (Block[mu]) && (Block[mu] <= grid->GlobalDimensions()[mu] ) ) {
-	// If costly could provide Grid earlier and precompute masks
-	std::cout << GridLogMessage << " Dirichlet in mu="<<mu<<std::endl;
-	LatticeCoordinate(coor,mu);
-	auto P_mu = PeekIndex<LorentzIndex>(P, mu);
-	P_mu = where(mod(coor,Block[mu])==Integer(Block[mu]-1),zz,P_mu);
-	PokeIndex<LorentzIndex>(P, P_mu, mu);
+      if ( (Block[mu]) && (Block[mu] <= Global[mu] ) ) {
+	if ( coor[mu]%Block[mu] == Block[mu]-1 ) m |= 1<<mu;
       }
     }
+    return m;
+  }
+
+  void applyFilter(MomentaField &P) const override
+  {
+    GridBase *grid = P.Grid();
+    if ( !Sites.Valid(grid) ) {
+      std::cout << GridLogMessage << " Dirichlet filter block "<<Block<<std::endl;
+      Coordinate Global=grid->GlobalDimensions();
+      Sites.Build(grid,[&](const Coordinate &coor){ return Mask(Global,coor); });
+    }
+    Sites.Apply(P);
   }
 };
 
@@ -0,0 +1,117 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/filters/FilterSiteList.h
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+//--------------------------------------------------------------------
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////
+// Compact list of the (site,lane) pairs on which a filter zeroes Lorentz
+// components of a gauge or momentum field.
+//
+// Built once for a grid from a rule mapping the global coordinate to a bit
+// mask over mu, then applied in place by one kernel over the listed sites.
+// The filter cost follows the block surface rather than the volume, and
+// no full lattice temporaries or coordinate fields are needed.
+// Sites are node local, so no communication is involved.
+////////////////////////////////////////////////////////////////////////////
+class FilterSiteList {
+public:
+  GridBase  *grid = nullptr;
+  Coordinate gdims, ldims, rdims, pcoor; // geometry the list was built for
+  deviceVector<uint64_t> site;           // ss*Nsimd + lane
+  deviceVector<uint64_t> mask;           // bit mu set: zero Lorentz component mu
+
+  bool Valid(GridBase *_grid) const
+  {
+    return (grid == _grid)
+      && (gdims == _grid->_gdimensions)
+      && (ldims == _grid->_ldimensions)
+      && (rdims == _grid->_rdimensions)
+      && (pcoor == _grid->_processor_coor);
+  }
+
+  template<class Rule>
+  void Build(GridBase *_grid,Rule rule)
+  {
+    assert(!_grid->_isCheckerBoarded);
+    grid  = _grid;
+    gdims = grid->_gdimensions;
+    ldims = grid->_ldimensions;
+    rdims = grid->_rdimensions;
+    pcoor = grid->_processor_coor;
+
+    int nd    = grid->Nd();
+    int Nsimd = grid->Nsimd();
+    std::vector<uint64_t> hsite;
+    std::vector<uint64_t> hmask;
+    Coordinate lcoor(nd), gcoor(nd);
+    for(int idx=0;idx<grid->lSites();idx++){
+      grid->LocalIndexToLocalCoor(idx,lcoor);
+      for(int d=0;d<nd;d++) gcoor[d] = lcoor[d] + grid->_lstart[d];
+      uint32_t m = rule(gcoor);
+      if ( m ) {
+	hsite.push_back((uint64_t)grid->oIndex(lcoor)*Nsimd + grid->iIndex(lcoor));
+	hmask.push_back(m);
+      }
+    }
+    site.resize(hsite.size());
+    mask.resize(hmask.size());
+    if ( hsite.size() ) {
+      acceleratorCopyToDevice(&hsite[0],&site[0],hsite.size()*sizeof(uint64_t));
+      acceleratorCopyToDevice(&hmask[0],&mask[0],hmask.size()*sizeof(uint64_t));
+    }
+    std::cout << GridLogMessage << " FilterSiteList: "<<hsite.size()<<" of "<<grid->lSites()
+	      <<" local sites on the boundary"<<std::endl;
+  }
+
+  template<class Field>
+  void Apply(Field &U) const
+  {
+    assert(U.Grid() == grid);
+    uint64_t nsite = site.size();
+    if ( nsite == 0 ) return;
+    const int Nsimd = Field::vector_type::Nsimd();
+    const uint64_t *site_p = &site[0];
+    const uint64_t *mask_p = &mask[0];
+    autoView( U_v , U, AcceleratorWrite);
+    accelerator_for(e,nsite,1,{
+      uint64_t ss   = site_p[e] / Nsimd;
+      int      lane = site_p[e] % Nsimd;
+      uint64_t m    = mask_p[e];
+      auto u = extractLane(lane,U_v[ss]);
+      for(int mu=0;mu<Nd;mu++){
+	if ( (m>>mu)&0x1 ) u(mu) = Zero();
+      }
+      insertLane(lane,U_v[ss],u);
+    });
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -132,6 +132,12 @@ public:
       return ret;
     }
 
+  // exp(ep P) U projected on the group, for a single link in a site kernel
+  template<class vlink>
+  static accelerator_inline vlink update_link(const vlink &P, const vlink &U, double ep){
+    return Group::ProjectOnGeneralGroup(Exponentiate(P, ep, Nexp) * U);
+  }
+
   static inline void update_field(Field& P, Field& U, double ep){
     //static std::chrono::duration<double> diff;
 
@@ -140,8 +146,7 @@ public:
     autoView(P_v,P,AcceleratorRead);
     accelerator_for(ss, P.Grid()->oSites(),1,{
       for (int mu = 0; mu < Nd; mu++) {
-          U_v[ss](mu) = Exponentiate(P_v[ss](mu), ep, Nexp) * U_v[ss](mu);
-          U_v[ss](mu) = Group::ProjectOnGeneralGroup(U_v[ss](mu));
+          U_v[ss](mu) = update_link(P_v[ss](mu), U_v[ss](mu), ep);
       }
     });
    //auto end = std::chrono::high_resolution_clock::now();
@@ -44,8 +44,17 @@ private:
   RealD c_plaq;
   RealD c_rect;
   typename WilsonLoops<Gimpl>::StapleAndRectStapleAllWorkspace workspace;
+  GaugeLinkPaths<Gimpl> loops; // 0: plaquettes, 1: rectangles of both orientations
 public:
-  PlaqPlusRectangleAction(RealD b,RealD c): c_plaq(b),c_rect(c){};
+  PlaqPlusRectangleAction(RealD b,RealD c): c_plaq(b),c_rect(c){
+    for(int mu=1;mu<Nd;mu++){
+      for(int nu=0;nu<mu;nu++){
+	loops.AddPath(0,GaugeLinkPath::Loop(mu,nu,1,1));
+	loops.AddPath(1,GaugeLinkPath::Loop(mu,nu,2,1));
+	loops.AddPath(1,GaugeLinkPath::Loop(mu,nu,1,2));
+      }
+    }
+  };
 
   virtual std::string action_name(){return "PlaqPlusRectangleAction";}
       
@@ -62,8 +71,15 @@ public:
   virtual RealD S(const GaugeField &U) {
     RealD vol = U.Grid()->gSites();
 
-    RealD plaq = WilsonLoops<Gimpl>::avgPlaquette(U);
-    RealD rect = WilsonLoops<Gimpl>::avgRectangle(U);
+    // Both loop sums from one padded evaluation
+    std::vector<GaugeLinkField> loop;
+    loops.Evaluate(loop,U);
+    ComplexField tr(U.Grid());
+    RealD faces = Nd*(Nd-1.0)*0.5;
+    tr = trace(loop[0]);
+    RealD plaq = TensorRemove(sum(tr)).real()/vol/faces/Nc;
+    tr = trace(loop[1]);
+    RealD rect = TensorRemove(sum(tr)).real()/vol/(2.0*faces)/Nc;
 
     RealD action=c_plaq*(1.0 -plaq)*(Nd*(Nd-1.0))*vol*0.5
       +c_rect*(1.0 -rect)*(Nd*(Nd-1.0))*vol;
@@ -118,6 +118,20 @@ public:
   TopologicalChargeMod(): ObsBase(){}
 };
 
+template < class Impl >
+class SolverPerformanceMod: public ObservableModule<SolverPerformanceLogger<Impl>, SolverPerformanceObsParameters>{
+  typedef ObservableModule<SolverPerformanceLogger<Impl>, SolverPerformanceObsParameters> ObsBase;
+  using ObsBase::ObsBase; // for constructors
+
+  // acquire resource
+  virtual void initialize(){
+    this->ObservablePtr.reset(new SolverPerformanceLogger<Impl>(this->Par_));
+  }
+public:
+  SolverPerformanceMod(SolverPerformanceObsParameters Par): ObsBase(Par){}
+  SolverPerformanceMod(): ObsBase(SolverPerformanceObsParameters()){}
+};
+
 ////////////////////////////////////////
 // Factories specialisations
 ////////////////////////////////////////
@@ -106,6 +106,7 @@ static Registrar< DomainWallFermionModule<FermionImplementationPolicy>,
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 static Registrar<PlaquetteMod<ImplementationPolicy>, HMC_ObservablesModuleFactory<observable_string, typename ImplementationPolicy::Field, Serialiser> > __OBSPLmodXMLInit("Plaquette"); 
+static Registrar<SolverPerformanceMod<ImplementationPolicy>, HMC_ObservablesModuleFactory<observable_string, typename ImplementationPolicy::Field, Serialiser> > __OBSSPmodXMLInit("SolverPerformance"); 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Checkpointers
@@ -56,5 +56,7 @@ NAMESPACE_CHECK(Plaq);
 NAMESPACE_CHECK(Topo);
 #include "polyakov_loop.h"
 NAMESPACE_CHECK(Polyakov);
+#include "solver_performance.h"
+NAMESPACE_CHECK(SolverPerformance);
 
 
@@ -0,0 +1,84 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/observables/solver_performance.h
+
+Copyright (C) 2017
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+struct SolverPerformanceObsParameters : Serializable {
+  GRID_SERIALIZABLE_CLASS_MEMBERS(SolverPerformanceObsParameters,
+				  std::string, output_prefix,
+				  std::string, format);   // "xml" or "json"
+
+  SolverPerformanceObsParameters(std::string prefix = "solver_performance",std::string fmt = "xml"):
+    output_prefix(prefix), format(fmt){}
+
+  template <class ReaderClass >
+  SolverPerformanceObsParameters(Reader<ReaderClass>& Reader){
+    read(Reader, "SolverPerformance", *this);
+  }
+};
+
+// Writes the solves of the trajectory to <prefix>.<traj>.<format>,
+// per solve and summed per solver, then starts a fresh log
+template <class Impl>
+class SolverPerformanceLogger : public HmcObservable<typename Impl::Field> {
+  SolverPerformanceObsParameters Pars;
+
+public:
+  typedef typename Impl::Field Field;
+
+  SolverPerformanceLogger(SolverPerformanceObsParameters P = SolverPerformanceObsParameters()):Pars(P)
+  {
+    SolverPerformanceLog::Enable();
+  }
+
+  void TrajectoryComplete(int traj,
+			  Field &U,
+			  GridSerialRNG &sRNG,
+			  GridParallelRNG &pRNG) {
+
+    std::vector<SolverPerformance> summary = SolverPerformanceLog::Summary();
+    for(auto &s : summary){
+      std::cout << GridLogMessage << "Solver performance: [ " << traj << " ] " << s.Solver
+		<< " solves "     << s.Solves
+		<< " iterations " << s.Iterations
+		<< " time "       << s.TotalTime << " s"
+		<< " matrix "     << s.MatrixTime << " s"
+		<< " halo "       << s.HaloTime << " s"
+		<< " reductions " << s.Reductions << std::endl;
+    }
+
+    std::string file = Pars.output_prefix + "." + std::to_string(traj) + "." + Pars.format;
+    SolverPerformanceLog::WriteFile(file);
+    SolverPerformanceLog::Clear();
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -49,6 +49,41 @@ private:
     return res;
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  // Depth one padded cell and the four staple neighbours x+mu, x+nu, x-nu
+  // and x+mu-nu of every (mu,nu) plane, built on first use for a grid.
+  // The padding is filled by plain Cshift, so this path is only taken for
+  // periodic gauge fields; twisted boundaries use the Cshift staples.
+  ////////////////////////////////////////////////////////////////////////////
+  mutable std::shared_ptr<PaddedCell>          Ghost;
+  mutable std::shared_ptr<GeneralLocalStencil> StapleStencil;
+
+  static accelerator_inline int StapleIndex(int mu,int nu) { return 4*(nu+Nd*mu); }
+
+  bool PaddedStaples(GridBase *grid) const {
+    if ( !Gimpl::isPeriodicGaugeField() ) return false;
+    GridCartesian *cgrid = dynamic_cast<GridCartesian *>(grid);
+    if ( cgrid == nullptr ) return false;
+    if ( Ghost && (Ghost->unpadded_grid == cgrid) ) return true;
+
+    Ghost = std::make_shared<PaddedCell>(1,cgrid);
+    std::vector<Coordinate> shifts;
+    for(int mu=0;mu<Nd;mu++){
+      for(int nu=0;nu<Nd;nu++){
+	Coordinate xpmu(Nd,0);     xpmu[mu] = 1;
+	Coordinate xpnu(Nd,0);     xpnu[nu] = 1;
+	Coordinate xmnu(Nd,0);     xmnu[nu] =-1;
+	Coordinate xpmumnu = xmnu; xpmumnu[mu] += 1;
+	shifts.push_back(xpmu);
+	shifts.push_back(xpnu);
+	shifts.push_back(xmnu);
+	shifts.push_back(xpmumnu);
+      }
+    }
+    StapleStencil = std::make_shared<GeneralLocalStencil>(Ghost->grids.back(),shifts);
+    return true;
+  }
+
 public:
   // Defines the gauge field types
   INHERIT_GIMPL_TYPES(Gimpl)
@@ -62,6 +97,136 @@ public:
 
   ///////////////////////////////////////////////////////////////////////////////
   void smear(GaugeField& u_smr, const GaugeField& U)const{
+    if ( PaddedStaples(U.Grid()) ) smearPadded(u_smr,U);
+    else                           smearCshift(u_smr,U);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  void derivative(GaugeField& SigmaTerm,
+		  const GaugeField& iLambda,
+		  const GaugeField& U)const{
+    if ( PaddedStaples(U.Grid()) ) derivativePadded(SigmaTerm,iLambda,U);
+    else                           derivativeCshift(SigmaTerm,iLambda,U);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // All staples of all directions in one kernel over the padded cell
+  // u_smr[mu] = sum_nu rho_munu ( U_nu(x) U_mu(x+nu) U^dag_nu(x+mu)
+  //                             + U^dag_nu(x-nu) U_mu(x-nu) U_nu(x+mu-nu) )
+  ///////////////////////////////////////////////////////////////////////////////
+  void smearPadded(GaugeField& u_smr, const GaugeField& U)const{
+    GaugeField Ughost = Ghost->Exchange(U);
+    GaugeField Cghost(Ughost.Grid());
+
+    RealD rho_p[Nd*Nd];
+    for(int i=0;i<Nd*Nd;i++) rho_p[i] = rho[i];
+    {
+      autoView( U_v , Ughost, AcceleratorRead);
+      autoView( C_v , Cghost, AcceleratorWrite);
+      auto gStencil_v = StapleStencil->View(AcceleratorRead);
+
+      typedef decltype(coalescedReadGeneralPermute(U_v[0](0),gStencil_v.GetEntry(0,0)->_permute,Nd)) U3matrix;
+
+      accelerator_for(ss,Ughost.Grid()->oSites(),GaugeField::vector_type::Nsimd(),{
+	for(int mu=0;mu<Nd;mu++){
+	  U3matrix Cmu, Unu_x, Unu_xpmu, Umu_xpnu, Unu_xmnu, Umu_xmnu, Unu_xpmumnu;
+	  Cmu = Zero();
+	  for(int nu=0;nu<Nd;nu++){
+	    if ( nu==mu ) continue;
+	    int s = StapleIndex(mu,nu);
+	    auto SE0 = gStencil_v.GetEntry(s+0,ss);
+	    auto SE1 = gStencil_v.GetEntry(s+1,ss);
+	    auto SE2 = gStencil_v.GetEntry(s+2,ss);
+	    auto SE3 = gStencil_v.GetEntry(s+3,ss);
+	    Unu_x       = coalescedRead(U_v[ss](nu));
+	    Unu_xpmu    = coalescedReadGeneralPermute(U_v[SE0->_offset](nu),SE0->_permute,Nd);
+	    Umu_xpnu    = coalescedReadGeneralPermute(U_v[SE1->_offset](mu),SE1->_permute,Nd);
+	    Unu_xmnu    = coalescedReadGeneralPermute(U_v[SE2->_offset](nu),SE2->_permute,Nd);
+	    Umu_xmnu    = coalescedReadGeneralPermute(U_v[SE2->_offset](mu),SE2->_permute,Nd);
+	    Unu_xpmumnu = coalescedReadGeneralPermute(U_v[SE3->_offset](nu),SE3->_permute,Nd);
+	    Cmu = Cmu + rho_p[mu + Nd * nu]*( Unu_x*Umu_xpnu*adj(Unu_xpmu)
+					     + adj(Unu_xmnu)*Umu_xmnu*Unu_xpmumnu );
+	  }
+	  coalescedWrite(C_v[ss](mu),Cmu);
+	}
+      });
+    }
+    u_smr = Ghost->Extract(Cghost);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // Equation 75 of Morningstar, Peardon for all directions in one kernel,
+  // the lower staple contributions being read from x-nu rather than shifted
+  ////////////////////////////////////////////////////////////////////////////////
+  void derivativePadded(GaugeField& SigmaTerm,
+			const GaugeField& iLambda,
+			const GaugeField& U)const{
+    GaugeField Ughost = Ghost->Exchange(U);
+    GaugeField Lghost = Ghost->Exchange(iLambda);
+    GaugeField Sghost(Ughost.Grid());
+
+    RealD rho_p[Nd*Nd];
+    for(int i=0;i<Nd*Nd;i++) rho_p[i] = rho[i];
+    {
+      autoView( U_v , Ughost, AcceleratorRead);
+      autoView( L_v , Lghost, AcceleratorRead);
+      autoView( S_v , Sghost, AcceleratorWrite);
+      auto gStencil_v = StapleStencil->View(AcceleratorRead);
+
+      typedef decltype(coalescedReadGeneralPermute(U_v[0](0),gStencil_v.GetEntry(0,0)->_permute,Nd)) U3matrix;
+
+      accelerator_for(ss,Ughost.Grid()->oSites(),GaugeField::vector_type::Nsimd(),{
+	for(int mu=0;mu<Nd;mu++){
+	  U3matrix Sigma, staple, Umu_xmnu_dag, Unu_xpmumnu_dag;
+	  U3matrix Unu_x, Unu_xpmu, Umu_xpnu, Unu_xmnu, Umu_xmnu, Unu_xpmumnu;
+	  U3matrix Lmu_x, Lnu_x, Lnu_xpmu, Lmu_xpnu, Lmu_xmnu, Lnu_xmnu, Lnu_xpmumnu;
+	  Sigma = Zero();
+	  Lmu_x = coalescedRead(L_v[ss](mu));
+	  for(int nu=0;nu<Nd;nu++){
+	    if ( nu==mu ) continue;
+	    RealD rho_munu = rho_p[mu + Nd * nu];
+	    RealD rho_numu = rho_p[nu + Nd * mu];
+	    int s = StapleIndex(mu,nu);
+	    auto SE0 = gStencil_v.GetEntry(s+0,ss);
+	    auto SE1 = gStencil_v.GetEntry(s+1,ss);
+	    auto SE2 = gStencil_v.GetEntry(s+2,ss);
+	    auto SE3 = gStencil_v.GetEntry(s+3,ss);
+	    Unu_x       = coalescedRead(U_v[ss](nu));
+	    Lnu_x       = coalescedRead(L_v[ss](nu));
+	    Unu_xpmu    = coalescedReadGeneralPermute(U_v[SE0->_offset](nu),SE0->_permute,Nd);
+	    Lnu_xpmu    = coalescedReadGeneralPermute(L_v[SE0->_offset](nu),SE0->_permute,Nd);
+	    Umu_xpnu    = coalescedReadGeneralPermute(U_v[SE1->_offset](mu),SE1->_permute,Nd);
+	    Lmu_xpnu    = coalescedReadGeneralPermute(L_v[SE1->_offset](mu),SE1->_permute,Nd);
+	    Unu_xmnu    = coalescedReadGeneralPermute(U_v[SE2->_offset](nu),SE2->_permute,Nd);
+	    Umu_xmnu    = coalescedReadGeneralPermute(U_v[SE2->_offset](mu),SE2->_permute,Nd);
+	    Lmu_xmnu    = coalescedReadGeneralPermute(L_v[SE2->_offset](mu),SE2->_permute,Nd);
+	    Lnu_xmnu    = coalescedReadGeneralPermute(L_v[SE2->_offset](nu),SE2->_permute,Nd);
+	    Unu_xpmumnu = coalescedReadGeneralPermute(U_v[SE3->_offset](nu),SE3->_permute,Nd);
+	    Lnu_xpmumnu = coalescedReadGeneralPermute(L_v[SE3->_offset](nu),SE3->_permute,Nd);
+
+	    // Upper staple U_nu(x+mu) U^dag_mu(x+nu) U^dag_nu(x)
+	    staple = Unu_xpmu*adj(Umu_xpnu)*adj(Unu_x);
+	    Sigma = Sigma - rho_numu*staple*Lnu_x
+	                  + rho_numu*Lnu_xpmu*staple
+	                  - rho_munu*staple*Unu_x*Lmu_xpnu*adj(Unu_x);
+
+	    // Lower staple, at x-nu
+	    Umu_xmnu_dag    = adj(Umu_xmnu);
+	    Unu_xpmumnu_dag = adj(Unu_xpmumnu);
+	    Sigma = Sigma + Unu_xpmumnu_dag*Umu_xmnu_dag*(rho_numu*Lnu_xmnu - rho_munu*Lmu_xmnu)*Unu_xmnu
+	                  - rho_numu*Unu_xpmumnu_dag*Lnu_xpmumnu*Umu_xmnu_dag*Unu_xmnu;
+	  }
+	  coalescedWrite(S_v[ss](mu),Sigma);
+	}
+      });
+    }
+    SigmaTerm = SigmaTerm + Ghost->Extract(Sghost);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // Staples through Cshift, general boundary conditions
+  ///////////////////////////////////////////////////////////////////////////////
+  void smearCshift(GaugeField& u_smr, const GaugeField& U)const{
     GridBase *grid = U.Grid();
     GaugeLinkField Cup(grid), tmp_stpl(grid);
     WilsonLoops<Gimpl> WL;
@@ -82,9 +247,9 @@ public:
   }
 
   ////////////////////////////////////////////////////////////////////////////////
-  void derivative(GaugeField& SigmaTerm,
-		  const GaugeField& iLambda,
-		  const GaugeField& U)const{
+  void derivativeCshift(GaugeField& SigmaTerm,
+			const GaugeField& iLambda,
+			const GaugeField& U)const{
 
     // Reference
     // Morningstar, Peardon, Phys.Rev.D69,054501(2004)
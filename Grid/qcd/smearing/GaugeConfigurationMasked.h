@@ -868,10 +868,7 @@ private:
     GaugeField SigmaK(grid), iLambda(grid);
     GaugeField SigmaKPrimeA(grid);
     GaugeField SigmaKPrimeB(grid);
-    GaugeLinkField iLambda_mu(grid);
-    GaugeLinkField iQ(grid), e_iQ(grid);
-    GaugeLinkField SigmaKPrime_mu(grid);
-    GaugeLinkField GaugeKmu(grid), Cmu(grid);
+    GaugeLinkField Cmu(grid);
 
     int mmu= (level/2) %Nd;
     int cb= (level%2);
@@ -904,14 +901,21 @@ private:
     int mu =mmu;
     BaseSmear(Cmu, GaugeK,mu,rho);
     {
-      // Cmu = peekLorentz(C, mu);
-      GaugeKmu = peekLorentz(GaugeK, mu);
-      SigmaKPrime_mu = peekLorentz(SigmaKPrimeA, mu);
-      iQ = Ta(Cmu * adj(GaugeKmu));
-      this->set_iLambda(iLambda_mu, e_iQ, iQ, SigmaKPrime_mu, GaugeKmu);
-      pokeLorentz(SigmaK, SigmaKPrime_mu * e_iQ + adj(Cmu) * iLambda_mu, mu);
-      pokeLorentz(iLambda, iLambda_mu, mu);
-      std::cout << " mu "<<mu<<" SigmaKPrime_mu"<<norm2(SigmaKPrime_mu)<< " iLambda_mu " <<norm2(iLambda_mu)<<std::endl;
+      // e^{iQ}, Lambda and Sigma_K for the smeared direction in one pass
+      autoView( Cmu_v    , Cmu         , AcceleratorRead);
+      autoView( U_v      , GaugeK      , AcceleratorRead);
+      autoView( SigmaP_v , SigmaKPrimeA, AcceleratorRead);
+      autoView( SigmaK_v , SigmaK      , AcceleratorWrite);
+      autoView( iLambda_v, iLambda     , AcceleratorWrite);
+      accelerator_for(ss, grid->oSites(), GaugeField::vector_type::Nsimd(), {
+	auto Cs       = coalescedRead(Cmu_v[ss]()());
+	auto Umu      = coalescedRead(U_v[ss](mu)());
+	auto SigmaPmu = coalescedRead(SigmaP_v[ss](mu)());
+	StoutSiteExp<decltype(Umu)> E(Ta(Cs * adj(Umu)));
+	auto iLambda_mu = E.Lambda(Umu * SigmaPmu);
+	coalescedWrite(iLambda_v[ss](mu)(), iLambda_mu);
+	coalescedWrite(SigmaK_v[ss](mu)(), SigmaPmu * E.Exponential() + adj(Cs) * iLambda_mu);
+      });
     }
     //    GaugeField SigmaKcopy(grid);
     //    SigmaKcopy = SigmaK;
@@ -35,6 +35,129 @@
 
 NAMESPACE_BEGIN(Grid);
 
+/*!  @brief Cayley-Hamilton exponential of one SU(3) algebra element.
+
+  Site local form of Morningstar and Peardon, hep-lat/0311018, eqs (29)-(34)
+  for e^{iQ} and (65)-(74) for Lambda. The colour matrix and all coefficients
+  live in registers, so stout smearing and its force recursion run in a single
+  kernel with no lattice wide scalar temporaries. The matrix type is the SIMD
+  colour matrix on CPU and the lane scalar one inside an accelerator_for.
+*/
+template <class mat>
+class StoutSiteExp {
+public:
+  typedef typename mat::vector_type cplx;
+  typedef iScalar<cplx> scalar;
+
+  mat iQ, iQ2;
+  scalar u, w, u2, w2, xi0, cosw, emiu, e2iu;
+  scalar f0, f1, f2;
+
+  // input matrix is anti-hermitian NOT hermitian
+  accelerator_inline StoutSiteExp(const mat &_iQ) : iQ(_iQ) {
+    const RealD one_over_three = 1.0 / 3.0;
+    scalar unity, trQ2, trQ3, c0, c1, tmp, c0max, theta;
+    scalar ixi0, h0, h1, h2, fden;
+    mat iQ3;
+
+    unity = 1.0;
+    iQ2 = iQ * iQ;
+    iQ3 = iQ * iQ2;
+
+    // sign in c0 from the conventions on the Ta; real and imaginary parts
+    // are taken through the conjugate so the scalars stay complex typed
+    trQ2 = trace(iQ2);
+    trQ3 = trace(iQ3);
+    c0 = timesI(trQ3 - conjugate(trQ3)) * (0.5 * one_over_three);
+    c1 = (trQ2 + conjugate(trQ2)) * (-0.25);
+
+    tmp = c1 * one_over_three;
+    c0max = 2.0 * pow(tmp, 1.5);
+    theta = acos(c0 / c0max) * one_over_three;
+    u = sqrt(tmp) * cos(theta);
+    w = sqrt(c1) * sin(theta);
+
+    xi0 = sin(w) / w;
+    u2 = u * u;
+    w2 = w * w;
+    cosw = cos(w);
+
+    ixi0 = timesI(xi0);
+    emiu = cos(u) - timesI(sin(u));
+    e2iu = cos(2.0 * u) + timesI(sin(2.0 * u));
+
+    h0 = e2iu * (u2 - w2) +
+      emiu * ((8.0 * u2 * cosw) + (2.0 * u * (3.0 * u2 + w2) * ixi0));
+    h1 = e2iu * (2.0 * u) - emiu * ((2.0 * u * cosw) - (3.0 * u2 - w2) * ixi0);
+    h2 = e2iu - emiu * (cosw + (3.0 * u) * ixi0);
+
+    fden = unity / (9.0 * u2 - w2);  // reals
+    f0 = h0 * fden;
+    f1 = h1 * fden;
+    f2 = h2 * fden;
+  }
+
+  accelerator_inline mat Exponential(void) const {
+    mat e_iQ = timesMinusI(f1) * iQ - f2 * iQ2;
+    for (int c = 0; c < 3; c++) e_iQ._internal[c][c] = e_iQ._internal[c][c] + f0._internal;
+    return e_iQ;
+  }
+
+  // iLambda for USigmap = U Sigma'
+  accelerator_inline mat Lambda(const mat &USigmap) const {
+    scalar unity, xi1;
+    scalar r01, r11, r21, r02, r12, r22, fden;
+    scalar b10, b11, b12, b20, b21, b22, tr1, tr2;
+    mat B1, B2, iGamma;
+
+    unity = 1.0;
+    xi1 = cosw / w2 - sin(w) / (w2 * w);
+
+    r01 = (2.0 * u + timesI(2.0 * (u2 - w2))) * e2iu +
+      emiu * ((16.0 * u * cosw + 2.0 * u * (3.0 * u2 + w2) * xi0) +
+	      timesI(-8.0 * u2 * cosw + 2.0 * (9.0 * u2 + w2) * xi0));
+
+    r11 = (2.0 * unity + timesI(4.0 * u)) * e2iu +
+      emiu * ((-2.0 * cosw + (3.0 * u2 - w2) * xi0) +
+	      timesI((2.0 * u * cosw + 6.0 * u * xi0)));
+
+    r21 = 2.0 * timesI(e2iu) + emiu * (-3.0 * u * xi0 + timesI(cosw - 3.0 * xi0));
+
+    r02 = -2.0 * e2iu +
+      emiu * (-8.0 * u2 * xi0 +
+	      timesI(2.0 * u * (cosw + xi0 + 3.0 * u2 * xi1)));
+
+    r12 = emiu * (2.0 * u * xi0 + timesI(-cosw - xi0 + 3.0 * u2 * xi1));
+
+    r22 = emiu * (xi0 - timesI(3.0 * u * xi1));
+
+    fden = unity / (2.0 * (9.0 * u2 - w2) * (9.0 * u2 - w2));
+
+    b10 = (2.0 * u * r01 + (3.0 * u2 - w2) * r02 - (30.0 * u2 + 2.0 * w2) * f0) * fden;
+    b11 = (2.0 * u * r11 + (3.0 * u2 - w2) * r12 - (30.0 * u2 + 2.0 * w2) * f1) * fden;
+    b12 = (2.0 * u * r21 + (3.0 * u2 - w2) * r22 - (30.0 * u2 + 2.0 * w2) * f2) * fden;
+
+    b20 = (r01 - (3.0 * u) * r02 - (24.0 * u) * f0) * fden;
+    b21 = (r11 - (3.0 * u) * r12 - (24.0 * u) * f1) * fden;
+    b22 = (r21 - (3.0 * u) * r22 - (24.0 * u) * f2) * fden;
+
+    B1 = timesMinusI(b11) * iQ - b12 * iQ2;
+    B2 = timesMinusI(b21) * iQ - b22 * iQ2;
+    for (int c = 0; c < 3; c++) {
+      B1._internal[c][c] = B1._internal[c][c] + b10._internal;
+      B2._internal[c][c] = B2._internal[c][c] + b20._internal;
+    }
+
+    tr1 = trace(USigmap * B1);
+    tr2 = trace(USigmap * B2);
+
+    iGamma = tr1 * iQ - timesI(tr2) * iQ2 +
+      timesI(f1) * USigmap + f2 * (iQ * USigmap + USigmap * iQ);
+
+    return Ta(iGamma);
+  }
+};
+
 /*!  @brief Stout smearing of link variable. */
 template <class Gimpl>
 class Smear_Stout : public Smear<Gimpl> {
@@ -83,23 +206,29 @@ public:
 
   void smear(GaugeField& u_smr, const GaugeField& U) const {
     GaugeField C(U.Grid());
-    GaugeLinkField tmp(U.Grid()), iq_mu(U.Grid()), Umu(U.Grid());
 
     std::cout << GridLogDebug << "Stout smearing started\n";
 
     // C contains the staples multiplied by some rho
-    u_smr = U ; // set the smeared field to the current gauge field
     SmearBase->smear(C, U);
 
-    for (int mu = 0; mu < Nd; mu++) {
-      if( mu == OrthogDim ) continue ;
-      // u_smr = exp(iQ_mu)*U_mu apart from Orthogdim
-      Umu = peekLorentz(U, mu);
-      tmp = peekLorentz(C, mu);
-      iq_mu = Ta( tmp * adj(Umu));  
-      exponentiate_iQ(tmp, iq_mu);
-      pokeLorentz(u_smr, tmp * Umu, mu);
-    }
+    // u_smr = exp(iQ_mu)*U_mu apart from Orthogdim
+    int orthog = OrthogDim;
+    autoView( U_v    , U    , AcceleratorRead);
+    autoView( C_v    , C    , AcceleratorRead);
+    autoView( smr_v  , u_smr, AcceleratorWrite);
+    accelerator_for(ss, U.Grid()->oSites(), GaugeField::vector_type::Nsimd(), {
+      for (int mu = 0; mu < Nd; mu++) {
+	auto Umu = coalescedRead(U_v[ss](mu)());
+	if ( mu == orthog ) {
+	  coalescedWrite(smr_v[ss](mu)(), Umu);
+	  continue;
+	}
+	auto Cmu = coalescedRead(C_v[ss](mu)());
+	StoutSiteExp<decltype(Umu)> E(Ta(Cmu * adj(Umu)));
+	coalescedWrite(smr_v[ss](mu)(), E.Exponential() * Umu);
+      }
+    });
     std::cout << GridLogDebug << "Stout smearing completed\n";
   };
 
@@ -113,34 +242,16 @@ public:
   };
 
 
-  // Repetion of code here (use the Tensor_exp.h function)
+  // only valid for SU(3) matrices; one Lorentz direction at a time
+  // input matrix is anti-hermitian NOT hermitian
   void exponentiate_iQ(GaugeLinkField& e_iQ, const GaugeLinkField& iQ) const {
-    // Put this outside
-    // only valid for SU(3) matrices
-
-    // only one Lorentz direction at a time
-
-    // notice that it actually computes
-    // exp ( input matrix )
-    // the i sign is coming from outside
-    // input matrix is anti-hermitian NOT hermitian
-
-    GridBase* grid = iQ.Grid();
-    GaugeLinkField unity(grid);
-    unity = 1.0;
-
-    GaugeLinkField iQ2(grid), iQ3(grid);
-    LatticeComplex u(grid), w(grid);
-    LatticeComplex f0(grid), f1(grid), f2(grid);
-
-    iQ2 = iQ * iQ;
-    iQ3 = iQ * iQ2;
-
-    //We should check sgn(c0) here already and then apply eq (34) from 0311018
-    set_uw(u, w, iQ2, iQ3);
-    set_fj(f0, f1, f2, u, w);
-
-    e_iQ = f0 * unity + timesMinusI(f1) * iQ - f2 * iQ2;
+    autoView( iQ_v , iQ  , AcceleratorRead);
+    autoView( e_v  , e_iQ, AcceleratorWrite);
+    accelerator_for(ss, iQ.Grid()->oSites(), GaugeLinkField::vector_type::Nsimd(), {
+      auto iQs = coalescedRead(iQ_v[ss]()());
+      StoutSiteExp<decltype(iQs)> E(iQs);
+      coalescedWrite(e_v[ss]()(), E.Exponential());
+    });
   };
 
   void set_uw(LatticeComplex& u, LatticeComplex& w, GaugeLinkField& iQ2,
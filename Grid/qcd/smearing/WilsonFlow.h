@@ -41,18 +41,59 @@ public:
 protected:
   std::vector< std::pair<int, FunctionType> > functions; //The int maps to the measurement frequency
 
+  //Default measurements, interval 0 disables
+  int energy_meas_interval;
+  int topq_meas_interval;
+
   mutable WilsonGaugeAction<Gimpl> SG;
-   
+
+  //Staples of the Wilson action, output mu sums the 2(Nd-1) staples of the mu links
+  GaugeLinkPaths<Gimpl> staples;
+
+  //1x1 clover leaves of the field strength, for the charge and cloverleaf energy measurements
+  GaugeLinkPaths<Gimpl> clover;
+
+  //sum_x,mu Re tr U_mu S_mu and global volume of the field handed to the measurements,
+  //from the force of the next step
+  mutable RealD staple_trace;
+  mutable RealD staple_sites;
+
+  //One fused RK3 stage on every link:  Z = c2*(c1*Z + F(U)),  U = exp(-2 eps Z) U  if eps != 0
+  //F(U) is the Wilson action force; returns sum_x,mu Re tr U_mu S_mu of the U the force was taken on
+  RealD fusedStage(typename Gimpl::GaugeField &U, typename Gimpl::GaugeField &Z, RealD c1, RealD c2, RealD eps) const;
+
+  //Z = F(U) for the first stage of the next step, keeping the staple trace of U for energyDensityPlaquetteFlowed
+  void nextForce(typename Gimpl::GaugeField &U, typename Gimpl::GaugeField &Z) const{
+    staple_trace = fusedStage(U, Z, 0.0, 1.0, 0.0);
+    staple_sites = U.Grid()->gSites();
+  }
+
+  //Run the measurements due at this step
+  bool measurementDue(int step) const;
+  void measure(int step, RealD t, const typename Gimpl::GaugeField &U) const;
+
 public:
   INHERIT_GIMPL_TYPES(Gimpl)
 
   explicit WilsonFlowBase(unsigned int meas_interval =1):
     SG(WilsonGaugeAction<Gimpl>(3.0)) {
     // WilsonGaugeAction with beta 3.0
+    for(int mu=0;mu<Nd;mu++){
+      Coordinate xpmu(Nd,0); xpmu[mu]=1;
+      for(int nu=0;nu<Nd;nu++){
+	if ( nu==mu ) continue;
+	GaugeLinkPath upper(xpmu), lower(xpmu);
+	upper.Forward(nu).Backward(mu).Backward(nu);
+	lower.Backward(nu).Backward(mu).Forward(nu);
+	staples.AddPath(mu,upper);
+	staples.AddPath(mu,lower);
+      }
+    }
+    WilsonLoops<Gimpl>::FieldStrengthMxNPaths(clover,1,1);
     setDefaultMeasurements(meas_interval);
   }
     
-  void resetActions(){ functions.clear(); }
+  void resetActions(){ functions.clear(); energy_meas_interval=0; topq_meas_interval=0; }
 
   void addMeasurement(int meas_interval, FunctionType meas){ functions.push_back({meas_interval, meas}); }
 
@@ -67,12 +108,24 @@ public:
     // undefined for WilsonFlow
   }
 
+  //Flow several configurations at once, one per sub-communicator of split_grid
+  //in.size() must be the number of sub-communicators; measurements see the split field
+  void smear(std::vector<GaugeField> &out, const std::vector<GaugeField> &in, GridCartesian *split_grid) const;
+  using Smear<Gimpl>::smear;
+
   //Compute t^2 <E(t)> for time t from the plaquette
   static RealD energyDensityPlaquette(const RealD t, const GaugeField& U);
 
+  //t^2 <E(t)> from the plaquette of the field passed to the current measurement,
+  //taken from the staples of the next flow step at no extra cost.
+  //Only valid inside a measurement added to this flow, for the field handed to it;
+  //use energyDensityPlaquette(t,U) for any other field
+  RealD energyDensityPlaquetteFlowed(const RealD t) const;
+
   //Compute t^2 <E(t)> for time t from the 1x1 cloverleaf form
   //t is the Wilson flow time
   static RealD energyDensityCloverleaf(const RealD t, const GaugeField& U);
+  static RealD energyDensityCloverleaf(const RealD t, const GaugeField& U, const GaugeLinkPaths<Gimpl> &clover);
   
   //Evolve the gauge field by Nstep steps of epsilon and return the energy density computed every interval steps
   //The smeared field is output as V
@@ -98,7 +151,8 @@ private:
   RealD epsilon;  //step size
 
   //Evolve the gauge field by 1 step of size eps and update tau
-  void evolve_step(typename Gimpl::GaugeField &U, RealD &tau) const;
+  //On entry Z holds the force F(U), on exit the force of the evolved field if lookahead is set
+  void evolve_step(typename Gimpl::GaugeField &U, typename Gimpl::GaugeField &Z, RealD &tau, bool lookahead) const;
 
 public:
   INHERIT_GIMPL_TYPES(Gimpl)
@@ -107,6 +161,7 @@ public:
   WilsonFlow(const RealD epsilon, const int Nstep, unsigned int meas_interval = 1): WilsonFlowBase<Gimpl>(meas_interval), Nstep(Nstep), epsilon(epsilon){}
 
   void smear(GaugeField& out, const GaugeField& in) const override;
+  using WilsonFlowBase<Gimpl>::smear;
 };
 
 //Wilson flow with adaptive step size
@@ -116,6 +171,7 @@ private:
   RealD init_epsilon; //initial step size
   RealD maxTau; //integrate to t=maxTau
   RealD tolerance; //integration error tolerance
+  mutable unsigned int step_count; //successful steps so far
 
   //Evolve the gauge field by 1 step and update tau and the current time step eps
   //
@@ -124,7 +180,10 @@ private:
   //value for the next iteration.
   //
   //For a successful integration step the function will return 1
-  int evolve_step_adaptive(typename Gimpl::GaugeField&U, RealD &tau, RealD &eps) const;
+  //
+  //On entry Z holds the force F(U); on exit it holds the force of the field returned, unless
+  //a successful step reaches maxTau
+  int evolve_step_adaptive(typename Gimpl::GaugeField&U, typename Gimpl::GaugeField &Z, RealD &tau, RealD &eps) const;
 
 public:
   INHERIT_GIMPL_TYPES(Gimpl)
@@ -133,40 +192,91 @@ public:
   WilsonFlowBase<Gimpl>(meas_interval), init_epsilon(init_epsilon), maxTau(maxTau), tolerance(tolerance){}
 
   void smear(GaugeField& out, const GaugeField& in) const override;
+  using WilsonFlowBase<Gimpl>::smear;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 // Implementations
 ////////////////////////////////////////////////////////////////////////////////
+template <class Gimpl>
+RealD WilsonFlowBase<Gimpl>::fusedStage(typename Gimpl::GaugeField &U, typename Gimpl::GaugeField &Z, RealD c1, RealD c2, RealD eps) const{
+  GRID_TRACE("WilsonFlowStage");
+  typedef typename GaugeLinkField::vector_object vobj;
+  typedef LatticeView<vobj> View;
+
+  std::vector<GaugeLinkField> S;
+  staples.Evaluate(S, U);
+
+  ComplexField trUS(U.Grid());
+  RealD factor = 0.5 * 3.0 / RealD(Nc); // WilsonGaugeAction::deriv with beta 3.0
+  bool update = (eps != 0.0);
+  RealD ep = -2.0*eps;
+  {
+    autoView( U_v , U, AcceleratorWrite);
+    autoView( Z_v , Z, AcceleratorWrite);
+    autoView( t_v , trUS, AcceleratorWrite);
+    Vector<View> S_v; S_v.reserve(Nd);
+    for(int mu=0;mu<Nd;mu++) S_v.push_back(S[mu].View(AcceleratorRead));
+    View *S_p = &S_v[0];
+    accelerator_for(ss, U.Grid()->oSites(), vobj::Nsimd(), {
+      auto Us = U_v(ss);
+      auto Zs = Z_v(ss);
+      decltype(coalescedRead(t_v[0])) tr;
+      tr = Zero();
+      for(int mu=0;mu<Nd;mu++){
+	auto US = Us(mu) * S_p[mu](ss)();
+	tr() = tr() + trace(US);
+	Zs(mu) = c2 * ( c1 * Zs(mu) + factor * Ta(US) );
+	if ( update ) Us(mu) = Gimpl::update_link(Zs(mu), Us(mu), ep);
+      }
+      coalescedWrite(Z_v[ss], Zs);
+      coalescedWrite(t_v[ss], tr);
+      if ( update ) coalescedWrite(U_v[ss], Us);
+    });
+    for(int mu=0;mu<Nd;mu++) S_v[mu].ViewClose();
+  }
+  return TensorRemove(sum(trUS)).real();
+}
+
 template <class Gimpl>
 RealD WilsonFlowBase<Gimpl>::energyDensityPlaquette(const RealD t, const GaugeField& U){
   static WilsonGaugeAction<Gimpl> SG(3.0);
   return 2.0 * t * t * SG.S(U)/U.Grid()->gSites();
 }
 
+//Every plaquette appears in four of the U S products
+template <class Gimpl>
+RealD WilsonFlowBase<Gimpl>::energyDensityPlaquetteFlowed(const RealD t) const{
+  RealD faces = (1.0 * Nd * (Nd - 1)) / 2.0;
+  RealD plaq  = staple_trace / 4.0 / staple_sites / faces / Nc;
+  return 2.0 * t * t * 3.0 * (1.0 - plaq) * faces;
+}
+
 //Compute t^2 <E(t)> for time from the 1x1 cloverleaf form
 template <class Gimpl>
 RealD WilsonFlowBase<Gimpl>::energyDensityCloverleaf(const RealD t, const GaugeField& U){
+  GaugeLinkPaths<Gimpl> clover;
+  WilsonLoops<Gimpl>::FieldStrengthMxNPaths(clover,1,1);
+  return energyDensityCloverleaf(t,U,clover);
+}
+
+//As above with the clover leaves from WilsonLoops::FieldStrengthMxNPaths(clover,1,1) held by the caller
+template <class Gimpl>
+RealD WilsonFlowBase<Gimpl>::energyDensityCloverleaf(const RealD t, const GaugeField& U, const GaugeLinkPaths<Gimpl> &clover){
   typedef typename Gimpl::GaugeLinkField GaugeMat;
-  typedef typename Gimpl::GaugeField GaugeLorentz;
 
   assert(Nd == 4);
   //E = 1/2 tr( F_munu F_munu )
   //However as  F_numu = -F_munu, only need to sum the trace of the squares of the following 6 field strengths:
   //F_01 F_02 F_03   F_12 F_13  F_23
-  GaugeMat F(U.Grid());
-  LatticeComplexD R(U.Grid());
-  R = Zero();
-  
-  for(int mu=0;mu<3;mu++){
-    for(int nu=mu+1;nu<4;nu++){
-      WilsonLoops<Gimpl>::FieldStrength(F, U, mu, nu);
-      R = R + trace(F*F);
-    }
-  }
+  //all six from one evaluation of the clover paths
+  std::vector<std::vector<GaugeMat> > F;
+  WilsonLoops<Gimpl>::FieldStrengthMxNAll(F, U, 1, 1, clover);
+  ComplexField R(U.Grid());
+  WilsonLoops<Gimpl>::EnergyDensityCloverleaf(R, F);
   ComplexD out = sum(R);
   out = t*t*out / RealD(U.Grid()->gSites());
-  return -real(out); //minus sign necessary for +ve energy
+  return real(out);
 }
 
 
@@ -174,9 +284,9 @@ template <class Gimpl>
 std::vector<RealD> WilsonFlowBase<Gimpl>::flowMeasureEnergyDensityPlaquette(GaugeField &V, const GaugeField& U, int measure_interval){
   std::vector<RealD> out;
   resetActions();
-  addMeasurement(measure_interval, [&out](int step, RealD t, const typename Gimpl::GaugeField &U){ 
+  addMeasurement(measure_interval, [this,&out](int step, RealD t, const typename Gimpl::GaugeField &U){ 
       std::cout << GridLogMessage << "[WilsonFlow] Computing plaquette energy density for step " << step << std::endl;
-      out.push_back( energyDensityPlaquette(t,U) );
+      out.push_back( energyDensityPlaquetteFlowed(t) );
     });      
   smear(V,U);
   return out;
@@ -192,9 +302,9 @@ template <class Gimpl>
 std::vector<RealD> WilsonFlowBase<Gimpl>::flowMeasureEnergyDensityCloverleaf(GaugeField &V, const GaugeField& U, int measure_interval){
   std::vector<RealD> out;
   resetActions();
-  addMeasurement(measure_interval, [&out](int step, RealD t, const typename Gimpl::GaugeField &U){ 
+  addMeasurement(measure_interval, [this,&out](int step, RealD t, const typename Gimpl::GaugeField &U){ 
       std::cout << GridLogMessage << "[WilsonFlow] Computing Cloverleaf energy density for step " << step << std::endl;
-      out.push_back( energyDensityCloverleaf(t,U) );
+      out.push_back( energyDensityCloverleaf(t,U,clover) );
     });      
   smear(V,U);
   return out;
@@ -208,33 +318,57 @@ std::vector<RealD> WilsonFlowBase<Gimpl>::flowMeasureEnergyDensityCloverleaf(con
 
 template <class Gimpl>
 void WilsonFlowBase<Gimpl>::setDefaultMeasurements(int topq_meas_interval){
-  addMeasurement(1, [](int step, RealD t, const typename Gimpl::GaugeField &U){
-      std::cout << GridLogMessage << "[WilsonFlow] Energy density (plaq) : "  << step << "  " << t << "  " << energyDensityPlaquette(t,U) << std::endl;
-    });
-  addMeasurement(topq_meas_interval, [](int step, RealD t, const typename Gimpl::GaugeField &U){
-      std::cout << GridLogMessage << "[WilsonFlow] Top. charge           : "  << step << "  " << WilsonLoops<Gimpl>::TopologicalCharge(U) << std::endl;
-    });
+  energy_meas_interval = 1;
+  this->topq_meas_interval = topq_meas_interval;
+}
+
+template <class Gimpl>
+bool WilsonFlowBase<Gimpl>::measurementDue(int step) const{
+  if ( energy_meas_interval && (step % energy_meas_interval == 0) ) return true;
+  if ( topq_meas_interval   && (step % topq_meas_interval   == 0) ) return true;
+  for(auto const &meas : functions)
+    if( step % meas.first == 0 ) return true;
+  return false;
+}
+
+template <class Gimpl>
+void WilsonFlowBase<Gimpl>::measure(int step, RealD t, const typename Gimpl::GaugeField &U) const{
+  if ( energy_meas_interval && (step % energy_meas_interval == 0) )
+    std::cout << GridLogMessage << "[WilsonFlow] Energy density (plaq) : "  << step << "  " << t << "  " << energyDensityPlaquetteFlowed(t) << std::endl;
+  if ( topq_meas_interval && (step % topq_meas_interval == 0) )
+    std::cout << GridLogMessage << "[WilsonFlow] Top. charge           : "  << step << "  " << WilsonLoops<Gimpl>::TopologicalCharge(U,clover) << std::endl;
+  for(auto const &meas : functions)
+    if( step % meas.first == 0 ) meas.second(step,t,U);
 }
 
+template <class Gimpl>
+void WilsonFlowBase<Gimpl>::smear(std::vector<GaugeField> &out, const std::vector<GaugeField> &in, GridCartesian *split_grid) const{
+  assert(in.size()>0);
+  GridBase *grid = in[0].Grid();
+  int nvector = grid->_Nprocessors / split_grid->_Nprocessors;
+  assert(in.size() == nvector);
+  assert(nvector*split_grid->_Nprocessors == grid->_Nprocessors);
+
+  std::vector<GaugeField> full(in);
+  GaugeField split(split_grid);
+  Grid_split(full, split);
+  GaugeField split_out(split_grid);
+  smear(split_out, split);
+  out.resize(nvector, grid);
+  Grid_unsplit(out, split_out);
+}
 
 
+//Each stage is one pass over the links fusing staples, force, Z recursion and link update.
+//The force of the first stage of the next step is taken as soon as a step completes, so
+//the plaquette measurements reuse its staples.
 template <class Gimpl>
-void WilsonFlow<Gimpl>::evolve_step(typename Gimpl::GaugeField &U, RealD &tau) const{
-  GaugeField Z(U.Grid());
-  GaugeField tmp(U.Grid());
-  this->SG.deriv(U, Z);
-  Z *= 0.25;                                  // Z0 = 1/4 * F(U)
-  Gimpl::update_field(Z, U, -2.0*epsilon);    // U = W1 = exp(ep*Z0)*W0
-
-  Z *= -17.0/8.0;
-  this->SG.deriv(U, tmp); Z += tmp;                 // -17/32*Z0 +Z1
-  Z *= 8.0/9.0;                               // Z = -17/36*Z0 +8/9*Z1
-  Gimpl::update_field(Z, U, -2.0*epsilon);    // U_= W2 = exp(ep*Z)*W1
-
-  Z *= -4.0/3.0;
-  this->SG.deriv(U, tmp); Z += tmp;                 // 4/3*(17/36*Z0 -8/9*Z1) +Z2
-  Z *= 3.0/4.0;                               // Z = 17/36*Z0 -8/9*Z1 +3/4*Z2
-  Gimpl::update_field(Z, U, -2.0*epsilon);    // V(t+e) = exp(ep*Z)*W2
+void WilsonFlow<Gimpl>::evolve_step(typename Gimpl::GaugeField &U, typename Gimpl::GaugeField &Z, RealD &tau, bool lookahead) const{
+  Z *= 0.25;                                          // Z0 = 1/4 * F(U)
+  Gimpl::update_field(Z, U, -2.0*epsilon);            // U = W1 = exp(ep*Z0)*W0
+  this->fusedStage(U, Z, -17.0/8.0, 8.0/9.0, epsilon);  // Z = -17/36*Z0 +8/9*Z1,  U_= W2 = exp(ep*Z)*W1
+  this->fusedStage(U, Z, -4.0/3.0, 3.0/4.0, epsilon);   // Z = 17/36*Z0 -8/9*Z1 +3/4*Z2,  V(t+e) = exp(ep*Z)*W2
+  if ( lookahead ) this->nextForce(U, Z);              // Z = F(V(t+e))
   tau += epsilon;
 }
 
@@ -248,51 +382,44 @@ void WilsonFlow<Gimpl>::smear(GaugeField& out, const GaugeField& in) const{
 	    << "[WilsonFlow] full trajectory : " << Nstep * epsilon << std::endl;
 
   out = in;
+  GaugeField Z(in.Grid());
+  Z = Zero();
+  this->nextForce(out, Z);
   RealD taus = 0.;
   for (unsigned int step = 1; step <= Nstep; step++) { //step indicates the number of smearing steps applied at the time of measurement
+    bool due = this->measurementDue(step);
     auto start = std::chrono::high_resolution_clock::now();
-    evolve_step(out, taus);
+    evolve_step(out, Z, taus, (step < Nstep) || due);
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> diff = end - start;
 #ifdef WF_TIMING
     std::cout << "Time to evolve " << diff.count() << " s\n";
 #endif
     //Perform measurements
-    for(auto const &meas : this->functions)
-      if( step % meas.first == 0 ) meas.second(step,taus,out);
+    if ( due ) this->measure(step,taus,out);
   }
 }
 
 
 
 template <class Gimpl>
-int WilsonFlowAdaptive<Gimpl>::evolve_step_adaptive(typename Gimpl::GaugeField &U, RealD &tau, RealD &eps) const{
+int WilsonFlowAdaptive<Gimpl>::evolve_step_adaptive(typename Gimpl::GaugeField &U, typename Gimpl::GaugeField &Z, RealD &tau, RealD &eps) const{
   if (maxTau - tau < eps){
     eps = maxTau-tau;
   }
   //std::cout << GridLogMessage << "Integration epsilon : " << epsilon << std::endl;
-  GaugeField Z(U.Grid());
   GaugeField Zprime(U.Grid());
-  GaugeField tmp(U.Grid()), Uprime(U.Grid()), Usave(U.Grid());
+  GaugeField Uprime(U.Grid()), Usave(U.Grid());
   Uprime = U;
   Usave = U;
 
-  this->SG.deriv(U, Z);
-  Zprime = -Z;
-  Z *= 0.25;                                  // Z0 = 1/4 * F(U)
-  Gimpl::update_field(Z, U, -2.0*eps);    // U = W1 = exp(ep*Z0)*W0
+  Z *= 0.25;                                          // Z0 = 1/4 * F(U)
+  Zprime = 0.25*Z;                                    // Z' = -F(U) + 2 F(W1) = 1/4 Z0 + 9/4 Z below
+  Gimpl::update_field(Z, U, -2.0*eps);                // U = W1 = exp(ep*Z0)*W0
 
-  Z *= -17.0/8.0;
-  this->SG.deriv(U, tmp); Z += tmp;                 // -17/32*Z0 +Z1
-  Zprime += 2.0*tmp;
-  Z *= 8.0/9.0;                               // Z = -17/36*Z0 +8/9*Z1
-  Gimpl::update_field(Z, U, -2.0*eps);    // U_= W2 = exp(ep*Z)*W1
-    
-
-  Z *= -4.0/3.0;
-  this->SG.deriv(U, tmp); Z += tmp;                 // 4/3*(17/36*Z0 -8/9*Z1) +Z2
-  Z *= 3.0/4.0;                               // Z = 17/36*Z0 -8/9*Z1 +3/4*Z2
-  Gimpl::update_field(Z, U, -2.0*eps);    // V(t+e) = exp(ep*Z)*W2
+  this->fusedStage(U, Z, -17.0/8.0, 8.0/9.0, eps);      // Z = -17/36*Z0 +8/9*Z1,  U_= W2 = exp(ep*Z)*W1
+  Zprime += (9.0/4.0)*Z;
+  this->fusedStage(U, Z, -4.0/3.0, 3.0/4.0, eps);       // Z = 17/36*Z0 -8/9*Z1 +3/4*Z2,  V(t+e) = exp(ep*Z)*W2
 
   // Ramos arXiv:1301.4388
   Gimpl::update_field(Zprime, Uprime, -2.0*eps); // V'(t+e) = exp(ep*Z')*W0
@@ -318,6 +445,10 @@ int WilsonFlowAdaptive<Gimpl>::evolve_step_adaptive(typename Gimpl::GaugeField &
   eps = eps*0.95*std::pow(tolerance/max_dist,1./3.);
   std::cout << GridLogMessage << "Adaptive smearing : Distance: "<< max_dist <<" Step successful: " << ret << " New epsilon: " << eps << std::endl; 
 
+  // Force for the next attempt; after the final step only if it is measured
+  if ( (tau < maxTau) || this->measurementDue(step_count+ret) )
+    this->nextForce(U, Z);
+
   return ret;
 }
 
@@ -330,17 +461,19 @@ void WilsonFlowAdaptive<Gimpl>::smear(GaugeField& out, const GaugeField& in) con
   std::cout << GridLogMessage
 	    << "[WilsonFlow] tolerance   : " << tolerance << std::endl;
   out = in;
+  GaugeField Z(in.Grid());
+  Z = Zero();
+  this->nextForce(out, Z);
   RealD taus = 0.;
   RealD eps = init_epsilon;
-  unsigned int step = 0;
+  step_count = 0;
   do{
-    int step_success = evolve_step_adaptive(out, taus, eps); 
-    step += step_success; //step will not be incremented if the integration step fails
+    int step_success = evolve_step_adaptive(out, Z, taus, eps); 
+    step_count += step_success; //step will not be incremented if the integration step fails
 
     //Perform measurements
-    if(step_success)
-      for(auto const &meas : this->functions)
-	if( step % meas.first == 0 ) meas.second(step,taus,out);
+    if(step_success && this->measurementDue(step_count))
+      this->measure(step_count,taus,out);
   } while (taus < maxTau);
 }
 
@@ -6,8 +6,19 @@ NAMESPACE_BEGIN(Grid);
 
 #undef DELTA_F_EQ_2
 
+////////////////////////////////////////////////////////////////////////////////////////
+// MesonFieldGemm selects the blocked GEMM formulation of MesonField on host builds
+// (--meson-field-gemm). It does the flops of the site loop, but its colour stage is a
+// batch of Nc deep products that BLAS runs well below peak, so it is off by default.
+// Benchmark_meson_field scans both paths over block size and momenta.
+////////////////////////////////////////////////////////////////////////////////////////
+class A2AutilsStatic {
+public:
+  static int MesonFieldGemm;
+};
+
 template <typename FImpl>
-class A2Autils 
+class A2Autils : public A2AutilsStatic
 {
 public:
   typedef typename FImpl::ComplexField ComplexField;
@@ -120,6 +131,13 @@ public:
 			int orthogdim);
 #endif
 private:
+  template <typename TensorType>
+  static void MesonFieldKernelGemm(TensorType &mat, 
+				   const FermionField *lhs_wi,
+				   const FermionField *rhs_vj,
+				   std::vector<Gamma::Algebra> gammas,
+				   const std::vector<ComplexField > &mom,
+				   int orthogdim, double *t_kernel, double *t_gsum);
   inline static void OuterProductWWVV(PropagatorField &WWVV,
                                const vobj &lhs,
                                const vobj &rhs,
@@ -160,10 +178,26 @@ void A2Autils<FImpl>::MesonField(TensorType &mat,
   int ld=grid->_ldimensions[orthogdim];
   int rd=grid->_rdimensions[orthogdim];
 
+#if !defined(GRID_CUDA) && !defined(GRID_HIP) && !defined(GRID_SYCL)
+  if ( MesonFieldGemm ) {
+    MesonFieldKernelGemm(mat,lhs_wi,rhs_vj,gammas,mom,orthogdim,t_kernel,t_gsum);
+    return;
+  }
+#endif
+
+  int e1=    grid->_slice_nblock[orthogdim];
+  int e2=    grid->_slice_block [orthogdim];
+  int stride=grid->_slice_stride[orthogdim];
+
+  // Each plane's sites are split into nchunk chunks so that every thread has sites
+  // to work on when the local time extent is small; chunks are summed below.
+  int nsite  = e1*e2;
+  int nchunk = std::max(1,std::min(nsite,(GridThread::GetThreads()+rd-1)/rd));
+
   // will locally sum vectors first
   // sum across these down to scalars
   // splitting the SIMD
-  int MFrvol = rd*Lblock*Rblock*Nmom;
+  int MFrvol = rd*nchunk*Lblock*Rblock*Nmom;
   int MFlvol = ld*Lblock*Rblock*Nmom;
 
   Vector<SpinMatrix_v > lvSum(MFrvol);
@@ -176,54 +210,57 @@ void A2Autils<FImpl>::MesonField(TensorType &mat,
     lsSum[r]=scalar_type(0.0);
   });
 
-  int e1=    grid->_slice_nblock[orthogdim];
-  int e2=    grid->_slice_block [orthogdim];
-  int stride=grid->_slice_stride[orthogdim];
+  typedef decltype(lhs_wi[0].View(CpuRead)) FermionView;
+  typedef decltype(mom[0].View(CpuRead))    ComplexView;
+  std::vector<FermionView> lhs_v, rhs_v;
+  std::vector<ComplexView> mom_v;
+  for(int i=0;i<Lblock;i++) lhs_v.push_back(lhs_wi[i].View(CpuRead));
+  for(int j=0;j<Rblock;j++) rhs_v.push_back(rhs_vj[j].View(CpuRead));
+  for(int m=0;m<Nmom;m++)   mom_v.push_back(mom[m].View(CpuRead));
 
-  // potentially wasting cores here if local time extent too small
   if (t_kernel) *t_kernel = -usecond();
-  thread_for(r,rd,{
+  thread_for(rc,rd*nchunk,{
 
+    int r  = rc/nchunk;
+    int ch = rc%nchunk;
     int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
 
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
+    for(int nb=(nsite*ch)/nchunk;nb<(nsite*(ch+1))/nchunk;nb++){
 
-	int ss= so+n*stride+b;
+      int n = nb/e2;
+      int b = nb%e2;
+      int ss= so+n*stride+b;
 
-	for(int i=0;i<Lblock;i++){
+      for(int i=0;i<Lblock;i++){
 
-	  // Recreate view potentially expensive outside fo UVM mode
-	  autoView(lhs_v,lhs_wi[i],CpuRead);
-	  auto left = conjugate(lhs_v[ss]);
-	  for(int j=0;j<Rblock;j++){
+	auto left = conjugate(lhs_v[i][ss]);
+	for(int j=0;j<Rblock;j++){
 
-	    SpinMatrix_v vv;
-	    // Recreate view potentially expensive outside fo UVM mode
-	    autoView(rhs_v,rhs_vj[j],CpuRead);
-	    auto right = rhs_v[ss];
-	    for(int s1=0;s1<Ns;s1++){
-	    for(int s2=0;s2<Ns;s2++){
-	      vv()(s1,s2)() = left()(s2)(0) * right()(s1)(0)
-		+             left()(s2)(1) * right()(s1)(1)
-		+             left()(s2)(2) * right()(s1)(2);
-	    }}
+	  SpinMatrix_v vv;
+	  auto right = rhs_v[j][ss];
+	  for(int s1=0;s1<Ns;s1++){
+	  for(int s2=0;s2<Ns;s2++){
+	    vv()(s1,s2)() = left()(s2)(0) * right()(s1)(0)
+	      +             left()(s2)(1) * right()(s1)(1)
+	      +             left()(s2)(2) * right()(s1)(2);
+	  }}
 	    
-	    // After getting the sitewise product do the mom phase loop
-	    int base = Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*r;
-	    for ( int m=0;m<Nmom;m++){
-	      int idx = m+base;
-	      autoView(mom_v,mom[m],CpuRead);
-	      auto phase = mom_v[ss];
-	      mac(&lvSum[idx],&vv,&phase);
-	    }
+	  // After getting the sitewise product do the mom phase loop
+	  int base = Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*rc;
+	  for ( int m=0;m<Nmom;m++){
+	    int idx = m+base;
+	    auto phase = mom_v[m][ss];
+	    mac(&lvSum[idx],&vv,&phase);
 	  }
 	}
       }
     }
   });
+  for(auto &v : lhs_v) v.ViewClose();
+  for(auto &v : rhs_v) v.ViewClose();
+  for(auto &v : mom_v) v.ViewClose();
 
-  // Sum across simd lanes in the plane, breaking out orthog dir.
+  // Sum the chunks and across simd lanes in the plane, breaking out orthog dir.
   thread_for(rt,rd,{
 
     Coordinate icoor(Nd);
@@ -233,9 +270,13 @@ void A2Autils<FImpl>::MesonField(TensorType &mat,
     for(int j=0;j<Rblock;j++){
     for(int m=0;m<Nmom;m++){
 
-      int ij_rdx = m+Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*rt;
+      SpinMatrix_v vsum = Zero();
+      for(int ch=0;ch<nchunk;ch++){
+	int ij_rdx = m+Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*(rt*nchunk+ch);
+	vsum = vsum + lvSum[ij_rdx];
+      }
 
-      extract(lvSum[ij_rdx],extracted);
+      extract(vsum,extracted);
 
       for(int idx=0;idx<Nsimd;idx++){
 
@@ -298,6 +339,199 @@ void A2Autils<FImpl>::MesonField(TensorType &mat,
   if (t_gsum) *t_gsum += usecond();
 }
 
+#if !defined(GRID_CUDA) && !defined(GRID_HIP) && !defined(GRID_SYCL)
+template <class FImpl>
+template <typename TensorType>
+void A2Autils<FImpl>::MesonFieldKernelGemm(TensorType &mat, 
+					   const FermionField *lhs_wi,
+					   const FermionField *rhs_vj,
+					   std::vector<Gamma::Algebra> gammas,
+					   const std::vector<ComplexField > &mom,
+					   int orthogdim, double *t_kernel, double *t_gsum) 
+{
+  typedef typename FImpl::SiteSpinor vobj;
+
+  typedef typename vobj::scalar_object sobj;
+  typedef typename vobj::scalar_type scalar_type;
+
+  typedef iSpinMatrix<scalar_type> SpinMatrix_s;
+
+  int Lblock = mat.dimension(3); 
+  int Rblock = mat.dimension(4);
+
+  GridBase *grid = lhs_wi[0].Grid();
+  
+  const int    Nd = grid->_ndimension;
+  const int Nsimd = grid->Nsimd();
+
+  int Nt     = grid->GlobalDimensions()[orthogdim];
+  int Ngamma = gammas.size();
+  int Nmom   = mom.size();
+
+  int ld=grid->_ldimensions[orthogdim];
+  int rd=grid->_rdimensions[orthogdim];
+
+  ////////////////////////////////////////////////////////////////////////////////////////
+  // Blocked GEMM formulation, in three stages on each local time slice:
+  //
+  //   colour:   P[(s1,s2,i,j),x]     = sum_c conj(w_i(x,s2,c)) v_j(x,s1,c)
+  //   momentum: S[(s1,s2),(i,j,m)]   = sum_x P[(s1,s2,i,j),x] phase_m(x)
+  //   gamma:    D[mu,(i,j,m)]        = sum_{s1,s2} Gamma_mu(s2,s1) S[(s1,s2),(i,j,m)]
+  //
+  // The colour stage is Nc deep and done site by site in simd, with the flops of the site
+  // loop; the momentum stage is one GEMM per time slice over its sites, and its output is
+  // read in place by the gamma GEMM over the Ns*Ns spin pairs. Sites are taken in blocks,
+  // accumulating the momentum GEMM, so the panels stay bounded.
+  ////////////////////////////////////////////////////////////////////////////////////////
+  assert(mat.dimension(0) == Nmom);
+  assert(mat.dimension(1) == Ngamma);
+  assert(mat.dimension(2) == Nt);
+
+  int e1=    grid->_slice_nblock[orthogdim];
+  int e2=    grid->_slice_block [orthogdim];
+  int stride=grid->_slice_stride[orthogdim];
+  int ostride=grid->_ostride[orthogdim];
+
+  if (t_kernel) *t_kernel = -usecond();
+
+  // The simd lanes of an outer site lie on simd_t local time slices, nlane on each.
+  // Column x of a slice's panel is (lane_x, outer site) of the current block of outer sites.
+  int simd_t = ld/rd;
+  int nlane  = Nsimd/simd_t;
+  int Vo     = e1*e2;
+  std::vector<int> lane_t(Nsimd), lane_x(Nsimd);
+  {
+    std::vector<int> count(simd_t,0);
+    Coordinate icoor(Nd);
+    for(int l=0;l<Nsimd;l++){
+      grid->iCoorFromIindex(icoor,l);
+      lane_t[l] = icoor[orthogdim];
+      lane_x[l] = count[lane_t[l]]++;
+    }
+  }
+
+  const int K2 = Ns*Ns;
+  const int NN = K2*Lblock*Rblock;
+  const uint64_t panel_bytes = 4*1024*1024; // cache resident; larger panels measured slower
+  int Ob = panel_bytes/((uint64_t)ld*nlane*(NN+Nmom)*sizeof(scalar_type));
+  Ob = std::max(1,std::min(Ob,Vo));
+
+  std::vector<scalar_type> Pp((size_t)ld*nlane*Ob*NN);
+  std::vector<scalar_type> Ph((size_t)ld*nlane*Ob*Nmom);
+  std::vector<scalar_type> Sp((size_t)ld*NN*Nmom);
+
+  typedef decltype(lhs_wi[0].View(CpuRead)) FermionView;
+  typedef decltype(mom[0].View(CpuRead))    ComplexView;
+  std::vector<FermionView> w_v, v_v;
+  std::vector<ComplexView> mom_v;
+  for(int i=0;i<Lblock;i++) w_v.push_back(lhs_wi[i].View(CpuRead));
+  for(int j=0;j<Rblock;j++) v_v.push_back(rhs_vj[j].View(CpuRead));
+  for(int m=0;m<Nmom;m++)   mom_v.push_back(mom[m].View(CpuRead));
+
+  GridBLAS BLAS;
+  for(int o0=0;o0<Vo;o0+=Ob){
+    int Oc = std::min(Ob,Vo-o0);
+    int Kc = Oc*nlane;
+    // colour: the spin matrices of each site, in simd as the site loop, then
+    // scattered by lane into the columns of P for the momentum stage
+    thread_for(ro, rd*Oc, {
+      int r  = ro/Oc;
+      int o  = ro%Oc;
+      int ss = r*ostride+((o0+o)/e2)*stride+(o0+o)%e2;
+      ExtractBuffer<SpinMatrix_s> extracted(Nsimd);
+      std::vector<scalar_type *> P(Nsimd);
+      for(int l=0;l<Nsimd;l++){
+	int lt = r+lane_t[l]*rd;
+	int x  = lane_x[l]*Oc+o;
+	P[l] = &Pp[((size_t)lt*Kc+x)*NN];
+	for(int m=0;m<Nmom;m++){
+	  Ph[(size_t)lt*Kc*Nmom + x + (size_t)Kc*m] = TensorRemove(extractLane(l,mom_v[m][ss]));
+	}
+      }
+      for(int i=0;i<Lblock;i++){
+	auto left = conjugate(w_v[i][ss]);
+	for(int j=0;j<Rblock;j++){
+	  auto right = v_v[j][ss];
+	  SpinMatrix_v vv;
+	  for(int s1=0;s1<Ns;s1++){
+	  for(int s2=0;s2<Ns;s2++){
+	    vv()(s1,s2)() = left()(s2)(0) * right()(s1)(0)
+	      +             left()(s2)(1) * right()(s1)(1)
+	      +             left()(s2)(2) * right()(s1)(2);
+	  }}
+	  extract(vv,extracted);
+	  for(int l=0;l<Nsimd;l++){
+	    scalar_type *Pij = P[l] + K2*(i+Lblock*j);
+	    for(int s1=0;s1<Ns;s1++){
+	    for(int s2=0;s2<Ns;s2++){
+	      Pij[s2+Ns*s1] = extracted[l]()(s1,s2)();
+	    }}
+	  }
+	}
+      }
+    });
+    // momentum: (NN x Kc)(Kc x Nmom) per time slice, accumulated over site blocks
+    scalar_type beta = (o0==0) ? scalar_type(0.0) : scalar_type(1.0);
+    BLAS.gemmStridedBatched(GridBLAS_OP_N,GridBLAS_OP_N,
+			    NN,Nmom,Kc,
+			    scalar_type(1.0),
+			    &Pp[0],(int64_t)NN*Kc,
+			    &Ph[0],(int64_t)Kc*Nmom,
+			    beta,
+			    &Sp[0],(int64_t)NN*Nmom,
+			    ld);
+  }
+  for(auto &v : w_v)   v.ViewClose();
+  for(auto &v : v_v)   v.ViewClose();
+  for(auto &v : mom_v) v.ViewClose();
+
+  // gamma: G[mu,(s1,s2)] = Gamma_mu(s2,s1) against the Ns*Ns x (i,j,m) view of S
+  const int M2 = Lblock*Rblock*Nmom;
+  std::vector<scalar_type> G(Ngamma*K2);
+  std::vector<scalar_type> D((size_t)ld*Ngamma*M2);
+  for(int mu=0;mu<Ngamma;mu++){
+    SpinMatrix_s unit; unit = scalar_type(1.0);
+    SpinMatrix_s gm = unit*Gamma(gammas[mu]);
+    for(int s1=0;s1<Ns;s1++){
+    for(int s2=0;s2<Ns;s2++){
+      G[mu+Ngamma*(s2+Ns*s1)] = gm()(s2,s1)();
+    }}
+  }
+  BLAS.gemmStridedBatched(GridBLAS_OP_N,GridBLAS_OP_N,
+			  Ngamma,M2,K2,
+			  scalar_type(1.0),
+			  &G[0],(int64_t)0,
+			  &Sp[0],(int64_t)K2*M2,
+			  scalar_type(0.0),
+			  &D[0],(int64_t)Ngamma*M2,
+			  ld);
+  if (t_kernel) *t_kernel += usecond();
+
+  int pd = grid->_processors[orthogdim];
+  int pc = grid->_processor_coor[orthogdim];
+  thread_for_collapse(2,lt,ld,{
+    for(int pt=0;pt<pd;pt++){
+      int t = lt + pt*ld;
+      for(int i=0;i<Lblock;i++){
+	for(int j=0;j<Rblock;j++){
+	  for(int m=0;m<Nmom;m++){
+	    int row = i+Lblock*j+Lblock*Rblock*m;
+	    for(int mu=0;mu<Ngamma;mu++){
+	      if (pt == pc) mat(m,mu,t,i,j) = D[(size_t)lt*Ngamma*M2 + mu + (size_t)Ngamma*row];
+	      else          mat(m,mu,t,i,j) = scalar_type(0.0);
+	    }
+	  }
+	}
+      }
+    }
+  });
+
+  if (t_gsum) *t_gsum = -usecond();
+  grid->GlobalSumVector(&mat(0,0,0,0,0),Nmom*Ngamma*Nt*Lblock*Rblock);
+  if (t_gsum) *t_gsum += usecond();
+}
+#endif
+
 //
 // meson field with user defined v,w vecs.
 // No gammas or mom done here
@@ -41,7 +41,17 @@ public:
 
   typedef Lattice<iSpinMatrix<typename FImpl::Simd>> SpinMatrixField;
 
-  private: 
+  // One 2pt structure for the diquark engine, arguments as in ContractBaryons
+  struct BaryonContraction {
+    Gamma GammaA_left;
+    Gamma GammaB_left;
+    Gamma GammaA_right;
+    Gamma GammaB_right;
+    int wick_contractions;
+    int parity;
+  };
+
+  private:
   template <class mobj, class robj> accelerator_inline
   static void BaryonSite(const mobj &D1,
          const mobj &D2,
@@ -110,6 +120,53 @@ public:
          const int nt,
          robj &result);
   private:
+  template <class mobj> accelerator_inline
+  static void BaryonDiquarkSite(const mobj &D2,
+         const mobj &D3,
+         const Gamma GammaB_left,
+         mobj &diquark);
+  template <class mobj, class robj> accelerator_inline
+  static void BaryonDiquarkSiteMatrix(const mobj &D1,
+         const mobj &diquark,
+         const Gamma GammaA_left,
+         const Gamma GammaA_right,
+         const Gamma GammaB_right,
+         const int wick_contractions,
+         robj &result);
+  template <class mobj, class robj> accelerator_inline
+  static void BaryonDiquarkSiteTrace(const mobj &D1,
+         const mobj &diquark,
+         const BaryonContraction &c,
+         robj &result);
+  static void DiquarkGammas(const std::vector<BaryonContraction> &contractions,
+         std::vector<Gamma> &GammaB_left,
+         std::vector<int> &diquark);
+  public:
+  static void ContractBaryons(const PropagatorField &q1_left,
+         const PropagatorField &q2_left,
+         const PropagatorField &q3_left,
+         const std::vector<BaryonContraction> &contractions,
+         std::vector<ComplexField> &baryon_corr);
+  static void ContractBaryons(const std::vector<PropagatorField> &q1_left,
+         const std::vector<PropagatorField> &q2_left,
+         const std::vector<PropagatorField> &q3_left,
+         const std::vector<BaryonContraction> &contractions,
+         std::vector<std::vector<ComplexField>> &baryon_corr);
+  template <class mobj, class robj>
+  static void ContractBaryonsSliced(const mobj &D1,
+         const mobj &D2,
+         const mobj &D3,
+         const std::vector<BaryonContraction> &contractions,
+         const int nt,
+         std::vector<robj> &result);
+  template <class mobj, class robj>
+  static void ContractBaryonsSlicedBatch(const std::vector<mobj> &D1,
+         const std::vector<mobj> &D2,
+         const std::vector<mobj> &D3,
+         const std::vector<BaryonContraction> &contractions,
+         const int nt,
+         std::vector<std::vector<robj>> &result);
+  private:
   template <class mobj, class mobj2, class robj> accelerator_inline
   static void BaryonGamma3ptGroup1Site(
            const mobj &Dq1_ti,
@@ -660,6 +717,295 @@ void BaryonUtils<FImpl>::ContractBaryonsSlicedMatrix(const mobj &D1,
   }
 }
 
+/***********************************************************************
+ * Diquark engine for the baryon 2pt-function.                         *
+ *                                                                     *
+ * Relabelling the sink colours, all six Wick contractions share the   *
+ * colour structure eps_f eps_i D1^{c_f c_i} D2^{a_f a_i} D3^{b_f b_i} *
+ * and differ only in how the spin indices are joined. The colour sum  *
+ * over (a,b) is therefore done once, in the diquark                   *
+ *   N^{c_f c_i}_{delta alpha} = eps_f eps_i (D3 (D2 GammaB_i)^T)      *
+ * of the second and third quark, and every sink gamma, parity and     *
+ * Wick term is a spin contraction of N with D1.                       *
+ **********************************************************************/
+template <class FImpl>
+template <class mobj> accelerator_inline
+void BaryonUtils<FImpl>::BaryonDiquarkSite(const mobj &D2,
+                const mobj &D3,
+                const Gamma GammaB_i,
+                mobj &diquark)
+{
+  auto D2_GBi = D2 * GammaB_i;
+
+  Real ee;
+
+  diquark = Zero();
+  for (int ie_f=0; ie_f < 6 ; ie_f++){
+    int a_f    = (ie_f < 3 ? ie_f       : (6-ie_f)%3 ); //epsilon[ie_n][0]; //a
+    int b_f    = (ie_f < 3 ? (ie_f+1)%3 : (8-ie_f)%3 ); //epsilon[ie_n][1]; //b
+    int c_f    = (ie_f < 3 ? (ie_f+2)%3 : (7-ie_f)%3 ); //epsilon[ie_n][2]; //c
+    int eSgn_f = (ie_f < 3 ? 1 : -1);
+    for (int ie_i=0; ie_i < 6 ; ie_i++){
+      int a_i = (ie_i < 3 ? ie_i       : (6-ie_i)%3 ); //epsilon[ie_s][0]; //a'
+      int b_i = (ie_i < 3 ? (ie_i+1)%3 : (8-ie_i)%3 ); //epsilon[ie_s][1]; //b'
+      int c_i = (ie_i < 3 ? (ie_i+2)%3 : (7-ie_i)%3 ); //epsilon[ie_s][2]; //c'
+      int eSgn_i = (ie_i < 3 ? 1 : -1);
+
+      ee = Real(eSgn_f * eSgn_i); //epsilon_sgn[ie_n] * epsilon_sgn[ie_s];
+      for (int alpha=0; alpha<Ns; alpha++){
+      for (int beta=0; beta<Ns; beta++){
+        auto ee_D2_GBi_ab_aa = ee * D2_GBi()(alpha,beta)(a_f,a_i);
+        for (int delta=0; delta<Ns; delta++){
+          diquark()(delta,alpha)(c_f,c_i) += ee_D2_GBi_ab_aa * D3()(delta,beta)(b_f,b_i);
+        }
+      }}
+    }
+  }
+}
+
+/* Spin matrix GammaA_f S GammaA_i with S = sum_{c_f c_i} K^{c_f c_i} D1^{c_f c_i}, *
+ * where K collects the requested Wick terms as products of the diquark   *
+ * N and GammaB_f. Tracing with the parity projector gives BaryonSite,    *
+ * and without it this is BaryonSiteMatrix.                               */
+template <class FImpl>
+template <class mobj, class robj> accelerator_inline
+void BaryonUtils<FImpl>::BaryonDiquarkSiteMatrix(const mobj &D1,
+                const mobj &diquark,
+                const Gamma GammaA_i,
+                const Gamma GammaA_f,
+                const Gamma GammaB_f,
+                const int wick_contraction,
+                robj &result)
+{
+  mobj NT;
+  for (int x=0; x<Ns; x++){
+  for (int y=0; y<Ns; y++){
+    NT()(x,y) = diquark()(y,x);
+  }}
+  auto GBf_N  = GammaB_f * diquark;
+  auto GBf_NT = GammaB_f * NT;
+
+  mobj K = Zero();
+  if (wick_contraction & 4)  K += NT * GammaB_f;     //\delta_{456}^{312}
+  if (wick_contraction & 16) K += diquark * GammaB_f; //\delta_{456}^{321}
+  for (int x=0; x<Ns; x++){
+  for (int y=0; y<Ns; y++){
+    if (wick_contraction & 1)  K()(x,x) += GBf_N ()(y,y); //\delta_{456}^{123}
+    if (wick_contraction & 2)  K()(x,y) += GBf_NT()(y,x); //\delta_{456}^{231}
+    if (wick_contraction & 8)  K()(x,x) += GBf_NT()(y,y); //\delta_{456}^{132}
+    if (wick_contraction & 32) K()(x,y) += GBf_N ()(y,x); //\delta_{456}^{213}
+  }}
+
+  robj S = Zero();
+  for (int x=0; x<Ns; x++){
+  for (int z=0; z<Ns; z++){
+    for (int y=0; y<Ns; y++){
+      for (int c_f=0; c_f<Nc; c_f++){
+      for (int c_i=0; c_i<Nc; c_i++){
+        S()(x,z)() += K()(x,y)(c_f,c_i) * D1()(y,z)(c_f,c_i);
+      }}
+    }
+  }}
+  result = GammaA_f * S * GammaA_i;
+}
+
+template <class FImpl>
+template <class mobj, class robj> accelerator_inline
+void BaryonUtils<FImpl>::BaryonDiquarkSiteTrace(const mobj &D1,
+                const mobj &diquark,
+                const BaryonContraction &c,
+                robj &result)
+{
+  Gamma g4(Gamma::Algebra::GammaT); //needed for parity P_\pm = 0.5*(1 \pm \gamma_4)
+
+  decltype(traceIndex<ColourIndex>(D1)) R;
+  BaryonDiquarkSiteMatrix(D1,diquark,c.GammaA_left,c.GammaA_right,c.GammaB_right,c.wick_contractions,R);
+  auto R_P = 0.5*(R + (Real)c.parity * (R * g4));
+  for (int rho=0; rho<Ns; rho++){
+    result()()() += R_P()(rho,rho)();
+  }
+}
+
+/* The distinct source diquark gammas GammaB_left, and for each *
+ * contraction the index of the diquark it uses                 */
+template<class FImpl>
+void BaryonUtils<FImpl>::DiquarkGammas(const std::vector<BaryonContraction> &contractions,
+             std::vector<Gamma> &GammaB_left,
+             std::vector<int> &diquark)
+{
+  GammaB_left.clear();
+  diquark.resize(contractions.size());
+  for (int k=0; k<contractions.size(); k++) {
+    int q=0;
+    while ( q<GammaB_left.size() && GammaB_left[q].g != contractions[k].GammaB_left.g ) q++;
+    if ( q==GammaB_left.size() ) GammaB_left.push_back(contractions[k].GammaB_left);
+    diquark[k]=q;
+  }
+}
+
+/* All requested gamma, parity and Wick-term combinations in one pass *
+ * over the lattice per source diquark gamma; baryon_corr[k] receives *
+ * the correlator of contractions[k], equal to ContractBaryons with   *
+ * the same arguments                                                  */
+template<class FImpl>
+void BaryonUtils<FImpl>::ContractBaryons(const PropagatorField &q1_left,
+             const PropagatorField &q2_left,
+             const PropagatorField &q3_left,
+             const std::vector<BaryonContraction> &contractions,
+             std::vector<ComplexField> &baryon_corr)
+{
+
+  assert(Ns==4 && "Baryon code only implemented for N_spin = 4");
+  assert(Nc==3 && "Baryon code only implemented for N_colour = 3");
+
+  for (auto &c : contractions) assert((c.parity==1 || c.parity == -1) && "Parity must be +1 or -1");
+
+  GridBase *grid = q1_left.Grid();
+  int Ncon = contractions.size();
+  baryon_corr.resize(Ncon,grid);
+  if ( Ncon==0 ) return;
+
+  std::vector<Gamma> GammaB;
+  std::vector<int>   diquark;
+  DiquarkGammas(contractions,GammaB,diquark);
+
+  typedef decltype(baryon_corr[0].View(AcceleratorWrite)) View;
+  Vector<View> corr_v; corr_v.reserve(Ncon);
+  for (int k=0; k<Ncon; k++) corr_v.push_back(baryon_corr[k].View(AcceleratorWrite));
+  View *corr_p = &corr_v[0];
+
+  Vector<BaryonContraction> con_v(contractions.begin(),contractions.end());
+  BaryonContraction *con_p = &con_v[0];
+
+  autoView( v1 , q1_left , AcceleratorRead);
+  autoView( v2 , q2_left , AcceleratorRead);
+  autoView( v3 , q3_left , AcceleratorRead);
+
+  for (int q=0; q<GammaB.size(); q++) {
+    Vector<int> kq;
+    for (int k=0; k<Ncon; k++) if ( diquark[k]==q ) kq.push_back(k);
+    int *kq_p = &kq[0];
+    int nk = kq.size();
+    Gamma GammaB_left = GammaB[q];
+
+    accelerator_for(ss, grid->oSites(), grid->Nsimd(), {
+      auto D1 = v1(ss);
+      auto D2 = v2(ss);
+      auto D3 = v3(ss);
+      decltype(D1) N;
+      BaryonDiquarkSite(D2,D3,GammaB_left,N);
+      typedef decltype(coalescedRead(corr_p[0][0])) cVec;
+      for (int n=0; n<nk; n++) {
+        int k = kq_p[n];
+        cVec result=Zero();
+        BaryonDiquarkSiteTrace(D1,N,con_p[k],result);
+        coalescedWrite(corr_p[k][ss],result);
+      }
+    });//end loop over lattice sites
+  }
+
+  for (int k=0; k<Ncon; k++) corr_v[k].ViewClose();
+}
+
+/* Batched over source positions, baryon_corr[s][k] for the propagators q[s] */
+template<class FImpl>
+void BaryonUtils<FImpl>::ContractBaryons(const std::vector<PropagatorField> &q1_left,
+             const std::vector<PropagatorField> &q2_left,
+             const std::vector<PropagatorField> &q3_left,
+             const std::vector<BaryonContraction> &contractions,
+             std::vector<std::vector<ComplexField>> &baryon_corr)
+{
+  int Nsrc = q1_left.size();
+  assert(q2_left.size()==Nsrc && q3_left.size()==Nsrc);
+  baryon_corr.resize(Nsrc);
+  for (int s=0; s<Nsrc; s++) {
+    ContractBaryons(q1_left[s],q2_left[s],q3_left[s],contractions,baryon_corr[s]);
+  }
+}
+
+/* Sliced version of the engine: the diquarks are built once per  *
+ * timeslice and source diquark gamma and shared by all the       *
+ * contractions; result[k][t] is set for contractions[k]          */
+template <class FImpl>
+template <class mobj, class robj>
+void BaryonUtils<FImpl>::ContractBaryonsSliced(const mobj &D1,
+             const mobj &D2,
+             const mobj &D3,
+             const std::vector<BaryonContraction> &contractions,
+             const int nt,
+             std::vector<robj> &result)
+{
+
+  assert(Ns==4 && "Baryon code only implemented for N_spin = 4");
+  assert(Nc==3 && "Baryon code only implemented for N_colour = 3");
+
+  for (auto &c : contractions) assert((c.parity==1 || c.parity == -1) && "Parity must be +1 or -1");
+
+  typedef typename std::decay<decltype(D1[0])>::type sobj;
+
+  std::vector<Gamma> GammaB;
+  std::vector<int>   diquark;
+  DiquarkGammas(contractions,GammaB,diquark);
+
+  int Ncon = contractions.size();
+  result.resize(Ncon);
+  for (int k=0; k<Ncon; k++) result[k].resize(nt);
+
+  thread_for(t, nt, {
+    std::vector<sobj> N(GammaB.size());
+    for (int q=0; q<GammaB.size(); q++) BaryonDiquarkSite(D2[t],D3[t],GammaB[q],N[q]);
+    for (int k=0; k<Ncon; k++) {
+      result[k][t] = Zero();
+      BaryonDiquarkSiteTrace(D1[t],N[diquark[k]],contractions[k],result[k][t]);
+    }
+  });
+}
+
+/* Batched over source positions, result[s][k][t] for the sliced propagators D[s], *
+ * threaded over sources and timeslices together                                  */
+template <class FImpl>
+template <class mobj, class robj>
+void BaryonUtils<FImpl>::ContractBaryonsSlicedBatch(const std::vector<mobj> &D1,
+             const std::vector<mobj> &D2,
+             const std::vector<mobj> &D3,
+             const std::vector<BaryonContraction> &contractions,
+             const int nt,
+             std::vector<std::vector<robj>> &result)
+{
+
+  assert(Ns==4 && "Baryon code only implemented for N_spin = 4");
+  assert(Nc==3 && "Baryon code only implemented for N_colour = 3");
+
+  for (auto &c : contractions) assert((c.parity==1 || c.parity == -1) && "Parity must be +1 or -1");
+
+  typedef typename std::decay<decltype(D1[0][0])>::type sobj;
+
+  int Nsrc = D1.size();
+  assert(D2.size()==Nsrc && D3.size()==Nsrc);
+
+  std::vector<Gamma> GammaB;
+  std::vector<int>   diquark;
+  DiquarkGammas(contractions,GammaB,diquark);
+
+  int Ncon = contractions.size();
+  result.resize(Nsrc);
+  for (int s=0; s<Nsrc; s++) {
+    result[s].resize(Ncon);
+    for (int k=0; k<Ncon; k++) result[s][k].resize(nt);
+  }
+
+  thread_for(st, Nsrc*nt, {
+    int s = st / nt;
+    int t = st % nt;
+    std::vector<sobj> N(GammaB.size());
+    for (int q=0; q<GammaB.size(); q++) BaryonDiquarkSite(D2[s][t],D3[s][t],GammaB[q],N[q]);
+    for (int k=0; k<Ncon; k++) {
+      result[s][k][t] = Zero();
+      BaryonDiquarkSiteTrace(D1[s][t],N[diquark[k]],contractions[k],result[s][k][t]);
+    }
+  });
+}
+
 /***********************************************************************
  * End of Baryon 2pt-function code.                                    *
  *                                                                     *
@@ -39,6 +39,51 @@ public:
 
   typedef typename Gimpl::GaugeLinkField GaugeMat;
   typedef typename Gimpl::GaugeField GaugeLorentz;
+  typedef typename GaugeMat::vector_object vobj;
+  typedef LatticeView<vobj> View;
+
+  //The FFT, which keeps its plans, and the acceleration weights Fp = psq_max/psq.
+  //Built once per gauge fix rather than every iteration.
+  class FourierAccelerator {
+  public:
+    FFT theFFT;
+    LatticeComplex Fp;
+    Coordinate mask;
+
+    FourierAccelerator(GridBase *grid,int orthog) : theFFT((GridCartesian *)grid), Fp(grid), mask(Nd,1)
+    {
+      for(int mu=0;mu<Nd;mu++) if (mu==orthog) mask[mu]=0;
+
+      //////////////////////////////////
+      // Work out Fp = psq_max/ psq...
+      // Avoid singularities in Fp
+      //////////////////////////////////
+      LatticeComplex  psq(grid); psq=Zero();
+      LatticeComplex  pmu(grid); 
+      LatticeComplex   one(grid); one = Complex(1.0,0.0);
+      Coordinate latt_size = grid->GlobalDimensions();
+      Coordinate coor(grid->_ndimension,0);
+      for(int mu=0;mu<Nd;mu++) {
+	if ( mu != orthog ) { 
+	  Real TwoPiL =  M_PI * 2.0/ latt_size[mu];
+	  LatticeCoordinate(pmu,mu);
+	  pmu = TwoPiL * pmu ;
+	  psq = psq + 4.0*sin(pmu*0.5)*sin(pmu*0.5); 
+	}
+      }
+
+      Complex psqMax(16.0);
+      Fp =  psqMax*one/psq;
+
+      pokeSite(TComplex(16.0),Fp,coor);
+      if( (orthog>=0) && (orthog<Nd) ){
+	for(int t=0;t<grid->GlobalDimensions()[orthog];t++){
+	  coor[orthog]=t;
+	  pokeSite(TComplex(16.0),Fp,coor);
+	}
+      }
+    }
+  };
 
   //A_\mu(x) = -i Ta(U_\mu(x) )   where Ta(U) = 1/2( U - U^dag ) - 1/2N tr(U - U^dag)  is the traceless antihermitian part. This is an O(A^3) approximation to the logarithm of U
   static void GaugeLinkToLieAlgebraField(const GaugeMat &U, GaugeMat &A) {
@@ -49,35 +94,115 @@ public:
   //The derivative of the Lie algebra field
   static void DmuAmu(const std::vector<GaugeMat> &U, GaugeMat &dmuAmu,int orthog) {
     GridBase* grid = U[0].Grid();
-    GaugeMat Ax(grid);
-    GaugeMat Axm1(grid);
-    GaugeMat Utmp(grid);
 
-    dmuAmu=Zero();
+    //Rather than define functionality to work out how the BCs apply to A_\mu we simply use the BC-aware Cshift to the gauge links
+    //and form A_\mu(x) and A_\mu(x-1) together in one kernel over all directions
+    std::vector<GaugeMat> Um(Nd,grid);
     for(int mu=0;mu<Nd;mu++){
-      if ( mu != orthog ) {
-	//Rather than define functionality to work out how the BCs apply to A_\mu we simply use the BC-aware Cshift to the gauge links and compute A_\mu(x) and A_\mu(x-1) separately
-	//Ax = A_\mu(x)
-	GaugeLinkToLieAlgebraField(U[mu], Ax);
-	
-	//Axm1 = A_\mu(x_\mu-1)
-	Utmp = Gimpl::CshiftLink(U[mu], mu, -1);
-	GaugeLinkToLieAlgebraField(Utmp, Axm1);
-	
-	//Derivative
-	dmuAmu = dmuAmu + Ax - Axm1;
-      }
+      if ( mu != orthog ) Um[mu] = Gimpl::CshiftLink(U[mu], mu, -1);
+    }
+
+    Vector<View> U_v; U_v.reserve(Nd);
+    Vector<View> Um_v; Um_v.reserve(Nd);
+    for(int mu=0;mu<Nd;mu++){
+      U_v.push_back(U[mu].View(AcceleratorRead));
+      Um_v.push_back(Um[mu].View(AcceleratorRead));
+    }
+    View *U_p  = &U_v[0];
+    View *Um_p = &Um_v[0];
+    Complex cmi(0.0,-1.0);
+    {
+      autoView( d_v , dmuAmu, AcceleratorWrite);
+      accelerator_for(ss, grid->oSites(), vobj::Nsimd(), {
+	decltype(coalescedRead(d_v[0])) d;
+	d = Zero();
+	for(int mu=0;mu<Nd;mu++){
+	  if ( mu != orthog ) d = d + Ta(U_p[mu](ss)) - Ta(Um_p[mu](ss));
+	}
+	coalescedWrite(d_v[ss], d*cmi);
+      });
+    }
+    for(int mu=0;mu<Nd;mu++){
+      U_v[mu].ViewClose();
+      Um_v[mu].ViewClose();
     }
   }  
 
+  //U_mu(x) = g(x) U_mu(x) g^dag(x+mu), all directions in one kernel after the BC-aware shifts of g^dag
+  static void TransformLinks(std::vector<GaugeMat> &U, const GaugeMat &g) {
+    GridBase *grid = g.Grid();
+    GaugeMat ag(grid); ag = adj(g);
+    std::vector<GaugeMat> agp(Nd,grid);
+    for(int mu=0;mu<Nd;mu++) agp[mu] = Gimpl::CshiftLink(ag, mu, 1);
+
+    Vector<View> U_v; U_v.reserve(Nd);
+    Vector<View> a_v; a_v.reserve(Nd);
+    for(int mu=0;mu<Nd;mu++){
+      U_v.push_back(U[mu].View(AcceleratorWrite));
+      a_v.push_back(agp[mu].View(AcceleratorRead));
+    }
+    View *U_p = &U_v[0];
+    View *a_p = &a_v[0];
+    {
+      autoView( g_v , g, AcceleratorRead);
+      accelerator_for(ss, grid->oSites(), vobj::Nsimd(), {
+	auto gs = g_v(ss);
+	for(int mu=0;mu<Nd;mu++){
+	  coalescedWrite(U_p[mu][ss], gs*U_p[mu](ss)*a_p[mu](ss));
+	}
+      });
+    }
+    for(int mu=0;mu<Nd;mu++){
+      U_v[mu].ViewClose();
+      a_v[mu].ViewClose();
+    }
+  }
+
+  //g = exp(-i alpha dmuAmu) by the 12th order series of taExp and xform = g xform in one kernel,
+  //then the links are transformed. Returns 1/(V Nc) sum_x Re tr g
+  static Real ExpiAlphaDmuAmuTransform(std::vector<GaugeMat> &U,GaugeMat &xform, Real alpha, const GaugeMat &dmuAmu) {
+    GridBase *grid = U[0].Grid();
+    GaugeMat g(grid);
+    ComplexField trg(grid);
+    Complex cialpha(0.0,-alpha);
+    {
+      autoView( d_v , dmuAmu, AcceleratorRead);
+      autoView( g_v , g, AcceleratorWrite);
+      autoView( x_v , xform, AcceleratorWrite);
+      autoView( t_v , trg, AcceleratorWrite);
+      accelerator_for(ss, grid->oSites(), vobj::Nsimd(), {
+	auto x = d_v(ss)*cialpha;
+	auto xn = x;
+	auto ex = x;
+	ex = 1.0;
+	ex = ex + x;
+	RealD nfac = 1.0;
+	for (int i = 2; i <= 12; ++i) {
+	  nfac = nfac / RealD(i);
+	  xn = xn * x;
+	  ex = ex + xn * nfac;
+	}
+	coalescedWrite(g_v[ss], ex);
+	coalescedWrite(x_v[ss], ex*x_v(ss));
+	coalescedWrite(t_v[ss], trace(ex));
+      });
+    }
+    Real vol = grid->gSites();
+    Real trG = TensorRemove(sum(trg)).real()/vol/Nc;
+
+    TransformLinks(U,g);
+    return trG;
+  }
+
   //Fix the gauge field Umu
   //0 < alpha < 1 is related to the step size, cf https://arxiv.org/pdf/1405.5812.pdf
-  static void SteepestDescentGaugeFix(GaugeLorentz &Umu,Real alpha,int maxiter,Real Omega_tol, Real Phi_tol,bool Fourier=false,int orthog=-1,bool err_on_no_converge=true) {
+  //Returns the number of iterations taken
+  static int SteepestDescentGaugeFix(GaugeLorentz &Umu,Real alpha,int maxiter,Real Omega_tol, Real Phi_tol,bool Fourier=false,int orthog=-1,bool err_on_no_converge=true) {
     GridBase *grid = Umu.Grid();
     GaugeMat xform(grid);
-    SteepestDescentGaugeFix(Umu,xform,alpha,maxiter,Omega_tol,Phi_tol,Fourier,orthog,err_on_no_converge);
+    return SteepestDescentGaugeFix(Umu,xform,alpha,maxiter,Omega_tol,Phi_tol,Fourier,orthog,err_on_no_converge);
   }
-  static void SteepestDescentGaugeFix(GaugeLorentz &Umu,GaugeMat &xform,Real alpha,int maxiter,Real Omega_tol, Real Phi_tol,bool Fourier=false,int orthog=-1,bool err_on_no_converge=true) {
+  static int SteepestDescentGaugeFix(GaugeLorentz &Umu,GaugeMat &xform,Real alpha,int maxiter,Real Omega_tol, Real Phi_tol,bool Fourier=false,int orthog=-1,bool err_on_no_converge=true) {
   //Fix the gauge field Umu and also return the gauge transformation from the original gauge field, xform
 
     GridBase *grid = Umu.Grid();
@@ -92,6 +217,9 @@ public:
     std::vector<GaugeMat> U(Nd,grid);
     GaugeMat dmuAmu(grid);
 
+    std::unique_ptr<FourierAccelerator> accel;
+    if ( Fourier ) accel.reset(new FourierAccelerator(grid,orthog));
+
     {
       Real plaq      =WilsonLoops<Gimpl>::avgPlaquette(Umu);
       Real link_trace=WilsonLoops<Gimpl>::linkTrace(Umu); 
@@ -101,24 +229,24 @@ public:
 	std::cout << GridLogMessage << " Gauge fixing to Landau gauge plaq= "<<plaq<<" link trace = "<<link_trace<<  std::endl;
       }
     }
+    for(int mu=0;mu<Nd;mu++) U[mu]= PeekIndex<LorentzIndex>(Umu,mu);
+    double t0=usecond();
     for(int i=0;i<maxiter;i++){
 
-      for(int mu=0;mu<Nd;mu++) U[mu]= PeekIndex<LorentzIndex>(Umu,mu);
-
       if ( Fourier==false ) { 
 	trG = SteepestDescentStep(U,xform,alpha,dmuAmu,orthog);
       } else { 
-	trG = FourierAccelSteepestDescentStep(U,xform,alpha,dmuAmu,orthog);
+	trG = FourierAccelSteepestDescentStep(U,xform,alpha,dmuAmu,orthog,*accel);
       }
 
       //      std::cout << GridLogMessage << "trG   "<< trG<< std::endl;
       //      std::cout << GridLogMessage << "xform "<< norm2(xform)<< std::endl;
       //      std::cout << GridLogMessage << "dmuAmu "<< norm2(dmuAmu)<< std::endl;
 
-      for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
       // Monitor progress and convergence test 
       // infrequently to minimise cost overhead
       if ( i %20 == 0 ) { 
+	for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
 	Real plaq      =WilsonLoops<Gimpl>::avgPlaquette(Umu);
 	Real link_trace=WilsonLoops<Gimpl>::linkTrace(Umu); 
 
@@ -132,95 +260,44 @@ public:
 
 	std::cout << GridLogMessage << " Iteration "<<i<< " Phi= "<<Phi<< " Omega= " << Omega<< " trG " << trG <<std::endl;
 	if ( (Omega < Omega_tol) && ( ::fabs(Phi) < Phi_tol) ) {
-	  std::cout << GridLogMessage << "Converged ! "<<std::endl;
-	  return;
+	  double t1=usecond();
+	  std::cout << GridLogMessage << "Converged ! "<<i+1<<" iterations, "<<(i+1)/((t1-t0)*1.0e-6)<<" iterations/s"<<std::endl;
+	  return i+1;
 	}
 
 	old_trace = link_trace;
 
       }
     }
+    for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
     std::cout << GridLogError << "Gauge fixing did not converge in " << maxiter << " iterations." << std::endl;
     if (err_on_no_converge)
       assert(0 && "Gauge fixing did not converge within the specified number of iterations");
+    return maxiter;
   };
   static Real SteepestDescentStep(std::vector<GaugeMat> &U,GaugeMat &xform, Real alpha, GaugeMat & dmuAmu,int orthog) {
-    GridBase *grid = U[0].Grid();
-
-    GaugeMat g(grid);
-    ExpiAlphaDmuAmu(U,g,alpha,dmuAmu,orthog);
-
-    Real vol = grid->gSites();
-    Real trG = TensorRemove(sum(trace(g))).real()/vol/Nc;
-
-    xform = g*xform ;
-    SU<Nc>::GaugeTransform<Gimpl>(U,g);
-
-    return trG;
+    DmuAmu(U,dmuAmu,orthog);
+    return ExpiAlphaDmuAmuTransform(U,xform,alpha,dmuAmu);
   }
 
   static Real FourierAccelSteepestDescentStep(std::vector<GaugeMat> &U,GaugeMat &xform, Real alpha, GaugeMat & dmuAmu,int orthog) {
+    FourierAccelerator accel(U[0].Grid(),orthog);
+    return FourierAccelSteepestDescentStep(U,xform,alpha,dmuAmu,orthog,accel);
+  }
+  static Real FourierAccelSteepestDescentStep(std::vector<GaugeMat> &U,GaugeMat &xform, Real alpha, GaugeMat & dmuAmu,int orthog,FourierAccelerator &accel) {
 
     GridBase *grid = U[0].Grid();
 
-    Real vol = grid->gSites();
-
-    FFT theFFT((GridCartesian *)grid);
-
-    LatticeComplex  Fp(grid);
-    LatticeComplex  psq(grid); psq=Zero();
-    LatticeComplex  pmu(grid); 
-    LatticeComplex   one(grid); one = Complex(1.0,0.0);
-
-    GaugeMat g(grid);
     GaugeMat dmuAmu_p(grid);
     DmuAmu(U,dmuAmu,orthog);
 
-    std::vector<int> mask(Nd,1);
-    for(int mu=0;mu<Nd;mu++) if (mu==orthog) mask[mu]=0;
-    theFFT.FFT_dim_mask(dmuAmu_p,dmuAmu,mask,FFT::forward);
-
-    //////////////////////////////////
-    // Work out Fp = psq_max/ psq...
-    // Avoid singularities in Fp
-    //////////////////////////////////
-    Coordinate latt_size = grid->GlobalDimensions();
-    Coordinate coor(grid->_ndimension,0);
-    for(int mu=0;mu<Nd;mu++) {
-      if ( mu != orthog ) { 
-	Real TwoPiL =  M_PI * 2.0/ latt_size[mu];
-	LatticeCoordinate(pmu,mu);
-	pmu = TwoPiL * pmu ;
-	psq = psq + 4.0*sin(pmu*0.5)*sin(pmu*0.5); 
-      }
-    }
-
-    Complex psqMax(16.0);
-    Fp =  psqMax*one/psq;
-
-    pokeSite(TComplex(16.0),Fp,coor);
-    if( (orthog>=0) && (orthog<Nd) ){
-      for(int t=0;t<grid->GlobalDimensions()[orthog];t++){
-	coor[orthog]=t;
-	pokeSite(TComplex(16.0),Fp,coor);
-      }
-    }
-    
-    dmuAmu_p  = dmuAmu_p * Fp; 
-
-    theFFT.FFT_dim_mask(dmuAmu,dmuAmu_p,mask,FFT::backward);
+    accel.theFFT.FFT_dim_mask(dmuAmu_p,dmuAmu,accel.mask,FFT::forward);
 
-    GaugeMat ciadmam(grid);
-    Complex cialpha(0.0,-alpha);
-    ciadmam = dmuAmu*cialpha;
-    SU<Nc>::taExp(ciadmam,g);
+    dmuAmu_p  = dmuAmu_p * accel.Fp; 
 
-    Real trG = TensorRemove(sum(trace(g))).real()/vol/Nc;
+    accel.theFFT.FFT_dim_mask(dmuAmu,dmuAmu_p,accel.mask,FFT::backward);
 
-    xform = g*xform ;
-    SU<Nc>::GaugeTransform<Gimpl>(U,g);
-
-    return trG;
+    return ExpiAlphaDmuAmuTransform(U,xform,alpha,dmuAmu);
   }
 
   static void ExpiAlphaDmuAmu(const std::vector<GaugeMat> &U,GaugeMat &g, Real alpha, GaugeMat &dmuAmu,int orthog) {
@@ -231,6 +308,144 @@ public:
     ciadmam = dmuAmu*cialpha;
     SU<Nc>::taExp(ciadmam,g);
   }  
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////
+  // Los Alamos overrelaxation. Sites of one parity are updated at a time: g(x) maximises
+  // Re tr g(x) K(x), K(x) = sum_mu U_mu(x) + U_mu^dag(x-mu), one SU(2) subgroup after the other
+  // with each subgroup element raised to the power omega, 1 <= omega < 2.
+  // g^omega is the second order binomial series, reunitarised. omega=1 is plain relaxation.
+  // Needs no FFT and typically converges in far fewer iterations than steepest descent.
+  ////////////////////////////////////////////////////////////////////////////////////////////////
+  static Real OverrelaxationStep(std::vector<GaugeMat> &U,GaugeMat &xform, Real omega, const LatticeInteger &parity, int cb, int orthog) {
+    GridBase *grid = U[0].Grid();
+    std::vector<GaugeMat> Um(Nd,grid);
+    for(int mu=0;mu<Nd;mu++){
+      if ( mu != orthog ) Um[mu] = Gimpl::CshiftLink(U[mu], mu, -1);
+    }
+
+    GaugeMat g(grid);
+    Vector<View> U_v; U_v.reserve(Nd);
+    Vector<View> Um_v; Um_v.reserve(Nd);
+    for(int mu=0;mu<Nd;mu++){
+      U_v.push_back(U[mu].View(AcceleratorRead));
+      Um_v.push_back(Um[mu].View(AcceleratorRead));
+    }
+    View *U_p  = &U_v[0];
+    View *Um_p = &Um_v[0];
+    RealD c1 = omega;
+    RealD c2 = 0.5*omega*(omega-1.0);
+    {
+      autoView( g_v , g, AcceleratorWrite);
+      accelerator_for(ss, grid->oSites(), vobj::Nsimd(), {
+	typedef decltype(coalescedRead(g_v[0])) mat_t;
+	typedef typename std::remove_reference<decltype(g_v[0]()()(0,0))>::type cplx_t;
+	const cplx_t one(1.0);
+	mat_t K, gs;
+	K = Zero();
+	for(int mu=0;mu<Nd;mu++){
+	  if ( mu != orthog ) K = K + U_p[mu](ss) + adj(Um_p[mu](ss));
+	}
+	gs = 1.0;
+	for(int i0=0;i0<Nc;i0++){
+	for(int i1=i0+1;i1<Nc;i1++){
+	  // The subgroup element (a,b;-b*,a*) maximising Re tr g K
+	  auto a = conjugate(K()()(i0,i0)) + K()()(i1,i1);
+	  auto b = conjugate(K()()(i1,i0)) - K()()(i0,i1);
+	  auto n = sqrt(real(a*conjugate(a)+b*conjugate(b)));
+	  a = a/n;
+	  b = b/n;
+	  // g^omega ~ 1 + omega h + omega(omega-1)/2 h^2, h = g-1
+	  auto h0 = a - one;
+	  auto hb = b*real(h0);
+	  auto ra = one + c1*h0 + c2*(h0*h0 - b*conjugate(b));
+	  auto rb = c1*b + c2*(hb+hb);
+	  n = sqrt(real(ra*conjugate(ra)+rb*conjugate(rb)));
+	  ra = ra/n;
+	  rb = rb/n;
+	  // Rows i0,i1 of K and of the accumulated g
+	  for(int j=0;j<Nc;j++){
+	    auto k0 = K()()(i0,j);
+	    auto k1 = K()()(i1,j);
+	    K()()(i0,j) = ra*k0 + rb*k1;
+	    K()()(i1,j) = conjugate(ra)*k1 - conjugate(rb)*k0;
+	    auto g0 = gs()()(i0,j);
+	    auto g1 = gs()()(i1,j);
+	    gs()()(i0,j) = ra*g0 + rb*g1;
+	    gs()()(i1,j) = conjugate(ra)*g1 - conjugate(rb)*g0;
+	  }
+	}}
+	coalescedWrite(g_v[ss], gs);
+      });
+    }
+    for(int mu=0;mu<Nd;mu++){
+      U_v[mu].ViewClose();
+      Um_v[mu].ViewClose();
+    }
+
+    GaugeMat one(grid); one = 1.0;
+    g = where(parity==Integer(cb), g, one);
+
+    Real vol = grid->gSites();
+    Real trG = (TensorRemove(sum(trace(g))).real() - 0.5*vol*Nc)/(0.5*vol*Nc);
+    xform = g*xform;
+    TransformLinks(U,g);
+    return trG;
+  }
+
+  //Returns the number of iterations taken, one iteration updates both parities
+  static int OverrelaxationGaugeFix(GaugeLorentz &Umu,Real omega,int maxiter,Real Omega_tol, Real Phi_tol,int orthog=-1,bool err_on_no_converge=true) {
+    GridBase *grid = Umu.Grid();
+    GaugeMat xform(grid);
+    return OverrelaxationGaugeFix(Umu,xform,omega,maxiter,Omega_tol,Phi_tol,orthog,err_on_no_converge);
+  }
+  static int OverrelaxationGaugeFix(GaugeLorentz &Umu,GaugeMat &xform,Real omega,int maxiter,Real Omega_tol, Real Phi_tol,int orthog=-1,bool err_on_no_converge=true) {
+    GridBase *grid = Umu.Grid();
+    assert( (omega >= 1.0) && (omega < 2.0) );
+
+    Real old_trace = WilsonLoops<Gimpl>::linkTrace(Umu);
+    xform=1.0;
+
+    LatticeInteger parity(grid), coor(grid);
+    parity = Zero();
+    for(int mu=0;mu<Nd;mu++){
+      LatticeCoordinate(coor,mu);
+      parity = parity + coor;
+    }
+    parity = mod(parity,2);
+
+    std::vector<GaugeMat> U(Nd,grid);
+    for(int mu=0;mu<Nd;mu++) U[mu]= PeekIndex<LorentzIndex>(Umu,mu);
+
+    if( (orthog>=0) && (orthog<Nd) ){
+      std::cout << GridLogMessage << " Overrelaxation gauge fixing to Coulomb gauge time="<<orthog<< " omega= "<<omega<<" link trace = "<<old_trace<<  std::endl;
+    } else { 
+      std::cout << GridLogMessage << " Overrelaxation gauge fixing to Landau gauge omega= "<<omega<<" link trace = "<<old_trace<<  std::endl;
+    }
+    double t0=usecond();
+    for(int i=0;i<maxiter;i++){
+      Real trG = 0.5*OverrelaxationStep(U,xform,omega,parity,Even,orthog);
+      trG     += 0.5*OverrelaxationStep(U,xform,omega,parity,Odd ,orthog);
+
+      if ( i %20 == 0 ) { 
+	for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
+	Real link_trace=WilsonLoops<Gimpl>::linkTrace(Umu); 
+	Real Phi  = 1.0 - old_trace / link_trace ;
+	Real Omega= 1.0 - trG;
+	std::cout << GridLogMessage << " Overrelaxation Iteration "<<i<< " Phi= "<<Phi<< " Omega= " << Omega<< " trG " << trG <<std::endl;
+	if ( (Omega < Omega_tol) && ( ::fabs(Phi) < Phi_tol) ) {
+	  double t1=usecond();
+	  std::cout << GridLogMessage << "Converged ! "<<i+1<<" iterations, "<<(i+1)/((t1-t0)*1.0e-6)<<" iterations/s"<<std::endl;
+	  return i+1;
+	}
+	old_trace = link_trace;
+      }
+    }
+    for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
+    std::cout << GridLogError << "Gauge fixing did not converge in " << maxiter << " iterations." << std::endl;
+    if (err_on_no_converge)
+      assert(0 && "Gauge fixing did not converge within the specified number of iterations");
+    return maxiter;
+  }
 };
 
 NAMESPACE_END(Grid);
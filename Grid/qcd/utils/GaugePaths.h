@@ -0,0 +1,308 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/utils/GaugePaths.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////
+// A path of gauge links starting at x+origin, read left to right:
+//   Forward(mu)  multiplies by U_mu(y)   and moves y -> y+mu
+//   Backward(mu) moves y -> y-mu and multiplies by U^dag_mu(y)
+// A closed path is a Wilson loop based at x+origin, an open one ending at
+// x is a staple.
+////////////////////////////////////////////////////////////////////////////
+class GaugeLinkPath {
+public:
+  Coordinate       origin;
+  std::vector<int> steps;   // +(mu+1) forward, -(mu+1) backward
+
+  GaugeLinkPath(void) : origin(Nd,0) {};
+  GaugeLinkPath(const Coordinate &_origin) : origin(_origin) {};
+
+  GaugeLinkPath &Forward (int mu,int n=1) { for(int i=0;i<n;i++) steps.push_back( mu+1); return *this; }
+  GaugeLinkPath &Backward(int mu,int n=1) { for(int i=0;i<n;i++) steps.push_back(-mu-1); return *this; }
+
+  // Rmu x Rnu loop at x in the orientation of WilsonLoops::wilsonLoop
+  static GaugeLinkPath Loop(int mu,int nu,int Rmu,int Rnu)
+  {
+    GaugeLinkPath p;
+    p.Backward(mu,Rmu).Backward(nu,Rnu).Forward(mu,Rmu).Forward(nu,Rnu);
+    return p;
+  }
+
+  // Sites visited, both ends included. Every link on the path sits on one of them.
+  std::vector<Coordinate> Sites(void) const
+  {
+    std::vector<Coordinate> sites(1,origin);
+    Coordinate y = origin;
+    for(int s=0;s<steps.size();s++){
+      int mu = abs(steps[s])-1;
+      y[mu] += (steps[s]>0) ? 1 : -1;
+      sites.push_back(y);
+    }
+    return sites;
+  }
+  // Padding needed to evaluate the path from any site of the local volume
+  int Depth(void) const
+  {
+    int depth=0;
+    std::vector<Coordinate> sites = Sites();
+    for(int i=0;i<sites.size();i++){
+      for(int d=0;d<sites[i].size();d++) depth = std::max(depth,abs(sites[i][d]));
+    }
+    return depth;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Sums of link paths evaluated in one pass:
+//
+//   out[o](x) = sum_{paths p of output o} c_p  P_p(x)
+//
+// For periodic gauge fields the links are padded once to the deepest path
+// and every path of every output is multiplied out site locally through a
+// GeneralLocalStencil over the padded cell, so a set of large loops costs a
+// single halo exchange per link direction instead of a Cshift per link. The
+// padded cell and stencil are built on first use for a grid and kept by this
+// object only, so a caller evaluating the same paths repeatedly must keep the
+// GaugeLinkPaths alive (see the WilsonLoops ...Paths builders and the
+// overloads taking a held path set).
+//
+// Twisted boundaries, red black grids and local volumes thinner than the
+// padding fall back to CovShiftForward / CovShiftBackward chains.
+////////////////////////////////////////////////////////////////////////////
+template<class Gimpl>
+class GaugeLinkPaths {
+public:
+  INHERIT_GIMPL_TYPES(Gimpl);
+  typedef typename GaugeLinkField::vector_object vobj;
+
+private:
+  struct Term {
+    int           out;
+    GaugeLinkPath path;
+    RealD         coeff;
+  };
+  std::vector<Term> terms;
+  int nout;
+  int depth;
+
+  // Tables for the padded kernel, terms ordered by output
+  mutable std::shared_ptr<PaddedCell>          Ghost;
+  mutable std::shared_ptr<GeneralLocalStencil> PathStencil;
+  mutable Vector<int>   out_begin;   // terms of output o are [out_begin[o],out_begin[o+1])
+  mutable Vector<int>   term_begin;  // links of term t are [term_begin[t],term_begin[t+1])
+  mutable Vector<int>   links;       // (point*Nd+mu)*2+dagger
+  mutable Vector<RealD> coeffs;
+
+  void BuildTables(GridCartesian *cgrid) const
+  {
+    std::vector<int> order(terms.size());
+    for(int t=0;t<terms.size();t++) order[t]=t;
+    std::stable_sort(order.begin(),order.end(),[&](int a,int b){ return terms[a].out < terms[b].out; });
+
+    std::map<std::vector<int>,int> point_of;
+    std::vector<Coordinate> shifts;
+    auto point = [&](const Coordinate &c) {
+      std::vector<int> key(c.begin(),c.end());
+      auto it = point_of.find(key);
+      if ( it != point_of.end() ) return it->second;
+      int p = shifts.size();
+      point_of[key] = p;
+      shifts.push_back(c);
+      return p;
+    };
+
+    out_begin.resize(nout+1);
+    term_begin.resize(0);
+    links.resize(0);
+    coeffs.resize(0);
+    int o=0;
+    for(int i=0;i<order.size();i++){
+      const Term &term = terms[order[i]];
+      while ( o<=term.out ) out_begin[o++] = i;
+      term_begin.push_back(links.size());
+      coeffs.push_back(term.coeff);
+      Coordinate y = term.path.origin;
+      for(int s=0;s<term.path.steps.size();s++){
+	int step = term.path.steps[s];
+	int mu   = abs(step)-1;
+	if ( step>0 ) {
+	  links.push_back((point(y)*Nd+mu)*2);
+	  y[mu]++;
+	} else {
+	  y[mu]--;
+	  links.push_back((point(y)*Nd+mu)*2+1);
+	}
+      }
+    }
+    while ( o<=nout ) out_begin[o++] = order.size();
+    term_begin.push_back(links.size());
+
+    Ghost       = std::make_shared<PaddedCell>(depth,cgrid);
+    PathStencil = std::make_shared<GeneralLocalStencil>(Ghost->grids.back(),shifts);
+  }
+
+public:
+  GaugeLinkPaths(void) : nout(0), depth(0) {};
+
+  // Add c * path to output out
+  void AddPath(int out,const GaugeLinkPath &path,RealD coeff=1.0)
+  {
+    assert(out>=0);
+    assert(path.origin.size()==Nd);
+    assert(path.steps.size()>0);
+    terms.push_back(Term{out,path,coeff});
+    nout  = std::max(nout,out+1);
+    depth = std::max(depth,path.Depth());
+    Ghost       = nullptr;
+    PathStencil = nullptr;
+  }
+  int Outputs(void) const { return nout; }
+  int Paths(void)   const { return terms.size(); }
+  int Depth(void)   const { return depth; }
+
+  bool Padded(GridBase *grid) const
+  {
+    if ( !Gimpl::isPeriodicGaugeField() ) return false;
+    GridCartesian *cgrid = dynamic_cast<GridCartesian *>(grid);
+    if ( cgrid == nullptr ) return false;
+    Coordinate local = cgrid->LocalDimensions();
+    Coordinate procs = cgrid->ProcessorGrid();
+    for(int d=0;d<Nd;d++){
+      if ( (procs[d]>1) && (local[d]<depth) ) return false;
+    }
+    if ( !(Ghost && (Ghost->unpadded_grid == cgrid)) ) BuildTables(cgrid);
+    return true;
+  }
+
+  void Evaluate(std::vector<GaugeLinkField> &out,const GaugeField &Umu) const
+  {
+    std::vector<GaugeLinkField> U(Nd,Umu.Grid());
+    for(int mu=0;mu<Nd;mu++) U[mu] = PeekIndex<LorentzIndex>(Umu,mu);
+    Evaluate(out,U);
+  }
+  void Evaluate(std::vector<GaugeLinkField> &out,const std::vector<GaugeLinkField> &U) const
+  {
+    assert(U.size()==Nd);
+    GridBase *grid = U[0].Grid();
+    out.resize(nout,grid);
+    if ( Padded(grid) ) EvaluatePadded(out,U);
+    else                EvaluateCshift(out,U);
+  }
+
+  void EvaluatePadded(std::vector<GaugeLinkField> &out,const std::vector<GaugeLinkField> &U) const
+  {
+    GRID_TRACE("GaugeLinkPathsPadded");
+    double t0=usecond();
+    GridBase *pgrid = Ghost->grids.back();
+    std::vector<GaugeLinkField> Ug(Nd,pgrid);
+    std::vector<GaugeLinkField> Og(nout,pgrid);
+    for(int mu=0;mu<Nd;mu++) Ug[mu] = Ghost->Exchange(U[mu]);
+    double t1=usecond();
+
+    typedef LatticeView<vobj> View;
+    Vector<View> U_v; U_v.reserve(Nd);
+    Vector<View> O_v; O_v.reserve(nout);
+    for(int mu=0;mu<Nd;mu++) U_v.push_back(Ug[mu].View(AcceleratorRead));
+    for(int o=0;o<nout;o++)  O_v.push_back(Og[o].View(AcceleratorWrite));
+    View *U_p = &U_v[0];
+    View *O_p = &O_v[0];
+
+    int   *ob_p = &out_begin[0];
+    int   *tb_p = &term_begin[0];
+    int   *lk_p = &links[0];
+    RealD *cf_p = &coeffs[0];
+    int Nout = nout;
+    auto gStencil_v = PathStencil->View(AcceleratorRead);
+
+    typedef decltype(coalescedReadGeneralPermute(U_p[0][0],gStencil_v.GetEntry(0,0)->_permute,Nd)) U3matrix;
+
+    accelerator_for(ss,pgrid->oSites(),vobj::Nsimd(),{
+      for(int o=0;o<Nout;o++){
+	U3matrix acc, prod, link;
+	acc = Zero();
+	for(int t=ob_p[o];t<ob_p[o+1];t++){
+	  for(int l=tb_p[t];l<tb_p[t+1];l++){
+	    int lk = lk_p[l];
+	    int mu = (lk>>1)%Nd;
+	    auto SE = gStencil_v.GetEntry((lk>>1)/Nd,ss);
+	    link = coalescedReadGeneralPermute(U_p[mu][SE->_offset],SE->_permute,Nd);
+	    if ( lk&0x1 ) link = adj(link);
+	    if ( l==tb_p[t] ) prod = link;
+	    else              prod = prod*link;
+	  }
+	  acc = acc + cf_p[t]*prod;
+	}
+	coalescedWrite(O_p[o][ss],acc);
+      }
+    });
+
+    for(int mu=0;mu<Nd;mu++) U_v[mu].ViewClose();
+    for(int o=0;o<nout;o++)  O_v[o].ViewClose();
+
+    for(int o=0;o<nout;o++) out[o] = Ghost->Extract(Og[o]);
+    double t2=usecond();
+    std::cout << GridLogPerformance << "GaugeLinkPaths: "<<terms.size()<<" paths depth "<<depth
+	      << " pad:" << (t1-t0)/1000 << "ms, paths:" << (t2-t1)/1000 << "ms" << std::endl;
+  }
+
+  // Reference evaluation by covariant shifts, boundary conditions from Gimpl
+  void EvaluateCshift(std::vector<GaugeLinkField> &out,const std::vector<GaugeLinkField> &U) const
+  {
+    GRID_TRACE("GaugeLinkPathsCshift");
+    GridBase *grid = U[0].Grid();
+    out.resize(nout,grid);
+    for(int o=0;o<nout;o++) out[o] = Zero();
+
+    GaugeLinkField P(grid);
+    for(int t=0;t<terms.size();t++){
+      const GaugeLinkPath &path = terms[t].path;
+      // Build the product from its last link
+      int n = path.steps.size();
+      int step = path.steps[n-1];
+      int mu   = abs(step)-1;
+      if ( step>0 ) P = Gimpl::CovShiftIdentityForward(U[mu],mu);
+      else          P = Gimpl::CovShiftIdentityBackward(U[mu],mu);
+      for(int s=n-2;s>=0;s--){
+	step = path.steps[s];
+	mu   = abs(step)-1;
+	if ( step>0 ) P = Gimpl::CovShiftForward (U[mu],mu,P);
+	else          P = Gimpl::CovShiftBackward(U[mu],mu,P);
+      }
+      for(int d=0;d<Nd;d++){
+	for(int i=0;i<abs(path.origin[d]);i++){
+	  P = Gimpl::CshiftLink(P,d,(path.origin[d]>0) ? 1 : -1);
+	}
+      }
+      out[terms[t].out] = out[terms[t].out] + terms[t].coeff*P;
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
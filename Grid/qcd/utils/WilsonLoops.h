@@ -619,25 +619,37 @@ public:
   }
 
   static Real TopologicalCharge(const GaugeLorentz &U){
+    GaugeLinkPaths<Gimpl> clover;
+    FieldStrengthMxNPaths(clover, 1, 1);
+    return TopologicalCharge(U, clover);
+  }
+  //As above with the clover leaves from FieldStrengthMxNPaths(clover,1,1) held by the caller
+  static Real TopologicalCharge(const GaugeLorentz &U, const GaugeLinkPaths<Gimpl> &clover){
     // 4d topological charge
     assert(Nd==4);
-    // Bx = -iF(y,z), By = -iF(z,y), Bz = -iF(x,y)
-    GaugeMat Bx(U.Grid()), By(U.Grid()), Bz(U.Grid());
-    FieldStrength(Bx, U, Ydir, Zdir);
-    FieldStrength(By, U, Zdir, Xdir);
-    FieldStrength(Bz, U, Xdir, Ydir);
-
-    // Ex = -iF(t,x), Ey = -iF(t,y), Ez = -iF(t,z)
-    GaugeMat Ex(U.Grid()), Ey(U.Grid()), Ez(U.Grid());
-    FieldStrength(Ex, U, Tdir, Xdir);
-    FieldStrength(Ey, U, Tdir, Ydir);
-    FieldStrength(Ez, U, Tdir, Zdir);
+    std::vector<std::vector<GaugeMat> > F;
+    FieldStrengthMxNAll(F, U, 1, 1, clover);
+    ComplexField qfield(U.Grid());
+    TopologicalChargeDensity(qfield, F);
+    auto Tq = sum(qfield);
+    return TensorRemove(Tq).real();
+  }
 
+  //Clover topological charge density from the FieldStrengthMxNAll(F,U,1,1) planes
+  //FieldStrength(mu,nu) = -F[mu][nu], so tr(Bx Ex + By Ey + Bz Ez) in terms of the mu<nu planes
+  static void TopologicalChargeDensity(ComplexField &qfield, const std::vector<std::vector<GaugeMat> > &F){
     double coeff = 8.0/(32.0*M_PI*M_PI);
+    qfield = coeff*trace( F[Ydir][Tdir]*F[Xdir][Zdir] - F[Xdir][Tdir]*F[Ydir][Zdir] - F[Zdir][Tdir]*F[Xdir][Ydir] );
+  }
 
-    ComplexField qfield = coeff*trace(Bx*Ex + By*Ey + Bz*Ez);
-    auto Tq = sum(qfield);
-    return TensorRemove(Tq).real();
+  //Clover energy density -sum_{mu<nu} tr F_munu F_munu from the FieldStrengthMxNAll(F,U,1,1) planes
+  static void EnergyDensityCloverleaf(ComplexField &R, const std::vector<std::vector<GaugeMat> > &F){
+    R = Zero();
+    for(int mu=0;mu<Nd-1;mu++){
+      for(int nu=mu+1;nu<Nd;nu++){
+	R = R - trace(F[mu][nu]*F[mu][nu]);
+      }
+    }
   }
 
 
@@ -716,6 +728,57 @@ public:
 #undef BnuI
   }
 
+  //The four CloverleafMxN loops as link paths, added with weight coeff to output out
+  static void CloverleafMxNPaths(GaugeLinkPaths<Gimpl> &paths, int out, int mu, int nu, int M, int N, RealD coeff=1.0){
+    GaugeLinkPath ur, ul, lr, ll;
+    ur.Forward(nu,N).Forward(mu,M).Backward(nu,N).Backward(mu,M);
+    ul.Backward(mu,M).Forward(nu,N).Forward(mu,M).Backward(nu,N);
+    lr.Forward(mu,M).Backward(nu,N).Backward(mu,M).Forward(nu,N);
+    ll.Backward(nu,N).Backward(mu,M).Forward(nu,N).Forward(mu,M);
+    paths.AddPath(out,ur,coeff);
+    paths.AddPath(out,ul,coeff);
+    paths.AddPath(out,lr,coeff);
+    paths.AddPath(out,ll,coeff);
+  }
+
+  //The clover leaves of FieldStrengthMxNAll, one output per plane mu < nu
+  static void FieldStrengthMxNPaths(GaugeLinkPaths<Gimpl> &paths, int M, int N){
+    int planes=0;
+    for(int mu=0;mu<Nd-1;mu++){
+      for(int nu=mu+1; nu<Nd; nu++){
+	CloverleafMxNPaths(paths, planes, mu, nu, M, N);
+	if(M != N) CloverleafMxNPaths(paths, planes, mu, nu, N, M);
+	planes++;
+      }
+    }
+  }
+
+  //FieldStrengthMxN for all planes mu < nu from one evaluation of the clover leaves
+  //FS is sized on output, entries with mu >= nu are not set
+  static void FieldStrengthMxNAll(std::vector<std::vector<GaugeMat> > &FS, const GaugeLorentz &U, int M, int N){
+    GaugeLinkPaths<Gimpl> paths;
+    FieldStrengthMxNPaths(paths, M, N);
+    FieldStrengthMxNAll(FS, U, M, N, paths);
+  }
+  //As above with paths from FieldStrengthMxNPaths(paths,M,N) held by the caller,
+  //so repeated measurements reuse its padded cell and stencil
+  static void FieldStrengthMxNAll(std::vector<std::vector<GaugeMat> > &FS, const GaugeLorentz &U, int M, int N,
+				  const GaugeLinkPaths<Gimpl> &paths){
+    std::vector<GaugeMat> C;
+    paths.Evaluate(C, U);
+
+    RealD coeff = (M == N) ? 0.125 : 0.0625;
+    FS.resize(Nd);
+    int planes=0;
+    for(int mu=0;mu<Nd-1;mu++){
+      FS[mu].resize(Nd, U.Grid());
+      for(int nu=mu+1; nu<Nd; nu++){
+	FS[mu][nu] = coeff * ( C[planes] - adj(C[planes]) );
+	planes++;
+      }
+    }
+  }
+
   //Field strength from MxN Wilson loop
   //Note F_numu = - F_munu
   static void FieldStrengthMxN(GaugeMat &FS, const GaugeLorentz &U, int mu, int nu, int M, int N){  
@@ -739,16 +802,11 @@ public:
   //output is the charge by timeslice: sum over timeslices to obtain the total
   static std::vector<Real> TimesliceTopologicalChargeMxN(const GaugeLorentz &U, int M, int N){
     assert(Nd == 4);
-    std::vector<std::vector<GaugeMat*> > F(Nd,std::vector<GaugeMat*>(Nd,nullptr));
     //Note F_numu = - F_munu
     //hence we only need to loop over mu,nu,rho,sigma that aren't related by permuting mu,nu  or rho,sigma
     //Use nu > mu
-    for(int mu=0;mu<Nd-1;mu++){
-      for(int nu=mu+1; nu<Nd; nu++){
-	F[mu][nu] = new GaugeMat(U.Grid());
-	FieldStrengthMxN(*F[mu][nu], U, mu, nu, M, N);
-      }
-    }
+    std::vector<std::vector<GaugeMat> > F;
+    FieldStrengthMxNAll(F, U, M, N);
     Real coeff = -1./(32 * M_PI*M_PI * M*M * N*N); //overall sign to match CPS and Grid conventions, possibly related to time direction = 3 vs 0
 
     static const int combs[3][4] = { {0,1,2,3}, {0,2,1,3}, {0,3,1,2} };
@@ -759,13 +817,9 @@ public:
     for(int c=0;c<3;c++){
       int mu = combs[c][0], nu = combs[c][1], rho = combs[c][2], sigma = combs[c][3];
       int eps = signs[c];
-      fsum = fsum + (8. * coeff * eps) * trace( (*F[mu][nu]) * (*F[rho][sigma]) ); 
+      fsum = fsum + (8. * coeff * eps) * trace( F[mu][nu] * F[rho][sigma] ); 
     }
 
-    for(int mu=0;mu<Nd-1;mu++)
-      for(int nu=mu+1; nu<Nd; nu++)
-	delete F[mu][nu];
-    
     typedef typename ComplexField::scalar_object sobj;
     std::vector<sobj> Tq;
     sliceSum(fsum, Tq, Nd-1);
@@ -860,17 +914,30 @@ public:
     dirRectangle(sp, U, mu, nu);
     rect = trace(sp);
   }
-  static void siteRectangle(ComplexField &Rect,
-                            const std::vector<GaugeMat> &U) {
-    ComplexField siteRect(U[0].Grid());
-    Rect = Zero();
+  static void RectanglePaths(GaugeLinkPaths<Gimpl> &paths) {
     for (int mu = 1; mu < Nd; mu++) {
       for (int nu = 0; nu < mu; nu++) {
-        traceDirRectangle(siteRect, U, mu, nu);
-        Rect = Rect + siteRect;
+        GaugeLinkPath r1, r2;
+        r1.Forward(mu,2).Forward(nu).Backward(mu,2).Backward(nu);
+        r2.Forward(mu).Forward(nu,2).Backward(mu).Backward(nu,2);
+        paths.AddPath(0,r1);
+        paths.AddPath(0,r2);
       }
     }
   }
+  static void siteRectangle(ComplexField &Rect,
+                            const std::vector<GaugeMat> &U) {
+    GaugeLinkPaths<Gimpl> paths;
+    RectanglePaths(paths);
+    siteRectangle(Rect, U, paths);
+  }
+  static void siteRectangle(ComplexField &Rect,
+                            const std::vector<GaugeMat> &U,
+                            const GaugeLinkPaths<Gimpl> &paths) {
+    std::vector<GaugeMat> sum;
+    paths.Evaluate(sum,U);
+    Rect = trace(sum[0]);
+  }
 
   //////////////////////////////////////////////////
   // sum over all x,y,z,t and over all planes of plaquette
@@ -1399,54 +1466,59 @@ public:
   //////////////////////////////////////////////////
   // sum over all planes of Wilson loop
   //////////////////////////////////////////////////
-  static void siteWilsonLoop(LatticeComplex &Wl,
-                            const std::vector<GaugeMat> &U,
-                            const int R1, const int R2) {
-    LatticeComplex siteWl(U[0].Grid());
-    Wl = Zero();
-    for (int mu = 1; mu < U[0].Grid()->_ndimension; mu++) {
+  static void WilsonLoopPaths(GaugeLinkPaths<Gimpl> &paths, const int ndim,
+                              const int R1, const int R2) {
+    for (int mu = 1; mu < ndim; mu++) {
       for (int nu = 0; nu < mu; nu++) {
-        traceWilsonLoop(siteWl, U, R1, R2, mu, nu);
-        Wl = Wl + siteWl;
-        traceWilsonLoop(siteWl, U, R2, R1, mu, nu);
-        Wl = Wl + siteWl;
+        paths.AddPath(0,GaugeLinkPath::Loop(mu,nu,R1,R2));
+        paths.AddPath(0,GaugeLinkPath::Loop(mu,nu,R2,R1));
       }
     }
   }
+  static void siteWilsonLoop(LatticeComplex &Wl,
+                            const std::vector<GaugeMat> &U,
+                            const int R1, const int R2) {
+    GaugeLinkPaths<Gimpl> paths;
+    WilsonLoopPaths(paths, U[0].Grid()->_ndimension, R1, R2);
+    siteWilsonLoop(Wl, U, paths);
+  }
+  static void siteWilsonLoop(LatticeComplex &Wl,
+                            const std::vector<GaugeMat> &U,
+                            const GaugeLinkPaths<Gimpl> &paths) {
+    std::vector<GaugeMat> sum;
+    paths.Evaluate(sum,U);
+    Wl = trace(sum[0]);
+  }
   //////////////////////////////////////////////////
   // sum over planes of Wilson loop with length R1
   // in the time direction
   //////////////////////////////////////////////////
+  static void TimelikeWilsonLoopPaths(GaugeLinkPaths<Gimpl> &paths, const int ndim,
+                                      const int R1, const int R2) {
+    for (int nu = 0; nu < ndim - 1; nu++) {
+      paths.AddPath(0,GaugeLinkPath::Loop(ndim-1,nu,R1,R2));
+    }
+  }
   static void siteTimelikeWilsonLoop(LatticeComplex &Wl,
                             const std::vector<GaugeMat> &U,
                             const int R1, const int R2) {
-    LatticeComplex siteWl(U[0].Grid());
-
-    int ndim = U[0].Grid()->_ndimension;
-
-    Wl = Zero();
-    for (int nu = 0; nu < ndim - 1; nu++) {
-      traceWilsonLoop(siteWl, U, R1, R2, ndim-1, nu);
-      Wl = Wl + siteWl;
-    }
+    GaugeLinkPaths<Gimpl> paths;
+    TimelikeWilsonLoopPaths(paths, U[0].Grid()->_ndimension, R1, R2);
+    siteWilsonLoop(Wl, U, paths);
   }
   //////////////////////////////////////////////////
   // sum Wilson loop over all planes orthogonal to the time direction
   //////////////////////////////////////////////////
+  static void SpatialWilsonLoopPaths(GaugeLinkPaths<Gimpl> &paths, const int ndim,
+                                     const int R1, const int R2) {
+    WilsonLoopPaths(paths, ndim - 1, R1, R2);
+  }
   static void siteSpatialWilsonLoop(LatticeComplex &Wl,
                             const std::vector<GaugeMat> &U,
                             const int R1, const int R2) {
-    LatticeComplex siteWl(U[0].Grid());
-
-    Wl = Zero();
-    for (int mu = 1; mu < U[0].Grid()->_ndimension - 1; mu++) {
-      for (int nu = 0; nu < mu; nu++) {
-        traceWilsonLoop(siteWl, U, R1, R2, mu, nu);
-        Wl = Wl + siteWl;
-        traceWilsonLoop(siteWl, U, R2, R1, mu, nu);
-        Wl = Wl + siteWl;
-      }
-    }
+    GaugeLinkPaths<Gimpl> paths;
+    SpatialWilsonLoopPaths(paths, U[0].Grid()->_ndimension, R1, R2);
+    siteWilsonLoop(Wl, U, paths);
   }
   //////////////////////////////////////////////////
   // sum over all x,y,z,t and over all planes of Wilson loop
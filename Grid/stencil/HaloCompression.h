@@ -0,0 +1,113 @@
+/*************************************************************************************
+
+     Grid physics library, www.github.com/paboyle/Grid
+
+     Source file: ./lib/stencil/HaloCompression.h
+
+     Copyright (C) 2015
+
+ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+     This program is free software; you can redistribute it and/or modify
+     it under the terms of the GNU General Public License as published by
+     the Free Software Foundation; either version 2 of the License, or
+     (at your option) any later version.
+
+     This program is distributed in the hope that it will be useful,
+     but WITHOUT ANY WARRANTY; without even the implied warranty of
+     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+     GNU General Public License for more details.
+
+     You should have received a copy of the GNU General Public License along
+     with this program; if not, write to the Free Software Foundation, Inc.,
+     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+     See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////////////
+// Reduced precision wire format for stencil halo exchange.
+//
+// Sits after the compressor: whatever the compressor gathered (Wilson half spinor,
+// staggered spinor, coarse vector...) is packed block-wise into 16 bit words with
+// one float scale per block before MPI, and unpacked into the comms buffer after.
+// Each stencil opts in through comms_precision in its parameters (ImplParams); the
+// packed reals follow the compressor's datum, so half comms spinors are packed as float.
+//////////////////////////////////////////////////////////////////////////////////
+enum HaloPrecision { HaloPrecisionFull=0, HaloPrecisionFp16=1, HaloPrecisionBf16=2 };
+
+const int HaloCompressionBlock = 32; // reals per scale factor
+
+accelerator_inline uint16_t sfw_float_to_bfloat16(float ff) {
+  FP32 f; f.f = ff;
+  // round to nearest even on the 16 dropped bits
+  unsigned int lsb = (f.u >> 16) & 1;
+  f.u += 0x7fff + lsb;
+  return (uint16_t)(f.u >> 16);
+}
+accelerator_inline float sfw_bfloat16_to_float(uint16_t h) {
+  FP32 f;
+  f.u = ((unsigned int)h)<<16;
+  return f.f;
+}
+
+inline uint64_t HaloCompressedBytes(uint64_t bytes,int realsize)
+{
+  uint64_t nreal  = bytes/realsize;
+  uint64_t nblock = (nreal+HaloCompressionBlock-1)/HaloCompressionBlock;
+  uint64_t words  = nblock*sizeof(float) + nreal*sizeof(uint16_t);
+  return (words+15)&(~((uint64_t)15)); // keep successive packets aligned
+}
+
+template<class Real>
+void HaloCompress(int precision,void *wire,const void *buf,uint64_t bytes)
+{
+  uint64_t nreal  = bytes/sizeof(Real);
+  uint64_t nblock = (nreal+HaloCompressionBlock-1)/HaloCompressionBlock;
+  const Real *in  = (const Real *)buf;
+  float    *scale = (float *)wire;
+  uint16_t *out   = (uint16_t *)&scale[nblock];
+  accelerator_for(b,nblock,1,{
+    uint64_t s = b*HaloCompressionBlock;
+    uint64_t e = s+HaloCompressionBlock; if ( e > nreal ) e = nreal;
+    Real mx=0.0;
+    for(uint64_t r=s;r<e;r++){
+      Real a = in[r]; a = (a<0.0) ? -a : a;
+      mx = (a>mx) ? a : mx;
+    }
+    float sc  = (float)mx;
+    float isc = (mx==0.0) ? 0.0f : 1.0f/sc;
+    scale[b] = sc;
+    if ( precision == HaloPrecisionFp16 ) {
+      for(uint64_t r=s;r<e;r++) out[r] = sfw_float_to_half((float)in[r]*isc).x;
+    } else {
+      for(uint64_t r=s;r<e;r++) out[r] = sfw_float_to_bfloat16((float)in[r]*isc);
+    }
+  });
+}
+
+template<class Real>
+void HaloDecompress(int precision,void *buf,const void *wire,uint64_t bytes)
+{
+  uint64_t nreal  = bytes/sizeof(Real);
+  uint64_t nblock = (nreal+HaloCompressionBlock-1)/HaloCompressionBlock;
+  Real *out = (Real *)buf;
+  const float    *scale = (const float *)wire;
+  const uint16_t *in    = (const uint16_t *)&scale[nblock];
+  accelerator_for(b,nblock,1,{
+    uint64_t s = b*HaloCompressionBlock;
+    uint64_t e = s+HaloCompressionBlock; if ( e > nreal ) e = nreal;
+    float sc = scale[b];
+    if ( precision == HaloPrecisionFp16 ) {
+      for(uint64_t r=s;r<e;r++) out[r] = sfw_half_to_float(Grid_half(in[r]))*sc;
+    } else {
+      for(uint64_t r=s;r<e;r++) out[r] = sfw_bfloat16_to_float(in[r])*sc;
+    }
+  });
+}
+
+NAMESPACE_END(Grid);
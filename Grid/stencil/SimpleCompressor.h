@@ -7,7 +7,8 @@ class SimpleStencilParams{
 public:
   Coordinate dirichlet;
   int partialDirichlet;
-  SimpleStencilParams() { partialDirichlet = 0; };
+  int comms_precision;
+  SimpleStencilParams() { partialDirichlet = 0; comms_precision = HaloPrecisionFull; };
 };
 
 
@@ -49,6 +49,25 @@ void DslashLogFull(void)     { DslashFullCount++;}
 void DslashLogPartial(void)  { DslashPartialCount++;}
 void DslashLogDirichlet(void){ DslashDirichletCount++;}
 
+// Time spent in CommunicateBegin/Complete and bytes put on the wire;
+// exchanges counts completed halo exchanges
+double   StencilHaloUsec;
+uint64_t StencilHaloBytes;
+uint64_t StencilHaloExchanges;
+
+void StencilHaloLog(double usec,uint64_t bytes,uint64_t exchanges)
+{
+  StencilHaloUsec     +=usec;
+  StencilHaloBytes    +=bytes;
+  StencilHaloExchanges+=exchanges;
+}
+void StencilGetHaloCounts(double &usec,uint64_t &bytes,uint64_t &exchanges)
+{
+  usec      = StencilHaloUsec;
+  bytes     = StencilHaloBytes;
+  exchanges = StencilHaloExchanges;
+}
+
 
 void Gather_plane_table_compute (GridBase *grid,int dimension,int plane,int cbmask,
 				 int off,std::vector<std::pair<int,int> > & table)
@@ -30,6 +30,7 @@
 
 #define STENCIL_MAX (16)
 
+#include <Grid/stencil/HaloCompression.h>
 #include <Grid/stencil/SimpleCompressor.h>   // subdir aggregate
 #include <Grid/stencil/Lebesgue.h>   // subdir aggregate
 #include <Grid/stencil/GeneralLocalStencil.h>
@@ -57,9 +58,11 @@ NAMESPACE_BEGIN(Grid);
 struct DefaultImplParams {
   Coordinate dirichlet; // Blocksize of dirichlet BCs
   int  partialDirichlet;
+  int  comms_precision; // HaloPrecision of the halo wire format
   DefaultImplParams()  {
     dirichlet.resize(0);
     partialDirichlet=0;
+    comms_precision=HaloPrecisionFull;
   };
 };
 
@@ -75,6 +78,8 @@ void DslashGetCounts(uint64_t &dirichlet,uint64_t &partial,uint64_t &full);
 void DslashLogFull(void);
 void DslashLogPartial(void);
 void DslashLogDirichlet(void);
+void StencilHaloLog(double usec,uint64_t bytes,uint64_t exchanges);
+void StencilGetHaloCounts(double &usec,uint64_t &bytes,uint64_t &exchanges);
 
 struct StencilEntry {
 #ifdef GRID_CUDA
@@ -199,6 +204,7 @@ public:
 
   typedef typename cobj::vector_type vector_type;
   typedef typename cobj::scalar_object scalar_object;
+  typedef typename RealPart<typename cobj::scalar_type>::type RealScalar;
   typedef const CartesianStencilView<vobj,cobj,Parameters> View_type;
   typedef typename View_type::StencilVector StencilVector;
   ///////////////////////////////////////////
@@ -217,6 +223,10 @@ public:
     Integer do_recv;
     Integer xbytes;
     Integer rbytes;
+    void * wire_send_buf; // == send_buf unless halo compression is on
+    void * wire_recv_buf;
+    Integer wire_xbytes;
+    Integer wire_rbytes;
   };
   struct Merge {
     static constexpr int Nsimd = vobj::Nsimd();
@@ -286,6 +296,18 @@ public:
   std::vector<CopyReceiveBuffer> CopyReceiveBuffers ;
   std::vector<CachedTransfer> CachedTransfers;
   std::vector<CommsRequest_t> MpiReqs;
+
+  ///////////////////////////////////////////////////////////
+  // Persistent plan: the Packets/Mergers/Decompressions schedule
+  // recorded by the first gather is replayed while the compressor
+  // is unchanged, with persistent MPI requests where possible.
+  ///////////////////////////////////////////////////////////
+  int plan_recorded;
+  size_t plan_compressor;
+  int plan_datum_size;
+  int plan_decompress;
+  std::vector<CommsRequest_t> MpiPersistentReqs;
+  int persistent_reqs_built;
   
   ///////////////////////////////////////////////////////////
   // Unified Comms buffers for all directions
@@ -299,6 +321,19 @@ public:
   int u_comm_offset;
   int _unified_buffer_size;
 
+  ///////////////////////////////////////////////////////////
+  // Reduced precision wire buffers, only if the parameters ask
+  // for comms_precision. wire_precision is what the current
+  // compressor's datum allows, packing reals of wire_real_size.
+  ///////////////////////////////////////////////////////////
+  int comms_precision;
+  int wire_precision;
+  int wire_real_size;
+  char *u_wire_send_buf_p;
+  char *u_wire_recv_buf_p;
+  uint64_t u_wire_send_offset;
+  uint64_t u_wire_recv_offset;
+
   ////////////////////////////////////////
   // Stencil query
   ////////////////////////////////////////
@@ -364,49 +399,87 @@ public:
   ////////////////////////////////////////////////////////////////////////
   // Non blocking send and receive. Necessarily parallel.
   ////////////////////////////////////////////////////////////////////////
+  int PersistentComms(void)
+  {
+#ifdef ACCELERATOR_AWARE_MPI
+    return plan_recorded && Stencil_force_mpi;
+#else
+    return 0; // host staging buffers are not address stable
+#endif
+  }
   void CommunicateBegin(std::vector<std::vector<CommsRequest_t> > &reqs)
   {
+    double t0=usecond();
+    uint64_t bytes=0;
     // All GPU kernel tasks must complete
     //    accelerator_barrier();     // All kernels should ALREADY be complete
     //    _grid->StencilBarrier();   // Everyone is here, so noone running slow and still using receive buffer
                                // But the HaloGather had a barrier too.
+    if ( wire_precision ) {
+      for(int i=0;i<Packets.size();i++){
+	if ( Packets[i].do_send && Packets[i].xbytes ) {
+	  if ( wire_real_size == sizeof(RealD) ) HaloCompress<RealD>(wire_precision,Packets[i].wire_send_buf,Packets[i].send_buf,Packets[i].xbytes);
+	  else                                   HaloCompress<RealF>(wire_precision,Packets[i].wire_send_buf,Packets[i].send_buf,Packets[i].xbytes);
+	}
+      }
+    }
 #ifdef ACCELERATOR_AWARE_MPI
-    for(int i=0;i<Packets.size();i++){
-      _grid->StencilSendToRecvFromBegin(MpiReqs,
-					Packets[i].send_buf,
-					Packets[i].to_rank,Packets[i].do_send,
-					Packets[i].recv_buf,
-					Packets[i].from_rank,Packets[i].do_recv,
-					Packets[i].xbytes,Packets[i].rbytes,i);
+    if ( PersistentComms() ) {
+      if ( !persistent_reqs_built ) {
+	for(int i=0;i<Packets.size();i++){
+	  _grid->StencilSendToRecvFromPersistentInit(MpiPersistentReqs,
+						     Packets[i].wire_send_buf,
+						     Packets[i].to_rank,Packets[i].do_send,
+						     Packets[i].wire_recv_buf,
+						     Packets[i].from_rank,Packets[i].do_recv,
+						     Packets[i].wire_xbytes,Packets[i].wire_rbytes,i);
+	}
+	persistent_reqs_built=1;
+      }
+      _grid->StencilSendToRecvFromPersistentBegin(MpiPersistentReqs);
+    } else {
+      for(int i=0;i<Packets.size();i++){
+	_grid->StencilSendToRecvFromBegin(MpiReqs,
+					  Packets[i].wire_send_buf,
+					  Packets[i].to_rank,Packets[i].do_send,
+					  Packets[i].wire_recv_buf,
+					  Packets[i].from_rank,Packets[i].do_recv,
+					  Packets[i].wire_xbytes,Packets[i].wire_rbytes,i);
+      }
     }
 #else
 #warning "Using COPY VIA HOST BUFFERS IN STENCIL"
     for(int i=0;i<Packets.size();i++){
       // Introduce a host buffer with a cheap slab allocator and zero cost wipe all
-      Packets[i].host_send_buf = _grid->HostBufferMalloc(Packets[i].xbytes);
-      Packets[i].host_recv_buf = _grid->HostBufferMalloc(Packets[i].rbytes);
+      Packets[i].host_send_buf = _grid->HostBufferMalloc(Packets[i].wire_xbytes);
+      Packets[i].host_recv_buf = _grid->HostBufferMalloc(Packets[i].wire_rbytes);
       if ( Packets[i].do_send ) {
-	acceleratorCopyFromDevice(Packets[i].send_buf, Packets[i].host_send_buf,Packets[i].xbytes);
+	acceleratorCopyFromDevice(Packets[i].wire_send_buf, Packets[i].host_send_buf,Packets[i].wire_xbytes);
       }
       _grid->StencilSendToRecvFromBegin(MpiReqs,
 					Packets[i].host_send_buf,
 					Packets[i].to_rank,Packets[i].do_send,
 					Packets[i].host_recv_buf,
 					Packets[i].from_rank,Packets[i].do_recv,
-					Packets[i].xbytes,Packets[i].rbytes,i);
+					Packets[i].wire_xbytes,Packets[i].wire_rbytes,i);
     }
 #endif
     // Get comms started then run checksums
     // Having this PRIOR to the dslash seems to make Sunspot work... (!)
     for(int i=0;i<Packets.size();i++){
-      if ( Packets[i].do_send )
+      if ( Packets[i].do_send ) {
 	FlightRecorder::xmitLog(Packets[i].send_buf,Packets[i].xbytes);
+	bytes+=Packets[i].wire_xbytes;
+      }
     }
+    StencilHaloLog(usecond()-t0,bytes,0);
   }
 
   void CommunicateComplete(std::vector<std::vector<CommsRequest_t> > &reqs)
   {
-    _grid->StencilSendToRecvFromComplete(MpiReqs,0); // MPI is done
+    double t0=usecond();
+    if ( PersistentComms() ) _grid->StencilSendToRecvFromPersistentComplete(MpiPersistentReqs);
+    else                     _grid->StencilSendToRecvFromComplete(MpiReqs,0); // MPI is done
     if   ( this->partialDirichlet ) DslashLogPartial();
     else if ( this->fullDirichlet ) DslashLogDirichlet();
     else DslashLogFull();
@@ -417,16 +490,25 @@ public:
 #warning "Using COPY VIA HOST BUFFERS IN STENCIL"
     for(int i=0;i<Packets.size();i++){
       if ( Packets[i].do_recv ) {
-	acceleratorCopyToDevice(Packets[i].host_recv_buf, Packets[i].recv_buf,Packets[i].rbytes);
+	acceleratorCopyToDevice(Packets[i].host_recv_buf, Packets[i].wire_recv_buf,Packets[i].wire_rbytes);
       }
     }
     _grid->HostBufferFreeAll();
 #endif
+    if ( wire_precision ) {
+      for(int i=0;i<Packets.size();i++){
+	if ( Packets[i].do_recv && Packets[i].rbytes ) {
+	  if ( wire_real_size == sizeof(RealD) ) HaloDecompress<RealD>(wire_precision,Packets[i].recv_buf,Packets[i].wire_recv_buf,Packets[i].rbytes);
+	  else                                   HaloDecompress<RealF>(wire_precision,Packets[i].recv_buf,Packets[i].wire_recv_buf,Packets[i].rbytes);
+	}
+      }
+    }
     // run any checksums
     for(int i=0;i<Packets.size();i++){
       if ( Packets[i].do_recv )
 	FlightRecorder::recvLog(Packets[i].recv_buf,Packets[i].rbytes,Packets[i].from_rank);
     }
+    StencilHaloLog(usecond()-t0,0,1);
   }
   ////////////////////////////////////////////////////////////////////////
   // Blocking send and receive. Either sequential or parallel.
@@ -507,6 +589,8 @@ public:
 
     assert(source.Grid()==_grid);
 
+    PlanCheck(compress);
+
     u_comm_offset=0;
 
     // Gather all comms buffers
@@ -517,14 +601,51 @@ public:
     }
     accelerator_barrier(); // All my local gathers are complete
     face_table_computed=1;
+    PlanRecord();
     assert(u_comm_offset==_unified_buffer_size);
   }
 
-  /////////////////////////
-  // Implementation
-  /////////////////////////
-  void Prepare(void)
+  ////////////////////////////////////////////////////////////////////////
+  // Persistent plan bookkeeping. A recorded schedule is only valid for the
+  // compressor that built it; any change of type or wire format forces a rebuild.
+  ////////////////////////////////////////////////////////////////////////
+  template<class compressor> void PlanCheck(compressor &compress)
+  {
+    size_t type  = typeid(compressor).hash_code();
+    int datum    = compress.CommDatumSize();
+    int decomp   = compress.DecompressionStep();
+    if ( plan_recorded ) {
+      if ( (type!=plan_compressor) || (datum!=plan_datum_size) || (decomp!=plan_decompress) ) {
+	PlanReset();
+      }
+    }
+    plan_compressor = type;
+    plan_datum_size = datum;
+    plan_decompress = decomp;
+    WirePrecision(datum);
+  }
+  // The send buffers hold the compressor's datum, which may be a lower precision
+  // than cobj (half comms spinors). Pack its reals, if they are double or float.
+  void WirePrecision(int datum)
+  {
+    wire_precision = HaloPrecisionFull;
+    wire_real_size = sizeof(RealScalar);
+    if ( !comms_precision ) return;
+    if ( (datum*sizeof(RealScalar)) % sizeof(cobj) ) return;
+    wire_real_size = (datum*sizeof(RealScalar))/sizeof(cobj);
+    if ( (wire_real_size==sizeof(RealD)) || (wire_real_size==sizeof(RealF)) ) wire_precision = comms_precision;
+  }
+  void PlanRecord(void)
+  {
+    plan_recorded = Stencil_persistent_comms;
+  }
+  void PlanReset(void)
   {
+    plan_recorded=0;
+    if ( persistent_reqs_built ) {
+      _grid->StencilSendToRecvFromPersistentFree(MpiPersistentReqs);
+      persistent_reqs_built=0;
+    }
     Decompressions.resize(0);
     DecompressionsSHM.resize(0);
     Mergers.resize(0);
@@ -532,7 +653,18 @@ public:
     Packets.resize(0);
     CopyReceiveBuffers.resize(0);
     CachedTransfers.resize(0);
+    u_wire_send_offset=0;
+    u_wire_recv_offset=0;
+  }
+
+  /////////////////////////
+  // Implementation
+  /////////////////////////
+  void Prepare(void)
+  {
     MpiReqs.resize(0);
+    if ( plan_recorded && Stencil_persistent_comms ) return; // replay the recorded schedule
+    PlanReset();
   }
   void AddCopy(void *from,void * to, Integer bytes)
   {
@@ -603,6 +735,21 @@ public:
     p.do_recv  = do_recv;
     p.xbytes    = xbytes;
     p.rbytes    = rbytes;
+    if ( wire_precision ) {
+      p.wire_xbytes = HaloCompressedBytes(xbytes,wire_real_size);
+      p.wire_rbytes = HaloCompressedBytes(rbytes,wire_real_size);
+      p.wire_send_buf = (void *)&u_wire_send_buf_p[u_wire_send_offset];
+      p.wire_recv_buf = (void *)&u_wire_recv_buf_p[u_wire_recv_offset];
+      u_wire_send_offset += p.wire_xbytes;
+      u_wire_recv_offset += p.wire_rbytes;
+      assert(u_wire_send_offset <= _unified_buffer_size*sizeof(cobj));
+      assert(u_wire_recv_offset <= _unified_buffer_size*sizeof(cobj));
+    } else {
+      p.wire_xbytes = xbytes;
+      p.wire_rbytes = rbytes;
+      p.wire_send_buf = xmit;
+      p.wire_recv_buf = rcv;
+    }
     //    if (do_send) std::cout << GridLogMessage << " MPI packet to   "<<to<< " of size "<<xbytes<<std::endl;
     //    if (do_recv) std::cout << GridLogMessage << " MPI packet from "<<from<< " of size "<<xbytes<<std::endl;
     Packets.push_back(p);
@@ -741,6 +888,15 @@ public:
 		   bool preserve_shm=false)
   {
     face_table_computed=0;
+    plan_recorded=0;
+    persistent_reqs_built=0;
+    u_wire_send_offset=0;
+    u_wire_recv_offset=0;
+    u_wire_send_buf_p=NULL;
+    u_wire_recv_buf_p=NULL;
+    comms_precision = p.comms_precision;
+    wire_precision  = HaloPrecisionFull;
+    wire_real_size  = sizeof(RealScalar);
     _grid    = grid;
     this->parameters=p;
     /////////////////////////////////////
@@ -846,8 +1002,19 @@ public:
       u_simd_recv_buf[l] = (cobj *)_grid->ShmBufferMalloc(_unified_buffer_size*sizeof(cobj));
       u_simd_send_buf[l] = (cobj *)_grid->ShmBufferMalloc(_unified_buffer_size*sizeof(cobj));
     }
+    if ( comms_precision ) {
+      u_wire_send_buf_p=(char *)_grid->ShmBufferMalloc(_unified_buffer_size*sizeof(cobj));
+      u_wire_recv_buf_p=(char *)_grid->ShmBufferMalloc(_unified_buffer_size*sizeof(cobj));
+    }
     PrecomputeByteOffsets();
   }
+  ~CartesianStencil()
+  {
+    if ( persistent_reqs_built ) _grid->StencilSendToRecvFromPersistentFree(MpiPersistentReqs);
+  }
+  // The persistent requests are owned by this stencil; a copy would free them twice
+  CartesianStencil(const CartesianStencil &) = delete;
+  CartesianStencil &operator=(const CartesianStencil &) = delete;
 
   void Local     (int point, int dimension,int shiftpm,int cbmask)
   {
@@ -1191,7 +1358,7 @@ public:
 	//	std::cout << " GatherPlaneSimple partial send "<< comms_partial_send<<std::endl;
 	compressor::Gather_plane_simple(face_table[face_idx],rhs,send_buf,compress,comm_off,so,comms_partial_send);
 
-        int duplicate = CheckForDuplicate(dimension,sx,comm_proc,(void *)&recv_buf[comm_off],0,xbytes,rbytes,cbmask);
+	int duplicate = plan_recorded || CheckForDuplicate(dimension,sx,comm_proc,(void *)&recv_buf[comm_off],0,xbytes,rbytes,cbmask);
 	if ( !duplicate ) { // Force comms for now
 	  
 	  ///////////////////////////////////////////////////////////
@@ -1207,7 +1374,7 @@ public:
 		    xbytes,rbytes);
 	}
 
-	if ( (compress.DecompressionStep() && comms_recv) || comms_partial_recv ) {
+	if ( ((compress.DecompressionStep() && comms_recv) || comms_partial_recv) && !plan_recorded ) {
 	  AddDecompress(&this->u_recv_buf_p[comm_off],
 			&recv_buf[comm_off],
 			words,Decompressions);
@@ -1377,7 +1544,7 @@ public:
 	    rpointers[i] = rp;
 #endif
 	    
-	    int duplicate = CheckForDuplicate(dimension,sx,nbr_proc,(void *)rp,i,xbytes,rbytes,cbmask);
+	    int duplicate = plan_recorded || CheckForDuplicate(dimension,sx,nbr_proc,(void *)rp,i,xbytes,rbytes,cbmask);
 	    if ( !duplicate  ) { 
 	      if ( (bytes != rbytes) && (rbytes!=0) ){
 		acceleratorMemSet(rp,0,bytes); // Zero prefill comms buffer to zero
@@ -1396,7 +1563,7 @@ public:
 	  }
 	}
 	// rpointer may be doing a remote read in the gather over SHM
-	if ( comms_recv|comms_partial_recv ) {
+	if ( (comms_recv|comms_partial_recv) && !plan_recorded ) {
 	  AddMerge(&this->u_recv_buf_p[comm_off],rpointers,reduced_buffer_size,permute_type,Mergers);
 	}
 
@@ -94,6 +94,8 @@ int GridThread::_threads =1;
 int GridThread::_hyperthreads=1;
 int GridThread::_cores=1;
 
+int GridParallelRNG::CounterBased=0;
+
 char hostname[HOST_NAME_MAX+1];
 
 char *GridHostname(void)
@@ -467,14 +469,24 @@ void Grid_init(int *argc,char ***argv)
     std::cout<<GridLogMessage<<"  --comms-concurrent : Asynchronous MPI calls; several dirs at a time "<<std::endl;    
     std::cout<<GridLogMessage<<"  --comms-sequential : Synchronous MPI calls; one dirs at a time "<<std::endl;    
     std::cout<<GridLogMessage<<"  --comms-overlap    : Overlap comms with compute "<<std::endl;    
+    std::cout<<GridLogMessage<<"  --comms-persistent : Record stencil halo schedules once and replay with persistent MPI requests "<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --dslash-generic: Wilson kernel for generic Nc"<<std::endl;    
     std::cout<<GridLogMessage<<"  --dslash-unroll : Wilson kernel for Nc=3"<<std::endl;    
     std::cout<<GridLogMessage<<"  --dslash-asm    : Wilson kernel for AVX512"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-fuse5d : Fuse 5d Cayley MooeeInv/M5D into the hopping term sweep"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-fuse-clover : Fuse compact clover MooeeInv into the even-odd hopping term sweep"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --lebesgue      : Cache oblivious Lebesgue curve/Morton order/Z-graph stencil looping"<<std::endl;    
     std::cout<<GridLogMessage<<"  --cacheblocking n.m.o.p : Hypercuboidal cache blocking"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"  --rng-counter   : Stateless counter based (Philox) parallel RNG"<<std::endl;    
+    std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"  --io-chunk MB   : Streaming I/O chunk size; 0 disables fused chunked checksum pass"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --io-write-behind : Lattice writes return once checksummed and drain to disk in background"<<std::endl;    
+    std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"  --meson-field-gemm : Blocked GEMM formulation of A2Autils::MesonField on host builds"<<std::endl;    
+    std::cout<<GridLogMessage<<std::endl;
     exit(EXIT_SUCCESS);
   }
 
@@ -494,6 +506,12 @@ void Grid_init(int *argc,char ***argv)
     WilsonKernelsStatic::Opt=WilsonKernelsStatic::OptGeneric;
     StaggeredKernelsStatic::Opt=StaggeredKernelsStatic::OptGeneric;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-fuse5d") ){
+    WilsonKernelsStatic::Fuse5D=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-fuse-clover") ){
+    WilsonKernelsStatic::FuseClover=1;
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-overlap") ){
     WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
     StaggeredKernelsStatic::Comms = StaggeredKernelsStatic::CommsAndCompute;
@@ -501,6 +519,9 @@ void Grid_init(int *argc,char ***argv)
     WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsThenCompute;
     StaggeredKernelsStatic::Comms = StaggeredKernelsStatic::CommsThenCompute;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-persistent") ){
+    Stencil_persistent_comms = true;
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-concurrent") ){
     CartesianCommunicator::SetCommunicatorPolicy(CartesianCommunicator::CommunicatorPolicyConcurrent);
   }
@@ -511,6 +532,22 @@ void Grid_init(int *argc,char ***argv)
   if( GridCmdOptionExists(*argv,*argv+*argc,"--lebesgue") ){
     LebesgueOrder::UseLebesgueOrder=1;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--rng-counter") ){
+    GridParallelRNG::CounterBased=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-chunk") ){
+    int MB;
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--io-chunk");
+    GridCmdOptionInt(arg,MB);
+    uint64_t MB64 = MB;
+    BinaryIO::ioChunkBytes = MB64*1024LL*1024LL;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-write-behind") ){
+    BinaryIO::writeBehind=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--meson-field-gemm") ){
+    A2AutilsStatic::MesonFieldGemm=1;
+  }
   CartesianCommunicator::nCommThreads = 1;
 #ifdef GRID_COMMS_THREADS  
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-threads") ){
@@ -549,6 +586,8 @@ void Grid_init(int *argc,char ***argv)
 
 void Grid_finalize(void)
 {
+  BinaryIO::WriteBehindComplete();
+
   std::cout<<GridLogMessage<<"*******************************************"<<std::endl;
   std::cout<<GridLogMessage<<"******* Grid Finalize                ******"<<std::endl;
   std::cout<<GridLogMessage<<"*******************************************"<<std::endl;
@@ -105,6 +105,9 @@ int main(int argc, char **argv) {
   CheckpointerParameters CPPar(CPar.conf_path+CPar.conf_prefix, CPar.conf_path+CPar.conf_smr_prefix, CPar.conf_path+CPar.rng_prefix);
   NerscHmcCheckpointer<PeriodicGimplR> CPNersc(CPPar);
 
+  GaugeLinkPaths<PeriodicGimplR> clover;
+  WilsonLoops<PeriodicGimplR>::FieldStrengthMxNPaths(clover, 1, 1);
+
   for (int conf = CPar.StartConfiguration; conf <= CPar.EndConfiguration; conf+= CPar.Skip){
 
   CPNersc.CheckpointRestore(conf, Umu, sRNG, pRNG);
@@ -116,7 +119,7 @@ int main(int argc, char **argv) {
   std::string file_post = CPar.conf_prefix + "." + std::to_string(conf);
 
   WilsonFlow<PeriodicGimplR> WF(WFPar.step_size,WFPar.steps,WFPar.meas_interval);
-  WF.addMeasurement(WFPar.meas_interval_density, [&file_pre,&file_post,&conf](int step, RealD t, const typename PeriodicGimplR::GaugeField &U){
+  WF.addMeasurement(WFPar.meas_interval_density, [&file_pre,&file_post,&conf,&clover](int step, RealD t, const typename PeriodicGimplR::GaugeField &U){
     
     typedef typename PeriodicGimplR::GaugeLinkField GaugeMat;
     typedef typename PeriodicGimplR::ComplexField ComplexField;
@@ -131,35 +134,16 @@ int main(int argc, char **argv) {
     //E = 1/2 tr( F_munu F_munu )
     //However as  F_numu = -F_munu, only need to sum the trace of the squares of the following 6 field strengths:
     //F_01 F_02 F_03   F_12 F_13  F_23
-    GaugeMat F(U.Grid());
-    //LatticeComplexD R(U.Grid());
+    //All six planes from one evaluation of the clover paths, shared by E and Q
+    std::vector<std::vector<GaugeMat> > F;
+    WilsonLoops<PeriodicGimplR>::FieldStrengthMxNAll(F, U, 1, 1, clover);
+
     ComplexField R(U.Grid());
-    R = Zero();
-  
-    for(int mu=0;mu<3;mu++){
-      for(int nu=mu+1;nu<4;nu++){
-	WilsonLoops<PeriodicGimplR>::FieldStrength(F, U, mu, nu);
-	R = R + trace(F*F);
-      }
-    }
-    R = (-1.0) * R;
+    WilsonLoops<PeriodicGimplR>::EnergyDensityCloverleaf(R, F);
     
     //// Taken from qcd/utils/WilsonLoops.h
-    
-    // Bx = -iF(y,z), By = -iF(z,y), Bz = -iF(x,y)
-    GaugeMat Bx(U.Grid()), By(U.Grid()), Bz(U.Grid());
-    WilsonLoops<PeriodicGimplR>::FieldStrength(Bx, U, Ydir, Zdir);
-    WilsonLoops<PeriodicGimplR>::FieldStrength(By, U, Zdir, Xdir);
-    WilsonLoops<PeriodicGimplR>::FieldStrength(Bz, U, Xdir, Ydir);
-
-    // Ex = -iF(t,x), Ey = -iF(t,y), Ez = -iF(t,z)
-    GaugeMat Ex(U.Grid()), Ey(U.Grid()), Ez(U.Grid());
-    WilsonLoops<PeriodicGimplR>::FieldStrength(Ex, U, Tdir, Xdir);
-    WilsonLoops<PeriodicGimplR>::FieldStrength(Ey, U, Tdir, Ydir);
-    WilsonLoops<PeriodicGimplR>::FieldStrength(Ez, U, Tdir, Zdir);
-
-    double coeff = 8.0/(32.0*M_PI*M_PI);
-    ComplexField qfield = coeff*trace(Bx*Ex + By*Ey + Bz*Ez);
+    ComplexField qfield(U.Grid());
+    WilsonLoops<PeriodicGimplR>::TopologicalChargeDensity(qfield, F);
     //ComplexField qfield Plq(U.Grid());
     //WilsonLoops<PeriodicGimplR>::sitePlaquette(Plq, U);
     //double coeff = 2.0 / (1.0 * Nd * (Nd - 1)) / 3.0;
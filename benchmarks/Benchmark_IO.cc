@@ -135,6 +135,19 @@ int main (int argc, char ** argv)
     avPerf[i] /= nRelVol;
   }
 
+  MSG << BIGSEP << std::endl;
+  MSG << "Benchmark BinaryIO modes, C-Lime write (MB/s)" << std::endl;
+  MSG << BIGSEP << std::endl;
+  grid_printf("%4s %12s %12s %12s\n", "L", "legacy", "streamed", "write behind");
+  for (int l = BENCH_IO_LMIN; l <= BENCH_IO_LMAX; l += 2)
+  {
+    std::vector<double> mbps;
+
+    latt = {l*mpi[0], l*mpi[1], l*mpi[2], l*mpi[3]};
+    modeBenchmark<LatticeFermion>(latt, filestem(l), mbps);
+    grid_printf("%4d %12.1f %12.1f %12.1f\n", l, mbps[0], mbps[1], mbps[2]);
+  }
+
   Eigen::MatrixXd mean(nVol, 4), stdDev(nVol, 4), rob(nVol, 4);
   Eigen::VectorXd avMean(4), avStdDev(4), avRob(4);
   //  double          n = BENCH_IO_NPASS;
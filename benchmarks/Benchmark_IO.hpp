@@ -231,6 +231,40 @@ void writeBenchmark(const Coordinate &latt, const std::string filename,
   write(filename, vec);
 }
 
+// wall clock MB/s of a C-Lime write in each BinaryIO mode; write behind is
+// timed up to the return of the call (the drain overlaps the caller)
+template <typename Field>
+void modeBenchmark(const Coordinate &latt, const std::string filename,
+                   std::vector<double> &mbps)
+{
+  auto                           mpi  = GridDefaultMpi();
+  auto                           simd = GridDefaultSimd(latt.size(), Field::vector_type::Nsimd());
+  std::shared_ptr<GridCartesian> gBasePt(SpaceTimeGrid::makeFourDimGrid(latt, simd, mpi));
+  GridBase                       *g = gBasePt.get();
+  GridParallelRNG                rng(g);
+  Field                          vec(g);
+  uint64_t                       chunk = BinaryIO::ioChunkBytes;
+  double                         size  = g->gSites()*sizeof(typename Field::scalar_object);
+  GridStopWatch                  ioWatch;
+
+  rng.SeedFixedIntegers({1, 2, 3, 4});
+  random(rng, vec);
+  mbps.resize(3);
+  for (int mode = 0; mode < 3; ++mode)
+  {
+    BinaryIO::ioChunkBytes = (mode == 0) ? 0 : chunk;
+    BinaryIO::writeBehind  = (mode == 2);
+    ioWatch.Reset();
+    ioWatch.Start();
+    limeWrite(filename, vec);
+    ioWatch.Stop();
+    BinaryIO::WriteBehindComplete();
+    mbps[mode] = size/1024./1024./(ioWatch.useconds()/1.e6);
+  }
+  BinaryIO::ioChunkBytes = chunk;
+  BinaryIO::writeBehind  = 0;
+}
+
 template <typename Field>
 void readBenchmark(const Coordinate &latt, const std::string filename,
                    const ReaderFn<Field> &read, 
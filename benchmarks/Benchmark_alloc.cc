@@ -0,0 +1,107 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./benchmarks/Benchmark_alloc.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking raw MemoryManager allocate/free churn"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "  bytes  "<<"\t\t"<<"direct us"<<"\t"<<"cached us"<<"\t"<<"hits"<<"\t"<<"misses"<<std::endl;
+
+  const int Nloop=1000;
+  for(size_t bytes=1024;bytes<=64*1024*1024;bytes*=4){
+
+    // A few live blocks of slightly different sizes, as from a solver's temporaries
+    const int Nlive=4;
+    void *ptrs[Nlive];
+
+    double t0=usecond();
+    for(int i=0;i<Nloop;i++){
+      for(int l=0;l<Nlive;l++) ptrs[l] = acceleratorAllocCpu(bytes+l*64);
+      for(int l=0;l<Nlive;l++) acceleratorFreeCpu(ptrs[l]);
+    }
+    double t1=usecond();
+
+    MemoryManager::ResetCacheCounters();
+    double t2=usecond();
+    for(int i=0;i<Nloop;i++){
+      for(int l=0;l<Nlive;l++) ptrs[l] = MemoryManager::CpuAllocate(bytes+l*64);
+      for(int l=0;l<Nlive;l++) MemoryManager::CpuFree(ptrs[l],bytes+l*64);
+    }
+    double t3=usecond();
+
+    double direct=(t1-t0)/(Nloop*Nlive);
+    double cached=(t3-t2)/(Nloop*Nlive);
+    std::cout<<GridLogMessage << std::setw(10) << bytes <<"\t\t"<<direct<<"\t\t"<<cached
+	     <<"\t\t"<<MemoryManager::HostCacheHits()<<"\t"<<MemoryManager::HostCacheMisses()<<std::endl;
+  }
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking lattice temporary churn"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "  L  "<<"\t\t"<<"us per expression"<<"\t"<<"hits"<<"\t"<<"misses"<<std::endl;
+
+  for(int lat=4;lat<=16;lat+=4){
+
+    Coordinate latt_size  ({lat*mpi_layout[0],lat*mpi_layout[1],lat*mpi_layout[2],lat*mpi_layout[3]});
+    GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+
+    GridParallelRNG          pRNG(&Grid);      
+    pRNG.SeedFixedIntegers(std::vector<int>({56,17,89,101}));
+
+    LatticeFermion x(&Grid); random(pRNG,x);
+    LatticeFermion y(&Grid); random(pRNG,y);
+    LatticeComplex c(&Grid); random(pRNG,c);
+
+    int Nexpr = 100;
+    MemoryManager::ResetCacheCounters();
+    double start=usecond();
+    for(int i=0;i<Nexpr;i++){
+      // Each statement constructs and destroys lattice temporaries
+      LatticeFermion r = x - y;
+      LatticeFermion s = c*r + x;
+      LatticeComplex d = localInnerProduct(s,r);
+      y = s + d*x;
+    }
+    double stop=usecond();
+
+    std::cout<<GridLogMessage<<std::setw(4) << lat<<"\t\t"<<(stop-start)/Nexpr
+	     <<"\t\t\t"<<MemoryManager::HostCacheHits()<<"\t"<<MemoryManager::HostCacheMisses()<<std::endl;
+  }
+
+  Grid_finalize();
+}
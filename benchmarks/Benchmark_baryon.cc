@@ -0,0 +1,149 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./benchmarks/Benchmark_baryon.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+#include <Grid/qcd/utils/BaryonUtils.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef BaryonUtils<WilsonImplR> BU;
+typedef BU::BaryonContraction    BaryonContraction;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplex::Nsimd()),
+							 GridDefaultMpi());
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(seeds);
+
+  LatticePropagator qu(UGrid), qd(UGrid), qs(UGrid);
+  random(RNG4,qu);
+  random(RNG4,qd);
+  random(RNG4,qs);
+
+  // Octet and decuplet style diquarks, three sink/source structures each,
+  // both parities, for the nucleon, Lambda-like and Sigma-like flavour content
+  Gamma C(Gamma::Algebra::SigmaXZ);
+  std::vector<Gamma> GA = { Gamma(Gamma::Algebra::Identity), Gamma(Gamma::Algebra::GammaT), Gamma(Gamma::Algebra::GammaTGamma5) };
+  std::vector<Gamma> GB = { C*Gamma(Gamma::Algebra::Gamma5), C, C*Gamma(Gamma::Algebra::GammaX) };
+
+  int wick_udu, wick_uds, wick_usd;
+  BU::WickContractions("udu","udu",wick_udu);
+  BU::WickContractions("uds","uds",wick_uds);
+  BU::WickContractions("uds","usd",wick_usd);
+
+  std::vector<BaryonContraction> contractions;
+  for (int w : {wick_udu, wick_uds, wick_usd}) {
+    for (int g=0; g<GA.size(); g++) {
+      for (int parity : {1,-1}) {
+	contractions.push_back({GA[g],GB[g],GA[g],GB[g],w,parity});
+      }
+    }
+  }
+  int Ncon = contractions.size();
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking baryon 2pt contractions, "<<Ncon<<" structures on "<<UGrid->gSites()<<" sites"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+
+  const int Nloop=3;
+  LatticeComplex corr(UGrid), diff(UGrid);
+  std::vector<LatticeComplex> fused;
+  RealD err=0;
+
+  // One kernel per structure
+  double t0=usecond();
+  for (int i=0;i<Nloop;i++){
+    for (int k=0;k<Ncon;k++){
+      auto &c = contractions[k];
+      BU::ContractBaryons(qu,qd,qs,c.GammaA_left,c.GammaB_left,c.GammaA_right,c.GammaB_right,c.wick_contractions,c.parity,corr);
+    }
+  }
+  double t1=usecond();
+  double t_site = (t1-t0)/Nloop;
+  std::cout<<GridLogMessage << "Per structure          \t" << t_site/1000 << " ms" <<std::endl;
+
+  // Single structure through the engine
+  t0=usecond();
+  for (int i=0;i<Nloop;i++){
+    for (int k=0;k<Ncon;k++){
+      BU::ContractBaryons(qu,qd,qs,std::vector<BaryonContraction>(1,contractions[k]),fused);
+    }
+  }
+  t1=usecond();
+  std::cout<<GridLogMessage << "Diquark, one at a time \t" << (t1-t0)/Nloop/1000 << " ms\tspeedup " << t_site/((t1-t0)/Nloop) <<std::endl;
+
+  // All structures in one fused pass
+  t0=usecond();
+  for (int i=0;i<Nloop;i++){
+    BU::ContractBaryons(qu,qd,qs,contractions,fused);
+  }
+  t1=usecond();
+  std::cout<<GridLogMessage << "Diquark, fused         \t" << (t1-t0)/Nloop/1000 << " ms\tspeedup " << t_site/((t1-t0)/Nloop) <<std::endl;
+
+  for (int k=0;k<Ncon;k++){
+    auto &c = contractions[k];
+    BU::ContractBaryons(qu,qd,qs,c.GammaA_left,c.GammaB_left,c.GammaA_right,c.GammaB_right,c.wick_contractions,c.parity,corr);
+    diff = corr-fused[k];
+    err = std::max(err,std::sqrt(norm2(diff)/norm2(corr)));
+  }
+  std::cout<<GridLogMessage << "Max relative difference fused/per structure " << err <<std::endl;
+
+  // Sliced, batched over source positions
+  const int Nsrc = 8;
+  int nt = GridDefaultLatt()[Tp];
+  std::vector<std::vector<SpinColourMatrix>> Du(Nsrc), Dd(Nsrc), Ds(Nsrc);
+  for (int s=0;s<Nsrc;s++){
+    random(RNG4,qu);
+    sliceSum(qu,Du[s],Tp);
+    sliceSum(qd,Dd[s],Tp);
+    sliceSum(qs,Ds[s],Tp);
+  }
+  t0=usecond();
+  for (int s=0;s<Nsrc;s++){
+    for (int k=0;k<Ncon;k++){
+      auto &c = contractions[k];
+      std::vector<TComplex> r(nt,Zero());
+      BU::ContractBaryonsSliced(Du[s],Dd[s],Ds[s],c.GammaA_left,c.GammaB_left,c.GammaA_right,c.GammaB_right,c.wick_contractions,c.parity,nt,r);
+    }
+  }
+  t1=usecond();
+  double t_sliced = t1-t0;
+  std::vector<std::vector<std::vector<TComplex>>> bcorr;
+  t0=usecond();
+  BU::ContractBaryonsSlicedBatch(Du,Dd,Ds,contractions,nt,bcorr);
+  t1=usecond();
+  std::cout<<GridLogMessage << "Sliced, "<<Nsrc<<" sources per structure\t" << t_sliced/1000 << " ms" <<std::endl;
+  std::cout<<GridLogMessage << "Sliced, "<<Nsrc<<" sources batched      \t" << (t1-t0)/1000 << " ms\tspeedup " << t_sliced/(t1-t0) <<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+
+  Grid_finalize();
+}
@@ -440,6 +440,71 @@ int main (int argc, char ** argv)
     }
   }    
 #endif
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking reduced precision STENCIL halo exchange in "<<nmu<<" dimensions"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << " L  "<<"\t"<<" prec "<<"\t"<<std::setw(11)<<"face bytes"<<"\t"<<"wire MB/s"<<"\t"<<"face MB/s"<<"\t"<<"rel. error"<<std::endl;
+  {
+    typedef vSpinColourVectorF vobj;
+    typedef CartesianStencil<vobj,vobj,SimpleStencilParams> Stencil;
+    const char *precname[] = { "full","fp16","bf16" };
+    std::vector<int> directions;
+    std::vector<int> displacements;
+    for(int mu=0;mu<Nd;mu++){
+      directions.push_back(mu); displacements.push_back( 1);
+      directions.push_back(mu); displacements.push_back(-1);
+    }
+    for(int lat=8;lat<=maxlat;lat+=8){
+      Coordinate latt_size  ({lat*mpi_layout[0],lat*mpi_layout[1],lat*mpi_layout[2],lat*mpi_layout[3]});
+      GridCartesian Grid(latt_size,GridDefaultSimd(Nd,vobj::Nsimd()),mpi_layout);
+      GridParallelRNG RNG(&Grid); RNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+      Lattice<vobj> src(&Grid); gaussian(RNG,src);
+      SimpleCompressor<vobj> compress;
+
+      std::vector<vobj> reference;
+      for(int prec=HaloPrecisionFull;prec<=HaloPrecisionBf16;prec++){
+	SimpleStencilParams params;
+	params.comms_precision = prec;
+	Stencil St(&Grid,directions.size(),Even,directions,displacements,params);
+
+	uint64_t words = St._unified_buffer_size;
+	double fbytes = words*sizeof(vobj);
+	double wbytes = prec ? HaloCompressedBytes(words*sizeof(vobj),sizeof(RealF)) : fbytes;
+
+	St.HaloExchange(src,compress);
+	for(int i=0;i<Nloop;i++){
+	  double start=usecond();
+	  St.HaloExchange(src,compress);
+	  Grid.Barrier();
+	  double stop=usecond();
+	  t_time[i] = stop-start; // microseconds
+	}
+	timestat.statistics(t_time);
+
+	// Received halo compared to the full precision exchange
+	std::vector<vobj> recv(words);
+	if ( words ) acceleratorCopyFromDevice(St.CommBuf(),&recv[0],words*sizeof(vobj));
+	if ( prec == HaloPrecisionFull ) reference = recv;
+	RealD diff=0.0, ref=0.0;
+	for(uint64_t w=0;w<words;w++){
+	  vobj d = recv[w]-reference[w];
+	  diff += Reduce(TensorRemove(innerProduct(d,d))).real();
+	  ref  += Reduce(TensorRemove(innerProduct(reference[w],reference[w]))).real();
+	}
+	Grid.GlobalSum(diff);
+	Grid.GlobalSum(ref);
+	RealD err = (ref>0.0) ? std::sqrt(diff/ref) : 0.0;
+
+	std::cout<<GridLogMessage << std::setw(4) << lat<<"\t"<<precname[prec]<<"\t"
+		 <<std::setw(11) << fbytes << std::fixed << std::setprecision(1) << "\t"
+		 <<std::setw(7) << 2.0*wbytes/timestat.mean<<"\t"
+		 <<std::setw(7) << 2.0*fbytes/timestat.mean<<"\t"
+		 <<std::scientific << std::setprecision(3) << err << std::endl;
+      }
+    }
+  }
+
   std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
   std::cout<<GridLogMessage << "= All done; Bye Bye"<<std::endl;
   std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
@@ -302,6 +302,7 @@ int main (int argc, char ** argv)
   if ( WilsonKernelsStatic::Opt == WilsonKernelsStatic::OptGeneric   ) std::cout << GridLogMessage<< "* Using GENERIC Nc WilsonKernels" <<std::endl;
   if ( WilsonKernelsStatic::Opt == WilsonKernelsStatic::OptHandUnroll) std::cout << GridLogMessage<< "* Using Nc=3       WilsonKernels" <<std::endl;
   if ( WilsonKernelsStatic::Opt == WilsonKernelsStatic::OptInlineAsm ) std::cout << GridLogMessage<< "* Using Asm Nc=3   WilsonKernels" <<std::endl;
+  if ( WilsonKernelsStatic::Fuse5D ) std::cout << GridLogMessage<< "* Fusing 5d Cayley operators into Dhop" <<std::endl;
   std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
   {
     FGrid->Barrier();
@@ -326,6 +327,76 @@ int main (int argc, char ** argv)
     std::cout<<GridLogMessage << "Deo mflop/s per rank   "<< flops/(t1-t0)/NP<<std::endl;
     std::cout<<GridLogMessage << "Deo mflop/s per node   "<< flops/(t1-t0)/NN<<std::endl;
   }
+
+  std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+  std::cout << GridLogMessage<< "* Benchmarking MooeeInv Meooe, separate and fused 5d sweeps" <<std::endl;
+  std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+  {
+    LatticeFermion r_sep(FrbGrid);
+    LatticeFermion r_fus(FrbGrid);
+    int Fuse5D = WilsonKernelsStatic::Fuse5D;
+    double dt[2];
+    for(int fuse=0;fuse<2;fuse++){
+      WilsonKernelsStatic::Fuse5D = fuse;
+      LatticeFermion &r = fuse ? r_fus : r_sep;
+      Dw.MooeeInvMeooe(src_o,r);
+      FGrid->Barrier();
+      double t0=usecond();
+      for(int i=0;i<ncall;i++){
+	Dw.MooeeInvMeooe(src_o,r);
+      }
+      double t1=usecond();
+      FGrid->Barrier();
+      dt[fuse] = (t1-t0)/ncall;
+    }
+    WilsonKernelsStatic::Fuse5D = Fuse5D;
+
+    r_sep = r_sep - r_fus;
+    std::cout<<GridLogMessage << "MooeeInvMeooe separate "<< dt[0]<<" us"<<std::endl;
+    std::cout<<GridLogMessage << "MooeeInvMeooe fused    "<< dt[1]<<" us"<<std::endl;
+    std::cout<<GridLogMessage << "MooeeInvMeooe speedup  "<< dt[0]/dt[1]<<std::endl;
+    std::cout<<GridLogMessage << "MooeeInvMeooe norm diff "<< norm2(r_sep)<<std::endl;
+    assert(norm2(r_sep)<1.0e-10);
+  }
+
+  std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+  std::cout << GridLogMessage<< "* Benchmarking DomainWallFermionD::Dhop with packed links" <<std::endl;
+  std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+  {
+    // Links must reproduce to rounding, so reunitarise the hot start
+    LatticeGaugeField Upack(UGrid); Upack = ProjectOnGroup(Umu);
+    LatticeFermion r18(FGrid);
+    double volume=Ls;  for(int mu=0;mu<Nd;mu++) volume=volume*latt4[mu];
+    double flops=single_site_flops*volume*ncall;
+    auto nsimd = vComplex::Nsimd();
+    auto simdwidth = sizeof(vComplex);
+    for(int reconstruct : {18,12,8}){
+      DomainWallFermionD::ImplParams params;
+      params.reconstruct = reconstruct;
+      DomainWallFermionD Dp(Upack,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,params);
+
+      Dp.Dhop(src,result,0);
+      FGrid->Barrier();
+      double t0=usecond();
+      for(int i=0;i<ncall;i++){
+	Dp.Dhop(src,result,0);
+      }
+      double t1=usecond();
+      FGrid->Barrier();
+
+      // mem: links read once per Ls, stored with the phase/scale word when packed
+      int link_words = (reconstruct==18) ? Nc*Nc : ( (reconstruct==12) ? 7 : 5 );
+      double data_mem = (volume * (2*Nd+1)*Nd*Nc + (volume/Ls) *2*Nd*link_words) * simdwidth / nsimd * ncall / (1024.*1024.*1024.);
+
+      if ( reconstruct==18 ) r18 = result;
+      err = r18-result;
+      std::cout<<GridLogMessage << "Reconstruct-"<<reconstruct<<" mflop/s per rank = "<< flops/(t1-t0)/NP
+	       << " mem GiB/s (base 2) = "<< 1000000. * data_mem/((t1-t0))
+	       << " norm diff "<< norm2(err)<<std::endl;
+      assert(norm2(err)<1.0e-10);
+    }
+  }
+
   Dw.DhopEO(src_o,r_e,DaggerNo);
   Dw.DhopOE(src_e,r_o,DaggerNo);
   Dw.Dhop  (src  ,result,DaggerNo);
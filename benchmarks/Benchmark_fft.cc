@@ -0,0 +1,112 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./benchmarks/Benchmark_fft.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+
+template<class Field>
+void Bench(GridCartesian *grid,GridParallelRNG &RNG,const std::string &name,int Nbatch)
+{
+  const int Nloop=10;
+  int Nd = grid->_ndimension;
+  double vol = grid->gSites();
+
+  Field src(grid); gaussian(RNG,src);
+  Field res(grid);
+  std::vector<Field> bsrc(Nbatch,grid), bres(Nbatch,grid);
+  for(int b=0;b<Nbatch;b++) gaussian(RNG,bsrc[b]);
+
+  FFT theFFT(grid);
+  theFFT.FFT_all_dim(res,src,FFT::forward); // plans and communicators built here
+
+  std::cout<<GridLogMessage << "----------------------------------------------------------------------------------------------------"<<std::endl;
+  std::cout<<GridLogMessage << name << " " << sizeof(typename Field::scalar_object) << " bytes per site"<<std::endl;
+  for(int d=0;d<Nd;d++){
+    double t0=usecond();
+    for(int i=0;i<Nloop;i++) theFFT.FFT_dim(res,src,d,FFT::forward);
+    double t1=usecond();
+    double bytes = 2.0*vol*sizeof(typename Field::scalar_object);
+    std::cout<<GridLogMessage << "FFT_dim " << d << "\t" << (t1-t0)/Nloop << " us\t" << bytes*Nloop/(t1-t0)/1000. << " GB/s"<<std::endl;
+  }
+
+  // A new FFT object per transform, as many callers do; planning is shared between objects
+  double t0=usecond();
+  for(int i=0;i<Nloop;i++) theFFT.FFT_all_dim(res,src,FFT::forward);
+  double t1=usecond();
+  for(int i=0;i<Nloop;i++) {
+    FFT tmpFFT(grid);
+    tmpFFT.FFT_all_dim(res,src,FFT::forward);
+  }
+  double t2=usecond();
+  std::cout<<GridLogMessage << "FFT_all_dim          \t" << (t1-t0)/Nloop << " us"<<std::endl;
+  std::cout<<GridLogMessage << "FFT_all_dim new FFT  \t" << (t2-t1)/Nloop << " us"<<std::endl;
+
+  // Batched fields share the transposes
+  t0=usecond();
+  for(int i=0;i<Nloop;i++) {
+    for(int b=0;b<Nbatch;b++) theFFT.FFT_all_dim(bres[b],bsrc[b],FFT::forward);
+  }
+  t1=usecond();
+  for(int i=0;i<Nloop;i++) theFFT.FFT_all_dim(bres,bsrc,FFT::forward);
+  t2=usecond();
+  std::cout<<GridLogMessage << Nbatch << " fields one at a time\t" << (t1-t0)/Nloop << " us"<<std::endl;
+  std::cout<<GridLogMessage << Nbatch << " fields batched     \t" << (t2-t1)/Nloop << " us\t speedup "<<(t1-t0)/(t2-t1)<<std::endl;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+#ifndef HAVE_FFTW
+  std::cout<<GridLogMessage << "Grid was built without FFTW"<<std::endl;
+#else
+  int Nbatch = 8;
+  for(int i=1;i<argc;i++){
+    std::string sarg(argv[i]);
+    if(sarg == "--batch") { std::istringstream ss(argv[i+1]); ss >> Nbatch; }
+  }
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplexD::Nsimd()),
+							 GridDefaultMpi());
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(seeds);
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking FFT on "<<GridDefaultLatt()<<" mpi "<<GridDefaultMpi()<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+
+  Bench<LatticeComplexD>          (UGrid,RNG4,"LatticeComplexD",Nbatch);
+  Bench<LatticeColourMatrixD>     (UGrid,RNG4,"LatticeColourMatrixD",Nbatch);
+  Bench<LatticeSpinColourMatrixD> (UGrid,RNG4,"LatticeSpinColourMatrixD",Nbatch);
+#endif
+
+  Grid_finalize();
+}
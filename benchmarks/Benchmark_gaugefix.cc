@@ -0,0 +1,139 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./benchmarks/Benchmark_gaugefix.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef PeriodicGimplR Gimpl;
+typedef FourierAcceleratedGaugeFixer<Gimpl> GaugeFixer;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Real alpha = 0.1;
+  Real omega = 1.7;
+  Real tol   = 1.0e-10;
+  int  maxiter = 20000;
+  int  orthog = -1;
+  for(int i=1;i<argc;i++){
+    std::string sarg(argv[i]);
+    if(sarg == "--alpha")   { std::istringstream ss(argv[i+1]); ss >> alpha; }
+    if(sarg == "--omega")   { std::istringstream ss(argv[i+1]); ss >> omega; }
+    if(sarg == "--tol")     { std::istringstream ss(argv[i+1]); ss >> tol; }
+    if(sarg == "--maxiter") { std::istringstream ss(argv[i+1]); ss >> maxiter; }
+    if(sarg == "--coulomb") orthog = Nd-1;
+  }
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplex::Nsimd()),
+							 GridDefaultMpi());
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(seeds);
+
+  // A smooth configuration, as gauge fixing sees after some flow or on fine lattices
+  LatticeGaugeField U0(UGrid); SU<Nc>::HotConfiguration(RNG4,U0);
+  {
+    LatticeGaugeField V(UGrid);
+    WilsonFlow<Gimpl> WF(0.02,20);
+    WF.resetActions();
+    WF.smear(V,U0);
+    U0 = V;
+  }
+  LatticeGaugeField   U(UGrid);
+  LatticeColourMatrix xform(UGrid);
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking gauge fixing to "<<((orthog<0) ? "Landau" : "Coulomb")<<" gauge, tolerance "<<tol<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+
+  struct Result { std::string name; int iter; double sec; };
+  std::vector<Result> results;
+
+  // Single iteration throughput, no convergence test in the way
+  auto rate = [&](const std::string &name,std::function<void(void)> iterate) {
+    const int Nwarm=2, Nloop=20;
+    for(int i=0;i<Nwarm;i++) iterate();
+    double t0=usecond();
+    for(int i=0;i<Nloop;i++) iterate();
+    double t1=usecond();
+    std::cout<<GridLogMessage << name << "\t" << Nloop/((t1-t0)*1.0e-6) << " iterations/s"<<std::endl;
+  };
+
+  {
+    std::vector<LatticeColourMatrix> Umu(Nd,UGrid);
+    LatticeColourMatrix dmuAmu(UGrid);
+    for(int mu=0;mu<Nd;mu++) Umu[mu] = PeekIndex<LorentzIndex>(U0,mu);
+    xform = 1.0;
+    rate("Steepest descent      ",[&](){ GaugeFixer::SteepestDescentStep(Umu,xform,alpha,dmuAmu,orthog); });
+
+    LatticeInteger parity(UGrid), coor(UGrid);
+    parity = Zero();
+    for(int mu=0;mu<Nd;mu++){ LatticeCoordinate(coor,mu); parity = parity + coor; }
+    parity = mod(parity,2);
+    rate("Overrelaxation        ",[&](){
+	GaugeFixer::OverrelaxationStep(Umu,xform,omega,parity,Even,orthog);
+	GaugeFixer::OverrelaxationStep(Umu,xform,omega,parity,Odd ,orthog);
+      });
+#ifdef HAVE_FFTW
+    GaugeFixer::FourierAccelerator accel(UGrid,orthog);
+    rate("Fourier accelerated   ",[&](){ GaugeFixer::FourierAccelSteepestDescentStep(Umu,xform,alpha,dmuAmu,orthog,accel); });
+#endif
+  }
+
+  // Time to tolerance
+  U = U0;
+  double t0=usecond();
+  int iter = GaugeFixer::SteepestDescentGaugeFix(U,xform,alpha,maxiter,tol,tol,false,orthog,false);
+  double t1=usecond();
+  results.push_back({"Steepest descent      ",iter,(t1-t0)*1.0e-6});
+
+#ifdef HAVE_FFTW
+  U = U0;
+  t0=usecond();
+  iter = GaugeFixer::SteepestDescentGaugeFix(U,xform,alpha,maxiter,tol,tol,true,orthog,false);
+  t1=usecond();
+  results.push_back({"Fourier accelerated   ",iter,(t1-t0)*1.0e-6});
+#endif
+
+  U = U0;
+  t0=usecond();
+  iter = GaugeFixer::OverrelaxationGaugeFix(U,xform,omega,maxiter,tol,tol,orthog,false);
+  t1=usecond();
+  results.push_back({"Overrelaxation        ",iter,(t1-t0)*1.0e-6});
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << " algorithm            \titerations\tseconds\titerations/s"<<std::endl;
+  for(auto &r : results){
+    std::cout<<GridLogMessage << r.name << "\t" << r.iter << "\t" << r.sec << "\t" << r.iter/r.sec << std::endl;
+  }
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+
+  Grid_finalize();
+}
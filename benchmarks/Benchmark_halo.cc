@@ -126,6 +126,28 @@ int main (int argc, char ** argv)
 
   }
 
+  std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+  std::cout << GridLogMessage<< "* Benchmarking DomainWallFermionF::HaloExchangeOpt       "<<std::endl;
+  std::cout << GridLogMessage<< "* rebuilt schedule vs persistent plan                    "<<std::endl;
+  std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+  {
+    typename DomainWallFermionF::Compressor compressor(0);
+    bool persistent = Stencil_persistent_comms;
+    for(int p=0;p<2;p++){
+      Stencil_persistent_comms = p;
+      FGrid->Barrier();
+      Dw.Stencil.HaloExchangeOpt(src,compressor);
+      double t0=usecond();
+      for(int i=0;i<ncall;i++){
+	Dw.Stencil.HaloExchangeOpt(src,compressor);
+      }
+      double t1=usecond();
+      FGrid->Barrier();
+      std::cout<<GridLogMessage << "HaloExchange persistent "<<p<<" us /call =   "<< (t1-t0)/ncall<<std::endl;
+    }
+    Stencil_persistent_comms = persistent;
+  }
+
   Grid_finalize();
   exit(0);
 }
@@ -769,6 +769,67 @@ int main (int argc, char ** argv)
   std::cout<<GridLogMessage << "Done "<< (t1-t0) <<" usecond " <<std::endl;
   std::cout<<GridLogMessage << "Done "<< flops/(t1-t0) <<" mflops " <<std::endl;
   std::cout<<GridLogMessage << "Done "<< byte /(t1-t0) <<" MB/s " <<std::endl;
+  double t_sitemom = t1-t0;
+
+  std::cout<<GridLogMessage << "Running A2Autils::MesonField blocked GEMM with Sixteen gammas "<<Nmom<<" momenta "<<std::endl;
+  Eigen::Tensor<ComplexD,5> MesonFieldsGemm(Nmom,16,nt,Nm,Nm);
+  {
+    std::vector<LatticeComplex> mom(Nmom,&Grid);
+    LatticeComplex coor(&Grid);
+    for(int m=0;m<Nmom;m++){
+      LatticeCoordinate(coor,m%(Nd-1));
+      mom[m] = exp(Complex(0.0,2.0*M_PI*m/latt_size[m%(Nd-1)])*coor);
+    }
+    int gemm = A2AutilsStatic::MesonFieldGemm;
+    double t_kernel;
+    A2AutilsStatic::MesonFieldGemm = 1;
+    t0 = usecond();
+    A2Autils<WilsonImplR>::MesonField(MesonFieldsGemm,&w[0],&v[0],Gmu16,mom,Tp,&t_kernel);
+    t1 = usecond();
+    std::cout<<GridLogMessage << "Done "<< (t1-t0) <<" usecond, kernel "<< t_kernel <<" usecond" <<std::endl;
+    std::cout<<GridLogMessage << "Done "<< flops/(t1-t0) <<" mflops " <<std::endl;
+    std::cout<<GridLogMessage << "Speedup over site loop "<< t_sitemom/(t1-t0) <<std::endl;
+
+    RealD errg = 0;
+    LatticeFermion tmp(&Grid);
+    for(int m=0;m<Nmom;m+=3){
+    for(int mu=0;mu<16;mu+=5){
+    for(int i=0;i<std::min(Nm,2);i++){
+    for(int j=0;j<std::min(Nm,2);j++){
+      tmp = mom[m]*(Gamma(Gmu16[mu])*v[j]);
+      sliceInnerProductVector(ip,w[i],tmp,Tp);
+      for(int t=0;t<nt;t++){
+	ComplexD d = MesonFieldsGemm(m,mu,t,i,j) - ip[t];
+	errg += real(d*conj(d));
+      }
+    }}}}
+    std::cout<<GridLogMessage << "Norm error GEMM meson field/sliceInnerProduct "<< errg <<std::endl;
+
+    // The GEMM path is opt in (--meson-field-gemm); scan block sizes and momenta
+    // for where it overtakes the site loop on this node
+    std::cout<<GridLogMessage << "A2Autils::MesonField site loop against blocked GEMM, sixteen gammas"<<std::endl;
+    std::cout<<GridLogMessage << "  block  Nmom   site loop/us    GEMM/us   speedup"<<std::endl;
+    for(int nb=4;nb<=Nm;nb*=2){
+      for(int nmom : {1,Nmom}){
+	std::vector<LatticeComplex> momb(mom.begin(),mom.begin()+nmom);
+	Eigen::Tensor<ComplexD,5> Msite(nmom,16,nt,nb,nb);
+	Eigen::Tensor<ComplexD,5> Mgemm(nmom,16,nt,nb,nb);
+	A2AutilsStatic::MesonFieldGemm = 0;
+	double ts = -usecond();
+	A2Autils<WilsonImplR>::MesonField(Msite,&w[0],&v[0],Gmu16,momb,Tp);
+	ts += usecond();
+	A2AutilsStatic::MesonFieldGemm = 1;
+	double tg = -usecond();
+	A2Autils<WilsonImplR>::MesonField(Mgemm,&w[0],&v[0],Gmu16,momb,Tp);
+	tg += usecond();
+	Eigen::Tensor<RealD,0> dev = (Msite-Mgemm).abs().maximum();
+	assert(dev() < 1.0e-8);
+	std::cout<<GridLogMessage << "  "<<std::setw(5)<<nb<<" "<<std::setw(5)<<nmom
+		 <<" "<<std::setw(14)<<ts<<" "<<std::setw(10)<<tg<<" "<<std::setw(9)<<ts/tg<<std::endl;
+      }
+    }
+    A2AutilsStatic::MesonFieldGemm = gemm;
+  }
 
 
 
@@ -145,6 +145,15 @@ int main (int argc, char ** argv)
     BENCH_DW(Mooee   ,src_o,r_o);
     BENCH_DW(MooeeInv,src_o,r_o);
 
+    WilsonKernelsStatic::Fuse5D=0;
+    std::cout<<GridLogMessage << "Separate Dhop and 5d sweeps"<<std::endl;
+    BENCH_DW(MooeeInvMeooe      ,src_o,r_e);
+    BENCH_DW(MooeeInvDagMeooeDag,src_o,r_e);
+    WilsonKernelsStatic::Fuse5D=1;
+    std::cout<<GridLogMessage << "Fused Dhop and 5d sweeps"<<std::endl;
+    BENCH_DW(MooeeInvMeooe      ,src_o,r_e);
+    BENCH_DW(MooeeInvDagMeooeDag,src_o,r_e);
+
   }
 
   Grid_finalize();
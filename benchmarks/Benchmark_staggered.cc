@@ -108,5 +108,27 @@ int main (int argc, char ** argv)
   std::cout<<GridLogMessage << "norm result "<< norm2(result)<<std::endl;
   std::cout<<GridLogMessage << "mflop/s =   "<< flops/(t1-t0)<<std::endl;
 
+  // Fat and long links packed to 12 or 8 reals, on reunitarised SU(3) links
+  LatticeGaugeField Uhot(&Grid); SU<Nc>::HotConfiguration(pRNG,Uhot);
+  Uhot = ProjectOnGroup(Uhot);
+  FermionField result18(&Grid);
+  for(int reconstruct : {18,12,8}){
+    params.reconstruct = reconstruct;
+    ImprovedStaggeredFermionD Dp(Uhot,Uhot,Grid,RBGrid,mass,c1,c2,u0,params);
+
+    Dp.Dhop(src,result,0);
+    double t2=usecond();
+    for(int i=0;i<ncall;i++){
+      Dp.Dhop(src,result,0);
+    }
+    double t3=usecond();
+
+    if ( reconstruct==18 ) result18 = result;
+    err = result18-result;
+    std::cout<<GridLogMessage << "Reconstruct-"<<reconstruct<<" mflop/s =   "<< flops/(t3-t2)
+	     << " norm diff "<< norm2(err)<<std::endl;
+    assert(norm2(err) <= 1.0e-6*norm2(result18));
+  }
+
   Grid_finalize();
 }
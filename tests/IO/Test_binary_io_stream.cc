@@ -0,0 +1,122 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/IO/Test_binary_io_stream.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Legacy whole-buffer passes, fused chunked streaming and write behind must
+// produce identical files and checksums.
+
+std::string fileBytes(const std::string &file)
+{
+  std::ifstream fin(file,std::ios::binary);
+  std::stringstream ss; ss << fin.rdbuf();
+  return ss.str();
+}
+
+template<class Field,class fobj>
+void testFormat(Field &U,const std::string &format)
+{
+  typedef typename Field::vector_object vobj;
+  typedef typename Field::scalar_object sobj;
+  GridBase *grid = U.Grid();
+
+  BinarySimpleUnmunger<fobj,sobj> unmunge;
+  BinarySimpleMunger<fobj,sobj>   munge;
+
+  const int Nmode=3;
+  const char *name[Nmode] = {"legacy","streamed","write-behind"};
+  uint32_t nersc[Nmode],csuma[Nmode],csumb[Nmode];
+  std::string bytes[Nmode];
+
+  uint64_t chunk = BinaryIO::ioChunkBytes;
+  for(int mode=0;mode<Nmode;mode++){
+    std::string file = "test_binary_io_stream."+std::to_string(mode);
+    BinaryIO::ioChunkBytes = (mode==0) ? 0 : 4096; // many chunks
+    BinaryIO::writeBehind  = (mode==2);
+    if ( grid->IsBoss() ) NerscIO::truncate(file);
+    grid->Barrier();
+    BinaryIO::writeLatticeObject<vobj,fobj>(U,file,unmunge,0,format,nersc[mode],csuma[mode],csumb[mode]);
+    // Appending callers (ILDG) seek to the end while the drain is in flight
+    if ( grid->IsBoss() ) {
+      std::ifstream fin(file,std::ios::binary|std::ios::ate);
+      assert((uint64_t)fin.tellg() == grid->_gsites*sizeof(fobj));
+    }
+    BinaryIO::WriteBehindComplete();
+    grid->Barrier();
+    std::cout << GridLogMessage << format << " " << name[mode] << " checksums "<<std::hex
+	      << nersc[mode]<<"/"<<csuma[mode]<<"/"<<csumb[mode]<<std::dec<<std::endl;
+    bytes[mode] = fileBytes(file);
+    assert(nersc[mode]==nersc[0]);
+    assert(csuma[mode]==csuma[0]);
+    assert(csumb[mode]==csumb[0]);
+    assert(bytes[mode]==bytes[0]);
+  }
+  BinaryIO::writeBehind  = 0;
+
+  for(int mode=0;mode<2;mode++){
+    Field Ur(grid);
+    uint32_t n,a,b;
+    BinaryIO::ioChunkBytes = (mode==0) ? 0 : 4096;
+    BinaryIO::readLatticeObject<vobj,fobj>(Ur,"test_binary_io_stream.2",munge,0,format,n,a,b);
+    assert(n==nersc[0]);
+    assert(a==csuma[0]);
+    assert(b==csumb[0]);
+    Ur = Ur - U;
+    std::cout << GridLogMessage << format << " " << name[mode] << " read back difference "<<norm2(Ur)<<std::endl;
+    assert(norm2(Ur)==0.0);
+  }
+  BinaryIO::ioChunkBytes = chunk;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplexD::Nsimd()),
+							 GridDefaultMpi());
+  GridParallelRNG RNG(UGrid); RNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  LatticeGaugeFieldD U(UGrid);
+  SU<Nc>::HotConfiguration(RNG,U);
+
+  testFormat<LatticeGaugeFieldD,LorentzColourMatrixD>(U,"IEEE64BIG");
+  testFormat<LatticeGaugeFieldD,LorentzColourMatrixD>(U,"IEEE64");
+
+  GridCartesian * UGridF = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							  GridDefaultSimd(Nd,vComplexF::Nsimd()),
+							  GridDefaultMpi());
+  LatticeGaugeFieldF UF(UGridF);
+  precisionChange(UF,U);
+  testFormat<LatticeGaugeFieldF,LorentzColourMatrixF>(UF,"IEEE32BIG");
+
+  std::cout << GridLogMessage << "Done" << std::endl;
+  Grid_finalize();
+}
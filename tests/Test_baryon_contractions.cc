@@ -0,0 +1,150 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: tests/Test_baryon_contractions.cc
+
+Copyright (C) 2015-2018
+
+Author: Felix Erben <felix.erben@ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+
+#include <Grid/Grid.h>
+#include <Grid/qcd/utils/BaryonUtils.h>
+
+using namespace Grid;
+
+typedef BaryonUtils<WilsonImplD> BU;
+typedef BU::BaryonContraction    BaryonContraction;
+typedef typename WilsonImplD::ComplexField    ComplexField;
+typedef typename WilsonImplD::PropagatorField PropagatorField;
+
+// The diquark engine against the per-structure contractions: every Wick term
+// on its own and combined, both parities, several source and sink gammas.
+// Terms cancel pairwise for antisymmetric diquark gammas such as C g5, so
+// errors are measured against the size of a single term.
+int main(int argc, char *argv[])
+{
+  Grid_init(&argc, &argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(4, vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian grid(latt_size,simd_layout,mpi_layout);
+  int nt = latt_size[Tp];
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(&grid);
+  pRNG.SeedFixedIntegers(seeds);
+
+  const int Nsrc = 2;
+  std::vector<PropagatorField> q1(Nsrc,&grid), q2(Nsrc,&grid), q3(Nsrc,&grid);
+  for (int s=0; s<Nsrc; s++) {
+    random(pRNG,q1[s]);
+    random(pRNG,q2[s]);
+    random(pRNG,q3[s]);
+  }
+
+  Gamma C(Gamma::Algebra::SigmaXZ), g5(Gamma::Algebra::Gamma5), gT(Gamma::Algebra::GammaT);
+  Gamma id(Gamma::Algebra::Identity), gX(Gamma::Algebra::GammaX), gYg5(Gamma::Algebra::GammaYGamma5);
+  std::vector<Gamma> GA = { id, gT, gX };
+  std::vector<Gamma> GB = { C*g5, gYg5 };
+
+  std::vector<BaryonContraction> contractions;
+  std::vector<int> wick = { 1, 2, 4, 8, 16, 32, 63, 1+8, 2+16+32 };
+  for (int w : wick) {
+    for (int parity : {1,-1}) {
+      contractions.push_back({GA[0],GB[0],GA[0],GB[0],w,parity});
+      contractions.push_back({GA[1],GB[1],GA[2],GB[0],w,parity});
+      contractions.push_back({GA[2],GB[0],GA[1],GB[1],w,parity});
+    }
+  }
+  int Ncon = contractions.size();
+
+  ComplexField ref(&grid), diff(&grid), scale(&grid);
+  std::vector<std::vector<ComplexField>> corr;
+
+  double t0=usecond();
+  BU::ContractBaryons(q1,q2,q3,contractions,corr);
+  double t1=usecond();
+
+  double tref=0;
+  RealD  maxerr=0;
+  for (int s=0; s<Nsrc; s++) {
+    for (int k=0; k<Ncon; k++) {
+      auto &c = contractions[k];
+      tref-=usecond();
+      BU::ContractBaryons(q1[s],q2[s],q3[s],c.GammaA_left,c.GammaB_left,c.GammaA_right,c.GammaB_right,
+			  c.wick_contractions,c.parity,ref);
+      tref+=usecond();
+      BU::ContractBaryons(q1[s],q2[s],q3[s],c.GammaA_left,c.GammaB_left,c.GammaA_right,c.GammaB_right,
+			  1,c.parity,scale);
+      diff = ref - corr[s][k];
+      RealD err = std::sqrt(norm2(diff)/norm2(scale));
+      maxerr = std::max(maxerr,err);
+      assert(err < 1.0e-12);
+    }
+  }
+  std::cout << GridLogMessage << Nsrc*Ncon << " contractions, max relative error " << maxerr << std::endl;
+  std::cout << GridLogMessage << "Diquark engine " << (t1-t0)/1000 << " ms, per structure " << tref/1000 << " ms" << std::endl;
+
+  // Sliced, on the zero momentum projections
+  typedef std::vector<SpinColourMatrixD> SlicedProp;
+  typedef std::vector<TComplexD>         SlicedCorr;
+  std::vector<SlicedProp> D1(Nsrc), D2(Nsrc), D3(Nsrc);
+  for (int s=0; s<Nsrc; s++) {
+    sliceSum(q1[s],D1[s],Tp);
+    sliceSum(q2[s],D2[s],Tp);
+    sliceSum(q3[s],D3[s],Tp);
+  }
+  std::vector<std::vector<SlicedCorr>> bcorr;
+  BU::ContractBaryonsSlicedBatch(D1,D2,D3,contractions,nt,bcorr);
+
+  maxerr=0;
+  for (int s=0; s<Nsrc; s++) {
+    std::vector<SlicedCorr> scorr;
+    BU::ContractBaryonsSliced(D1[s],D2[s],D3[s],contractions,nt,scorr);
+    for (int k=0; k<Ncon; k++) {
+      auto &c = contractions[k];
+      SlicedCorr sref(nt), sscale(nt);
+      for (int t=0; t<nt; t++) sref[t] = sscale[t] = Zero();
+      BU::ContractBaryonsSliced(D1[s],D2[s],D3[s],c.GammaA_left,c.GammaB_left,c.GammaA_right,c.GammaB_right,
+				c.wick_contractions,c.parity,nt,sref);
+      BU::ContractBaryonsSliced(D1[s],D2[s],D3[s],c.GammaA_left,c.GammaB_left,c.GammaA_right,c.GammaB_right,
+				1,c.parity,nt,sscale);
+      RealD nrm = 0;
+      for (int t=0; t<nt; t++) nrm = std::max(nrm,(RealD)std::abs(TensorRemove(sscale[t])));
+      for (int t=0; t<nt; t++) {
+	RealD err = std::abs(TensorRemove(sref[t]-scorr[k][t]))/nrm;
+	maxerr = std::max(maxerr,err);
+	assert(err < 1.0e-12);
+	assert(std::abs(TensorRemove(scorr[k][t]-bcorr[s][k][t])) <= 1.0e-14*nrm);
+      }
+    }
+  }
+  std::cout << GridLogMessage << "Sliced, max relative error " << maxerr << std::endl;
+
+  // No contractions asked for, no correlators back
+  std::vector<ComplexField> none;
+  BU::ContractBaryons(q1[0],q2[0],q3[0],std::vector<BaryonContraction>(),none);
+  assert(none.size()==0);
+
+  std::cout << GridLogMessage << "Done" << std::endl;
+  Grid_finalize();
+}
@@ -124,6 +124,42 @@ int main(int argc, char *argv[])
   stop = usecond();
   std::cout << GridLogMessage << "M(rho,rho) created, execution time " << stop-start << " us" << std::endl;
 
+  // check against slice inner products <phi_i| e^{ipx} Gamma |rho_j>
+  {
+    FermionField tmp(&grid);
+    std::vector<ComplexD> ip;
+    RealD err = 0, nrm = 0;
+    for (unsigned int m = 0; m < momenta.size(); ++m)
+    for (unsigned int mu = 0; mu < Gmu.size(); ++mu)
+    for (unsigned int i = 0; i < VDIM; ++i)
+    for (unsigned int j = 0; j < VDIM; ++j){
+      tmp = phases[m]*(Gamma(Gmu[mu])*rho[j]);
+      sliceInnerProductVector(ip,phi[i],tmp,Tp);
+      for (int tt = 0; tt < Nt; ++tt){
+	err += norm(Mpr(m,mu,tt,i,j)-ip[tt]);
+	nrm += norm(ip[tt]);
+      }
+    }
+    std::cout << GridLogMessage << "M(phi,rho) against sliceInnerProductVector, relative error " << err/nrm << std::endl;
+    assert(err < 1.0e-20*nrm);
+  }
+
+  // the site loop and the opt in blocked GEMM path must agree
+  {
+    Eigen::Tensor<ComplexD,5, Eigen::RowMajor> Mother(momenta.size(),Gmu.size(),Nt,VDIM,VDIM);
+    int gemm = A2AutilsStatic::MesonFieldGemm;
+    A2AutilsStatic::MesonFieldGemm = !gemm;
+    A2Autils<WilsonImplR>::MesonField(Mother,&phi[0],&rho[0],Gmu,phases,Tp);
+    A2AutilsStatic::MesonFieldGemm = gemm;
+    RealD err = 0, nrm = 0;
+    for (Eigen::Index n = 0; n < Mpr.size(); ++n){
+      err += norm(Mpr.data()[n]-Mother.data()[n]);
+      nrm += norm(Mpr.data()[n]);
+    }
+    std::cout << GridLogMessage << "M(phi,rho) site loop against blocked GEMM, relative error " << err/nrm << std::endl;
+    assert(err < 1.0e-20*nrm);
+  }
+
   std::string FileName = "Meson_Fields";
 #ifdef HAVE_HDF5
   using Default_Reader = Grid::Hdf5Reader;
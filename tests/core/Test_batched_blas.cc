@@ -0,0 +1,119 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_batched_blas.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class T> T RandomEntry(GridSerialRNG &sRNG);
+template<> RealD    RandomEntry(GridSerialRNG &sRNG) { RealD r; random(sRNG,r); return r-0.5; }
+template<> RealF    RandomEntry(GridSerialRNG &sRNG) { RealF r; random(sRNG,r); return r-0.5; }
+template<> ComplexD RandomEntry(GridSerialRNG &sRNG) { ComplexD c; gaussian(sRNG,c); return c; }
+template<> ComplexF RandomEntry(GridSerialRNG &sRNG) { ComplexF c; gaussian(sRNG,c); return c; }
+
+// Native engine against the Eigen reference, pointer list and strided batch
+template<class T>
+RealD Compare(GridBLAS &BLAS,GridSerialRNG &sRNG,
+	      GridBLASOperation_t OpA,GridBLASOperation_t OpB,int m,int n,int k,int batch,T beta)
+{
+  int64_t sA=m*k, sB=k*n, sC=m*n;
+  deviceVector<T> A(sA*batch), B(sB*batch), C(sC*batch), Cref(sC*batch), Cstr(sC*batch);
+  for(int64_t i=0;i<sA*batch;i++) A[i]=RandomEntry<T>(sRNG);
+  for(int64_t i=0;i<sB*batch;i++) B[i]=RandomEntry<T>(sRNG);
+  for(int64_t i=0;i<sC*batch;i++) { Cref[i]=RandomEntry<T>(sRNG); C[i]=Cref[i]; Cstr[i]=Cref[i]; }
+  if ( beta == T(0.0) ) C[0] = Cstr[0] = std::numeric_limits<RealD>::quiet_NaN(); // must not propagate
+
+  deviceVector<T *> As(batch), Bs(batch), Cs(batch), Crefs(batch);
+  for(int p=0;p<batch;p++){
+    As[p]=&A[p*sA]; Bs[p]=&B[p*sB]; Cs[p]=&C[p*sC]; Crefs[p]=&Cref[p*sC];
+  }
+  T alpha(0.7);
+
+  GridBLAS::cpuEngine = GridBLAS_CPU_EIGEN;
+  BLAS.gemmBatched(OpA,OpB,m,n,k,alpha,As,Bs,beta,Crefs);
+  GridBLAS::cpuEngine = GridBLAS_CPU_NATIVE;
+  BLAS.gemmBatched(OpA,OpB,m,n,k,alpha,As,Bs,beta,Cs);
+  BLAS.gemmStridedBatched(OpA,OpB,m,n,k,alpha,&A[0],sA,&B[0],sB,beta,&Cstr[0],sC,batch);
+
+  RealD diff=0, dstr=0, nrm=0;
+  for(int64_t i=0;i<sC*batch;i++){
+    diff += std::norm(C[i]-Cref[i]);
+    dstr += std::norm(Cstr[i]-Cref[i]);
+    nrm  += std::norm(Cref[i]);
+  }
+  return std::sqrt(std::max(diff,dstr)/nrm);
+}
+
+template<class T>
+void CompareAll(GridBLAS &BLAS,GridSerialRNG &sRNG,std::vector<GridBLASOperation_t> ops,RealD tol)
+{
+  std::vector<std::vector<int> > mnk({ {16,8,16}, {32,12,32}, {64,16,64}, {12,12,24}, {7,5,9}, {24,3,100} });
+  std::vector<int> batches({1,3,64});
+  for(auto OpA : ops){
+  for(auto OpB : ops){
+  for(auto &s : mnk){
+  for(auto batch : batches){
+  for(int b=0;b<2;b++){
+    T beta = b ? T(0.3) : T(0.0);
+    RealD err = Compare<T>(BLAS,sRNG,OpA,OpB,s[0],s[1],s[2],batch,beta);
+    if ( err > tol ) {
+      std::cout << GridLogMessage << " Op "<<OpA<<OpB<<" mnk "<<s[0]<<","<<s[1]<<","<<s[2]
+		<<" batch "<<batch<<" beta "<<beta<<" rel. error "<<err<<std::endl;
+    }
+    assert(err < tol);
+  }}}}}
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
+  std::cout << GridLogMessage << "Native CPU batched GEMM engine is only built on host targets"<<std::endl;
+  Grid_finalize();
+  return 0;
+#endif
+
+  GridSerialRNG sRNG; sRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridBLAS BLAS;
+
+  std::vector<GridBLASOperation_t> cops({GridBLAS_OP_N,GridBLAS_OP_C});
+  std::vector<GridBLASOperation_t> rops({GridBLAS_OP_N,GridBLAS_OP_T});
+
+  std::cout << GridLogMessage << "Batched GEMM: native engine vs Eigen, ComplexD"<<std::endl;
+  CompareAll<ComplexD>(BLAS,sRNG,cops,1.0e-13);
+  std::cout << GridLogMessage << "Batched GEMM: native engine vs Eigen, ComplexF"<<std::endl;
+  CompareAll<ComplexF>(BLAS,sRNG,cops,1.0e-5);
+  std::cout << GridLogMessage << "Batched GEMM: native engine vs Eigen, RealD"<<std::endl;
+  CompareAll<RealD>(BLAS,sRNG,rops,1.0e-13);
+  std::cout << GridLogMessage << "Batched GEMM: native engine vs Eigen, RealF"<<std::endl;
+  CompareAll<RealF>(BLAS,sRNG,rops,1.0e-5);
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,139 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_cayley_fused.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Fused Dhop + 5d sweeps against the separate Meooe and MooeeInv passes,
+// for both checkerboards, both kernel flavours and the Schur operators.
+template<class Action>
+void TestFused(Action &D,GridParallelRNG &RNG5,GridBase *FrbGrid,const std::string &name)
+{
+  typedef typename Action::FermionField FermionField;
+
+  FermionField src(D.FermionGrid()); random(RNG5,src);
+  FermionField src_e(FrbGrid);
+  FermionField src_o(FrbGrid);
+  pickCheckerboard(Even,src_e,src);
+  pickCheckerboard(Odd ,src_o,src);
+
+  FermionField tmp(FrbGrid);
+  FermionField ref(FrbGrid);
+  FermionField res(FrbGrid);
+  FermionField diff(FrbGrid);
+
+  int Opt[] = { WilsonKernelsStatic::OptGeneric, WilsonKernelsStatic::OptHandUnroll };
+  int Fuse5D = WilsonKernelsStatic::Fuse5D;
+  int Opt0   = WilsonKernelsStatic::Opt;
+
+  for(int o=0;o<2;o++){
+    WilsonKernelsStatic::Opt = Opt[o];
+    for(int cb=0;cb<2;cb++){
+      FermionField &in = cb ? src_o : src_e;
+
+      WilsonKernelsStatic::Fuse5D=0;
+      D.Meooe(in,tmp);
+      D.MooeeInv(tmp,ref);
+      WilsonKernelsStatic::Fuse5D=1;
+      D.MooeeInvMeooe(in,res);
+      assert(res.Checkerboard()==ref.Checkerboard());
+      diff = ref-res;
+      std::cout<<GridLogMessage<<name<<" Opt "<<Opt[o]<<" cb "<<cb
+	       <<" MooeeInvMeooe       |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)<<std::endl;
+      assert(norm2(diff) < 1.0e-10*norm2(ref));
+
+      WilsonKernelsStatic::Fuse5D=0;
+      D.MeooeDag(in,tmp);
+      D.MooeeInvDag(tmp,ref);
+      WilsonKernelsStatic::Fuse5D=1;
+      D.MooeeInvDagMeooeDag(in,res);
+      assert(res.Checkerboard()==ref.Checkerboard());
+      diff = ref-res;
+      std::cout<<GridLogMessage<<name<<" Opt "<<Opt[o]<<" cb "<<cb
+	       <<" MooeeInvDagMeooeDag |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)<<std::endl;
+      assert(norm2(diff) < 1.0e-10*norm2(ref));
+    }
+  }
+
+  // Schur operators on odd checkerboard
+  SchurDiagMooeeOperator<Action,FermionField> HermOpEO(D);
+  SchurDiagOneOperator<Action,FermionField>   HermOpOne(D);
+  SchurDiagTwoOperator<Action,FermionField>   HermOpTwo(D);
+  std::vector<SchurOperatorBase<FermionField> *> Ops({&HermOpEO,&HermOpOne,&HermOpTwo});
+  for(int op=0;op<Ops.size();op++){
+    WilsonKernelsStatic::Fuse5D=0;
+    Ops[op]->HermOp(src_o,ref);
+    WilsonKernelsStatic::Fuse5D=1;
+    Ops[op]->HermOp(src_o,res);
+    diff = ref-res;
+    std::cout<<GridLogMessage<<name<<" Schur operator "<<op
+	     <<" MpcDagMpc |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)<<std::endl;
+    assert(norm2(diff) < 1.0e-10*norm2(ref));
+  }
+
+  WilsonKernelsStatic::Fuse5D = Fuse5D;
+  WilsonKernelsStatic::Opt    = Opt0;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+  GridParallelRNG          RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+
+  LatticeGaugeField Umu(UGrid); SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+
+  DomainWallFermionD Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  TestFused(Ddwf,RNG5,FrbGrid,"DomainWall");
+
+  MobiusFermionD Dmob(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,1.5,0.5);
+  TestFused(Dmob,RNG5,FrbGrid,"Mobius");
+
+  std::vector<ComplexD> omegas;
+  for(int s=0;s<Ls;s++){
+    omegas.push_back(ComplexD(0.25+0.05*s, (s==0) ? 0.01 : ((s==Ls-1) ? -0.01 : 0.0)));
+  }
+  ZMobiusFermionD Dzmob(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,omegas,1.5,0.5);
+  TestFused(Dzmob,RNG5,FrbGrid,"ZMobius");
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
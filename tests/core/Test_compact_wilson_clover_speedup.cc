@@ -213,6 +213,60 @@ void runBenchmark(int* argc, char*** argv) {
   BENCH_CLOVER_KERNEL(MooeeInv);
   BENCH_CLOVER_KERNEL(MooeeInvDag);
 
+  // fused even-odd hopping term and clover inverse vs. separate passes, on a checkerboard
+  Fermion src_o(UrbGrid); pickCheckerboard(Odd, src_o, src);
+  Fermion ref_e(UrbGrid); ref_e = Zero();
+  Fermion res_e(UrbGrid); res_e = Zero();
+  double  fused_gflop_total = 0.5 * volume * nIter * (hop_flop_per_site + clov_flop_per_site) / 1e9;
+  double  fused_gbyte_total = 0.5 * volume * nIter * (hop_byte_per_site + clov_byte_per_site) / 1e9;
+  int     fuseClover        = WilsonKernelsStatic::FuseClover;
+
+#define BENCH_FUSED_KERNEL(KERNEL) { \
+  /* warmup + measure separate passes */ \
+  WilsonKernelsStatic::FuseClover = 0; \
+  for(auto n : {1, 2, 3, 4, 5}) Dwc_compact.KERNEL(src_o, ref_e); \
+  double t2 = usecond(); \
+  for(int n = 0; n < nIter; n++) Dwc_compact.KERNEL(src_o, ref_e); \
+  double t3 = usecond(); \
+  double secs_ref = (t3-t2)/1e6; \
+  grid_printf_msg("Performance(%35s, %s): %2.4f s, %6.0f GFlop/s, %6.0f GByte/s, speedup vs ref = %.2f, fraction of hop = %.2f\n", \
+                  "separate_"#KERNEL, precision.c_str(), secs_ref, fused_gflop_total/secs_ref, fused_gbyte_total/secs_ref, secs_ref/secs_ref, secs_ref/secs_hop); \
+\
+  /* warmup + measure fused sweep */ \
+  WilsonKernelsStatic::FuseClover = 1; \
+  for(auto n : {1, 2, 3, 4, 5}) Dwc_compact.KERNEL(src_o, res_e); \
+  double t4 = usecond(); \
+  for(int n = 0; n < nIter; n++) Dwc_compact.KERNEL(src_o, res_e); \
+  double t5 = usecond(); \
+  double secs_res = (t5-t4)/1e6; \
+  grid_printf_msg("Performance(%35s, %s): %2.4f s, %6.0f GFlop/s, %6.0f GByte/s, speedup vs ref = %.2f, fraction of hop = %.2f\n", \
+                  "fused_"#KERNEL, precision.c_str(), secs_res, fused_gflop_total/secs_res, fused_gbyte_total/secs_res, secs_ref/secs_res, secs_res/secs_hop); \
+  assert(resultsAgree(ref_e, res_e, #KERNEL)); \
+}
+
+  BENCH_FUSED_KERNEL(MooeeInvMeooe);
+  BENCH_FUSED_KERNEL(MooeeInvDagMeooeDag);
+
+  // fused sweep on both checkerboards with open boundaries, where the mask is applied in the sweep
+  {
+    typename CompactWilsonCloverOperator::ImplParams openParams;
+    std::vector<Complex> open_phases(Nd, 1.); open_phases[Nd-1] = 0.;
+    openParams.boundary_phases = open_phases;
+    CompactWilsonCloverOperator Dwc_open(Umu, *UGrid, *UrbGrid, mass, csw, csw, cF, anisParams, openParams);
+
+    Fermion src_cb(UrbGrid), ref_cb(UrbGrid), res_cb(UrbGrid);
+    for(auto cb : {Even, Odd}) {
+      pickCheckerboard(cb, src_cb, src);
+      WilsonKernelsStatic::FuseClover = 0; Dwc_open.MooeeInvMeooe(src_cb, ref_cb);
+      WilsonKernelsStatic::FuseClover = 1; Dwc_open.MooeeInvMeooe(src_cb, res_cb);
+      assert(resultsAgree(ref_cb, res_cb, "open_MooeeInvMeooe"));
+      WilsonKernelsStatic::FuseClover = 0; Dwc_open.MooeeInvDagMeooeDag(src_cb, ref_cb);
+      WilsonKernelsStatic::FuseClover = 1; Dwc_open.MooeeInvDagMeooeDag(src_cb, res_cb);
+      assert(resultsAgree(ref_cb, res_cb, "open_MooeeInvDagMeooeDag"));
+    }
+  }
+  WilsonKernelsStatic::FuseClover = fuseClover;
+
   grid_printf_msg("finalize %s\n", precision.c_str());
 }
 
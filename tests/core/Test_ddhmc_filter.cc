@@ -0,0 +1,119 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_ddhmc_filter.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Full volume reference: the coordinate mask filters
+void DDHMCReference(LatticeGaugeField &U,const Coordinate &Block,int Width)
+{
+  GridBase *grid = U.Grid();
+  Coordinate Global=grid->GlobalDimensions();
+  LatticeGaugeField zzz(grid); zzz = Zero();
+  LatticeInteger coor(grid);
+  auto zzz_mu = PeekIndex<LorentzIndex>(zzz,0);
+  for(int mu=0;mu<Nd;mu++) {
+    Integer B1 = Block[mu];
+    if ( B1 && (B1 <= Global[mu]) ) {
+      LatticeCoordinate(coor,mu);
+      for(int w=1;w<=Width;w++){
+	U = where(mod(coor,B1)==Integer(B1-w) ,zzz,U);
+	U = where(mod(coor,B1)==Integer(w-1)  ,zzz,U);
+      }
+      auto U_mu = PeekIndex<LorentzIndex>(U,mu);
+      U_mu = where(mod(coor,B1)==Integer(B1-Width-1),zzz_mu,U_mu);
+      PokeIndex<LorentzIndex>(U, U_mu, mu);
+    }
+  }
+}
+
+void DirichletReference(LatticeGaugeField &U,const Coordinate &Block)
+{
+  GridBase *grid = U.Grid();
+  LatticeInteger coor(grid);
+  LatticeColourMatrix zz(grid); zz = Zero();
+  for(int mu=0;mu<Nd;mu++) {
+    if ( (Block[mu]) && (Block[mu] <= grid->GlobalDimensions()[mu] ) ) {
+      LatticeCoordinate(coor,mu);
+      auto U_mu = PeekIndex<LorentzIndex>(U,mu);
+      U_mu = where(mod(coor,Block[mu])==Integer(Block[mu]-1),zz,U_mu);
+      PokeIndex<LorentzIndex>(U, U_mu, mu);
+    }
+  }
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt = GridDefaultLatt();
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(latt,
+							 GridDefaultSimd(Nd,vComplex::Nsimd()),
+							 GridDefaultMpi());
+  GridParallelRNG RNG(UGrid);  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeGaugeField U(UGrid);   gaussian(RNG,U);
+  LatticeGaugeField ref(UGrid);
+  LatticeGaugeField filt(UGrid);
+  LatticeGaugeField diff(UGrid);
+
+  // Blocks: every direction, some directions, and one larger than the lattice (inactive)
+  std::vector<Coordinate> Blocks;
+  Blocks.push_back(latt);
+  Blocks.push_back(Coordinate({0,latt[1],0,latt[3]/2}));
+  Blocks.push_back(Coordinate({latt[0],0,2*latt[2],0}));
+
+  for(auto &Block : Blocks){
+    for(int Width=1;Width<=3;Width++){
+      DDHMCFilter<LatticeGaugeField> Filter(Block,Width);
+      // Apply twice: second application reuses the cached site list
+      for(int rep=0;rep<2;rep++){
+	ref = U;  DDHMCReference(ref,Block,Width);
+	filt = U; Filter.applyFilter(filt);
+	diff = ref - filt;
+	RealD err = norm2(diff);
+	std::cout << GridLogMessage << " DDHMCFilter block "<<Block<<" width "<<Width
+		  <<" |ref|^2 "<<norm2(ref)<<" diff "<<err<<std::endl;
+	assert(err == 0.0);
+      }
+    }
+    DirichletFilter<LatticeGaugeField> Filter(Block);
+    for(int rep=0;rep<2;rep++){
+      ref = U;  DirichletReference(ref,Block);
+      filt = U; Filter.applyFilter(filt);
+      diff = ref - filt;
+      RealD err = norm2(diff);
+      std::cout << GridLogMessage << " DirichletFilter block "<<Block<<" diff "<<err<<std::endl;
+      assert(err == 0.0);
+    }
+  }
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
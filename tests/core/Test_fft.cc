@@ -129,6 +129,32 @@ int main (int argc, char ** argv)
   S= S-Stilde;
   std::cout << "diff FT[SpinMat] "<<norm2(S) << std::endl;
 
+  std::cout<<"*************************************************"<<std::endl;
+  std::cout<<"Testing batched transform of several fields      "<<std::endl;
+  std::cout<<"*************************************************"<<std::endl;
+  {
+    const int Nbatch = 4;
+    std::vector<LatticeSpinMatrixD> Sb(Nbatch,&GRID), Sbtilde(Nbatch,&GRID);
+    for(int b=0;b<Nbatch;b++) Sb[b] = S*ComplexD(b+1.0,0.0) + C;
+
+    double t0=usecond();
+    theFFT.FFT_all_dim(Sbtilde,Sb,FFT::forward);
+    double t1=usecond();
+    for(int b=0;b<Nbatch;b++){
+      theFFT.FFT_all_dim(Stilde,Sb[b],FFT::forward);
+    }
+    double t2=usecond();
+    std::cout << " batched "<<(t1-t0)/1000<<" ms, one at a time "<<(t2-t1)/1000<<" ms"<<std::endl;
+
+    RealD diff=0;
+    for(int b=0;b<Nbatch;b++){
+      theFFT.FFT_all_dim(Stilde,Sb[b],FFT::forward);
+      Stilde = Stilde - Sbtilde[b];
+      diff += norm2(Stilde);
+    }
+    std::cout << "diff batched FT[SpinMat] "<<diff << std::endl;
+  }
+
   /*
    */
   std::vector<int> seeds({1,2,3,4});
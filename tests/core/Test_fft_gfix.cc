@@ -31,7 +31,7 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 using namespace Grid;
 
 template<typename Gimpl>
-void run(double alpha, bool do_fft_gfix){
+void run(double alpha, double omega, bool do_fft_gfix){
   std::vector<int> seeds({1,2,3,4});
   int threads = GridThread::GetThreads();
 
@@ -100,6 +100,28 @@ void run(double alpha, bool do_fft_gfix){
   std::cout << " Norm difference between a unit gauge configuration and the gauge fixed configuration "<< norm2(Uorg) << " (expect 0)" << std::endl;
   std::cout << " Norm of gauge fixed configuration "<< norm2(Umu) << std::endl;
 
+  //#########################################################################################
+
+  std::cout<< "*********************************************************************************************************" <<std::endl;
+  std::cout<< "* Testing overrelaxation fixing to Landau gauge with randomly transformed unit gauge configuration      *" <<std::endl;
+  std::cout<< "*********************************************************************************************************" <<std::endl;
+
+  Umu=Urnd;
+  LatticeColourMatrix   xform4(&GRID); // Gauge xform
+  FourierAcceleratedGaugeFixer<Gimpl>::OverrelaxationGaugeFix(Umu,xform4,omega,10000,1.0e-12, 1.0e-12);
+
+  Utmp=Urnd;
+  SU<Nc>::GaugeTransform<Gimpl>(Utmp,xform4);
+  Utmp = Utmp - Umu;
+  std::cout << " Check the output gauge transformation matrices applied to the original field produce the xformed field "<< norm2(Utmp) << " (expect 0)" << std::endl;
+
+  plaq=WilsonLoops<Gimpl>::avgPlaquette(Umu);
+  std::cout << " Final plaquette "<<plaq << " diff " << plaq - init_plaq << " (expect 0)" << std::endl;
+
+  SU<Nc>::ColdConfiguration(pRNG,Uorg);
+  Uorg = Uorg - Umu;
+  std::cout << " Norm difference between a unit gauge configuration and the gauge fixed configuration "<< norm2(Uorg) << " (expect 0)" << std::endl;
+
   //#########################################################################################
   if(do_fft_gfix){
     std::cout<< "*************************************************************************************" <<std::endl;
@@ -150,6 +172,22 @@ void run(double alpha, bool do_fft_gfix){
     std::cout << " Final plaquette "<<plaq << " diff " << plaq - init_plaq << " (expect 0)" << std::endl;
   }
   //#########################################################################################
+
+  std::cout<< "******************************************************************************************" <<std::endl;
+  std::cout<< "* Testing overrelaxation fixing to Landau gauge with random configuration               **" <<std::endl;
+  std::cout<< "******************************************************************************************" <<std::endl;
+
+  SU<Nc>::HotConfiguration(pRNG,Umu);
+
+  init_plaq=WilsonLoops<Gimpl>::avgPlaquette(Umu);
+  std::cout << " Initial plaquette "<< init_plaq << std::endl;
+
+  FourierAcceleratedGaugeFixer<Gimpl>::OverrelaxationGaugeFix(Umu,omega,10000,1.0e-12, 1.0e-12);
+
+  plaq=WilsonLoops<Gimpl>::avgPlaquette(Umu);
+  std::cout << " Final plaquette "<<plaq << " diff " << plaq - init_plaq << " (expect 0)" << std::endl;
+
+  //#########################################################################################
   
   std::cout<< "*******************************************************************************************" <<std::endl;
   std::cout<< "* Testing steepest descent fixing to coulomb gauge with random configuration           *" <<std::endl;
@@ -167,6 +205,22 @@ void run(double alpha, bool do_fft_gfix){
   std::cout << " Final plaquette "<<plaq << " diff " << plaq - init_plaq << " (expect 0)" << std::endl;
 
 
+  //#########################################################################################
+
+  std::cout<< "*******************************************************************************************" <<std::endl;
+  std::cout<< "* Testing overrelaxation fixing to coulomb gauge with random configuration              *" <<std::endl;
+  std::cout<< "*******************************************************************************************" <<std::endl;
+
+  SU<Nc>::HotConfiguration(pRNG,Umu);
+
+  init_plaq=WilsonLoops<Gimpl>::avgPlaquette(Umu);
+  std::cout << " Initial plaquette "<< init_plaq << std::endl;
+
+  FourierAcceleratedGaugeFixer<Gimpl>::OverrelaxationGaugeFix(Umu,xform4,omega,10000,1.0e-12, 1.0e-12,coulomb_dir);
+
+  plaq=WilsonLoops<Gimpl>::avgPlaquette(Umu);
+  std::cout << " Final plaquette "<<plaq << " diff " << plaq - init_plaq << " (expect 0)" << std::endl;
+
   //#########################################################################################
   if(do_fft_gfix){
     std::cout<< "*******************************************************************************************" <<std::endl;
@@ -191,6 +245,7 @@ int main (int argc, char ** argv)
   Grid_init(&argc,&argv);
 
   double alpha=0.1; //step size
+  double omega=1.7; //overrelaxation parameter
   std::string gimpl = "periodic";
   bool do_fft_gfix = true; //test fourier transformed gfix as well as steepest descent
   for(int i=1;i<argc;i++){
@@ -208,13 +263,16 @@ int main (int argc, char ** argv)
     }else if(sarg == "--alpha"){
       assert(i<argc-1 && "--alpha option requires an argument");
       std::istringstream ss(argv[i+1]); ss >> alpha;
+    }else if(sarg == "--omega"){
+      assert(i<argc-1 && "--omega option requires an argument");
+      std::istringstream ss(argv[i+1]); ss >> omega;
     }
   }
 
 
   if(gimpl == "periodic"){
     std::cout << GridLogMessage << "Using periodic boundary condition" << std::endl;
-    run<PeriodicGimplR>(alpha, do_fft_gfix);
+    run<PeriodicGimplR>(alpha, omega, do_fft_gfix);
   }else{
     std::vector<int> conjdirs = {1,1,0,0}; //test with 2 conjugate dirs and 2 not
     std::cout << GridLogMessage << "Using complex conjugate boundary conditions in dimensions ";
@@ -224,7 +282,7 @@ int main (int argc, char ** argv)
     std::cout << std::endl;
 
     ConjugateGimplR::setDirections(conjdirs);
-    run<ConjugateGimplR>(alpha, do_fft_gfix);
+    run<ConjugateGimplR>(alpha, omega, do_fft_gfix);
   }
   
   Grid_finalize();
@@ -0,0 +1,103 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_fused_expression.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Fused multi-statement sweeps against the same statements one at a time
+template<class Field>
+void TestFusion(GridBase *grid,GridParallelRNG &RNG,int cb,RealD tol,const std::string &name)
+{
+  Field psi(grid), p(grid), r(grid), mmp(grid);
+  gaussian(RNG,psi); gaussian(RNG,p); gaussian(RNG,r); gaussian(RNG,mmp);
+  psi.Checkerboard()=cb; p.Checkerboard()=cb; r.Checkerboard()=cb; mmp.Checkerboard()=cb;
+  Field psi_ref(psi), p_ref(p), r_ref(r);
+  RealD a=0.3, b=-1.7;
+
+  // CG update: psi sees the old p, p sees the new r
+  r_ref   = r_ref - a*mmp;
+  psi_ref = a*p_ref + psi_ref;
+  p_ref   = b*p_ref + r_ref;
+  RealD    cp_ref  = norm2(r_ref);
+  ComplexD ip_ref  = innerProduct(p_ref,mmp);
+  RealD    n_ref   = norm2(psi_ref-p_ref);
+
+  RealD cp, n;
+  ComplexD ip;
+  double t0=usecond();
+  fusedEval(FusedAssign(r,   r - a*mmp),
+	    FusedNorm2(cp, r),
+	    FusedAssign(psi, a*p + psi),
+	    FusedAssign(p,   b*p + r),
+	    FusedInnerProduct(ip, p, mmp),
+	    FusedNorm2(n, psi - p));
+  double t1=usecond();
+
+  RealD dr   = norm2(r-r_ref);
+  RealD dpsi = norm2(psi-psi_ref);
+  RealD dp   = norm2(p-p_ref);
+  std::cout << GridLogMessage << name << " cb "<<cb<<" field diffs "<<dr<<" "<<dpsi<<" "<<dp
+	    << " norm "<<cp<<" ref "<<cp_ref<<" ip "<<ip<<" ref "<<ip_ref
+	    << " |psi-p|^2 "<<n<<" ref "<<n_ref<<" "<<(t1-t0)/1000<<" ms"<<std::endl;
+  assert(dr==0.0 && dpsi==0.0 && dp==0.0);
+  assert(psi.Checkerboard()==cb && p.Checkerboard()==cb && r.Checkerboard()==cb);
+  assert(fabs(cp-cp_ref) <= tol*cp_ref);
+  assert(abs(ip-ip_ref)  <= tol*abs(ip_ref));
+  assert(fabs(n-n_ref)   <= tol*n_ref);
+
+  // Assignments only, and a reduction only
+  fusedEval(FusedAssign(psi_ref, 2.0*p), FusedAssign(r_ref, psi_ref + r));
+  assert(norm2(psi_ref-2.0*p)==0.0);
+  assert(norm2(r_ref-(psi_ref+r))==0.0);
+  fusedEval(FusedNorm2(n, p));
+  assert(fabs(n-norm2(p)) <= tol*n);
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+								   GridDefaultSimd(Nd,vComplexD::Nsimd()),
+								   GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * UGridF  = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+								   GridDefaultSimd(Nd,vComplexF::Nsimd()),
+								   GridDefaultMpi());
+  GridParallelRNG RNG(UGrid);   RNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  GridParallelRNG RNGF(UGridF); RNGF.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  TestFusion<LatticeFermionD>(UGrid,RNG,Even,1.0e-12,"LatticeFermionD");
+  TestFusion<LatticeFermionD>(UrbGrid,RNG,Odd,1.0e-12,"LatticeFermionD red-black");
+  TestFusion<LatticeColourMatrixD>(UGrid,RNG,Even,1.0e-12,"LatticeColourMatrixD");
+  TestFusion<LatticeFermionF>(UGridF,RNGF,Even,1.0e-5,"LatticeFermionF");
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
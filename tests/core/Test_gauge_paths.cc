@@ -0,0 +1,161 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_gauge_paths.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef WilsonLoops<PeriodicGimplR> WL;
+
+void Check(const std::string &name,const LatticeColourMatrix &ref,const LatticeColourMatrix &res)
+{
+  LatticeColourMatrix diff(ref.Grid());
+  diff = ref-res;
+  std::cout << GridLogMessage << name << " |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)<<std::endl;
+  assert(norm2(diff) < 1.0e-24*norm2(ref));
+}
+void Check(const std::string &name,RealD ref,RealD res)
+{
+  std::cout << GridLogMessage << name << " ref "<<ref<<" res "<<res<<" diff "<<ref-res<<std::endl;
+  assert(fabs(ref-res) < 1.0e-12*fabs(ref));
+}
+
+// Padded cell link paths against covariant shifts and the existing
+// Cshift based loops, staples and field strengths.
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  std::cout << std::setprecision(14);
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplex::Nsimd()),
+							 GridDefaultMpi());
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(seeds);
+
+  LatticeGaugeField Umu(UGrid); SU<Nc>::HotConfiguration(RNG4,Umu);
+  std::vector<LatticeColourMatrix> U(Nd,UGrid);
+  for(int mu=0;mu<Nd;mu++) U[mu] = PeekIndex<LorentzIndex>(Umu,mu);
+
+  // Staples, as open paths from x+mu back to x
+  GaugeLinkPaths<PeriodicGimplR> staples;
+  for(int mu=0;mu<Nd;mu++){
+    for(int nu=0;nu<Nd;nu++){
+      if ( nu==mu ) continue;
+      Coordinate xpmu(Nd,0); xpmu[mu]=1;
+      GaugeLinkPath upper(xpmu), lower(xpmu);
+      upper.Forward(nu).Backward(mu).Backward(nu);
+      lower.Backward(nu).Backward(mu).Forward(nu);
+      staples.AddPath(mu,upper);
+      staples.AddPath(mu,lower);
+    }
+  }
+  std::vector<LatticeColourMatrix> out;
+  std::vector<LatticeColourMatrix> ref;
+  LatticeColourMatrix tmp(UGrid);
+  staples.Evaluate(out,U);
+  staples.EvaluateCshift(ref,U);
+  for(int mu=0;mu<Nd;mu++){
+    WL::Staple(tmp,U,mu);
+    Check("Staple  mu "+std::to_string(mu),tmp,out[mu]);
+    Check("Staple  Cshift mu "+std::to_string(mu),ref[mu],out[mu]);
+  }
+
+  // Large loops, clover leaves and weighted sums in several outputs
+  GaugeLinkPaths<PeriodicGimplR> loops;
+  loops.AddPath(0,GaugeLinkPath::Loop(3,1,3,2));
+  WL::CloverleafMxNPaths(loops,1,0,2,1,2);
+  WL::CloverleafMxNPaths(loops,2,1,3,2,2,0.5);
+  loops.AddPath(2,GaugeLinkPath::Loop(2,0,1,3),-0.25);
+  std::cout << GridLogMessage << loops.Paths()<<" paths "<<loops.Outputs()<<" outputs depth "<<loops.Depth()<<std::endl;
+  loops.Evaluate(out,U);
+  loops.EvaluateCshift(ref,U);
+  for(int o=0;o<loops.Outputs();o++){
+    Check("Paths output "+std::to_string(o),ref[o],out[o]);
+  }
+  WL::wilsonLoop(tmp,U,3,2,3,1);
+  Check("wilsonLoop 3x2",tmp,out[0]);
+  WL::CloverleafMxN(tmp,U[0],U[2],0,2,1,2);
+  Check("CloverleafMxN 1x2",tmp,out[1]);
+
+  // Field strengths of all planes
+  for(int M=1;M<=2;M++){
+    std::vector<std::vector<LatticeColourMatrix> > F;
+    WL::FieldStrengthMxNAll(F,Umu,M,2);
+    for(int mu=0;mu<Nd-1;mu++){
+      for(int nu=mu+1;nu<Nd;nu++){
+	WL::FieldStrengthMxN(tmp,Umu,mu,nu,M,2);
+	Check("FieldStrengthMxN "+std::to_string(M)+"x2 "+std::to_string(mu)+std::to_string(nu),tmp,F[mu][nu]);
+      }
+    }
+  }
+
+  // Loop sums
+  LatticeComplex site(UGrid), wl(UGrid), acc(UGrid);
+  acc = Zero();
+  for(int mu=1;mu<Nd;mu++){
+    for(int nu=0;nu<mu;nu++){
+      WL::traceDirRectangle(wl,U,mu,nu);
+      acc = acc + wl;
+    }
+  }
+  WL::siteRectangle(site,U);
+  Check("siteRectangle",TensorRemove(sum(acc)).real(),TensorRemove(sum(site)).real());
+
+  acc = Zero();
+  for(int mu=1;mu<Nd;mu++){
+    for(int nu=0;nu<mu;nu++){
+      WL::traceWilsonLoop(wl,U,2,3,mu,nu);
+      acc = acc + wl;
+      WL::traceWilsonLoop(wl,U,3,2,mu,nu);
+      acc = acc + wl;
+    }
+  }
+  WL::siteWilsonLoop(site,U,2,3);
+  Check("siteWilsonLoop 2x3",TensorRemove(sum(acc)).real(),TensorRemove(sum(site)).real());
+  // A caller held path set is reused across evaluations
+  GaugeLinkPaths<PeriodicGimplR> held;
+  WL::WilsonLoopPaths(held,Nd,2,3);
+  WL::siteWilsonLoop(site,U,held);
+  WL::siteWilsonLoop(site,U,held);
+  Check("siteWilsonLoop 2x3 held",TensorRemove(sum(acc)).real(),TensorRemove(sum(site)).real());
+
+  // Improved gauge action
+  RealD beta=2.13;
+  IwasakiGaugeActionR Iwasaki(beta);
+  RealD c1=-0.331;
+  RealD c_plaq=beta*(1.0-8.0*c1);
+  RealD c_rect=beta*c1;
+  RealD vol=UGrid->gSites();
+  RealD Sref = c_plaq*(1.0-WL::avgPlaquette(Umu))*(Nd*(Nd-1.0))*vol*0.5
+             + c_rect*(1.0-WL::avgRectangle(Umu))*(Nd*(Nd-1.0))*vol;
+  Check("Iwasaki action",Sref,Iwasaki.S(Umu));
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,152 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_halo_compression.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Stands in for a compressor when only its wire datum matters
+struct DatumCompressor {
+  int datum;
+  int decompress;
+  int CommDatumSize(void)     { return datum; }
+  int DecompressionStep(void) { return decompress; }
+};
+
+template<class Field>
+RealD RoundTrip(Field &in,int precision)
+{
+  typedef typename Field::vector_object vobj;
+  typedef typename RealPart<typename vobj::scalar_type>::type Real;
+
+  Field out(in.Grid());
+  uint64_t bytes = in.Grid()->oSites()*sizeof(vobj);
+  uint64_t wbytes= HaloCompressedBytes(bytes,sizeof(Real));
+  void *wire = acceleratorAllocDevice(wbytes);
+  {
+    autoView(in_v ,in ,AcceleratorRead);
+    autoView(out_v,out,AcceleratorWrite);
+    HaloCompress<Real>  (precision,wire,(void *)&in_v[0],bytes);
+    HaloDecompress<Real>(precision,(void *)&out_v[0],wire,bytes);
+  }
+  acceleratorFreeDevice(wire);
+  out = out - in;
+  return std::sqrt(norm2(out)/norm2(in));
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplex::Nsimd()),
+							 GridDefaultMpi());
+  GridCartesian * UGridF= SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplexF::Nsimd()),
+							 GridDefaultMpi());
+  GridParallelRNG RNG(UGrid);  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG RNGF(UGridF); RNGF.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeFermionD psi(UGrid);  gaussian(RNG,psi);
+  LatticeFermionF psiF(UGridF); gaussian(RNGF,psiF);
+
+  std::cout << GridLogMessage << "Halo wire format round trip"<<std::endl;
+  RealD err;
+  err = RoundTrip(psi ,HaloPrecisionFp16); std::cout << GridLogMessage << " double fp16 rel. error "<<err<<std::endl; assert(err < 1.0e-3);
+  err = RoundTrip(psi ,HaloPrecisionBf16); std::cout << GridLogMessage << " double bf16 rel. error "<<err<<std::endl; assert(err < 1.0e-2);
+  err = RoundTrip(psiF,HaloPrecisionFp16); std::cout << GridLogMessage << " single fp16 rel. error "<<err<<std::endl; assert(err < 1.0e-3);
+  err = RoundTrip(psiF,HaloPrecisionBf16); std::cout << GridLogMessage << " single bf16 rel. error "<<err<<std::endl; assert(err < 1.0e-2);
+
+  std::cout << GridLogMessage << "Stencil halo exchange with reduced precision wire format"<<std::endl;
+  {
+    typedef LatticeFermionF::vector_object vobj;
+    typedef CartesianStencil<vobj,vobj,SimpleStencilParams> Stencil;
+    std::vector<int> directions;
+    std::vector<int> displacements;
+    for(int mu=0;mu<Nd;mu++){
+      directions.push_back(mu); displacements.push_back( 1);
+      directions.push_back(mu); displacements.push_back(-1);
+    }
+    SimpleCompressor<vobj> compress;
+
+    Stencil Full(UGridF,directions.size(),Even,directions,displacements,SimpleStencilParams());
+    Full.HaloExchange(psiF,compress);
+    uint64_t words = Full._unified_buffer_size;
+    std::vector<vobj> ref(words);
+    if ( words ) acceleratorCopyFromDevice(Full.CommBuf(),&ref[0],words*sizeof(vobj));
+
+    for(int prec=HaloPrecisionFp16;prec<=HaloPrecisionBf16;prec++){
+      SimpleStencilParams params;
+      params.comms_precision = prec;
+      Stencil Half(UGridF,directions.size(),Even,directions,displacements,params,true);
+      Half.HaloExchange(psiF,compress);
+      std::vector<vobj> recv(words);
+      if ( words ) acceleratorCopyFromDevice(Half.CommBuf(),&recv[0],words*sizeof(vobj));
+      RealD diff=0.0, nrm=0.0;
+      for(uint64_t w=0;w<words;w++){
+	vobj d = recv[w]-ref[w];
+	diff += Reduce(TensorRemove(innerProduct(d,d))).real();
+	nrm  += Reduce(TensorRemove(innerProduct(ref[w],ref[w]))).real();
+      }
+      UGridF->GlobalSum(diff);
+      UGridF->GlobalSum(nrm);
+      err = (nrm>0.0) ? std::sqrt(diff/nrm) : 0.0;
+      std::cout << GridLogMessage << " precision "<<prec<<" halo words "<<words<<" rel. error "<<err<<std::endl;
+      assert(err < 1.0e-2);
+    }
+  }
+
+  std::cout << GridLogMessage << "Wire format follows the compressor datum"<<std::endl;
+  {
+    // Half comms compressors send a lower precision datum than the stencil's cobj
+    typedef LatticeFermionD::vector_object vobjD;
+    typedef LatticeFermionF::vector_object vobjF;
+    std::vector<int> directions({0});
+    std::vector<int> displacements({1});
+    SimpleStencilParams params;
+    params.comms_precision = HaloPrecisionFp16;
+    CartesianStencil<vobjD,vobjD,SimpleStencilParams> StD(UGrid ,1,Even,directions,displacements,params);
+    CartesianStencil<vobjF,vobjF,SimpleStencilParams> StF(UGridF,1,Even,directions,displacements,params);
+
+    DatumCompressor full({(int)sizeof(vobjD),0}), half({(int)sizeof(vobjD)/2,1});
+    StD.PlanCheck(full); assert(StD.wire_precision==HaloPrecisionFp16 && StD.wire_real_size==sizeof(RealD));
+    StD.PlanCheck(half); assert(StD.wire_precision==HaloPrecisionFp16 && StD.wire_real_size==sizeof(RealF));
+
+    DatumCompressor fullF({(int)sizeof(vobjF),0}), halfF({(int)sizeof(vobjF)/2,1});
+    StF.PlanCheck(fullF); assert(StF.wire_precision==HaloPrecisionFp16 && StF.wire_real_size==sizeof(RealF));
+    StF.PlanCheck(halfF); assert(StF.wire_precision==HaloPrecisionFull); // already 16 bit
+
+    // Without the opt in nothing is packed
+    CartesianStencil<vobjF,vobjF,SimpleStencilParams> StN(UGridF,1,Even,directions,displacements,SimpleStencilParams());
+    StN.PlanCheck(fullF); assert(StN.wire_precision==HaloPrecisionFull);
+    std::cout << GridLogMessage << " ok"<<std::endl;
+  }
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
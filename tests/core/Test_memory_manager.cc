@@ -34,6 +34,8 @@ void  MemoryTest(GridCartesian         * FGrid,int N);
 
 int main (int argc, char ** argv)
 {
+  // Allow reuse of blocks up to 10% larger, checked below
+  setenv("GRID_ALLOC_SLACK","10",0);
   Grid_init(&argc,&argv);
 
   GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
@@ -47,6 +49,51 @@ int main (int argc, char ** argv)
     MemoryManager::Print();
     AUDIT();
   }
+  MemoryStatus stat = MemoryManager::GetFootprint();
+  std::cout << GridLogMessage << "Host allocation cache hits "<<stat.HostAllocCacheHits
+	    <<" misses "<<stat.HostAllocCacheMisses<<std::endl;
+  std::cout << GridLogMessage << "Device allocation cache hits "<<stat.DeviceAllocCacheHits
+	    <<" misses "<<stat.DeviceAllocCacheMisses<<std::endl;
+
+  // Alternating two sizes must be served from the pool after the first pass
+  MemoryManager::ResetCacheCounters();
+  for(int i=0;i<N;i++){
+    void *a = MemoryManager::CpuAllocate(1024*1024);
+    void *b = MemoryManager::CpuAllocate(1024);
+    MemoryManager::CpuFree(b,1024);
+    MemoryManager::CpuFree(a,1024*1024);
+  }
+  stat = MemoryManager::GetFootprint();
+  std::cout << GridLogMessage << "Pool churn hits "<<stat.HostAllocCacheHits
+	    <<" misses "<<stat.HostAllocCacheMisses<<std::endl;
+#ifdef ALLOCATION_CACHE
+  assert(stat.HostAllocCacheMisses <= 2);
+#endif
+
+  // A block handed out for a smaller request keeps its true size in the pool
+  {
+    size_t big   = 1024*1024;
+    size_t small = big - 16*1024;
+    void *a = MemoryManager::CpuAllocate(big);
+    MemoryManager::CpuFree(a,big);
+    uint64_t cached = MemoryManager::HostCacheBytes();
+    void *b = MemoryManager::CpuAllocate(small);
+    MemoryManager::CpuFree(b,small);
+    std::cout << GridLogMessage << "Pool bytes after slack reuse "<<MemoryManager::HostCacheBytes()
+	      <<" before "<<cached<<std::endl;
+    assert(MemoryManager::HostCacheBytes() == cached);
+    MemoryManager::ResetCacheCounters();
+    void *c = MemoryManager::CpuAllocate(big);
+    MemoryManager::CpuFree(c,big);
+    stat = MemoryManager::GetFootprint();
+#ifdef ALLOCATION_CACHE
+    if ( getenv("GRID_ALLOC_SLACK") && atoi(getenv("GRID_ALLOC_SLACK"))>=2 ) {
+      assert(b == a);
+      assert(stat.HostAllocCacheMisses == 0);
+    }
+#endif
+  }
+
   Grid_finalize();
 }
 
@@ -0,0 +1,182 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_packed_gauge_links.cc
+
+    Copyright (C) 2015
+
+    Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Apply Dhop, DhopEO and DhopOE of both operators, with and without dagger,
+// and return the largest relative deviation.
+template<class Action,class Field>
+RealD CompareHopping(Action &Dfull,Action &Dpack,Field &src,GridBase *FGrid,GridBase *FrbGrid)
+{
+  RealD dev = 0.0;
+  Field ref(FGrid), res(FGrid), diff(FGrid);
+  Field src_e(FrbGrid), src_o(FrbGrid), ref_cb(FrbGrid), res_cb(FrbGrid), diff_cb(FrbGrid);
+  pickCheckerboard(Even,src_e,src);
+  pickCheckerboard(Odd ,src_o,src);
+  for(int dag=0;dag<2;dag++){
+    Dfull.Dhop(src,ref,dag);
+    Dpack.Dhop(src,res,dag);
+    diff = ref-res;
+    dev = std::max(dev,norm2(diff)/norm2(ref));
+
+    Dfull.DhopEO(src_o,ref_cb,dag);
+    Dpack.DhopEO(src_o,res_cb,dag);
+    diff_cb = ref_cb-res_cb;
+    dev = std::max(dev,norm2(diff_cb)/norm2(ref_cb));
+
+    Dfull.DhopOE(src_e,ref_cb,dag);
+    Dpack.DhopOE(src_e,res_cb,dag);
+    diff_cb = ref_cb-res_cb;
+    dev = std::max(dev,norm2(diff_cb)/norm2(ref_cb));
+  }
+  return dev;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG  RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds);
+  GridParallelRNG  RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds);
+
+  LatticeGaugeField Umu(UGrid); SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  // Packing only reorganises the links, so the answers agree to rounding
+  RealD tol = 1.0e-24;
+  RealD mass=0.1;
+  RealD M5  =1.8;
+
+  for(int reconstruct : {LinkReconstruct12,LinkReconstruct8}){
+
+    std::cout<<GridLogMessage<<"=========================================="<<std::endl;
+    std::cout<<GridLogMessage<<"Reconstruct-"<<reconstruct<<" against full links"<<std::endl;
+    std::cout<<GridLogMessage<<"=========================================="<<std::endl;
+
+#if Nc==3
+    {
+      WilsonImplParams params;
+      params.boundary_phases[Nd-1] = -1.0;
+      WilsonFermionD Dfull(Umu,*UGrid,*UrbGrid,mass,params);
+      params.reconstruct = reconstruct;
+      WilsonFermionD Dpack(Umu,*UGrid,*UrbGrid,mass,params);
+
+      LatticeFermionD src(UGrid); random(RNG4,src);
+      assert(Dpack.PackedLinks.reconstruct == reconstruct);
+      RealD dev = CompareHopping(Dfull,Dpack,src,UGrid,UrbGrid);
+      std::cout<<GridLogMessage<<"Wilson              rel. deviation "<<dev<<std::endl;
+      assert(dev < tol);
+    }
+    {
+      WilsonImplParams params;
+      DomainWallFermionD Dfull(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,params);
+      params.reconstruct = reconstruct;
+      DomainWallFermionD Dpack(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,params);
+
+      LatticeFermionD src(FGrid); random(RNG5,src);
+      assert(Dpack.PackedLinks.reconstruct == reconstruct);
+      RealD dev = CompareHopping(Dfull,Dpack,src,FGrid,FrbGrid);
+      std::cout<<GridLogMessage<<"DomainWall          rel. deviation "<<dev<<std::endl;
+      assert(dev < tol);
+    }
+    {
+      // Fat and long links both factor as a scale times SU(3) here
+      RealD c1=9.0/8.0, c2=-1.0/24.0, u0=1.0;
+      ImprovedStaggeredFermionD::ImplParams params;
+      ImprovedStaggeredFermionD Dfull(Umu,Umu,*UGrid,*UrbGrid,mass,c1,c2,u0,params);
+      params.reconstruct = reconstruct;
+      ImprovedStaggeredFermionD Dpack(Umu,Umu,*UGrid,*UrbGrid,mass,c1,c2,u0,params);
+
+      typedef ImprovedStaggeredFermionD::FermionField StaggeredField;
+      StaggeredField src(UGrid); random(RNG4,src);
+      assert(Dpack.PackedLinks.reconstruct == reconstruct);
+      RealD dev = CompareHopping(Dfull,Dpack,src,UGrid,UrbGrid);
+      std::cout<<GridLogMessage<<"ImprovedStaggered   rel. deviation "<<dev<<std::endl;
+      assert(dev < tol);
+    }
+    {
+      RealD c1=9.0/8.0, c2=-1.0/24.0, u0=1.0;
+      ImprovedStaggeredFermion5DD::ImplParams params;
+      ImprovedStaggeredFermion5DD Dfull(Umu,Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,c1,c2,u0,params);
+      params.reconstruct = reconstruct;
+      ImprovedStaggeredFermion5DD Dpack(Umu,Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,c1,c2,u0,params);
+
+      typedef ImprovedStaggeredFermion5DD::FermionField StaggeredField;
+      StaggeredField src(FGrid); random(RNG5,src);
+      assert(Dpack.PackedLinks.reconstruct == reconstruct);
+      RealD dev = CompareHopping(Dfull,Dpack,src,FGrid,FrbGrid);
+      std::cout<<GridLogMessage<<"ImprovedStaggered5D rel. deviation "<<dev<<std::endl;
+      assert(dev < tol);
+    }
+#endif
+  }
+
+#if Nc==3
+  {
+    // Links that have drifted off the group by rounding are reunitarised and
+    // still pack, at the cost of a deviation of the size of the drift
+    LatticeGaugeField Unoise(UGrid); gaussian(RNG4,Unoise);
+    LatticeGaugeField Udrift(UGrid); Udrift = Umu + 2.0e-15*Unoise;
+    WilsonImplParams params;
+    WilsonFermionD Dfull(Udrift,*UGrid,*UrbGrid,mass,params);
+    params.reconstruct = LinkReconstruct8;
+    WilsonFermionD Dpack(Udrift,*UGrid,*UrbGrid,mass,params);
+
+    LatticeFermionD src(UGrid); random(RNG4,src);
+    assert(Dpack.PackedLinks.reconstruct == LinkReconstruct8);
+    RealD dev = CompareHopping(Dfull,Dpack,src,UGrid,UrbGrid);
+    std::cout<<GridLogMessage<<"Drifted links       rel. deviation "<<dev<<std::endl;
+    assert(dev < tol);
+
+    // Drift well beyond rounding keeps the full links
+    Udrift = Umu + 1.0e-10*Unoise;
+    WilsonFermionD Dfar(Udrift,*UGrid,*UrbGrid,mass,params);
+    std::cout<<GridLogMessage<<"Far drifted links kept at reconstruct-"<<Dfar.PackedLinks.reconstruct<<std::endl;
+    assert(Dfar.PackedLinks.reconstruct == LinkReconstruct18);
+  }
+  {
+    // Links that are not unitary up to a scale fall back to full storage
+    LatticeGaugeField Urnd(UGrid); gaussian(RNG4,Urnd);
+    WilsonImplParams params;
+    params.reconstruct = LinkReconstruct8;
+    WilsonFermionD Dpack(Urnd,*UGrid,*UrbGrid,mass,params);
+    std::cout<<GridLogMessage<<"Gaussian links kept at reconstruct-"<<Dpack.PackedLinks.reconstruct<<std::endl;
+    assert(Dpack.PackedLinks.reconstruct == LinkReconstruct18);
+  }
+#endif
+
+  Grid_finalize();
+}
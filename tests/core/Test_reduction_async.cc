@@ -0,0 +1,86 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_reduction_async.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplexD::Nsimd()),
+							 GridDefaultMpi());
+  GridParallelRNG RNG(UGrid); RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeFermionD x(UGrid); gaussian(RNG,x);
+  LatticeFermionD y(UGrid); gaussian(RNG,y);
+  LatticeFermionD z(UGrid);
+
+  ComplexD ip_ref = innerProduct(x,y);
+  RealD    nx_ref = norm2(x);
+  RealD    ny_ref = norm2(y);
+
+  std::cout << GridLogMessage << "Several reductions in flight, completed out of order"<<std::endl;
+  auto ip = innerProductAsync(x,y);
+  auto nx = norm2Async(x);
+  auto ny = norm2Async(y);
+  z = x + y; // overlapped local work
+  RealD    ny_a = ny.get();
+  ComplexD ip_a = ip.get();
+  RealD    nx_a = nx.get();
+  std::cout << GridLogMessage << " innerProduct "<<ip_a<<" ref "<<ip_ref<<std::endl;
+  std::cout << GridLogMessage << " norm2 x "<<nx_a<<" ref "<<nx_ref<<std::endl;
+  std::cout << GridLogMessage << " norm2 y "<<ny_a<<" ref "<<ny_ref<<std::endl;
+  // MPI may order the non-blocking sum differently
+  assert(abs(ip_a - ip_ref) <= 1.0e-14*nx_ref);
+  assert(fabs(nx_a - nx_ref) <= 1.0e-14*nx_ref);
+  assert(fabs(ny_a - ny_ref) <= 1.0e-14*ny_ref);
+
+  // get() is idempotent, copies share the reduction
+  auto copy = ip;
+  assert(copy.get() == ip_a);
+  assert(ip.get()   == ip_a);
+
+  std::cout << GridLogMessage << "Communicator level begin/complete"<<std::endl;
+  std::vector<RealD> v({1.0,2.0,3.0});
+  CommsRequest_t req;
+  UGrid->GlobalSumVectorBegin(&v[0],v.size(),req);
+  UGrid->GlobalSumVectorComplete(req);
+  RealD nproc = UGrid->ProcessorCount();
+  for(int i=0;i<v.size();i++) assert(v[i] == (i+1)*nproc);
+
+  // Destroying an uncompleted future completes it
+  {
+    auto dropped = norm2Async(z);
+  }
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,117 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_rng_counter.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian *GridD = SpaceTimeGrid::makeFourDimGrid(latt_size,GridDefaultSimd(Nd,vComplexD::Nsimd()),mpi_layout);
+  GridCartesian *GridF = SpaceTimeGrid::makeFourDimGrid(latt_size,GridDefaultSimd(Nd,vComplexF::Nsimd()),mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+
+  GridParallelRNG pRNGD(GridD,1); pRNGD.SeedFixedIntegers(seeds);
+  GridParallelRNG pRNGF(GridF,1); pRNGF.SeedFixedIntegers(seeds);
+
+  //////////////////////////////////////////////////////////////
+  // Draws depend on the global site only, not on the SIMD layout
+  //////////////////////////////////////////////////////////////
+  LatticeColourVectorD lcvD(GridD);
+  LatticeColourVectorF lcvF(GridF);
+  LatticeColourVectorD tmp(GridD);
+  gaussian(pRNGD,lcvD);
+  gaussian(pRNGF,lcvF);
+  precisionChange(tmp,lcvF);
+  tmp = tmp - lcvD;
+  RealD diff = std::sqrt(norm2(tmp)/norm2(lcvD));
+  std::cout<<GridLogMessage<<"Counter RNG single vs double layout rel. difference "<<diff<<std::endl;
+  assert(diff < 1.0e-6);
+
+  //////////////////////////////////////////////////////////////
+  // Moments of the gaussian; 3 complex per site
+  //////////////////////////////////////////////////////////////
+  RealD nreal = 6.0*GridD->gSites();
+  RealD var  = norm2(lcvD)/nreal;
+  std::cout<<GridLogMessage<<"Counter RNG gaussian variance "<<var<<std::endl;
+  assert(fabs(var-1.0) < 10.0/std::sqrt(nreal));
+
+  LatticeComplexD lc(GridD);
+  random(pRNGD,lc);
+  RealD avg = real(TensorRemove(sum(lc)))/GridD->gSites();
+  std::cout<<GridLogMessage<<"Counter RNG uniform mean "<<avg<<std::endl;
+  assert(fabs(avg-0.5) < 10.0/std::sqrt(12.0*GridD->gSites()));
+
+  //////////////////////////////////////////////////////////////
+  // Key and counter are the whole state
+  //////////////////////////////////////////////////////////////
+  uint32_t k0,k1; uint64_t counter;
+  pRNGD.GetCounterState(k0,k1,counter);
+  LatticeColourVectorD a(GridD); gaussian(pRNGD,a);
+  LatticeColourVectorD b(GridD); gaussian(pRNGD,b);
+  GridParallelRNG restored(GridD,1); restored.SetCounterState(k0,k1,counter);
+  LatticeColourVectorD c(GridD); gaussian(restored,c);
+  tmp = a - c;
+  std::cout<<GridLogMessage<<"Counter RNG restored state difference "<<norm2(tmp)<<std::endl;
+  assert(norm2(tmp) == 0.0);
+  tmp = a - b;
+  assert(norm2(tmp) > 0.0);
+
+  GridSerialRNG sRNG; sRNG.SeedFixedIntegers(seeds);
+  uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+  restored.SetCounterState(k0,k1,counter);
+  BinaryIO::writeRNG(sRNG,restored,"ckpoint_rng_counter",0,nersc_csum,scidac_csuma,scidac_csumb);
+  GridParallelRNG reread(GridD,1);
+  BinaryIO::readRNG(sRNG,reread,"ckpoint_rng_counter",0,nersc_csum,scidac_csuma,scidac_csumb);
+  gaussian(reread,c);
+  tmp = a - c;
+  std::cout<<GridLogMessage<<"Counter RNG checkpoint difference "<<norm2(tmp)<<std::endl;
+  assert(norm2(tmp) == 0.0);
+
+  //////////////////////////////////////////////////////////////
+  // Checkerboarded fill matches the full lattice fill
+  //////////////////////////////////////////////////////////////
+  GridRedBlackCartesian *rbGridD = SpaceTimeGrid::makeFourDimRedBlackGrid(GridD);
+  LatticeColourVectorD full(GridD);
+  LatticeColourVectorD odd(rbGridD); odd.Checkerboard()=Odd;
+  LatticeColourVectorD fullodd(rbGridD);
+  restored.SetCounterState(k0,k1,counter);  gaussian(restored,full);
+  restored.SetCounterState(k0,k1,counter);  gaussian(restored,odd);
+  pickCheckerboard(Odd,fullodd,full);
+  fullodd = fullodd - odd;
+  assert(norm2(fullodd) == 0.0);
+
+  std::cout<<GridLogMessage<<"Done"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,156 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_sliceSum_batched.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace Grid;
+
+// Slice sums by masking on the coordinate, independent of the slice reduction kernels
+template<class vobj> std::vector<typename vobj::scalar_object> sliceSumMask(const Lattice<vobj> &Data,int orthogdim)
+{
+  GridBase *grid = Data.Grid();
+  int fd = grid->_fdimensions[orthogdim];
+  LatticeInteger coor(grid);
+  LatticeCoordinate(coor,orthogdim);
+  Lattice<vobj> zz(grid); zz = Zero();
+  std::vector<typename vobj::scalar_object> result(fd);
+  for(int t=0;t<fd;t++){
+    Lattice<vobj> masked(grid);
+    masked = where(coor==Integer(t),Data,zz);
+    result[t] = sum(masked);
+  }
+  return result;
+}
+
+template<class sobj> RealD diff2(const std::vector<sobj> &a,const std::vector<sobj> &b)
+{
+  assert(a.size()==b.size());
+  RealD d=0;
+  for(int t=0;t<a.size();t++) d+= norm2(a[t]-b[t]);
+  return d;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							GridDefaultSimd(Nd,vComplexD::Nsimd()),
+							GridDefaultMpi());
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(UGrid);
+  pRNG.SeedFixedIntegers(seeds);
+
+  const int Nbatch = 8;
+  std::vector<LatticeSpinColourVectorD> psi(Nbatch,UGrid), chi(Nbatch,UGrid);
+  std::vector<LatticeComplexD> phases(Nbatch,UGrid);
+  for(int i=0;i<Nbatch;i++){
+    gaussian(pRNG,psi[i]);
+    gaussian(pRNG,chi[i]);
+  }
+  {
+    // Momentum phases exp(i p.x) for a few spatial momenta
+    LatticeComplexD coor(UGrid);
+    ComplexD ci(0.0,1.0);
+    for(int i=0;i<Nbatch;i++){
+      phases[i] = Zero();
+      for(int mu=0;mu<Nd-1;mu++){
+	LatticeCoordinate(coor,mu);
+	RealD TwoPiL = M_PI * 2.0 / GridDefaultLatt()[mu];
+	phases[i] = phases[i] + (TwoPiL * ((i>>mu)&0x1)) * coor;
+      }
+      phases[i] = exp(phases[i]*ci);
+    }
+  }
+
+  for(int d=0;d<Nd;d++){
+    std::cout << GridLogMessage << "Orthog. dir. = " << d << std::endl;
+
+    // Single field against the masked reference
+    std::vector<SpinColourVectorD> ref = sliceSumMask(psi[0],d);
+    std::vector<SpinColourVectorD> res = sliceSum(psi[0],d);
+    std::cout << GridLogMessage << " sliceSum diff "<< diff2(ref,res) << std::endl;
+    assert(diff2(ref,res) < 1.0e-20);
+
+    // Batch of fields
+    std::vector<std::vector<SpinColourVectorD> > bres;
+    RealD t0=usecond();
+    for(int i=0;i<Nbatch;i++) res = sliceSum(psi[i],d);
+    RealD t1=usecond();
+    sliceSum(psi,bres,d);
+    RealD t2=usecond();
+    std::cout << GridLogMessage << " "<<Nbatch<<" fields one at a time "<<t1-t0<<" us, batched "<<t2-t1<<" us"<<std::endl;
+    assert(bres.size()==Nbatch);
+    for(int i=0;i<Nbatch;i++){
+      res = sliceSum(psi[i],d);
+      assert(diff2(res,bres[i]) < 1.0e-20);
+    }
+
+    // One field times a batch of phases
+    LatticeSpinColourVectorD prod(UGrid);
+    t0=usecond();
+    for(int i=0;i<Nbatch;i++) { prod = psi[0]*phases[i]; res = sliceSum(prod,d); }
+    t1=usecond();
+    sliceSum(psi[0],phases,bres,d);
+    t2=usecond();
+    std::cout << GridLogMessage << " "<<Nbatch<<" phases one at a time "<<t1-t0<<" us, batched "<<t2-t1<<" us"<<std::endl;
+    for(int i=0;i<Nbatch;i++){
+      prod = psi[0]*phases[i];
+      ref  = sliceSumMask(prod,d);
+      std::cout << GridLogMessage << " phase "<<i<<" diff "<< diff2(ref,bres[i]) << std::endl;
+      assert(diff2(ref,bres[i]) < 1.0e-20);
+    }
+
+    // Inner products and norms
+    std::vector<ComplexD> ip;
+    std::vector<std::vector<ComplexD> > bip;
+    std::vector<std::vector<RealD> > bsn;
+    std::vector<RealD> sn;
+    sliceInnerProductVector(bip,psi,chi,d);
+    sliceNorm(bsn,psi,d);
+    for(int i=0;i<Nbatch;i++){
+      LatticeComplexD lip(UGrid);
+      lip = localInnerProduct(psi[i],chi[i]);
+      std::vector<TComplexD> ipref = sliceSumMask(lip,d);
+      sliceInnerProductVector(ip,psi[i],chi[i],d);
+      sliceNorm(sn,psi[i],d);
+      RealD dip=0, dbip=0, dsn=0;
+      for(int t=0;t<ip.size();t++){
+	dip  += norm(ip[t]-TensorRemove(ipref[t]));
+	dbip += norm(bip[i][t]-ip[t]);
+	dsn  += (bsn[i][t]-sn[t])*(bsn[i][t]-sn[t]);
+      }
+      std::cout << GridLogMessage << " inner product "<<i<<" diff "<< dip << " batched "<<dbip<<" norm batched "<<dsn<<std::endl;
+      assert(dip  < 1.0e-20);
+      assert(dbip < 1.0e-20);
+      assert(dsn  < 1.0e-20);
+    }
+  }
+
+  std::cout << GridLogMessage << "Done" << std::endl;
+  Grid_finalize();
+}
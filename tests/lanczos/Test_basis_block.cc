@@ -0,0 +1,118 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/lanczos/Test_basis_block.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Blocked basis rotation and Gram-Schmidt against one vector at a time
+template<class Field,class Matrix>
+void TestRotate(std::vector<Field> &basis,Matrix &Qt,int j0,int j1,int k0,int k1,RealD tol,const std::string &name)
+{
+  int Nm = basis.size();
+  GridBase *grid = basis[0].Grid();
+  std::vector<Field> ref(Nm,grid);
+  for(int j=j0;j<j1;j++){
+    ref[j] = Zero();
+    for(int k=k0;k<k1;k++) ref[j] = ref[j] + Qt(j,k)*basis[k];
+  }
+  double t0=usecond();
+  basisRotate(basis,Qt,j0,j1,k0,k1,Nm);
+  double t1=usecond();
+  RealD nref=0, ndiff=0;
+  for(int j=j0;j<j1;j++){
+    nref += norm2(ref[j]);
+    ndiff+= norm2(ref[j]-basis[j]);
+  }
+  std::cout << GridLogMessage << name << " rotate ["<<j0<<","<<j1<<") x ["<<k0<<","<<k1<<")"
+	    << " |ref|^2 "<<nref<<" diff "<<ndiff<<" "<<(t1-t0)/1000<<" ms"<<std::endl;
+  assert(ndiff <= tol*tol*nref);
+}
+
+template<class Field>
+void TestBlock(GridBase *grid,GridParallelRNG &RNG,RealD tol,const std::string &name)
+{
+  const int Nm = 21; // not a multiple of the blocking
+  std::vector<Field> basis(Nm,grid);
+  for(auto &b : basis) gaussian(RNG,b);
+
+  Eigen::MatrixXd  Qd = Eigen::MatrixXd::Random(Nm,Nm);
+  Eigen::MatrixXcd Qz = Eigen::MatrixXcd::Random(Nm,Nm);
+  TestRotate(basis,Qd,0,Nm,0,Nm,tol,name+" real");
+  TestRotate(basis,Qd,3,11,2,17,tol,name+" real");
+  TestRotate(basis,Qz,0,Nm,0,Nm,tol,name+" complex");
+
+  // Orthonormal basis by modified Gram-Schmidt, one vector at a time
+  for(int k=0;k<Nm;k++){
+    for(int j=0;j<k;j++) basis[k] = basis[k] - innerProduct(basis[j],basis[k])*basis[j];
+    basis[k] = basis[k]*(1.0/std::sqrt(norm2(basis[k])));
+  }
+
+  Field w(grid);   gaussian(RNG,w);
+  Field ref(grid);
+  std::vector<ComplexD> ip;
+  basisInnerProducts(ip,basis,0,Nm,w);
+  for(int k=0;k<Nm;k++){
+    ComplexD r = innerProduct(basis[k],w);
+    assert(abs(ip[k]-r) <= tol*abs(r));
+  }
+
+  ref = w;
+  for(int k=0;k<Nm;k++) ref = ref - innerProduct(basis[k],ref)*basis[k];
+  double t0=usecond();
+  basisOrthogonalize(basis,w,Nm);
+  double t1=usecond();
+  RealD ndiff = norm2(ref-w);
+  RealD worst = 0;
+  for(int k=0;k<Nm;k++) worst = std::max(worst,abs(innerProduct(basis[k],w)));
+  std::cout << GridLogMessage << name << " orthogonalize |ref|^2 "<<norm2(ref)<<" diff "<<ndiff
+	    << " max |<b,w>| "<<worst<<" "<<(t1-t0)/1000<<" ms"<<std::endl;
+  assert(ndiff <= tol*tol*norm2(ref));
+  assert(worst <= tol*std::sqrt(norm2(w)));
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							   GridDefaultSimd(Nd,vComplexD::Nsimd()),
+							   GridDefaultMpi());
+  GridCartesian * UGridF  = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							   GridDefaultSimd(Nd,vComplexF::Nsimd()),
+							   GridDefaultMpi());
+  GridParallelRNG RNG(UGrid);  RNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  GridParallelRNG RNGF(UGridF);RNGF.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  TestBlock<LatticeFermionD>(UGrid,RNG,1.0e-10,"LatticeFermionD");
+  TestBlock<LatticeComplexD>(UGrid,RNG,1.0e-10,"LatticeComplexD");
+  TestBlock<LatticeFermionF>(UGridF,RNGF,1.0e-4,"LatticeFermionF");
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,144 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/lanczos/Test_compressed_evecs.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// <a,b> with site products and sums in double, as the packed store accumulates
+template<class Field>
+ComplexD innerProductDouble(const Field &a,const Field &b)
+{
+  typedef typename Field::vector_object vobj;
+  typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+  GridBase *grid = a.Grid();
+  const uint64_t sites = grid->oSites();
+  deviceVector<inner_t> inner_tmp(sites);
+  inner_t *inner_tmp_v = &inner_tmp[0];
+  autoView( a_v , a, AcceleratorRead);
+  autoView( b_v , b, AcceleratorRead);
+  accelerator_for(ss,sites,1,{
+    inner_tmp_v[ss] = innerProductD(a_v[ss],b_v[ss]);
+  });
+  ComplexD ip = TensorRemove(sum(inner_tmp_v,sites));
+  grid->GlobalSum(ip);
+  return ip;
+}
+
+// Packed eigenvector store: round trip precision, and the fused deflation
+// projections against the same vectors held as a std::vector<Field>
+template<class Field,class PackedVector>
+void TestStore(GridBase *grid,GridParallelRNG &RNG,RealD tol,const std::string &name)
+{
+  const int Nev = 11;
+  CompressedEigenVectors<Field,PackedVector> evecs(grid);
+  std::vector<Field> orig(Nev,grid);
+  std::vector<Field> unpacked(Nev,grid);
+  std::vector<RealD> eval(Nev);
+  for(int i=0;i<Nev;i++){
+    gaussian(RNG,orig[i]);
+    orig[i].Checkerboard() = Odd;
+    orig[i] = orig[i]*(1.0/std::sqrt(norm2(orig[i])));
+    eval[i] = 0.01*(i+1);
+    evecs.push_back(orig[i]);
+  }
+  RealD worst=0;
+  for(int i=0;i<Nev;i++){
+    evecs.get(i,unpacked[i]);
+    assert(unpacked[i].Checkerboard()==Odd);
+    worst = std::max(worst,norm2(unpacked[i]-orig[i]));
+  }
+  RealD full = (RealD)Nev*grid->oSites()*sizeof(typename Field::vector_object);
+  std::cout << GridLogMessage << name << " max |evec - unpacked|^2 "<<worst
+	    << " storage "<<evecs.Bytes()/full<<" of std::vector"<<std::endl;
+  assert(worst < tol*tol);
+
+  Field src(grid);   gaussian(RNG,src); src.Checkerboard() = Odd;
+  Field ref(grid);
+  Field res(grid);
+  std::vector<ComplexD> ip;
+  basisInnerProducts(ip,evecs,0,Nev,src);
+  for(int i=0;i<Nev;i++){
+    ComplexD r = innerProductDouble(unpacked[i],src);
+    assert(abs(ip[i]-r) < 1.0e-12*abs(r)+1.0e-12);
+  }
+
+  DeflatedGuesser<Field>                                             Ref(unpacked,eval);
+  DeflatedGuesser<Field,CompressedEigenVectors<Field,PackedVector> > Defl(evecs,eval);
+  double t0=usecond();
+  Ref(src,ref);
+  double t1=usecond();
+  Defl(src,res);
+  double t2=usecond();
+  assert(res.Checkerboard()==src.Checkerboard());
+  RealD diff = norm2(ref-res);
+  std::cout << GridLogMessage << name << " DeflatedGuesser |ref|^2 "<<norm2(ref)<<" diff "<<diff
+	    << " full "<<(t1-t0)/1000<<" ms packed "<<(t2-t1)/1000<<" ms"<<std::endl;
+  assert(diff < 1.0e-20*norm2(ref));
+
+  // Multi-RHS deflation imports the store through basisGet (double precision only)
+  if constexpr (std::is_same<typename Field::scalar_type,ComplexD>::value) {
+    MultiRHSDeflation<Field> Mrhs;
+    Mrhs.ImportEigenBasis(evecs,eval);
+    std::vector<Field> srcs(1,src), guesses(1,grid);
+    guesses[0].Checkerboard() = src.Checkerboard();
+    Mrhs.DeflateSources(srcs,guesses);
+    diff = norm2(guesses[0]-res);
+    std::cout << GridLogMessage << name << " MultiRHSDeflation diff "<<diff<<std::endl;
+    assert(diff < 1.0e-20*norm2(ref));
+  }
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+								   GridDefaultSimd(Nd,vComplexD::Nsimd()),
+								   GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(8,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(8,UGrid);
+  GridCartesian         * UGridF  = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+								   GridDefaultSimd(Nd,vComplexF::Nsimd()),
+								   GridDefaultMpi());
+  GridRedBlackCartesian * UrbGridF= SpaceTimeGrid::makeFourDimRedBlackGrid(UGridF);
+
+  GridParallelRNG RNG(FGrid);   RNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  GridParallelRNG RNGF(UGridF); RNGF.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  // fp16 relative precision is 2^-11 against the largest component on a site
+  TestStore<LatticeFermionD,vRealH>(FrbGrid,RNG,1.0e-3,"5d fermion fp16");
+  TestStore<LatticeFermionD,vRealF>(FrbGrid,RNG,1.0e-6,"5d fermion fp32");
+  TestStore<LatticeFermionD,vRealH>(UrbGrid,RNG4,1.0e-3,"4d fermion fp16");
+  TestStore<LatticeFermionF,vRealH>(UrbGridF,RNGF,1.0e-3,"4d single fermion fp16");
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,213 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/smearing/Test_WilsonFlow_fused.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef PeriodicGimplD Gimpl;
+typedef Gimpl::GaugeField GaugeField;
+
+// Lüscher RK3 step from the Wilson action force, as the flow was integrated before the stages were fused
+void ReferenceStep(WilsonGaugeAction<Gimpl> &SG,GaugeField &U,GaugeField &Zprime,RealD eps)
+{
+  GaugeField Z(U.Grid()), tmp(U.Grid());
+  SG.deriv(U, Z);
+  Zprime = -Z;
+  Z *= 0.25;
+  Gimpl::update_field(Z, U, -2.0*eps);
+  Z *= -17.0/8.0;
+  SG.deriv(U, tmp); Z += tmp;
+  Zprime += 2.0*tmp;
+  Z *= 8.0/9.0;
+  Gimpl::update_field(Z, U, -2.0*eps);
+  Z *= -4.0/3.0;
+  SG.deriv(U, tmp); Z += tmp;
+  Z *= 3.0/4.0;
+  Gimpl::update_field(Z, U, -2.0*eps);
+}
+
+// Topological charge from the per-plane clover FieldStrength, independent of the
+// batched clover-leaf paths behind TopologicalCharge and TopologicalChargeMxN
+RealD ReferenceCharge(const GaugeField &U)
+{
+  typedef WilsonLoops<Gimpl> WL;
+  GridBase *grid = U.Grid();
+  LatticeColourMatrixD Bx(grid), By(grid), Bz(grid), Ex(grid), Ey(grid), Ez(grid);
+  WL::FieldStrength(Bx, U, Ydir, Zdir);
+  WL::FieldStrength(By, U, Zdir, Xdir);
+  WL::FieldStrength(Bz, U, Xdir, Ydir);
+  WL::FieldStrength(Ex, U, Tdir, Xdir);
+  WL::FieldStrength(Ey, U, Tdir, Ydir);
+  WL::FieldStrength(Ez, U, Tdir, Zdir);
+  LatticeComplexD q(grid);
+  q = trace(Bx*Ex + By*Ey + Bz*Ez);
+  return 8.0/(32.0*M_PI*M_PI)*real(TensorRemove(sum(q)));
+}
+
+// Fused RK3 stages against the step built from the action force, plaquette energy
+// reused from the flow against a fresh evaluation, clover observables against
+// FieldStrength, adaptive flow and the batched flow on a split grid.
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  std::cout << std::setprecision(14);
+  Coordinate mpi_layout = GridDefaultMpi();
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplexD::Nsimd()),
+							 mpi_layout);
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(seeds);
+
+  GaugeField U(UGrid);   SU<Nc>::HotConfiguration(RNG4,U);
+  GaugeField ref(UGrid);
+  GaugeField res(UGrid);
+  GaugeField diff(UGrid);
+  GaugeField Zprime(UGrid);
+
+  // Fixed step size
+  const int   Nstep = 10;
+  const RealD eps   = 0.02;
+  WilsonGaugeAction<Gimpl> SG(3.0);
+  WilsonFlow<Gimpl> WF(eps,Nstep);
+  WF.resetActions();
+
+  std::vector<RealD> E_ref, E_flow;
+  std::vector<RealD> Q_ref, Q_flow, Q_mxn;
+  ref = U;
+  WF.addMeasurement(1, [&](int step, RealD t, const GaugeField &V){
+      ReferenceStep(SG,ref,Zprime,eps);
+      E_ref.push_back(WilsonFlow<Gimpl>::energyDensityPlaquette(t,ref));
+      E_flow.push_back(WF.energyDensityPlaquetteFlowed(t));
+    });
+  WF.addMeasurement(5, [&](int step, RealD t, const GaugeField &V){
+      Q_ref.push_back(ReferenceCharge(V));
+      Q_flow.push_back(WilsonLoops<Gimpl>::TopologicalCharge(V));
+      Q_mxn.push_back(WilsonLoops<Gimpl>::TopologicalChargeMxN(V,1,1));
+    });
+
+  double t0=usecond();
+  WF.smear(res,U);
+  double t1=usecond();
+  diff = ref-res;
+  std::cout << GridLogMessage << "Fixed step flow |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)
+	    << " " << (t1-t0)/1000/Nstep << " ms/step" << std::endl;
+  assert(norm2(diff) < 1.0e-24*norm2(ref));
+
+  assert(E_ref.size()==Nstep);
+  for(int s=0;s<Nstep;s++){
+    std::cout << GridLogMessage << "t^2 E(t) plaquette step "<<s+1<<" "<<E_ref[s]<<" "<<E_flow[s]<<std::endl;
+    assert(fabs(E_ref[s]-E_flow[s]) < 1.0e-10*fabs(E_ref[s]));
+  }
+  assert(Q_ref.size()==2);
+  for(int q=0;q<Q_ref.size();q++){
+    std::cout << GridLogMessage << "Q(t) "<<Q_ref[q]<<" "<<Q_flow[q]<<" "<<Q_mxn[q]<<std::endl;
+    assert(fabs(Q_ref[q]-Q_flow[q]) < 1.0e-10);
+    assert(fabs(Q_ref[q]-Q_mxn[q])  < 1.0e-10);
+  }
+
+  // Clover energy density against the field strengths one plane at a time
+  {
+    LatticeColourMatrixD F(UGrid);
+    LatticeComplexD R(UGrid); R = Zero();
+    for(int mu=0;mu<Nd-1;mu++){
+      for(int nu=mu+1;nu<Nd;nu++){
+	WilsonLoops<Gimpl>::FieldStrength(F, res, mu, nu);
+	R = R + trace(F*F);
+      }
+    }
+    RealD t = Nstep*eps;
+    RealD Eref = -t*t*real(TensorRemove(sum(R)))/UGrid->gSites();
+    RealD E    = WilsonFlow<Gimpl>::energyDensityCloverleaf(t,res);
+    std::cout << GridLogMessage << "t^2 E(t) clover "<<Eref<<" "<<E<<std::endl;
+    assert(fabs(Eref-E) < 1.0e-10*fabs(Eref));
+  }
+
+  // Adaptive flow against the same integrator with the Ramos distance
+  {
+    const RealD maxTau    = 0.2;
+    const RealD tolerance = 1.0e-4;
+    WilsonFlowAdaptive<Gimpl> WFA(eps,maxTau,tolerance);
+    WFA.resetActions();
+    WFA.smear(res,U);
+
+    ref = U;
+    RealD tau = 0.0;
+    RealD e   = eps;
+    GaugeField Uprime(UGrid), Usave(UGrid);
+    do {
+      if ( maxTau-tau < e ) e = maxTau-tau;
+      Usave = ref;
+      ReferenceStep(SG,ref,Zprime,e);
+      Uprime = Usave;
+      Gimpl::update_field(Zprime, Uprime, -2.0*e);
+      diff = ref-Uprime;
+      RealD max_dist = 0;
+      for(int mu=0;mu<Nd;mu++){
+	LatticeColourMatrixD d = PeekIndex<LorentzIndex>(diff,mu);
+	max_dist = std::max(max_dist,sqrt(maxLocalNorm2(d))/Nc/Nc);
+      }
+      if ( max_dist < tolerance ) tau += e;
+      else                        ref = Usave;
+      e = e*0.95*std::pow(tolerance/max_dist,1./3.);
+    } while ( tau < maxTau );
+    diff = ref-res;
+    std::cout << GridLogMessage << "Adaptive flow  |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)<<std::endl;
+    assert(norm2(diff) < 1.0e-20*norm2(ref));
+  }
+
+  // Batched flow, one configuration per sub-communicator
+  {
+    Coordinate mpi_split(Nd,1);
+    int nconf = 1;
+    for(int d=0;d<Nd;d++) nconf *= mpi_layout[d];
+    int me;
+    GridCartesian * SGrid = new GridCartesian(GridDefaultLatt(),
+					      GridDefaultSimd(Nd,vComplexD::Nsimd()),
+					      mpi_split,
+					      *UGrid,me);
+    std::vector<GaugeField> in(nconf,UGrid), out;
+    for(int c=0;c<nconf;c++) SU<Nc>::HotConfiguration(RNG4,in[c]);
+
+    WilsonFlow<Gimpl> WFB(eps,Nstep);
+    WFB.resetActions();
+    WFB.smear(out,in,SGrid);
+    assert(out.size()==nconf);
+    for(int c=0;c<nconf;c++){
+      WFB.smear(ref,in[c]);
+      diff = ref-out[c];
+      std::cout << GridLogMessage << "Batched flow conf "<<c<<" |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)<<std::endl;
+      assert(norm2(diff) < 1.0e-24*norm2(ref));
+    }
+    delete SGrid;
+  }
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,141 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/smearing/Test_stout_fused.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Padded cell staples against the Cshift staples, site local stout
+// exponential against the series, and the smeared force against the
+// change in the smeared Wilson action.
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  std::cout << std::setprecision(14);
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplex::Nsimd()),
+							 GridDefaultMpi());
+  std::vector<int> seeds({1,2,3,4});
+  GridSerialRNG   sRNG;        sRNG.SeedFixedIntegers(seeds);
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(seeds);
+
+  LatticeGaugeField U(UGrid);   SU<Nc>::HotConfiguration(RNG4,U);
+  LatticeGaugeField iLambda(UGrid);
+  LatticeGaugeField ref(UGrid);
+  LatticeGaugeField res(UGrid);
+  LatticeGaugeField diff(UGrid);
+  gaussian(RNG4,iLambda); iLambda = Ta(iLambda);
+
+  // Direction dependent weights
+  std::vector<double> rho(Nd*Nd);
+  for(int mu=0;mu<Nd;mu++){
+    for(int nu=0;nu<Nd;nu++){
+      rho[mu+Nd*nu] = (mu==nu) ? 0.0 : 0.05+0.01*mu+0.002*nu;
+    }
+  }
+  Smear_APE<PeriodicGimplR> APE(rho);
+
+  double t0=usecond();
+  APE.smearCshift(ref,U);
+  double t1=usecond();
+  APE.smear(res,U);
+  double t2=usecond();
+  diff = ref-res;
+  std::cout << GridLogMessage << "APE smear     |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)
+	    << " Cshift "<<(t1-t0)/1000<<" ms padded "<<(t2-t1)/1000<<" ms"<<std::endl;
+  assert(norm2(diff) < 1.0e-24*norm2(ref));
+
+  ref = Zero();
+  res = Zero();
+  t0=usecond();
+  APE.derivativeCshift(ref,iLambda,U);
+  t1=usecond();
+  APE.derivative(res,iLambda,U);
+  t2=usecond();
+  diff = ref-res;
+  std::cout << GridLogMessage << "APE derivative |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)
+	    << " Cshift "<<(t1-t0)/1000<<" ms padded "<<(t2-t1)/1000<<" ms"<<std::endl;
+  assert(norm2(diff) < 1.0e-24*norm2(ref));
+
+  // Stout link against the series exponential
+  double srho = 0.1;
+  Smear_Stout<PeriodicGimplR> Stout(srho);
+  Smear_APE<PeriodicGimplR>   APEs(srho);
+  LatticeColourMatrix Umu(UGrid), Cmu(UGrid), iQ(UGrid);
+  APEs.smearCshift(ref,U);
+  for(int mu=0;mu<Nd;mu++){
+    Umu = PeekIndex<LorentzIndex>(U,mu);
+    Cmu = PeekIndex<LorentzIndex>(ref,mu);
+    iQ  = Ta(Cmu*adj(Umu));
+    PokeIndex<LorentzIndex>(ref,expMat(iQ,1.0,20)*Umu,mu);
+  }
+  Stout.smear(res,U);
+  diff = ref-res;
+  std::cout << GridLogMessage << "Stout smear   |ref|^2 "<<norm2(ref)<<" diff "<<norm2(diff)<<std::endl;
+  assert(norm2(diff) < 1.0e-20*norm2(ref));
+
+  // Force through three levels of smearing against the change in action
+  const int levels=3;
+  SmearedConfiguration<PeriodicGimplR> StoutConfig(UGrid,levels,Stout);
+  WilsonGaugeActionR PlaqAction(6.0);
+  PlaqAction.is_smeared = true;
+  Action<LatticeGaugeField> &Action = PlaqAction;
+
+  LatticeGaugeField P(UGrid);
+  LatticeGaugeField UdSdU(UGrid);
+  LatticeColourMatrix Pmu(UGrid);
+  PeriodicGimplR::generate_momenta(P,sRNG,RNG4);
+
+  RealD eps=0.001;
+  StoutConfig.set_Field(U);
+  RealD S1 = Action.S(StoutConfig);
+
+  PeriodicGimplR::update_field(P,U,eps);
+  StoutConfig.set_Field(U);
+  Action.deriv(StoutConfig,UdSdU);
+  UdSdU = Ta(UdSdU);
+
+  PeriodicGimplR::update_field(P,U,eps);
+  StoutConfig.set_Field(U);
+  RealD S2 = Action.S(StoutConfig);
+
+  LatticeComplex dS(UGrid); dS = Zero();
+  for(int mu=0;mu<Nd;mu++){
+    auto UdSdUmu = PeekIndex<LorentzIndex>(UdSdU,mu);
+    Pmu = PeekIndex<LorentzIndex>(P,mu);
+    dS = dS - trace(Pmu*UdSdUmu)*eps*2.0*HMC_MOMENTUM_DENOMINATOR;
+  }
+  ComplexD dSpred = sum(dS);
+  RealD err = S2-S1-dSpred.real();
+  std::cout << GridLogMessage << "Smeared force dS "<<S2-S1<<" dSpred "<<dSpred.real()<<" diff "<<err<<std::endl;
+  assert(fabs(err) < 1.0e-4*fabs(S2-S1));
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,95 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/solver/Test_multishift_sstep.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// s-step multi-shift CG against the standard multi-shift CG on the domain
+// wall Schur operator with a rational approximation to x^{-1/2}.
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+  GridParallelRNG          RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+
+  LatticeGaugeFieldD Umu(UGrid); SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+  DomainWallFermionD Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  SchurDiagMooeeOperator<DomainWallFermionD,LatticeFermionD> HermOpEO(Ddwf);
+
+  LatticeFermionD src(FGrid); random(RNG5,src);
+  LatticeFermionD src_o(FrbGrid);
+  pickCheckerboard(Odd,src_o,src);
+
+  AlgRemez remez(1e-4,64,50);
+  int order = 12;
+  remez.generateApprox(order,1,2);
+  MultiShiftFunction shifts(remez,1e-10,false);
+
+  ConjugateGradientMultiShift<LatticeFermionD> MSCG(10000,shifts);
+  std::vector<LatticeFermionD> ref(order,FrbGrid);
+  double t0=usecond();
+  MSCG(HermOpEO,src_o,ref);
+  double t1=usecond();
+  std::cout << GridLogMessage << "ConjugateGradientMultiShift "<<MSCG.IterationsToComplete
+	    <<" iterations "<<(t1-t0)/1000<<" ms"<<std::endl;
+
+  LatticeFermionD diff(FrbGrid);
+  for(int s=1;s<=4;s++){
+    ConjugateGradientMultiShiftSStep<LatticeFermionD> SSCG(10000,shifts,s);
+    std::vector<LatticeFermionD> res(order,FrbGrid);
+    t0=usecond();
+    SSCG(HermOpEO,src_o,res);
+    t1=usecond();
+    std::cout << GridLogMessage << "ConjugateGradientMultiShiftSStep s="<<s<<" "<<SSCG.IterationsToComplete
+	      <<" iterations "<<(t1-t0)/1000<<" ms"<<std::endl;
+    for(int i=0;i<order;i++){
+      diff = ref[i]-res[i];
+      RealD rel = std::sqrt(norm2(diff)/norm2(ref[i]));
+      std::cout << GridLogMessage << " shift "<<i<<" true residual "<<SSCG.TrueResidualShift[i]
+		<<" |res-ref|/|ref| "<<rel<<std::endl;
+      assert(SSCG.TrueResidualShift[i] < 1.0e-8);
+      assert(rel < 1.0e-7);
+    }
+  }
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,97 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/Test_wilson_cg_pipelined.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(&Grid);
+
+  Coordinate simd_layout_f = GridDefaultSimd(Nd,vComplexF::Nsimd());
+  GridCartesian               Grid_f(latt_size,simd_layout_f,mpi_layout);
+  GridRedBlackCartesian     RBGrid_f(&Grid_f);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          pRNG(&Grid);  pRNG.SeedFixedIntegers(seeds);
+
+  LatticeGaugeFieldD Umu(&Grid); SU<Nc>::HotConfiguration(pRNG,Umu);
+  LatticeGaugeFieldF Umu_f(&Grid_f); precisionChange(Umu_f,Umu);
+
+  LatticeFermionD    src(&Grid); random(pRNG,src);
+  LatticeFermionD result(&Grid); result=Zero();
+  LatticeFermionD    ref(&Grid); ref=Zero();
+  LatticeFermionD   diff(&Grid);
+
+  RealD mass=0.1;
+  WilsonFermionD Dw(Umu,Grid,RBGrid,mass);
+  WilsonFermionF Dw_f(Umu_f,Grid_f,RBGrid_f,mass);
+
+  std::cout << GridLogMessage << "Schur solve with ConjugateGradient"<<std::endl;
+  ConjugateGradient<LatticeFermionD> CG(1.0e-8,10000);
+  SchurRedBlackDiagMooeeSolve<LatticeFermionD> SchurSolver(CG);
+  SchurSolver(Dw,src,ref);
+
+  std::cout << GridLogMessage << "Schur solve with ConjugateGradientPipelined"<<std::endl;
+  ConjugateGradientPipelined<LatticeFermionD> PCG(1.0e-8,10000);
+  SchurRedBlackDiagMooeeSolve<LatticeFermionD> PipelinedSolver(PCG);
+  PipelinedSolver(Dw,src,result);
+
+  diff = result - ref;
+  RealD reldiff = std::sqrt(norm2(diff)/norm2(ref));
+  std::cout << GridLogMessage << "CG iterations "<<CG.IterationsToComplete
+	    << " pipelined iterations "<<PCG.IterationsToComplete
+	    << " replacements "<<PCG.ReplacementsDone
+	    << " relative solution difference "<<reldiff<<std::endl;
+  assert(reldiff < 1.0e-6);
+  assert(PCG.TrueResidual < 1.0e-7);
+  assert(PCG.IterationsToComplete < 2*CG.IterationsToComplete);
+
+  std::cout << GridLogMessage << "Mixed precision solve with pipelined inner and patch-up CG"<<std::endl;
+  LatticeFermionD src_o(&RBGrid);
+  LatticeFermionD sol_o(&RBGrid);
+  pickCheckerboard(Odd,src_o,src);
+  sol_o = Zero();
+
+  SchurDiagMooeeOperator<WilsonFermionD,LatticeFermionD> HermOpEO(Dw);
+  SchurDiagMooeeOperator<WilsonFermionF,LatticeFermionF> HermOpEO_f(Dw_f);
+  MixedPrecisionConjugateGradient<LatticeFermionD,LatticeFermionF> mCG(1.0e-8, 10000, 50, &RBGrid_f, HermOpEO_f, HermOpEO);
+  mCG.UsePipelinedCG = true;
+  mCG(src_o,sol_o);
+  std::cout << GridLogMessage << "Mixed precision true residual "<<mCG.TrueResidual<<std::endl;
+  assert(mCG.TrueResidual < 1.0e-7);
+
+  Grid_finalize();
+}
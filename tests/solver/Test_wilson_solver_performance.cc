@@ -0,0 +1,118 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/Test_wilson_solver_performance.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(&Grid);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          pRNG(&Grid);  pRNG.SeedFixedIntegers(seeds);
+
+  LatticeGaugeFieldD Umu(&Grid); SU<Nc>::HotConfiguration(pRNG,Umu);
+
+  LatticeFermionD    src(&Grid); random(pRNG,src);
+  LatticeFermionD src_o(&RBGrid);
+  LatticeFermionD sol_o(&RBGrid);
+  pickCheckerboard(Odd,src_o,src);
+
+  RealD mass=0.1;
+  WilsonFermionD Dw(Umu,Grid,RBGrid,mass);
+  SchurDiagMooeeOperator<WilsonFermionD,LatticeFermionD> HermOpEO(Dw);
+
+  // Nothing is kept until the log is switched on
+  ConjugateGradient<LatticeFermionD> CG(1.0e-8,10000);
+  sol_o = Zero(); CG(HermOpEO,src_o,sol_o);
+  assert(SolverPerformanceLog::Records().size()==0);
+
+  SolverPerformanceLog::Enable();
+  sol_o = Zero(); CG(HermOpEO,src_o,sol_o);
+  sol_o = Zero(); CG(HermOpEO,src_o,sol_o);
+
+  ConjugateGradientPipelined<LatticeFermionD> PCG(1.0e-8,10000);
+  sol_o = Zero(); PCG(HermOpEO,src_o,sol_o);
+
+  BiCGSTAB<LatticeFermionD> BCG(1.0e-8,10000);
+  sol_o = Zero(); BCG(HermOpEO,src_o,sol_o);
+
+  std::vector<SolverPerformance> &rec = SolverPerformanceLog::Records();
+  assert(rec.size()==4);
+  assert(rec[0].Solver=="ConjugateGradient");
+  assert(rec[2].Solver=="ConjugateGradientPipelined");
+  assert(rec[3].Solver=="BiCGSTAB");
+  for(auto &r : rec){
+    std::cout << GridLogMessage << r.Solver << " iterations "<<r.Iterations
+	      << " matrix calls "<<r.MatrixCalls<<" reductions "<<r.Reductions
+	      << " halo exchanges "<<r.HaloExchanges<<" total "<<r.TotalTime<<" s"<<std::endl;
+    assert(r.Converged);
+    assert(r.Iterations>0);
+    assert(r.MatrixCalls>=r.Iterations);
+    assert(r.Reductions>=r.Iterations);
+    assert(r.LinalgFlops>0 && r.LinalgBytes>0);
+    assert(r.TotalTime>=r.MatrixTime+r.LinalgTime);
+  }
+  assert(rec[0].Iterations==CG.IterationsToComplete);
+  assert(rec[2].Iterations==PCG.IterationsToComplete);
+  // Pipelined CG: one fused reduction per iteration, plus set up and final check
+  assert(rec[2].Reductions < rec[0].Reductions);
+
+  std::vector<SolverPerformance> summary = SolverPerformanceLog::Summary();
+  assert(summary.size()==3);
+  assert(summary[0].Solves==2);
+  assert(summary[0].Iterations==rec[0].Iterations+rec[1].Iterations);
+
+  // Round trip through the serialisers
+  SolverPerformanceLog::WriteFile("solver_performance.xml");
+  SolverPerformanceLog::WriteFile("solver_performance.json");
+  {
+    XmlReader RD("solver_performance.xml");
+    std::vector<SolverPerformance> check;
+    read(RD,"Solves",check);
+    assert(check.size()==rec.size());
+    for(int i=0;i<check.size();i++){
+      assert(check[i].Solver     == rec[i].Solver);
+      assert(check[i].Iterations == rec[i].Iterations);
+      assert(check[i].Reductions == rec[i].Reductions);
+    }
+  }
+
+  SolverPerformanceLog::Clear();
+  assert(SolverPerformanceLog::Records().size()==0);
+
+  std::cout << GridLogMessage << "Done"<<std::endl;
+  Grid_finalize();
+}